@@ -57,6 +57,15 @@ enum {
 	 * IPC_M_DATA_READ requests.
 	 */
 	DATA_XFER_LIMIT = 64 * 1024,
+
+	/**
+	 * Maximum buffer size allowed for IPC_M_DATA_WRITE and
+	 * IPC_M_DATA_READ requests if the kernel can pin the caller's
+	 * buffer instead of copying it through a kernel buffer. Requests
+	 * larger than DATA_XFER_LIMIT are only accepted by recipients
+	 * that ask for them.
+	 */
+	DATA_XFER_PIN_LIMIT = 16 * 1024 * 1024,
 };
 
 /* Flags for calls */
@@ -49,6 +49,7 @@ enum {
 	/** Maximum name sizes */
 	TASK_NAME_BUFLEN = 64,
 	EXC_NAME_BUFLEN  = 20,
+	SLAB_NAME_BUFLEN = 32,
 };
 
 /** Item value type
@@ -73,6 +74,9 @@ typedef struct {
 	uint64_t busy_cycles;    /**< Number of busy cycles */
 } stats_cpu_t;
 
+/** Number of free block orders in physical memory statistics */
+#define STATS_PHYSMEM_ORDERS  20
+
 /** Physical memory statistics
  *
  */
@@ -81,6 +85,9 @@ typedef struct {
 	uint64_t unavail;  /**< Unavailable (reserved, firmware) bytes */
 	uint64_t used;     /**< Allocated physical memory (bytes) */
 	uint64_t free;     /**< Free physical memory (bytes) */
+
+	/** Number of free blocks of 2^order contiguous frames */
+	uint64_t free_blocks[STATS_PHYSMEM_ORDERS];
 } stats_physmem_t;
 
 /** IPC statistics
@@ -144,6 +151,24 @@ typedef struct {
 	uint64_t count;              /**< Number of handled exceptions */
 } stats_exc_t;
 
+/** Statistics about a single slab cache
+ *
+ */
+typedef struct {
+	char name[SLAB_NAME_BUFLEN];  /**< Cache name */
+	uint64_t size;                /**< Object size (bytes) */
+	uint64_t frames;              /**< Frames per slab */
+	uint64_t objects;             /**< Objects per slab */
+	uint64_t colors;              /**< Number of slab colors */
+	uint64_t slabs;               /**< Allocated slabs */
+	uint64_t cached;              /**< Objects cached in magazines */
+	uint64_t allocated;           /**< Allocated objects */
+	uint64_t magazine_size;       /**< Size of new magazines */
+	uint64_t hits;                /**< Allocations served by CPU magazines */
+	uint64_t misses;              /**< Allocations missed in CPU magazines */
+	uint64_t contention;          /**< Contended magazine list accesses */
+} stats_slab_t;
+
 /** Load fixed-point value */
 typedef uint32_t load_t;
 
@@ -46,11 +46,18 @@
  * have fairly large (prime/odd) divisors. Having a prime table size
  * mitigates the use of suboptimal hash functions and distributes
  * items over the whole table.
+ *
+ * Resizing is incremental. The new table is allocated at once, but its
+ * buckets are initialized and then the items are moved to it a few buckets
+ * at a time by the following insert and remove operations. Until then, an
+ * item whose old bucket has not been migrated yet is still found in the old
+ * table, so that each item has exactly one home bucket at any time.
  */
 
 #include <adt/hash_table.h>
 #include <adt/list.h>
 #include <assert.h>
+#include <macros.h>
 #include <stdlib.h>
 #include <str.h>
 
@@ -58,11 +65,16 @@
 #define HT_MIN_BUCKETS  89
 /* The table is resized when the average load per bucket exceeds this number. */
 #define HT_MAX_LOAD     2
+/* Number of old buckets migrated by each insert or remove during a resize. */
+#define HT_MIGRATE_STEP 4
+/* Number of new buckets initialized per old bucket migration step. */
+#define HT_INIT_STEP    8
 
 static size_t round_up_size(size_t);
 static bool alloc_table(size_t, list_t **);
 static void clear_items(hash_table_t *);
 static void resize(hash_table_t *, size_t);
+static void migrate(hash_table_t *, size_t);
 static void grow_if_needed(hash_table_t *);
 static void shrink_if_needed(hash_table_t *);
 
@@ -103,6 +115,10 @@ bool hash_table_create(hash_table_t *h, size_t init_size, size_t max_load,
 	if (!alloc_table(h->bucket_cnt, &h->bucket))
 		return false;
 
+	h->bucket_init_cnt = h->bucket_cnt;
+	h->old_bucket = NULL;
+	h->old_bucket_cnt = 0;
+	h->migrate_idx = 0;
 	h->max_load = (max_load == 0) ? HT_MAX_LOAD : max_load;
 	h->item_cnt = 0;
 	h->op = op;
@@ -124,8 +140,11 @@ void hash_table_destroy(hash_table_t *h)
 
 	clear_items(h);
 
+	free(h->old_bucket);
 	free(h->bucket);
 
+	h->old_bucket = NULL;
+	h->old_bucket_cnt = 0;
 	h->bucket = NULL;
 	h->bucket_cnt = 0;
 }
@@ -161,6 +180,21 @@ void hash_table_clear(hash_table_t *h)
 	}
 }
 
+/** Unlinks and removes all items of a bucket array. */
+static void clear_buckets(list_t *bucket, size_t first, size_t last,
+    void (*remove_cb)(ht_link_t *))
+{
+	for (size_t idx = first; idx < last; ++idx) {
+		list_foreach_safe(bucket[idx], cur, next) {
+			assert(cur);
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+
+			list_remove(cur);
+			remove_cb(cur_link);
+		}
+	}
+}
+
 /** Unlinks and removes all items but does not resize. */
 static void clear_items(hash_table_t *h)
 {
@@ -169,19 +203,32 @@ static void clear_items(hash_table_t *h)
 
 	void (*remove_cb)(ht_link_t *) = h->op->remove_callback ? h->op->remove_callback : nop_remove_callback;
 
-	for (size_t idx = 0; idx < h->bucket_cnt; ++idx) {
-		list_foreach_safe(h->bucket[idx], cur, next) {
-			assert(cur);
-			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
-
-			list_remove(cur);
-			remove_cb(cur_link);
-		}
+	if (h->old_bucket) {
+		clear_buckets(h->old_bucket, h->migrate_idx, h->old_bucket_cnt,
+		    remove_cb);
 	}
 
+	clear_buckets(h->bucket, 0, h->bucket_init_cnt, remove_cb);
+
 	h->item_cnt = 0;
 }
 
+/** Returns the bucket where items with the given hash belong.
+ *
+ * While the table is being resized, this is the bucket of the old table
+ * unless it has already been migrated.
+ */
+static list_t *home_bucket(const hash_table_t *h, size_t hash)
+{
+	if (h->old_bucket) {
+		size_t old_idx = hash % h->old_bucket_cnt;
+		if (old_idx >= h->migrate_idx)
+			return &h->old_bucket[old_idx];
+	}
+
+	return &h->bucket[hash % h->bucket_cnt];
+}
+
 /** Insert item into a hash table.
  *
  * @param h    Hash table.
@@ -193,9 +240,9 @@ void hash_table_insert(hash_table_t *h, ht_link_t *item)
 	assert(h && h->bucket);
 	assert(!h->apply_ongoing);
 
-	size_t idx = h->op->hash(item) % h->bucket_cnt;
+	migrate(h, HT_MIGRATE_STEP);
 
-	list_append(&item->link, &h->bucket[idx]);
+	list_append(&item->link, home_bucket(h, h->op->hash(item)));
 	++h->item_cnt;
 	grow_if_needed(h);
 }
@@ -215,10 +262,12 @@ bool hash_table_insert_unique(hash_table_t *h, ht_link_t *item)
 	assert(h->op && h->op->hash && h->op->equal);
 	assert(!h->apply_ongoing);
 
-	size_t idx = h->op->hash(item) % h->bucket_cnt;
+	migrate(h, HT_MIGRATE_STEP);
+
+	list_t *bucket = home_bucket(h, h->op->hash(item));
 
 	/* Check for duplicates. */
-	list_foreach(h->bucket[idx], link, ht_link_t, cur_link) {
+	list_foreach(*bucket, link, ht_link_t, cur_link) {
 		/*
 		 * We could filter out items using their hashes first, but
 		 * calling equal() might very well be just as fast.
@@ -227,7 +276,7 @@ bool hash_table_insert_unique(hash_table_t *h, ht_link_t *item)
 			return false;
 	}
 
-	list_append(&item->link, &h->bucket[idx]);
+	list_append(&item->link, bucket);
 	++h->item_cnt;
 	grow_if_needed(h);
 
@@ -247,9 +296,8 @@ ht_link_t *hash_table_find(const hash_table_t *h, const void *key)
 	assert(h && h->bucket);
 
 	size_t hash = h->op->key_hash(key);
-	size_t idx = hash % h->bucket_cnt;
 
-	list_foreach(h->bucket[idx], link, ht_link_t, cur_link) {
+	list_foreach(*home_bucket(h, hash), link, ht_link_t, cur_link) {
 		if (h->op->key_equal(key, hash, cur_link))
 			return cur_link;
 	}
@@ -264,8 +312,7 @@ hash_table_find_next(const hash_table_t *h, ht_link_t *item)
 	assert(item);
 	assert(h && h->bucket);
 
-	size_t idx = h->op->hash(item) % h->bucket_cnt;
-	list_t *list = &h->bucket[idx];
+	list_t *list = home_bucket(h, h->op->hash(item));
 	link_t *cur = list_next(&item->link, list);
 
 	/* Traverse the list until we reach its end. */
@@ -294,12 +341,12 @@ size_t hash_table_remove(hash_table_t *h, const void *key)
 	assert(h && h->bucket);
 	assert(!h->apply_ongoing);
 
-	size_t hash = h->op->key_hash(key);
-	size_t idx = hash % h->bucket_cnt;
+	migrate(h, HT_MIGRATE_STEP);
 
+	size_t hash = h->op->key_hash(key);
 	size_t removed = 0;
 
-	list_foreach_safe(h->bucket[idx], cur, next) {
+	list_foreach_safe(*home_bucket(h, hash), cur, next) {
 		ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
 
 		if (h->op->key_equal(key, hash, cur_link)) {
@@ -329,6 +376,8 @@ void hash_table_remove_item(hash_table_t *h, ht_link_t *item)
 
 	if (h->op->remove_callback)
 		h->op->remove_callback(item);
+
+	migrate(h, HT_MIGRATE_STEP);
 	shrink_if_needed(h);
 }
 
@@ -351,7 +400,19 @@ void hash_table_apply(hash_table_t *h, bool (*f)(ht_link_t *, void *), void *arg
 
 	h->apply_ongoing = true;
 
-	for (size_t idx = 0; idx < h->bucket_cnt; ++idx) {
+	/* Buckets of the old table which have not been migrated yet. */
+	size_t old_idx = h->old_bucket ? h->migrate_idx : 0;
+
+	for (; old_idx < h->old_bucket_cnt; ++old_idx) {
+		list_foreach_safe(h->old_bucket[old_idx], cur, next) {
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+			/* See below. */
+			if (!f(cur_link, arg))
+				goto out;
+		}
+	}
+
+	for (size_t idx = 0; idx < h->bucket_init_cnt; ++idx) {
 		list_foreach_safe(h->bucket[idx], cur, next) {
 			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
 			/*
@@ -421,7 +482,49 @@ static inline void grow_if_needed(hash_table_t *h)
 	}
 }
 
-/** Allocates and rehashes items to a new table. Frees the old table. */
+/** Moves items from up to @a cnt old buckets to the new table.
+ *
+ * Frees the old table when all of its buckets have been migrated.
+ */
+static void migrate(hash_table_t *h, size_t cnt)
+{
+	/* We are traversing the table and migrating would mess up the buckets. */
+	if (!h->old_bucket || h->apply_ongoing)
+		return;
+
+	/* Initialize the new buckets before moving any items to them. */
+	if (h->bucket_init_cnt < h->bucket_cnt) {
+		size_t init_cnt = min(h->bucket_cnt - h->bucket_init_cnt,
+		    cnt * HT_INIT_STEP);
+
+		for (; init_cnt > 0; --init_cnt)
+			list_initialize(&h->bucket[h->bucket_init_cnt++]);
+
+		if (h->bucket_init_cnt < h->bucket_cnt)
+			return;
+	}
+
+	for (; cnt > 0 && h->migrate_idx < h->old_bucket_cnt; --cnt) {
+		list_foreach_safe(h->old_bucket[h->migrate_idx], cur, next) {
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+
+			size_t new_idx = h->op->hash(cur_link) % h->bucket_cnt;
+			list_remove(cur);
+			list_append(cur, &h->bucket[new_idx]);
+		}
+
+		++h->migrate_idx;
+	}
+
+	if (h->migrate_idx == h->old_bucket_cnt) {
+		free(h->old_bucket);
+		h->old_bucket = NULL;
+		h->old_bucket_cnt = 0;
+		h->migrate_idx = 0;
+	}
+}
+
+/** Allocates a new table and starts migrating items to it. */
 static void resize(hash_table_t *h, size_t new_bucket_cnt)
 {
 	assert(h && h->bucket);
@@ -431,29 +534,29 @@ static void resize(hash_table_t *h, size_t new_bucket_cnt)
 	if (h->apply_ongoing)
 		return;
 
-	list_t *new_buckets;
+	/* The buckets are initialized by migrate(). */
+	list_t *new_buckets = malloc(new_bucket_cnt * sizeof(list_t));
 
 	/* Leave the table as is if we cannot resize. */
-	if (!alloc_table(new_bucket_cnt, &new_buckets))
+	if (!new_buckets)
 		return;
 
-	if (0 < h->item_cnt) {
-		/* Rehash all the items to the new table. */
-		for (size_t old_idx = 0; old_idx < h->bucket_cnt; ++old_idx) {
-			list_foreach_safe(h->bucket[old_idx], cur, next) {
-				ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+	/* Finish the previous resize, there can only be one old table. */
+	if (h->old_bucket)
+		migrate(h, h->old_bucket_cnt);
 
-				size_t new_idx = h->op->hash(cur_link) % new_bucket_cnt;
-				list_remove(cur);
-				list_append(cur, &new_buckets[new_idx]);
-			}
-		}
-	}
+	h->old_bucket = h->bucket;
+	h->old_bucket_cnt = h->bucket_cnt;
+	h->migrate_idx = 0;
 
-	free(h->bucket);
 	h->bucket = new_buckets;
 	h->bucket_cnt = new_bucket_cnt;
+	h->bucket_init_cnt = 0;
 	h->full_item_cnt = h->max_load * h->bucket_cnt;
+
+	/* There is nothing to migrate in an empty table. */
+	if (h->item_cnt == 0)
+		migrate(h, h->old_bucket_cnt);
 }
 
 /** @}
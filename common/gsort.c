@@ -32,14 +32,17 @@
 
 /**
  * @file
- * @brief Gnome Sort.
+ * @brief Stable merge sort.
  *
- * This file contains an implementation of gnome sort
+ * This file contains an implementation of a stable merge sort. Short runs
+ * are sorted by insertion sort, adjacent runs which are already in order
+ * are not merged at all.
  *
  */
 
 #include <gsort.h>
 #include <inttypes.h>
+#include <macros.h>
 #include <mem.h>
 #include <stdlib.h>
 
@@ -49,17 +52,20 @@
  * and use the stack.
  *
  */
-#define IBUF_SIZE  32
+#define IBUF_SIZE  256
+
+/** Runs up to this many elements are sorted by insertion sort. */
+#define RUN_SIZE  16
 
 /** Array accessor.
  *
  */
 #define INDEX(buf, i, elem_size)  ((buf) + (i) * (elem_size))
 
-/** Gnome sort
+/** Insertion sort
  *
- * Apply generic gnome sort algorithm on supplied data,
- * using pre-allocated buffer.
+ * Stable and allocation-free, but O(n^2), so it is used for short runs
+ * and as a fallback if no memory is available for merging.
  *
  * @param data      Pointer to data to be sorted.
  * @param cnt       Number of elements to be sorted.
@@ -70,30 +76,110 @@
  *                  elem_size bytes long.
  *
  */
-static void _gsort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp,
-    void *arg, void *slot)
+static void _insertion_sort(void *data, size_t cnt, size_t elem_size,
+    sort_cmp_t cmp, void *arg, void *slot)
 {
+	for (size_t i = 1; i < cnt; i++) {
+		if (cmp(INDEX(data, i - 1, elem_size), INDEX(data, i, elem_size),
+		    arg) <= 0)
+			continue;
+
+		memcpy(slot, INDEX(data, i, elem_size), elem_size);
+
+		size_t j = i - 1;
+		while ((j > 0) &&
+		    (cmp(INDEX(data, j - 1, elem_size), slot, arg) > 0))
+			j--;
+
+		memmove(INDEX(data, j + 1, elem_size), INDEX(data, j, elem_size),
+		    (i - j) * elem_size);
+		memcpy(INDEX(data, j, elem_size), slot, elem_size);
+	}
+}
+
+/** Merge two adjacent sorted runs
+ *
+ * The first run is moved aside to the buffer and merged back with the
+ * second run. Equal elements are taken from the first run first, which
+ * keeps the sort stable.
+ *
+ * @param data      Pointer to the first run.
+ * @param mid       Number of elements in the first run.
+ * @param cnt       Number of elements in both runs.
+ * @param elem_size Size of one element.
+ * @param cmp       Comparator function.
+ * @param arg       3rd argument passed to cmp.
+ * @param buf       Scratch memory buffer for @a mid elements.
+ *
+ */
+static void _merge(void *data, size_t mid, size_t cnt, size_t elem_size,
+    sort_cmp_t cmp, void *arg, void *buf)
+{
+	/* Already in order? */
+	if (cmp(INDEX(data, mid - 1, elem_size), INDEX(data, mid, elem_size),
+	    arg) <= 0)
+		return;
+
+	memcpy(buf, data, mid * elem_size);
+
 	size_t i = 0;
+	size_t j = mid;
+	size_t k = 0;
 
-	while (i < cnt) {
-		if ((i != 0) &&
-		    (cmp(INDEX(data, i, elem_size),
-		    INDEX(data, i - 1, elem_size), arg) < 0)) {
-			memcpy(slot, INDEX(data, i, elem_size), elem_size);
-			memcpy(INDEX(data, i, elem_size), INDEX(data, i - 1, elem_size),
+	while ((i < mid) && (j < cnt)) {
+		if (cmp(INDEX(data, j, elem_size), INDEX(buf, i, elem_size),
+		    arg) < 0) {
+			memcpy(INDEX(data, k, elem_size), INDEX(data, j, elem_size),
+			    elem_size);
+			j++;
+		} else {
+			memcpy(INDEX(data, k, elem_size), INDEX(buf, i, elem_size),
 			    elem_size);
-			memcpy(INDEX(data, i - 1, elem_size), slot, elem_size);
-			i--;
-		} else
 			i++;
+		}
+
+		k++;
 	}
+
+	/* The rest of the second run is already in place. */
+	memcpy(INDEX(data, k, elem_size), INDEX(buf, i, elem_size),
+	    (mid - i) * elem_size);
 }
 
-/** Gnome sort wrapper
+/** Merge sort
+ *
+ * Apply generic merge sort algorithm on supplied data,
+ * using pre-allocated buffer.
+ *
+ * @param data      Pointer to data to be sorted.
+ * @param cnt       Number of elements to be sorted.
+ * @param elem_size Size of one element.
+ * @param cmp       Comparator function.
+ * @param arg       3rd argument passed to cmp.
+ * @param buf       Scratch memory buffer for (cnt / 2) elements.
+ *
+ */
+static void _msort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp,
+    void *arg, void *buf)
+{
+	if (cnt <= RUN_SIZE) {
+		_insertion_sort(data, cnt, elem_size, cmp, arg, buf);
+		return;
+	}
+
+	size_t mid = cnt / 2;
+
+	_msort(data, mid, elem_size, cmp, arg, buf);
+	_msort(INDEX(data, mid, elem_size), cnt - mid, elem_size, cmp, arg, buf);
+	_merge(data, mid, cnt, elem_size, cmp, arg, buf);
+}
+
+/** Stable sort
  *
  * This is only a wrapper that takes care of memory
- * allocations for storing the slot element for generic
- * gnome sort algorithm.
+ * allocations for the scratch buffer of the generic
+ * merge sort algorithm. Small inputs are sorted without
+ * allocating memory.
  *
  * @param data      Pointer to data to be sorted.
  * @param cnt       Number of elements to be sorted.
@@ -106,20 +192,41 @@ static void _gsort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp,
  */
 bool gsort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp, void *arg)
 {
-	uint8_t ibuf_slot[IBUF_SIZE];
-	void *slot;
+	/* Comparators may access the elements in the buffer directly. */
+	union {
+		uint8_t data[IBUF_SIZE];
+		max_align_t align;
+	} ibuf;
+	void *buf;
+
+	/* The buffer holds a slot for insertion sort or half of the data. */
+	size_t buf_size = max(cnt / 2, 1) * elem_size;
+
+	if (buf_size > IBUF_SIZE) {
+		buf = malloc(buf_size);
+		if (buf == NULL) {
+			/* Fall back to sorting in place. */
+			if (elem_size > IBUF_SIZE) {
+				buf = malloc(elem_size);
+				if (buf == NULL)
+					return false;
+			} else
+				buf = (void *) ibuf.data;
+
+			_insertion_sort(data, cnt, elem_size, cmp, arg, buf);
+
+			if (buf != ibuf.data)
+				free(buf);
 
-	if (elem_size > IBUF_SIZE) {
-		slot = (void *) malloc(elem_size);
-		if (!slot)
-			return false;
+			return true;
+		}
 	} else
-		slot = (void *) ibuf_slot;
+		buf = (void *) ibuf.data;
 
-	_gsort(data, cnt, elem_size, cmp, arg, slot);
+	_msort(data, cnt, elem_size, cmp, arg, buf);
 
-	if (elem_size > IBUF_SIZE)
-		free(slot);
+	if (buf != ibuf.data)
+		free(buf);
 
 	return true;
 }
@@ -75,6 +75,15 @@ typedef struct {
 	const hash_table_ops_t *op;
 	list_t *bucket;
 	size_t bucket_cnt;
+	/** Number of initialized buckets, less than @c bucket_cnt only
+	 * at the beginning of a resize.
+	 */
+	size_t bucket_init_cnt;
+	/** Table being migrated to @c bucket during a resize, or NULL. */
+	list_t *old_bucket;
+	size_t old_bucket_cnt;
+	/** Old buckets below this index have already been migrated. */
+	size_t migrate_idx;
 	size_t full_item_cnt;
 	size_t item_cnt;
 	size_t max_load;
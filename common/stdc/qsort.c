@@ -33,12 +33,19 @@
 /**
  * @file
  * @brief Quicksort.
+ *
+ * Introsort: quicksort with median-of-three pivot selection which switches
+ * to heapsort when the recursion gets too deep, and leaves short ranges to
+ * insertion sort.
  */
 
 #include <qsort.h>
 #include <stdbool.h>
 #include <stddef.h>
 
+/** Ranges up to this many elements are sorted by insertion sort. */
+#define INSERTION_CUTOFF 16
+
 /** Quicksort spec */
 typedef struct {
 	void *base;
@@ -107,6 +114,28 @@ static void elem_swap(qs_spec_t *qs, size_t i, size_t j)
 	}
 }
 
+/** Move median of the first, middle and last element to the middle.
+ *
+ * @param qs Quicksort spec
+ * @param lo Lower bound (inclusive)
+ * @param hi Upper bound (inclusive)
+ * @return Index of the median
+ */
+static size_t median_of_three(qs_spec_t *qs, size_t lo, size_t hi)
+{
+	size_t mid = lo + (hi - lo) / 2;
+
+	if (elem_lt(qs, mid, lo))
+		elem_swap(qs, mid, lo);
+	if (elem_lt(qs, hi, mid)) {
+		elem_swap(qs, hi, mid);
+		if (elem_lt(qs, mid, lo))
+			elem_swap(qs, mid, lo);
+	}
+
+	return mid;
+}
+
 /** Partition a range of indices.
  *
  * @param qs Quicksort spec
@@ -119,7 +148,7 @@ static size_t partition(qs_spec_t *qs, size_t lo, size_t hi)
 	size_t pivot;
 	size_t i, j;
 
-	pivot = lo + (hi - lo) / 2;
+	pivot = median_of_three(qs, lo, hi);
 	i = lo;
 	j = hi;
 	while (true) {
@@ -144,21 +173,114 @@ static size_t partition(qs_spec_t *qs, size_t lo, size_t hi)
 	}
 }
 
+/** Sort a range of indices by insertion sort.
+ *
+ * @param qs Quicksort spec
+ * @param lo Lower bound (inclusive)
+ * @param hi Upper bound (inclusive)
+ */
+static void insertion_sort(qs_spec_t *qs, size_t lo, size_t hi)
+{
+	size_t i, j;
+
+	for (i = lo + 1; i <= hi; i++) {
+		for (j = i; j > lo && elem_lt(qs, j, j - 1); j--)
+			elem_swap(qs, j, j - 1);
+	}
+}
+
+/** Restore the heap property below a node.
+ *
+ * @param qs Quicksort spec
+ * @param lo Index of the heap root
+ * @param node Node index relative to @a lo
+ * @param cnt Number of elements in the heap
+ */
+static void sift_down(qs_spec_t *qs, size_t lo, size_t node, size_t cnt)
+{
+	size_t child;
+
+	while ((child = 2 * node + 1) < cnt) {
+		if (child + 1 < cnt && elem_lt(qs, lo + child, lo + child + 1))
+			child++;
+
+		if (!elem_lt(qs, lo + node, lo + child))
+			return;
+
+		elem_swap(qs, lo + node, lo + child);
+		node = child;
+	}
+}
+
+/** Sort a range of indices by heapsort.
+ *
+ * @param qs Quicksort spec
+ * @param lo Lower bound (inclusive)
+ * @param hi Upper bound (inclusive)
+ */
+static void heapsort(qs_spec_t *qs, size_t lo, size_t hi)
+{
+	size_t cnt = hi - lo + 1;
+	size_t i;
+
+	for (i = cnt / 2; i > 0; i--)
+		sift_down(qs, lo, i - 1, cnt);
+
+	for (i = cnt - 1; i > 0; i--) {
+		elem_swap(qs, lo, lo + i);
+		sift_down(qs, lo, 0, i);
+	}
+}
+
 /** Sort a range of indices.
+ *
+ * Recurses into the smaller part only, so the stack depth is logarithmic.
  *
  * @param qs Quicksort spec
  * @param lo Lower bound (inclusive)
  * @param hi Upper bound (inclusive)
+ * @param depth Number of partitioning levels left before using heapsort
  */
-static void quicksort(qs_spec_t *qs, size_t lo, size_t hi)
+static void quicksort(qs_spec_t *qs, size_t lo, size_t hi, size_t depth)
 {
 	size_t p;
 
-	if (lo < hi) {
+	while (hi - lo >= INSERTION_CUTOFF) {
+		if (depth == 0) {
+			heapsort(qs, lo, hi);
+			return;
+		}
+
+		depth--;
 		p = partition(qs, lo, hi);
-		quicksort(qs, lo, p);
-		quicksort(qs, p + 1, hi);
+
+		if (p - lo < hi - p) {
+			quicksort(qs, lo, p, depth);
+			lo = p + 1;
+		} else {
+			quicksort(qs, p + 1, hi, depth);
+			hi = p;
+		}
+	}
+
+	insertion_sort(qs, lo, hi);
+}
+
+/** Compute depth limit for introsort.
+ *
+ * @param nmemb Number of array members
+ * @return Twice the binary logarithm of @a nmemb
+ */
+static size_t depth_limit(size_t nmemb)
+{
+	size_t depth = 0;
+
+	while (nmemb > 1) {
+		nmemb /= 2;
+		depth += 2;
 	}
+
+	return depth;
 }
 
 /** Quicksort.
@@ -182,7 +304,7 @@ void qsort(void *base, size_t nmemb, size_t size, int (*compar)(const void *,
 	qs.compar = compar_wrap;
 	qs.arg = compar;
 
-	quicksort(&qs, 0, nmemb - 1);
+	quicksort(&qs, 0, nmemb - 1, depth_limit(nmemb));
 }
 
 /** Quicksort with extra argument to comparison function.
@@ -207,7 +329,7 @@ void qsort_r(void *base, size_t nmemb, size_t size, int (*compar)(const void *,
 	qs.compar = compar;
 	qs.arg = arg;
 
-	quicksort(&qs, 0, nmemb - 1);
+	quicksort(&qs, 0, nmemb - 1, depth_limit(nmemb));
 }
 
 /** @}
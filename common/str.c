@@ -641,14 +641,95 @@ size_t str_sanitize(char *str, size_t n, uint8_t replacement)
 	return _str_sanitize(str, n, replacement);
 }
 
+/*
+ * Word-at-a-time scanning. The string functions below read whole aligned
+ * words where possible. An aligned word never crosses a page boundary, so
+ * reading past the NULL-terminator within the last word is harmless.
+ */
+
+typedef unsigned long __attribute__((may_alias)) str_word_t;
+
+#define WORD_SIZE  sizeof(str_word_t)
+#define WORD_ONES  ((str_word_t) -1 / 0xff)
+#define WORD_HIGHS  (WORD_ONES * 0x80)
+
+static inline bool _word_aligned(const char *str)
+{
+	return ((uintptr_t) str & (WORD_SIZE - 1)) == 0;
+}
+
+/** Check whether a word contains a zero byte. */
+static inline bool _word_has_zero(str_word_t w)
+{
+	return ((w - WORD_ONES) & ~w & WORD_HIGHS) != 0;
+}
+
+/** Check whether a word contains byte @a c. */
+static inline bool _word_has_byte(str_word_t w, uint8_t c)
+{
+	return _word_has_zero(w ^ (WORD_ONES * c));
+}
+
+/** Check whether a word contains only ASCII bytes. */
+static inline bool _word_is_ascii(str_word_t w)
+{
+	return (w & WORD_HIGHS) == 0;
+}
+
+/** Get the number of leading non-NULL ASCII bytes in a string.
+ *
+ * @param str  String to consider.
+ * @param size Maximum number of bytes to consider.
+ *
+ * @return Number of leading non-NULL ASCII bytes, at most @a size.
+ */
+static size_t _ascii_span(const char *str, size_t size)
+{
+	const char *p = str;
+
+	while (!_word_aligned(p)) {
+		if (size == 0 || *p == 0 || !_is_ascii(*p))
+			return p - str;
+
+		p++;
+		size--;
+	}
+
+	while (size >= WORD_SIZE) {
+		str_word_t w = *(const str_word_t *) p;
+		if (_word_has_zero(w) || !_word_is_ascii(w))
+			break;
+
+		p += WORD_SIZE;
+		size -= WORD_SIZE;
+	}
+
+	while (size != 0 && *p != 0 && _is_ascii(*p)) {
+		p++;
+		size--;
+	}
+
+	return p - str;
+}
+
 static size_t _str_size(const char *str)
 {
-	size_t size = 0;
+	const char *p = str;
+
+	while (!_word_aligned(p)) {
+		if (*p == 0)
+			return p - str;
+
+		p++;
+	}
 
-	while (*str++ != 0)
-		size++;
+	while (!_word_has_zero(*(const str_word_t *) p))
+		p += WORD_SIZE;
 
-	return size;
+	while (*p != 0)
+		p++;
+
+	return p - str;
 }
 
 /** Get size of string.
@@ -711,12 +792,28 @@ size_t str_lsize(const char *str, size_t max_len)
 
 static size_t _str_nsize(const char *str, size_t max_size)
 {
-	size_t size = 0;
+	const char *p = str;
+
+	while (!_word_aligned(p)) {
+		if (max_size == 0 || *p == 0)
+			return p - str;
+
+		p++;
+		max_size--;
+	}
 
-	while ((*str++ != 0) && (size < max_size))
-		size++;
+	while (max_size >= WORD_SIZE &&
+	    !_word_has_zero(*(const str_word_t *) p)) {
+		p += WORD_SIZE;
+		max_size -= WORD_SIZE;
+	}
 
-	return size;
+	while (max_size != 0 && *p != 0) {
+		p++;
+		max_size--;
+	}
+
+	return p - str;
 }
 
 /** Get size of string with size limit.
@@ -778,13 +875,7 @@ size_t wstr_lsize(const char32_t *str, size_t max_len)
  */
 size_t str_length(const char *str)
 {
-	size_t len = 0;
-	size_t offset = 0;
-
-	while (str_decode(str, &offset, STR_NO_LIMIT) != 0)
-		len++;
-
-	return len;
+	return str_nlength(str, STR_NO_LIMIT);
 }
 
 /** Get number of characters in a wide string.
@@ -817,8 +908,17 @@ size_t str_nlength(const char *str, size_t size)
 	size_t len = 0;
 	size_t offset = 0;
 
-	while (str_decode(str, &offset, size) != 0)
+	while (true) {
+		/* Each ASCII byte is a character of its own. */
+		size_t span = _ascii_span(str + offset, size - offset);
+		offset += span;
+		len += span;
+
+		if (str_decode(str, &offset, size) == 0)
+			break;
+
 		len++;
+	}
 
 	return len;
 }
@@ -922,11 +1022,34 @@ int str_cmp(const char *s1, const char *s2)
 	 * UTF-8 has the nice property that lexicographic ordering on bytes is
 	 * the same as the lexicographic ordering of the character sequences.
 	 */
+	if (((uintptr_t) s1 & (WORD_SIZE - 1)) ==
+	    ((uintptr_t) s2 & (WORD_SIZE - 1))) {
+		while (!_word_aligned(s1)) {
+			if (*s1 != *s2 || *s1 == 0)
+				goto last;
+
+			s1++;
+			s2++;
+		}
+
+		/* Skip equal words, the difference is located bytewise. */
+		while (true) {
+			str_word_t w1 = *(const str_word_t *) s1;
+			str_word_t w2 = *(const str_word_t *) s2;
+			if (w1 != w2 || _word_has_zero(w1))
+				break;
+
+			s1 += WORD_SIZE;
+			s2 += WORD_SIZE;
+		}
+	}
+
 	while (*s1 == *s2 && *s1 != 0) {
 		s1++;
 		s2++;
 	}
 
+last:
 	if (*s1 == *s2)
 		return 0;
 
@@ -1551,6 +1674,21 @@ char32_t *str_to_awstr(const char *str)
 
 static char *_strchr(const char *str, char c)
 {
+	while (!_word_aligned(str)) {
+		if (*str == 0 || *str == c)
+			return (*str == c) ? (char *) str : NULL;
+
+		str++;
+	}
+
+	while (true) {
+		str_word_t w = *(const str_word_t *) str;
+		if (_word_has_zero(w) || _word_has_byte(w, c))
+			break;
+
+		str += WORD_SIZE;
+	}
+
 	while (*str != 0 && *str != c)
 		str++;
 
@@ -1594,6 +1732,136 @@ char *str_chr(const char *str, char32_t ch)
 	return NULL;
 }
 
+/** Compute the maximal suffix of a needle.
+ *
+ * @param n        Needle.
+ * @param nsize    Size of the needle.
+ * @param reversed Use the reversed byte order.
+ * @param period   Place to store the period of the suffix.
+ *
+ * @return Offset of the maximal suffix.
+ */
+static size_t _max_suffix(const uint8_t *n, size_t nsize, bool reversed,
+    size_t *period)
+{
+	/* Offset of the suffix minus one, wraps around for the whole needle. */
+	size_t ms = SIZE_MAX;
+	size_t j = 0;
+	size_t k = 1;
+	size_t p = 1;
+
+	while (j + k < nsize) {
+		uint8_t a = n[j + k];
+		uint8_t b = n[ms + k];
+
+		if (reversed ? (a > b) : (a < b)) {
+			j += k;
+			k = 1;
+			p = j - ms;
+		} else if (a == b) {
+			if (k != p) {
+				k++;
+			} else {
+				j += p;
+				k = 1;
+			}
+		} else {
+			ms = j++;
+			k = p = 1;
+		}
+	}
+
+	*period = p;
+	return ms + 1;
+}
+
+/** Find needle in haystack using the Two-Way algorithm.
+ *
+ * The Two-Way algorithm of Crochemore and Perrin runs in linear time and
+ * constant space. The needle is split at its critical factorization, the
+ * right part is matched first, then the left part.
+ *
+ * @param hs    Haystack.
+ * @param hsize Size of the haystack.
+ * @param n     Needle.
+ * @param nsize Size of the needle, not greater than @a hsize.
+ *
+ * @return Pointer to the match in @a hs or @c NULL if not found.
+ */
+static char *_two_way(const char *hs, size_t hsize, const char *n,
+    size_t nsize)
+{
+	const uint8_t *h = (const uint8_t *) hs;
+	const uint8_t *u = (const uint8_t *) n;
+	size_t per;
+	size_t per_rev;
+
+	/* Critical factorization. */
+	size_t ell = _max_suffix(u, nsize, false, &per);
+	size_t ell_rev = _max_suffix(u, nsize, true, &per_rev);
+	if (ell_rev >= ell) {
+		ell = ell_rev;
+		per = per_rev;
+	}
+
+	size_t j = 0;
+
+	if (memcmp(u, u + per, ell) == 0) {
+		/*
+		 * Periodic needle. Remember how much of the right part is
+		 * known to match after a shift by the period.
+		 */
+		size_t memory = 0;
+
+		while (j <= hsize - nsize) {
+			size_t i = max(ell, memory);
+			while (i < nsize && u[i] == h[i + j])
+				i++;
+
+			if (i < nsize) {
+				j += i - ell + 1;
+				memory = 0;
+				continue;
+			}
+
+			i = ell;
+			while (i > memory && u[i - 1] == h[i - 1 + j])
+				i--;
+
+			if (i <= memory)
+				return (char *) hs + j;
+
+			j += per;
+			memory = nsize - per;
+		}
+	} else {
+		/* The period is larger than half of the needle. */
+		per = max(ell, nsize - ell) + 1;
+
+		while (j <= hsize - nsize) {
+			size_t i = ell;
+			while (i < nsize && u[i] == h[i + j])
+				i++;
+
+			if (i < nsize) {
+				j += i - ell + 1;
+				continue;
+			}
+
+			i = ell;
+			while (i > 0 && u[i - 1] == h[i - 1 + j])
+				i--;
+
+			if (i == 0)
+				return (char *) hs + j;
+
+			j += per;
+		}
+	}
+
+	return NULL;
+}
+
 /** Find first occurence of substring in string.
  *
  * @param hs  Haystack (string)
@@ -1603,18 +1871,19 @@ char *str_chr(const char *str, char32_t ch)
  */
 char *str_str(const char *hs, const char *n)
 {
+	if (n[0] == 0)
+		return (char *) hs;
+
+	if (n[1] == 0)
+		return _strchr(hs, n[0]);
+
 	size_t hsize = _str_size(hs);
 	size_t nsize = _str_size(n);
 
-	while (hsize >= nsize) {
-		if (_test_prefix(hs, n))
-			return (char *) hs;
-
-		hs++;
-		hsize--;
-	}
+	if (hsize < nsize)
+		return NULL;
 
-	return NULL;
+	return _two_way(hs, hsize, n, nsize);
 }
 
 static void _str_rtrim(char *str, char c)
@@ -1713,10 +1982,11 @@ static char *_str_rchr(const char *str, char c)
 {
 	const char *last = NULL;
 
-	while (*str) {
-		if (*str == c)
-			last = str;
+	if (c == 0)
+		return NULL;
 
+	while ((str = _strchr(str, c)) != NULL) {
+		last = str;
 		str++;
 	}
 
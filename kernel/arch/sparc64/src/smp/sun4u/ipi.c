@@ -130,6 +130,22 @@ static void cross_call(int mid, void (*func)(void))
 	preemption_enable();
 }
 
+/** Translate IPI number to the function invoked on the recipient.
+ *
+ * @param ipi IPI number.
+ *
+ * @return Function to be invoked.
+ */
+static void (*ipi_func(int ipi))(void)
+{
+	switch (ipi) {
+	case IPI_TLB_SHOOTDOWN:
+		return tlb_shootdown_ipi_recv;
+	default:
+		panic("Unknown IPI (%d).\n", ipi);
+	}
+}
+
 /*
  * Deliver IPI to all processors except the current one.
  *
@@ -146,16 +162,7 @@ void ipi_broadcast_arch(int ipi)
 {
 	unsigned int i;
 
-	void (*func)(void);
-
-	switch (ipi) {
-	case IPI_TLB_SHOOTDOWN:
-		func = tlb_shootdown_ipi_recv;
-		break;
-	default:
-		panic("Unknown IPI (%d).\n", ipi);
-		break;
-	}
+	void (*func)(void) = ipi_func(ipi);
 
 	/*
 	 * As long as we don't support hot-plugging
@@ -172,5 +179,18 @@ void ipi_broadcast_arch(int ipi)
 	}
 }
 
+/*
+ * Deliver IPI to one processor.
+ *
+ * We assume that interrupts are disabled.
+ *
+ * @param cpu_id Logical ID of the target processor.
+ * @param ipi    IPI number.
+ */
+void ipi_unicast_arch(unsigned int cpu_id, int ipi)
+{
+	cross_call(cpus[cpu_id].arch.mid, ipi_func(ipi));
+}
+
 /** @}
  */
@@ -87,25 +87,32 @@ uint64_t ipi_unicast_to(void (*func)(void), uint16_t cpu_id)
 	return ipi_brodcast_to(func, ipi_cpu_list[CPU->arch.id], 1);
 }
 
-/*
- * Deliver IPI to all processors except the current one.
- *
- * We assume that interrupts are disabled.
+/** Translate IPI number to the function invoked on the recipient.
  *
  * @param ipi IPI number.
+ *
+ * @return Function to be invoked.
  */
-void ipi_broadcast_arch(int ipi)
+static void (*ipi_func(int ipi))(void)
 {
-	void (*func)(void);
-
 	switch (ipi) {
 	case IPI_TLB_SHOOTDOWN:
-		func = tlb_shootdown_ipi_recv;
-		break;
+		return tlb_shootdown_ipi_recv;
 	default:
 		panic("Unknown IPI (%d).\n", ipi);
-		break;
 	}
+}
+
+/*
+ * Deliver IPI to all processors except the current one.
+ *
+ * We assume that interrupts are disabled.
+ *
+ * @param ipi IPI number.
+ */
+void ipi_broadcast_arch(int ipi)
+{
+	void (*func)(void) = ipi_func(ipi);
 
 	unsigned int i;
 	unsigned idx = 0;
@@ -121,5 +128,18 @@ void ipi_broadcast_arch(int ipi)
 	ipi_brodcast_to(func, ipi_cpu_list[CPU->arch.id], idx);
 }
 
+/*
+ * Deliver IPI to one processor.
+ *
+ * We assume that interrupts are disabled.
+ *
+ * @param cpu_id Logical ID of the target processor.
+ * @param ipi    IPI number.
+ */
+void ipi_unicast_arch(unsigned int cpu_id, int ipi)
+{
+	ipi_unicast_to(ipi_func(ipi), (uint16_t) cpus[cpu_id].id);
+}
+
 /** @}
  */
@@ -35,9 +35,11 @@
 #ifndef KERN_CPU_H_
 #define KERN_CPU_H_
 
+#include <mm/frame.h>
 #include <mm/tlb.h>
 #include <synch/spinlock.h>
 #include <proc/scheduler.h>
+#include <time/timeout_wheel.h>
 #include <arch/cpu.h>
 #include <arch/context.h>
 #include <adt/list.h>
@@ -89,11 +91,14 @@ typedef struct cpu {
 	tlb_shootdown_msg_t tlb_messages[TLB_MESSAGE_QUEUE_LEN];
 	size_t tlb_messages_count;
 
+	/** Targeted by the TLB shootdown in progress. Protected by tlblock. */
+	bool tlb_target;
+
 	atomic_size_t nrdy;
 	runq_t rq[RQ_COUNT];
 
 	IRQ_SPINLOCK_DECLARE(timeoutlock);
-	list_t timeout_active_list;
+	timeout_wheel_t timeout_wheel;
 
 	/**
 	 * Processor cycle accounting.
@@ -120,6 +125,9 @@ typedef struct cpu {
 #endif
 	_Atomic(struct thread *) fpu_owner;
 
+	/** Cache of free frames for single frame allocations. */
+	frame_cpucache_t frame_cache;
+
 	cpu_local_t local;
 } cpu_t;
 
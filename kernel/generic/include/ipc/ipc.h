@@ -41,6 +41,7 @@
 #include <abi/ipc/ipc.h>
 #include <abi/proc/task.h>
 #include <typedefs.h>
+#include <mm/as.h>
 #include <mm/slab.h>
 #include <cap/cap.h>
 
@@ -48,6 +49,12 @@ struct answerbox;
 struct task;
 struct call;
 
+/**
+ * Minimal size of IPC_M_DATA_WRITE and IPC_M_DATA_READ requests for which
+ * the caller's buffer is pinned and copied directly from or to.
+ */
+#define DATA_XFER_PIN_THRESHOLD  (16 * 1024)
+
 typedef enum {
 	/** Phone is free and can be allocated */
 	IPC_PHONE_FREE = 0,
@@ -165,6 +172,12 @@ typedef struct call {
 
 	/** Buffer for IPC_M_DATA_WRITE and IPC_M_DATA_READ. */
 	uint8_t *buffer;
+
+	/**
+	 * Caller's frames used instead of the buffer for large
+	 * IPC_M_DATA_WRITE and IPC_M_DATA_READ requests.
+	 */
+	as_pin_t pin;
 } call_t;
 
 extern slab_cache_t *phone_cache;
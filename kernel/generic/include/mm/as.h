@@ -48,6 +48,7 @@
 #include <lib/elf.h>
 #include <arch.h>
 #include <lib/refcount.h>
+#include <stdatomic.h>
 
 #define AS                   CURRENT->as
 
@@ -115,6 +116,19 @@ typedef struct as {
 	 */
 	asid_t asid;
 
+	/** Processors whose TLB may hold entries of this address space.
+	 *
+	 * A processor is added when it activates the address space and the
+	 * mask is cleared when a new ASID is assigned. NULL for the kernel
+	 * address space, which is active everywhere. Protected by asidlock
+	 * for writing, read locklessly by the TLB shootdown initiator.
+	 *
+	 */
+	struct cpu_mask *cpu_mask;
+
+	/** True while a TLB shootdown of this address space is in progress. */
+	atomic_bool tlb_shootdown;
+
 	/** Number of references (i.e. tasks that reference this as). */
 	atomic_refcount_t refcount;
 
@@ -304,6 +318,18 @@ typedef struct mem_backend {
 	void (*destroy_shared_data)(void *);
 } mem_backend_t;
 
+/** Frames backing a piece of an address space area pinned by as_area_pin(). */
+typedef struct {
+	/** Physical addresses of the pinned frames, NULL if nothing is pinned. */
+	uintptr_t *frames;
+	/** Number of pinned frames. */
+	size_t count;
+	/** Offset of the pinned piece within the first frame. */
+	size_t offset;
+	/** Return the reservation of the frames when they are freed. */
+	bool reserve;
+} as_pin_t;
+
 extern as_t *AS_KERNEL;
 
 extern const as_operations_t *as_operations;
@@ -338,6 +364,11 @@ extern void as_pagemap_remove(as_page_mapping_t *);
 extern unsigned int as_area_get_flags(as_area_t *);
 extern bool as_area_check_access(as_area_t *, pf_access_t);
 extern size_t as_area_get_size(uintptr_t);
+extern errno_t as_area_pin(as_t *, uintptr_t, size_t, pf_access_t,
+    as_pin_t *);
+extern void as_area_unpin(as_pin_t *);
+extern errno_t as_pin_copy_from_uspace(as_pin_t *, uspace_addr_t, size_t);
+extern errno_t as_pin_copy_to_uspace(uspace_addr_t, as_pin_t *, size_t);
 extern used_space_ival_t *used_space_first(used_space_t *);
 extern used_space_ival_t *used_space_next(used_space_ival_t *);
 extern used_space_ival_t *used_space_find_gteq(used_space_t *, uintptr_t);
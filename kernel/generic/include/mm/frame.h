@@ -40,6 +40,7 @@
 #include <trace.h>
 #include <adt/bitmap.h>
 #include <adt/list.h>
+#include <abi/sysinfo.h>
 #include <synch/spinlock.h>
 #include <arch/mm/page.h>
 #include <arch/mm/frame.h>
@@ -89,9 +90,29 @@ typedef uint8_t zone_flags_t;
 	(((((zf) & ZONE_EF_MASK)) == ((f) & ZONE_EF_MASK)) && \
 	    (((zf) & ~ZONE_EF_MASK) & (f)))
 
+/** Number of free block orders tracked by the buddy index of a zone. */
+#define ZONE_BUDDY_ORDERS  STATS_PHYSMEM_ORDERS
+
+/** Buddy order of a frame which does not head a free block. */
+#define FRAME_BUDDY_NONE  ((uint8_t) -1)
+
 typedef struct {
 	size_t refcount;  /**< Tracking of shared frames */
 	void *parent;     /**< If allocated by slab, this points there */
+
+	/*
+	 * The buddy links cannot be kept in the free frames themselves,
+	 * as frames outside of the kernel identity mapping are not
+	 * accessible. This makes frame_t 40 bytes instead of 16 on 64-bit
+	 * platforms, i.e. about 1% of the physical memory instead of 0.4%.
+	 */
+
+	/** Next free block of the same order (frame index in the zone) */
+	size_t buddy_next;
+	/** Previous free block of the same order (frame index in the zone) */
+	size_t buddy_prev;
+	/** Order of the free block headed by this frame or FRAME_BUDDY_NONE */
+	uint8_t buddy_order;
 } frame_t;
 
 typedef struct {
@@ -113,6 +134,17 @@ typedef struct {
 	/** Frame bitmap */
 	bitmap_t bitmap;
 
+	/**
+	 * Buddy index of the free frames. The free frames are split into
+	 * naturally aligned blocks of 2^order frames, which are kept on
+	 * circular free lists indexed by order. The lists hold frame indices
+	 * rather than pointers, so that the zone structure can be moved.
+	 */
+	size_t buddy_head[ZONE_BUDDY_ORDERS];
+
+	/** Number of free blocks of each order */
+	size_t buddy_free[ZONE_BUDDY_ORDERS];
+
 	/** Array of frame_t structures in this zone */
 	frame_t *frames;
 } zone_t;
@@ -129,7 +161,31 @@ typedef struct {
 
 extern zones_t zones;
 
+/** Maximum number of frames of each kind in a per-CPU frame cache. */
+#define FRAME_CPUCACHE_SIZE   64
+
+/** Number of frames moved between a per-CPU frame cache and the zones. */
+#define FRAME_CPUCACHE_BATCH  16
+
+/** Per-CPU cache of single free frames.
+ *
+ * The cached frames are allocated from the zones' point of view, so that
+ * single frames can be allocated and freed without taking the zones lock.
+ */
+typedef struct {
+	IRQ_SPINLOCK_DECLARE(lock);
+
+	/** Number of cached frames from low memory zones. */
+	size_t lowmem_count;
+	/** Number of cached frames from high memory zones. */
+	size_t highmem_count;
+
+	pfn_t lowmem[FRAME_CPUCACHE_SIZE];
+	pfn_t highmem[FRAME_CPUCACHE_SIZE];
+} frame_cpucache_t;
+
 extern void frame_init(void);
+extern void frame_enable_cpucache(void);
 extern bool frame_adjust_zone_bounds(bool, uintptr_t *, size_t *);
 extern uintptr_t frame_alloc_generic(size_t, frame_flags_t, uintptr_t,
     size_t *);
@@ -151,6 +207,7 @@ extern bool zone_merge(size_t, size_t);
 extern void zone_merge_all(void);
 extern uint64_t zones_total_size(void);
 extern void zones_stats(uint64_t *, uint64_t *, uint64_t *, uint64_t *);
+extern void zones_buddy_stats(uint64_t *);
 
 /*
  * Console functions
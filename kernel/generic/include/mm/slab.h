@@ -39,10 +39,26 @@
 #include <synch/spinlock.h>
 #include <atomic.h>
 #include <mm/frame.h>
+#include <abi/sysinfo.h>
 
-/** Initial Magazine size (TODO: dynamically growing magazines) */
+/** Initial magazine size */
 #define SLAB_MAG_SIZE  4
 
+/** Number of magazine sizes, each twice the previous one */
+#define SLAB_MAG_SIZES  5
+
+/** Maximum magazine size */
+#define SLAB_MAG_SIZE_MAX  (SLAB_MAG_SIZE << (SLAB_MAG_SIZES - 1))
+
+/** Number of magazine list accesses over which contention is measured */
+#define SLAB_MAG_WINDOW  256
+
+/** Grow magazines if at least 1 in this many accesses is contended */
+#define SLAB_MAG_CONTENTION  16
+
+/** Distance between slab colors (at least the L1 cache line size) */
+#define SLAB_COLOR_SIZE  64
+
 /** If object size is less, store control structure inside SLAB */
 #define SLAB_INSIDE_SIZE  (PAGE_SIZE >> 3)
 
@@ -75,6 +91,9 @@ typedef struct {
 	slab_magazine_t *current;
 	slab_magazine_t *last;
 	IRQ_SPINLOCK_DECLARE(lock);
+
+	size_t hits;    /**< Allocations served by the magazines */
+	size_t misses;  /**< Allocations missed in the magazines */
 } slab_mag_cache_t;
 
 typedef struct {
@@ -94,8 +113,10 @@ typedef struct {
 	unsigned int flags;
 
 	/* Computed values */
-	size_t frames;   /**< Number of frames to be allocated */
-	size_t objects;  /**< Number of objects that fit in */
+	size_t frames;      /**< Number of frames to be allocated */
+	size_t objects;     /**< Number of objects that fit in */
+	size_t color_size;  /**< Distance between slab colors */
+	size_t colors;      /**< Number of slab colors */
 
 	/* Statistics */
 	atomic_size_t allocated_slabs;
@@ -103,6 +124,11 @@ typedef struct {
 	atomic_size_t cached_objs;
 	/** How many magazines in magazines list */
 	atomic_size_t magazine_counter;
+	/** Contended accesses to magazines list */
+	atomic_size_t magazine_contention;
+
+	/** Color of the next allocated slab */
+	atomic_size_t color_next;
 
 	/* Slabs */
 	list_t full_slabs;     /**< List of full slabs */
@@ -111,6 +137,12 @@ typedef struct {
 	/* Magazines */
 	list_t magazines;  /**< List o full magazines */
 	IRQ_SPINLOCK_DECLARE(maglock);
+	/** Size of newly allocated magazines */
+	atomic_size_t magazine_size;
+	/** Accesses to magazines list in the current window */
+	size_t maglock_accesses;
+	/** Contended accesses to magazines list in the current window */
+	size_t maglock_contended;
 
 	/** CPU cache */
 	slab_mag_cache_t *mag_cache;
@@ -132,6 +164,9 @@ extern void slab_enable_cpucache(void);
 /* kconsole debug */
 extern void slab_print_list(void);
 
+/* Statistics */
+extern size_t slab_stats(stats_slab_t *, size_t);
+
 #endif
 
 /** @}
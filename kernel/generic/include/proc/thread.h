@@ -299,7 +299,7 @@ extern slab_cache_t *fpu_context_cache;
 /* Thread syscall prototypes. */
 extern sys_errno_t sys_thread_create(uspace_ptr_uspace_arg_t, uspace_ptr_char, size_t,
     uspace_ptr_thread_id_t);
-extern sys_errno_t sys_thread_exit(int);
+extern sys_errno_t sys_thread_exit(int, uintptr_t);
 extern sys_errno_t sys_thread_get_id(uspace_ptr_thread_id_t);
 extern sys_errno_t sys_thread_usleep(uint32_t);
 extern sys_errno_t sys_thread_udelay(uint32_t);
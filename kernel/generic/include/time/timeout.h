@@ -45,7 +45,7 @@ typedef uint64_t deadline_t;
 #define DEADLINE_NEVER ((deadline_t) UINT64_MAX)
 
 typedef struct {
-	/** Link to the list of active timeouts on timeout->cpu */
+	/** Link to the timing wheel slot of timeout->cpu */
 	link_t link;
 	/** Timeout will be activated when current clock tick reaches this value. */
 	deadline_t deadline;
@@ -64,6 +64,7 @@ typedef struct {
 extern deadline_t timeout_deadline_in_usec(uint32_t us);
 
 extern void timeout_init(void);
+extern void timeout_expire(uint64_t);
 extern void timeout_initialize(timeout_t *);
 extern void timeout_register(timeout_t *, uint64_t, timeout_handler_t, void *);
 extern void timeout_register_deadline(timeout_t *, deadline_t, timeout_handler_t, void *);
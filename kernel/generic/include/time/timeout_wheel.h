@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_time
+ * @{
+ */
+/** @file
+ */
+
+#ifndef KERN_TIMEOUT_WHEEL_H_
+#define KERN_TIMEOUT_WHEEL_H_
+
+#include <adt/list.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Number of bits of the expiration tick resolved by one wheel level. */
+#define TIMEOUT_WHEEL_BITS    6
+#define TIMEOUT_WHEEL_SLOTS   (1 << TIMEOUT_WHEEL_BITS)
+#define TIMEOUT_WHEEL_MASK    (TIMEOUT_WHEEL_SLOTS - 1)
+
+/**
+ * Number of wheel levels. Timeouts expiring further than
+ * TIMEOUT_WHEEL_SLOTS ^ TIMEOUT_WHEEL_LEVELS ticks in the future wait
+ * in the overflow list.
+ */
+#define TIMEOUT_WHEEL_LEVELS  4
+
+/** Hierarchical timing wheel of active timeouts of one processor.
+ *
+ * Level 0 has one slot per clock tick, each slot of level n covers
+ * TIMEOUT_WHEEL_SLOTS ticks of level n - 1. Whenever level n - 1 wraps
+ * around, the timeouts of the next slot of level n are cascaded down.
+ *
+ */
+typedef struct {
+	/** Next clock tick to be processed. */
+	uint64_t tick;
+	/** Number of timeouts in the wheel, including the overflow list. */
+	size_t count;
+	/** Timeouts sorted into slots by their expiration tick. */
+	list_t slots[TIMEOUT_WHEEL_LEVELS][TIMEOUT_WHEEL_SLOTS];
+	/** Timeouts expiring beyond the range of the wheel. */
+	list_t overflow;
+} timeout_wheel_t;
+
+#endif
+
+/** @}
+ */
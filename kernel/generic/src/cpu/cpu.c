@@ -87,6 +87,8 @@ void cpu_init(void)
 			irq_spinlock_initialize(&cpus[i].fpu_lock, "cpus[].fpu_lock");
 #endif
 			irq_spinlock_initialize(&cpus[i].tlb_lock, "cpus[].tlb_lock");
+			irq_spinlock_initialize(&cpus[i].frame_cache.lock,
+			    "cpus[].frame_cache.lock");
 
 			for (unsigned int j = 0; j < RQ_COUNT; j++) {
 				irq_spinlock_initialize(&cpus[i].rq[j].lock, "cpus[].rq[].lock");
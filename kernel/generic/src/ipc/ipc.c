@@ -94,6 +94,7 @@ static void call_destroy(void *arg)
 
 	if (call->buffer)
 		free(call->buffer);
+	as_area_unpin(&call->pin);
 	if (call->caller_phone)
 		kobject_put(call->caller_phone->kobject);
 	slab_free(call_cache, call);
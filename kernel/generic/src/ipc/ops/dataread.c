@@ -35,6 +35,7 @@
 #include <assert.h>
 #include <ipc/sysipc_ops.h>
 #include <ipc/ipc.h>
+#include <mm/as.h>
 #include <stdlib.h>
 #include <abi/errno.h>
 #include <syscall/copy.h>
@@ -42,11 +43,30 @@
 
 static errno_t request_preprocess(call_t *call, phone_t *phone)
 {
+	uspace_addr_t dst = ipc_get_arg1(&call->data);
 	size_t size = ipc_get_arg2(&call->data);
+	int flags = ipc_get_arg3(&call->data);
+
+	if (size >= DATA_XFER_PIN_THRESHOLD) {
+		size_t pin_size = size;
+
+		if ((pin_size > DATA_XFER_PIN_LIMIT) && (flags & IPC_XF_RESTRICT))
+			pin_size = DATA_XFER_PIN_LIMIT;
+
+		/*
+		 * Pin the caller's buffer so that the recipient's data can
+		 * be copied directly to it. Use the kernel buffer if that is
+		 * not possible.
+		 */
+		if ((pin_size <= DATA_XFER_PIN_LIMIT) &&
+		    (as_area_pin(AS, dst, pin_size, PF_ACCESS_WRITE,
+		    &call->pin) == EOK)) {
+			ipc_set_arg2(&call->data, pin_size);
+			return EOK;
+		}
+	}
 
 	if (size > DATA_XFER_LIMIT) {
-		int flags = ipc_get_arg3(&call->data);
-
 		if (flags & IPC_XF_RESTRICT)
 			ipc_set_arg2(&call->data, DATA_XFER_LIMIT);
 		else
@@ -74,6 +94,17 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 			 */
 			ipc_set_arg1(&answer->data, dst);
 
+			if (answer->pin.frames) {
+				/* Copy directly to the caller's frames. */
+				errno_t rc = as_pin_copy_from_uspace(
+				    &answer->pin, src, size);
+				if (rc)
+					ipc_set_retval(&answer->data, rc);
+
+				as_area_unpin(&answer->pin);
+				return EOK;
+			}
+
 			answer->buffer = malloc(size);
 			if (!answer->buffer) {
 				ipc_set_retval(&answer->data, ENOMEM);
@@ -96,6 +127,9 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 		}
 	}
 
+	/* The caller's frames are not needed any more. */
+	as_area_unpin(&answer->pin);
+
 	return EOK;
 }
 
@@ -35,6 +35,7 @@
 #include <assert.h>
 #include <ipc/sysipc_ops.h>
 #include <ipc/ipc.h>
+#include <mm/as.h>
 #include <stdlib.h>
 #include <abi/errno.h>
 #include <syscall/copy.h>
@@ -44,10 +45,28 @@ static errno_t request_preprocess(call_t *call, phone_t *phone)
 {
 	uspace_addr_t src = ipc_get_arg1(&call->data);
 	size_t size = ipc_get_arg2(&call->data);
+	int flags = ipc_get_arg3(&call->data);
 
-	if (size > DATA_XFER_LIMIT) {
-		int flags = ipc_get_arg3(&call->data);
+	if (size >= DATA_XFER_PIN_THRESHOLD) {
+		size_t pin_size = size;
+
+		if ((pin_size > DATA_XFER_PIN_LIMIT) && (flags & IPC_XF_RESTRICT))
+			pin_size = DATA_XFER_PIN_LIMIT;
 
+		/*
+		 * Pin the sender's buffer so that the data can be copied
+		 * directly to the recipient. Use the kernel buffer if that
+		 * is not possible.
+		 */
+		if ((pin_size <= DATA_XFER_PIN_LIMIT) &&
+		    (as_area_pin(AS, src, pin_size, PF_ACCESS_READ,
+		    &call->pin) == EOK)) {
+			ipc_set_arg2(&call->data, pin_size);
+			return EOK;
+		}
+	}
+
+	if (size > DATA_XFER_LIMIT) {
 		if (flags & IPC_XF_RESTRICT) {
 			size = DATA_XFER_LIMIT;
 			ipc_set_arg2(&call->data, size);
@@ -72,7 +91,7 @@ static errno_t request_preprocess(call_t *call, phone_t *phone)
 
 static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 {
-	assert(answer->buffer);
+	assert(answer->buffer || answer->pin.frames);
 
 	if (!ipc_get_retval(&answer->data)) {
 		/* The recipient agreed to receive data. */
@@ -81,8 +100,15 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 		size_t max_size = ipc_get_arg2(olddata);
 
 		if (size <= max_size) {
-			errno_t rc = copy_to_uspace(dst,
-			    answer->buffer, size);
+			errno_t rc;
+
+			if (answer->pin.frames) {
+				rc = as_pin_copy_to_uspace(dst, &answer->pin,
+				    size);
+			} else {
+				rc = copy_to_uspace(dst, answer->buffer, size);
+			}
+
 			if (rc)
 				ipc_set_retval(&answer->data, rc);
 		} else {
@@ -90,6 +116,9 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 		}
 	}
 
+	/* The sender's frames are not needed any more. */
+	as_area_unpin(&answer->pin);
+
 	return EOK;
 }
 
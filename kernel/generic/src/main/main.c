@@ -240,6 +240,10 @@ void main_bsp_separated_stack(void)
 	    config.cpu_count, size, size_suffix);
 
 	cpu_init();
+
+	/* The frame caches live in the CPU structures. */
+	frame_enable_cpucache();
+
 	calibrate_delay_loop();
 	ARCH_OP(post_cpu_init);
 
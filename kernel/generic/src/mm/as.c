@@ -51,6 +51,7 @@
 #include <arch/mm/as.h>
 #include <mm/page.h>
 #include <mm/frame.h>
+#include <mm/km.h>
 #include <mm/slab.h>
 #include <mm/tlb.h>
 #include <arch/mm/page.h>
@@ -58,6 +59,8 @@
 #include <genarch/mm/page_ht.h>
 #include <mm/asid.h>
 #include <arch/mm/asid.h>
+#include <cpu/cpu_mask.h>
+#include <barrier.h>
 #include <preemption.h>
 #include <synch/spinlock.h>
 #include <synch/mutex.h>
@@ -172,6 +175,24 @@ as_t *as_create(unsigned int flags)
 	if (!as)
 		return NULL;
 
+	/*
+	 * The kernel address space is created before all processors are
+	 * known and it is active on all of them anyway.
+	 */
+	if (flags & FLAG_AS_KERNEL) {
+		as->cpu_mask = NULL;
+	} else {
+		as->cpu_mask = malloc(cpu_mask_size());
+		if (!as->cpu_mask) {
+			slab_free(as_cache, as);
+			return NULL;
+		}
+
+		cpu_mask_none(as->cpu_mask);
+	}
+
+	atomic_init(&as->tlb_shootdown, false);
+
 	(void) as_create_arch(as, 0);
 
 	odict_initialize(&as->as_areas, as_areas_getkey, as_areas_cmp);
@@ -269,6 +290,7 @@ retry:
 	page_table_destroy(NULL);
 #endif
 
+	free(as->cpu_mask);
 	slab_free(as_cache, as);
 }
 
@@ -954,9 +976,8 @@ errno_t as_area_resize(as_t *as, uintptr_t address, size_t size, unsigned int fl
 		 * Start TLB shootdown sequence.
 		 */
 
-		ipl_t ipl = tlb_shootdown_start(TLB_INVL_PAGES,
-		    as->asid, area->base + P2SZ(pages),
-		    area->pages - pages);
+		ipl_t ipl = tlb_shootdown_start_as(as, TLB_INVL_PAGES,
+		    area->base + P2SZ(pages), area->pages - pages);
 
 		/*
 		 * Remove frames belonging to used space starting from
@@ -1104,7 +1125,7 @@ errno_t as_area_destroy(as_t *as, uintptr_t address)
 	/*
 	 * Start TLB shootdown sequence.
 	 */
-	ipl_t ipl = tlb_shootdown_start(TLB_INVL_PAGES, as->asid, area->base,
+	ipl_t ipl = tlb_shootdown_start_as(as, TLB_INVL_PAGES, area->base,
 	    area->pages);
 
 	/*
@@ -1404,7 +1425,7 @@ errno_t as_area_change_flags(as_t *as, unsigned int flags, uintptr_t address)
 	/*
 	 * Start TLB shootdown sequence.
 	 */
-	ipl_t ipl = tlb_shootdown_start(TLB_INVL_PAGES, as->asid, area->base,
+	ipl_t ipl = tlb_shootdown_start_as(as, TLB_INVL_PAGES, area->base,
 	    area->pages);
 
 	/*
@@ -1637,6 +1658,30 @@ retry:
 		DEADLOCK_PROBE(p_asidlock, DEADLOCK_THRESHOLD);
 		goto retry;
 	}
+
+	/*
+	 * Announce that the new address space is about to appear in the TLB
+	 * of this processor. If a TLB shootdown of the address space is in
+	 * progress, its initiator may have already read the mask without
+	 * seeing us. Back off with interrupts enabled and retry once the
+	 * shootdown is over so that we never run on half-updated mappings.
+	 */
+	if (new_as->cpu_mask) {
+		if ((new_as->cpu_refcount == 0) &&
+		    (new_as->asid == ASID_INVALID))
+			cpu_mask_none(new_as->cpu_mask);
+
+		cpu_mask_set(new_as->cpu_mask, CPU->id);
+		memory_barrier();
+
+		if (atomic_load(&new_as->tlb_shootdown)) {
+			spinlock_unlock(&asidlock);
+			(void) interrupts_enable();
+			DEADLOCK_PROBE(p_asidlock, DEADLOCK_THRESHOLD);
+			goto retry;
+		}
+	}
+
 	preemption_enable();
 
 	/*
@@ -1663,6 +1708,16 @@ retry:
 		 * is being removed from the CPU.
 		 */
 		as_deinstall_arch(old_as);
+
+#ifdef asid_get
+		/*
+		 * Without hardware ASIDs, the TLB is flushed whenever
+		 * the address space is switched, so this processor will
+		 * hold no entries of the old address space.
+		 */
+		if (old_as->cpu_mask)
+			cpu_mask_reset(old_as->cpu_mask, CPU->id);
+#endif
 	}
 
 	/*
@@ -1848,6 +1903,207 @@ size_t as_area_get_size(uintptr_t base)
 	return size;
 }
 
+/** Pin frames backing a piece of an address space area.
+ *
+ * The pages are faulted in for the requested kind of access and their
+ * frames are referenced, so that they stay allocated even if the area is
+ * unmapped or resized in the meantime. The piece must lie within a single
+ * anonymous or ELF area.
+ *
+ * @param as     Address space.
+ * @param addr   Start of the piece. May be unaligned.
+ * @param size   Size of the piece in bytes.
+ * @param access Access to be performed on the frames.
+ * @param pin    Pin structure to be initialized.
+ *
+ * @return EOK on success, ENOENT if the piece does not lie within a single
+ *         area, EPERM if the area does not allow the access, ENOTSUP if the
+ *         area cannot be pinned and ENOMEM if the pages could not be
+ *         faulted in.
+ *
+ */
+errno_t as_area_pin(as_t *as, uintptr_t addr, size_t size, pf_access_t access,
+    as_pin_t *pin)
+{
+	uintptr_t page = ALIGN_DOWN(addr, PAGE_SIZE);
+
+	if (size == 0 || addr + size < addr)
+		return EINVAL;
+
+	size_t count = SIZE2FRAMES(addr - page + size);
+	uintptr_t *frames = malloc(count * sizeof(uintptr_t));
+	if (!frames)
+		return ENOMEM;
+
+	mutex_lock(&as->lock);
+	as_area_t *area = find_area_and_lock(as, page);
+	if (!area) {
+		mutex_unlock(&as->lock);
+		free(frames);
+		return ENOENT;
+	}
+
+	errno_t rc = EOK;
+
+	if (count > area->pages - ((page - area->base) >> PAGE_WIDTH))
+		rc = ENOENT;
+	else if (!as_area_check_access(area, access))
+		rc = EPERM;
+	else if ((area->attributes & AS_AREA_ATTR_PARTIAL) ||
+	    ((area->backend != &anon_backend) &&
+	    (area->backend != &elf_backend)))
+		rc = ENOTSUP;
+
+	size_t pinned = 0;
+
+	if (rc == EOK) {
+		page_table_lock(as, false);
+
+		for (; pinned < count; pinned++) {
+			uintptr_t va = page + P2SZ(pinned);
+			pte_t pte;
+
+			bool found = page_mapping_find(as, va, false, &pte);
+			if (!found || !PTE_PRESENT(&pte) ||
+			    ((access == PF_ACCESS_WRITE) && !PTE_WRITABLE(&pte))) {
+				if (area->backend->page_fault(area, va,
+				    access) != AS_PF_OK) {
+					rc = ENOMEM;
+					break;
+				}
+
+				found = page_mapping_find(as, va, false, &pte);
+				assert(found);
+				assert(PTE_PRESENT(&pte));
+			}
+
+			frames[pinned] = PTE_GET_FRAME(&pte);
+			frame_reference_add(ADDR2PFN(frames[pinned]));
+		}
+
+		page_table_unlock(as, false);
+	}
+
+	pin->frames = frames;
+	pin->count = pinned;
+	pin->offset = addr - page;
+	pin->reserve = (area->flags & AS_AREA_LATE_RESERVE) != 0;
+
+	mutex_unlock(&area->lock);
+	mutex_unlock(&as->lock);
+
+	if (rc != EOK)
+		as_area_unpin(pin);
+
+	return rc;
+}
+
+/** Release frames pinned by as_area_pin().
+ *
+ * @param pin Pin structure. Nothing is done if no frames are pinned.
+ *
+ */
+void as_area_unpin(as_pin_t *pin)
+{
+	if (!pin->frames)
+		return;
+
+	for (size_t i = 0; i < pin->count; i++) {
+		/*
+		 * Follow the backend, the reservation of frames of a late
+		 * reserve area is only returned when the frame is freed.
+		 */
+		if (pin->reserve)
+			frame_free(pin->frames[i], 1);
+		else
+			frame_free_noreserve(pin->frames[i], 1);
+	}
+
+	free(pin->frames);
+	pin->frames = NULL;
+	pin->count = 0;
+}
+
+/** Map a pinned frame into the kernel address space. */
+static uintptr_t pin_frame_map(uintptr_t frame)
+{
+	if (frame >= config.identity_size) {
+		return km_map(frame, PAGE_SIZE, PAGE_SIZE,
+		    PAGE_READ | PAGE_WRITE | PAGE_CACHEABLE);
+	}
+
+	return PA2KA(frame);
+}
+
+/** Copy data between the current address space and pinned frames.
+ *
+ * @param pin  Pinned frames.
+ * @param uspace_addr Address in the current address space.
+ * @param size Number of bytes to copy, at most the size of the pinned piece.
+ * @param to_pin True to copy to the pinned frames, false to copy from them.
+ *
+ * @return EOK on success or an error code from copy_from_uspace() or
+ *         copy_to_uspace().
+ *
+ */
+static errno_t pin_copy(as_pin_t *pin, uspace_addr_t uspace_addr, size_t size,
+    bool to_pin)
+{
+	size_t offset = pin->offset;
+	errno_t rc = EOK;
+
+	for (size_t i = 0; (size > 0) && (rc == EOK); i++) {
+		assert(i < pin->count);
+
+		size_t chunk = min(size, PAGE_SIZE - offset);
+		uintptr_t page = pin_frame_map(pin->frames[i]);
+
+		if (to_pin) {
+			rc = copy_from_uspace((void *) (page + offset),
+			    uspace_addr, chunk);
+		} else {
+			rc = copy_to_uspace(uspace_addr,
+			    (void *) (page + offset), chunk);
+		}
+
+		km_temporary_page_put(page);
+
+		uspace_addr += chunk;
+		size -= chunk;
+		offset = 0;
+	}
+
+	return rc;
+}
+
+/** Copy data from the current address space to pinned frames.
+ *
+ * @param pin  Frames pinned by as_area_pin().
+ * @param src  Source address in the current address space.
+ * @param size Number of bytes to copy.
+ *
+ * @return EOK on success or an error code from copy_from_uspace().
+ *
+ */
+errno_t as_pin_copy_from_uspace(as_pin_t *pin, uspace_addr_t src, size_t size)
+{
+	return pin_copy(pin, src, size, true);
+}
+
+/** Copy data from pinned frames to the current address space.
+ *
+ * @param dst  Destination address in the current address space.
+ * @param pin  Frames pinned by as_area_pin().
+ * @param size Number of bytes to copy.
+ *
+ * @return EOK on success or an error code from copy_to_uspace().
+ *
+ */
+errno_t as_pin_copy_to_uspace(uspace_addr_t dst, as_pin_t *pin, size_t size)
+{
+	return pin_copy(pin, dst, size, false);
+}
+
 /** Initialize used space map.
  *
  * @param used_space Used space map
@@ -39,6 +39,18 @@
  * This file contains the physical frame allocator and memory zone management.
  * The frame allocator is built on top of the two-level bitmap structure.
  *
+ * Each zone also keeps a buddy index of its free frames, i.e. free lists of
+ * naturally aligned blocks of 2^order frames. Allocations are served from the
+ * smallest sufficient free block, which is split as needed, and freed frames
+ * are coalesced with their free buddies. The bitmap remains the authoritative
+ * record of which frames are free and is searched only for allocations which
+ * the buddy index cannot satisfy (e.g. due to a constraint which is not an
+ * alignment, or a run of free frames which crosses a block boundary).
+ *
+ * Single frames are allocated and freed through small per-CPU caches, which
+ * are refilled from and drained to the zones in batches. This keeps the
+ * global zones lock off the path of page faults on anonymous memory.
+ *
  */
 
 #include <typedefs.h>
@@ -52,6 +64,8 @@
 #include <synch/condvar.h>
 #include <arch/asm.h>
 #include <arch.h>
+#include <atomic.h>
+#include <cpu.h>
 #include <stdio.h>
 #include <log.h>
 #include <align.h>
@@ -76,6 +90,16 @@ static CONDVAR_INITIALIZE(mem_avail_cv);
 static size_t mem_avail_req = 0;  /**< Number of frames requested. */
 static size_t mem_avail_gen = 0;  /**< Generation counter. */
 
+/*
+ * The per-CPU frame caches are only used once the zones have been set up.
+ * Zones are not created or merged afterwards, so the zone array can be
+ * searched without holding the zones lock.
+ */
+static atomic_bool frame_cpucache_enabled = false;
+
+/** True if there is any available high memory zone. */
+static bool frame_highmem = false;
+
 /** Initialize frame structure.
  *
  * @param frame Frame structure to be initialized.
@@ -85,6 +109,7 @@ _NO_TRACE static void frame_initialize(frame_t *frame)
 {
 	frame->refcount = 0;
 	frame->parent = NULL;
+	frame->buddy_order = FRAME_BUDDY_NONE;
 }
 
 /*
@@ -212,18 +237,25 @@ _NO_TRACE size_t find_zone(pfn_t frame, size_t count, size_t hint)
 	return (size_t) -1;
 }
 
+_NO_TRACE static size_t buddy_find_block(zone_t *, size_t, pfn_t, bool);
+
 /** @return True if zone can allocate specified number of frames */
 _NO_TRACE static bool zone_can_alloc(zone_t *zone, size_t count,
     pfn_t constraint)
 {
+	if (!(zone->flags & ZONE_AVAILABLE) || (zone->free_count < count))
+		return false;
+
+	if (buddy_find_block(zone, count, constraint, false) != (size_t) -1)
+		return true;
+
 	/*
 	 * The function bitmap_allocate_range() does not modify
 	 * the bitmap if the last argument is NULL.
 	 */
 
-	return ((zone->flags & ZONE_AVAILABLE) &&
-	    bitmap_allocate_range(&zone->bitmap, count, zone->base,
-	    FRAME_LOWPRIO, constraint, NULL));
+	return bitmap_allocate_range(&zone->bitmap, count, zone->base,
+	    FRAME_LOWPRIO, constraint, NULL);
 }
 
 /** Find a zone that can allocate specified number of frames
@@ -355,6 +387,262 @@ _NO_TRACE static frame_t *zone_get_frame(zone_t *zone, size_t index)
 	return &zone->frames[index];
 }
 
+/*
+ * Buddy index functions
+ */
+
+/** Insert a free block into the free list of its order.
+ *
+ * Blocks of high-priority memory are appended to the end of the list,
+ * other blocks are prepended, so that the head of each list is a block
+ * of low-priority memory whenever there is one.
+ *
+ * @param zone  Zone containing the block.
+ * @param index Index of the first frame of the block.
+ * @param order Order of the block.
+ *
+ */
+_NO_TRACE static void buddy_list_insert(zone_t *zone, size_t index,
+    uint8_t order)
+{
+	frame_t *frame = zone_get_frame(zone, index);
+	size_t head = zone->buddy_head[order];
+
+	frame->buddy_order = order;
+
+	if (head == (size_t) -1) {
+		frame->buddy_next = index;
+		frame->buddy_prev = index;
+		zone->buddy_head[order] = index;
+	} else {
+		frame_t *first = zone_get_frame(zone, head);
+		size_t tail = first->buddy_prev;
+
+		frame->buddy_next = head;
+		frame->buddy_prev = tail;
+		zone_get_frame(zone, tail)->buddy_next = index;
+		first->buddy_prev = index;
+
+		if (!is_high_priority(zone->base + index, 1))
+			zone->buddy_head[order] = index;
+	}
+
+	zone->buddy_free[order]++;
+}
+
+/** Remove a free block from the free list of its order.
+ *
+ * @param zone  Zone containing the block.
+ * @param index Index of the first frame of the block.
+ *
+ */
+_NO_TRACE static void buddy_list_remove(zone_t *zone, size_t index)
+{
+	frame_t *frame = zone_get_frame(zone, index);
+	uint8_t order = frame->buddy_order;
+
+	assert(order < ZONE_BUDDY_ORDERS);
+
+	if (frame->buddy_next == index) {
+		zone->buddy_head[order] = (size_t) -1;
+	} else {
+		zone_get_frame(zone, frame->buddy_prev)->buddy_next =
+		    frame->buddy_next;
+		zone_get_frame(zone, frame->buddy_next)->buddy_prev =
+		    frame->buddy_prev;
+
+		if (zone->buddy_head[order] == index)
+			zone->buddy_head[order] = frame->buddy_next;
+	}
+
+	frame->buddy_order = FRAME_BUDDY_NONE;
+	zone->buddy_free[order]--;
+}
+
+/** Add a free block to the buddy index, coalescing it with its buddies.
+ *
+ * @param zone  Zone containing the block.
+ * @param index Index of the first frame of the block.
+ * @param order Order of the block.
+ *
+ */
+_NO_TRACE static void buddy_insert(zone_t *zone, size_t index, uint8_t order)
+{
+	while (order + 1 < ZONE_BUDDY_ORDERS) {
+		pfn_t buddy = (zone->base + index) ^ ((pfn_t) 1 << order);
+
+		if ((buddy < zone->base) || (buddy - zone->base >= zone->count))
+			break;
+
+		size_t buddy_index = buddy - zone->base;
+		if (zone_get_frame(zone, buddy_index)->buddy_order != order)
+			break;
+
+		buddy_list_remove(zone, buddy_index);
+		index = min(index, buddy_index);
+		order++;
+	}
+
+	buddy_list_insert(zone, index, order);
+}
+
+/** Add a range of free frames to the buddy index.
+ *
+ * The range is split into the largest naturally aligned blocks.
+ *
+ * @param zone  Zone containing the frames.
+ * @param index Index of the first frame.
+ * @param count Number of frames.
+ *
+ */
+_NO_TRACE static void buddy_free_range(zone_t *zone, size_t index,
+    size_t count)
+{
+	while (count > 0) {
+		pfn_t pfn = zone->base + index;
+		uint8_t order = 0;
+
+		while ((order + 1 < ZONE_BUDDY_ORDERS) &&
+		    ((pfn & ((pfn_t) 1 << order)) == 0) &&
+		    (((size_t) 2 << order) <= count))
+			order++;
+
+		buddy_insert(zone, index, order);
+
+		index += (size_t) 1 << order;
+		count -= (size_t) 1 << order;
+	}
+}
+
+/** Find the free block containing a frame.
+ *
+ * @param zone  Zone containing the frame.
+ * @param index Index of the frame.
+ *
+ * @return Index of the first frame of the block.
+ * @return -1 if the frame is not free.
+ *
+ */
+_NO_TRACE static size_t buddy_find_containing(zone_t *zone, size_t index)
+{
+	for (uint8_t order = 0; order < ZONE_BUDDY_ORDERS; order++) {
+		pfn_t head = (zone->base + index) & ~(((pfn_t) 1 << order) - 1);
+
+		if (head < zone->base)
+			break;
+
+		if (zone_get_frame(zone, head - zone->base)->buddy_order == order)
+			return head - zone->base;
+	}
+
+	return (size_t) -1;
+}
+
+/** Remove a range of free frames from the buddy index.
+ *
+ * The blocks containing the frames are split and the parts which
+ * are not part of the range are returned to the buddy index.
+ *
+ * @param zone  Zone containing the frames.
+ * @param index Index of the first frame.
+ * @param count Number of frames.
+ *
+ */
+_NO_TRACE static void buddy_take_range(zone_t *zone, size_t index,
+    size_t count)
+{
+	while (count > 0) {
+		size_t head = buddy_find_containing(zone, index);
+		assert(head != (size_t) -1);
+
+		size_t end = head +
+		    ((size_t) 1 << zone_get_frame(zone, head)->buddy_order);
+		size_t taken = min(count, end - index);
+
+		buddy_list_remove(zone, head);
+		buddy_free_range(zone, head, index - head);
+		buddy_free_range(zone, index + taken, end - index - taken);
+
+		index += taken;
+		count -= taken;
+	}
+}
+
+/** Find a free block for an allocation.
+ *
+ * The smallest sufficient block of low-priority memory is preferred
+ * over high-priority memory.
+ *
+ * @param zone       Zone to search.
+ * @param count      Number of frames to allocate.
+ * @param constraint Indication of bits that cannot be set in the
+ *                   physical frame number of the first allocated frame.
+ * @param take       Remove the first @a count frames of the block
+ *                   from the buddy index.
+ *
+ * @return Index of the first frame of the block.
+ * @return -1 if the buddy index cannot satisfy the request.
+ *
+ */
+_NO_TRACE static size_t buddy_find_block(zone_t *zone, size_t count,
+    pfn_t constraint, bool take)
+{
+	/* Only alignment constraints are implied by the block order. */
+	if ((count == 0) || ((constraint & (constraint + 1)) != 0))
+		return (size_t) -1;
+
+	uint8_t order = (count > 1) ? fnzb(count - 1) + 1 : 0;
+	if (constraint != 0)
+		order = max(order, fnzb(constraint) + 1);
+
+	size_t index = (size_t) -1;
+
+	for (; order < ZONE_BUDDY_ORDERS; order++) {
+		size_t head = zone->buddy_head[order];
+		if (head == (size_t) -1)
+			continue;
+
+		if (!is_high_priority(zone->base + head, 1)) {
+			index = head;
+			break;
+		}
+
+		if (index == (size_t) -1)
+			index = head;
+	}
+
+	if ((take) && (index != (size_t) -1))
+		buddy_take_range(zone, index, count);
+
+	return index;
+}
+
+/** Rebuild the buddy index of a zone from its bitmap. */
+_NO_TRACE static void buddy_rebuild(zone_t *zone)
+{
+	for (uint8_t order = 0; order < ZONE_BUDDY_ORDERS; order++) {
+		zone->buddy_head[order] = (size_t) -1;
+		zone->buddy_free[order] = 0;
+	}
+
+	for (size_t i = 0; i < zone->count; i++)
+		zone->frames[i].buddy_order = FRAME_BUDDY_NONE;
+
+	size_t i = 0;
+	while (i < zone->count) {
+		if (bitmap_get(&zone->bitmap, i)) {
+			i++;
+			continue;
+		}
+
+		size_t start = i;
+		while ((i < zone->count) && (!bitmap_get(&zone->bitmap, i)))
+			i++;
+
+		buddy_free_range(zone, start, i - start);
+	}
+}
+
 /** Allocate frame in particular zone.
  *
  * Assume zone is locked and is available for allocation.
@@ -375,13 +663,19 @@ _NO_TRACE static size_t zone_frame_alloc(zone_t *zone, size_t count,
 	assert(zone->free_count >= count);
 
 	/* Allocate frames from zone */
-	size_t index = (size_t) -1;
-	int avail = bitmap_allocate_range(&zone->bitmap, count, zone->base,
-	    FRAME_LOWPRIO, constraint, &index);
+	size_t index = buddy_find_block(zone, count, constraint, true);
+	if (index != (size_t) -1) {
+		bitmap_set_range(&zone->bitmap, index, count);
+	} else {
+		int avail = bitmap_allocate_range(&zone->bitmap, count,
+		    zone->base, FRAME_LOWPRIO, constraint, &index);
+
+		(void) avail;
+		assert(avail);
+		assert(index != (size_t) -1);
 
-	(void) avail;
-	assert(avail);
-	assert(index != (size_t) -1);
+		buddy_take_range(zone, index, count);
+	}
 
 	/* Update frame reference count */
 	for (size_t i = 0; i < count; i++) {
@@ -419,6 +713,7 @@ _NO_TRACE static size_t zone_frame_free(zone_t *zone, size_t index)
 		assert(zone->busy_count > 0);
 
 		bitmap_set(&zone->bitmap, index, 0);
+		buddy_free_range(zone, index, 1);
 
 		/* Update zone information. */
 		zone->free_count++;
@@ -445,6 +740,7 @@ _NO_TRACE static void zone_mark_unavailable(zone_t *zone, size_t index)
 
 	frame->refcount = 1;
 	bitmap_set_range(&zone->bitmap, index, 1);
+	buddy_take_range(zone, index, 1);
 
 	zone->free_count--;
 	reserve_force_alloc(1);
@@ -460,6 +756,7 @@ _NO_TRACE static void zone_mark_available(zone_t *zone, size_t index)
 
 	frame->refcount = 0;
 	bitmap_set_range(&zone->bitmap, index, 0);
+	buddy_free_range(zone, index, 1);
 
 	zone->free_count++;
 }
@@ -516,14 +813,22 @@ _NO_TRACE static void zone_merge_internal(size_t z1, size_t z2, zone_t *old_z1,
 		    zones.info[z2].frames[i];
 	}
 
+	for (size_t i = 0; i < gap; i++)
+		frame_initialize(&zones.info[z1].frames[old_z1->count + i]);
+
+	/*
+	 * The buddy index of the merged zone refers to frame indices
+	 * which have changed, rebuild it from the merged bitmap.
+	 */
+
+	buddy_rebuild(&zones.info[z1]);
+
 	/*
 	 * Mark the gap between the original zones as unavailable.
 	 */
 
-	for (size_t i = 0; i < gap; i++) {
-		frame_initialize(&zones.info[z1].frames[old_z1->count + i]);
+	for (size_t i = 0; i < gap; i++)
 		zone_mark_unavailable(&zones.info[z1], old_z1->count + i);
-	}
 }
 
 /** Return old configuration frames into the zone.
@@ -682,9 +987,16 @@ _NO_TRACE static void zone_construct(zone_t *zone, pfn_t start, size_t count,
 
 		for (size_t i = 0; i < count; i++)
 			frame_initialize(&zone->frames[i]);
+
+		buddy_rebuild(zone);
 	} else {
 		bitmap_initialize(&zone->bitmap, 0, NULL);
 		zone->frames = NULL;
+
+		for (uint8_t order = 0; order < ZONE_BUDDY_ORDERS; order++) {
+			zone->buddy_head[order] = (size_t) -1;
+			zone->buddy_free[order] = 0;
+		}
 	}
 }
 
@@ -862,6 +1174,157 @@ static size_t try_find_zone(size_t count, bool lowmem,
 	    frame_constraint, hint);
 }
 
+/** Return frames from a per-CPU frame cache to their zones.
+ *
+ * Assume the cache is locked and interrupts are disabled.
+ *
+ * @param stack Cached frames of one kind.
+ * @param count Number of cached frames in @a stack.
+ * @param keep  Number of frames to keep in the cache.
+ *
+ * @return Number of freed frames.
+ *
+ */
+_NO_TRACE static size_t cpucache_release(pfn_t *stack, size_t *count,
+    size_t keep)
+{
+	size_t freed = 0;
+
+	irq_spinlock_lock(&zones.lock, false);
+
+	while (*count > keep) {
+		pfn_t pfn = stack[--(*count)];
+		size_t znum = find_zone(pfn, 1, 0);
+
+		assert(znum != (size_t) -1);
+
+		freed += zone_frame_free(&zones.info[znum],
+		    pfn - zones.info[znum].base);
+	}
+
+	irq_spinlock_unlock(&zones.lock, false);
+
+	return freed;
+}
+
+/** Refill an empty per-CPU frame cache from the zones.
+ *
+ * Assume the cache is locked and interrupts are disabled.
+ *
+ * @param stack Cached frames of one kind.
+ * @param count Number of cached frames in @a stack.
+ * @param flags Required flags of the zones to allocate from.
+ *
+ */
+_NO_TRACE static void cpucache_fill(pfn_t *stack, size_t *count,
+    zone_flags_t flags)
+{
+	size_t hint = 0;
+
+	irq_spinlock_lock(&zones.lock, false);
+
+	while (*count < FRAME_CPUCACHE_BATCH) {
+		size_t znum = find_free_zone(1, flags, 0, hint);
+		if (znum == (size_t) -1)
+			break;
+
+		stack[(*count)++] = zone_frame_alloc(&zones.info[znum], 1, 0) +
+		    zones.info[znum].base;
+		hint = znum;
+	}
+
+	irq_spinlock_unlock(&zones.lock, false);
+}
+
+/** Allocate a single frame from the current CPU's frame cache.
+ *
+ * @param lowmem True if the frame must be identity-mappable.
+ *
+ * @return Frame number or zero if there is no free frame.
+ *
+ */
+_NO_TRACE static pfn_t cpucache_alloc(bool lowmem)
+{
+	frame_cpucache_t *cache = &CPU->frame_cache;
+	pfn_t pfn = 0;
+
+	irq_spinlock_lock(&cache->lock, true);
+
+	if (!lowmem) {
+		if (cache->highmem_count == 0) {
+			cpucache_fill(cache->highmem, &cache->highmem_count,
+			    ZONE_HIGHMEM | ZONE_AVAILABLE);
+		}
+
+		if (cache->highmem_count > 0)
+			pfn = cache->highmem[--cache->highmem_count];
+	}
+
+	if (pfn == 0) {
+		if (cache->lowmem_count == 0) {
+			cpucache_fill(cache->lowmem, &cache->lowmem_count,
+			    ZONE_LOWMEM | ZONE_AVAILABLE);
+		}
+
+		if (cache->lowmem_count > 0)
+			pfn = cache->lowmem[--cache->lowmem_count];
+	}
+
+	irq_spinlock_unlock(&cache->lock, true);
+
+	return pfn;
+}
+
+/** Free a single frame to the current CPU's frame cache.
+ *
+ * The frame stays allocated from its zone's point of view. If the cache
+ * is full, a batch of frames is returned to the zones first.
+ *
+ * @param pfn     Frame to be freed.
+ * @param highmem True if the frame belongs to a high memory zone.
+ *
+ */
+_NO_TRACE static void cpucache_free(pfn_t pfn, bool highmem)
+{
+	frame_cpucache_t *cache = &CPU->frame_cache;
+
+	irq_spinlock_lock(&cache->lock, true);
+
+	pfn_t *stack = highmem ? cache->highmem : cache->lowmem;
+	size_t *count = highmem ? &cache->highmem_count : &cache->lowmem_count;
+
+	if (*count == FRAME_CPUCACHE_SIZE) {
+		(void) cpucache_release(stack, count,
+		    FRAME_CPUCACHE_SIZE - FRAME_CPUCACHE_BATCH);
+	}
+
+	stack[(*count)++] = pfn;
+
+	irq_spinlock_unlock(&cache->lock, true);
+}
+
+/** Return the frames cached by all CPUs to the zones.
+ *
+ * @return Number of freed frames.
+ *
+ */
+_NO_TRACE static size_t cpucache_drain_all(void)
+{
+	size_t freed = 0;
+
+	for (size_t i = 0; i < config.cpu_count; i++) {
+		frame_cpucache_t *cache = &cpus[i].frame_cache;
+
+		irq_spinlock_lock(&cache->lock, true);
+		freed += cpucache_release(cache->lowmem, &cache->lowmem_count, 0);
+		freed += cpucache_release(cache->highmem,
+		    &cache->highmem_count, 0);
+		irq_spinlock_unlock(&cache->lock, true);
+	}
+
+	return freed;
+}
+
 /** Allocate frames of physical memory.
  *
  * @param count      Number of continuous frames to allocate.
@@ -887,6 +1350,20 @@ uintptr_t frame_alloc_generic(size_t count, frame_flags_t flags,
 	if (!(flags & FRAME_NO_RESERVE))
 		reserve_force_alloc(count);
 
+	if ((count == 1) && (frame_constraint == 0) && CPU &&
+	    atomic_load(&frame_cpucache_enabled)) {
+		bool lowmem = (flags & FRAME_LOWMEM) || !(flags & FRAME_HIGHMEM) ||
+		    !frame_highmem;
+
+		pfn_t pfn = cpucache_alloc(lowmem);
+		if (pfn != 0) {
+			if (pzone)
+				*pzone = find_zone(pfn, 1, hint);
+
+			return PFN2ADDR(pfn);
+		}
+	}
+
 loop:
 	irq_spinlock_lock(&zones.lock, true);
 
@@ -898,6 +1375,17 @@ loop:
 	 */
 	size_t znum = try_find_zone(count, lowmem, frame_constraint, hint);
 
+	/* Frames held by the per-CPU caches can be used first. */
+	if ((znum == (size_t) -1) && atomic_load(&frame_cpucache_enabled)) {
+		irq_spinlock_unlock(&zones.lock, true);
+		size_t freed = cpucache_drain_all();
+		irq_spinlock_lock(&zones.lock, true);
+
+		if (freed > 0)
+			znum = try_find_zone(count, lowmem,
+			    frame_constraint, hint);
+	}
+
 	/*
 	 * If no memory, reclaim some slab memory,
 	 * if it does not help, reclaim all.
@@ -1004,6 +1492,34 @@ void frame_free_generic(uintptr_t start, size_t count, frame_flags_t flags)
 {
 	size_t freed = 0;
 
+	/*
+	 * Put single frames to the per-CPU cache unless somebody is waiting
+	 * for memory. The check of mem_avail_req is racy, but a waiter that
+	 * misses this frame is woken up by the next frame freed to a zone.
+	 */
+	if ((count == 1) && CPU && atomic_load(&frame_cpucache_enabled) &&
+	    (mem_avail_req == 0)) {
+		pfn_t pfn = ADDR2PFN(start);
+		size_t znum = find_zone(pfn, 1, 0);
+
+		assert(znum != (size_t) -1);
+
+		zone_t *zone = &zones.info[znum];
+
+		/*
+		 * A frame with a single reference belongs to the caller only,
+		 * so nobody else can change the reference count concurrently.
+		 */
+		if (zone_get_frame(zone, pfn - zone->base)->refcount == 1) {
+			cpucache_free(pfn, zone->flags & ZONE_HIGHMEM);
+
+			if (!(flags & FRAME_NO_RESERVE))
+				reserve_free(1);
+
+			return;
+		}
+	}
+
 	irq_spinlock_lock(&zones.lock, true);
 
 	for (size_t i = 0; i < count; i++) {
@@ -1124,6 +1640,27 @@ void frame_init(void)
 	frame_high_arch_init();
 }
 
+/** Enable the per-CPU frame caches.
+ *
+ * Must be called after the CPU structures are initialized and all
+ * memory zones are created and merged.
+ *
+ */
+void frame_enable_cpucache(void)
+{
+	irq_spinlock_lock(&zones.lock, true);
+
+	for (size_t i = 0; i < zones.count; i++) {
+		if (ZONE_FLAGS_MATCH(zones.info[i].flags,
+		    ZONE_HIGHMEM | ZONE_AVAILABLE))
+			frame_highmem = true;
+	}
+
+	irq_spinlock_unlock(&zones.lock, true);
+
+	atomic_store(&frame_cpucache_enabled, true);
+}
+
 /** Adjust bounds of physical memory region according to low/high memory split.
  *
  * @param low[in]      If true, the adjustment is performed to make the region
@@ -1206,6 +1743,27 @@ void zones_stats(uint64_t *total, uint64_t *unavail, uint64_t *busy,
 	irq_spinlock_unlock(&zones.lock, true);
 }
 
+/** Get the number of free blocks of each order in all zones.
+ *
+ * @param free_blocks Array of ZONE_BUDDY_ORDERS counters to fill in.
+ *
+ */
+void zones_buddy_stats(uint64_t *free_blocks)
+{
+	assert(free_blocks != NULL);
+
+	irq_spinlock_lock(&zones.lock, true);
+
+	for (uint8_t order = 0; order < ZONE_BUDDY_ORDERS; order++) {
+		free_blocks[order] = 0;
+
+		for (size_t i = 0; i < zones.count; i++)
+			free_blocks[order] += zones.info[i].buddy_free[order];
+	}
+
+	irq_spinlock_unlock(&zones.lock, true);
+}
+
 /** Prints list of zones.
  *
  */
@@ -1353,6 +1911,7 @@ void zone_print_one(size_t num)
 	size_t free_lowmem = 0;
 	size_t free_highmem = 0;
 	size_t free_highprio = 0;
+	size_t free_blocks[ZONE_BUDDY_ORDERS];
 
 	pfn_t fbase = zones.info[znum].base;
 	uintptr_t base = PFN2ADDR(fbase);
@@ -1366,6 +1925,9 @@ void zone_print_one(size_t num)
 	bool highmem = ((flags & ZONE_HIGHMEM) != 0);
 	bool highprio = is_high_priority(fbase, count);
 
+	for (uint8_t order = 0; order < ZONE_BUDDY_ORDERS; order++)
+		free_blocks[order] = zones.info[znum].buddy_free[order];
+
 	if (available) {
 		if (lowmem)
 			free_lowmem = free_count;
@@ -1435,6 +1997,11 @@ void zone_print_one(size_t num)
 		    false);
 		printf("Available high priority: %zu frames (%" PRIu64 " %s)\n",
 		    free_highprio, size, size_suffix);
+
+		printf("Free blocks by order:   ");
+		for (uint8_t order = 0; order < ZONE_BUDDY_ORDERS; order++)
+			printf(" %zu", free_blocks[order]);
+		printf("\n");
 	}
 }
 
@@ -77,8 +77,9 @@ void malloc_init(void)
 	for (i = 0, size = (1 << SLAB_MIN_MALLOC_W);
 	    i < (SLAB_MAX_MALLOC_W - SLAB_MIN_MALLOC_W + 1);
 	    i++, size <<= 1) {
-		malloc_caches[i] = slab_cache_create(malloc_names[i], size, 0,
-		    NULL, NULL, SLAB_CACHE_MAGDEFERRED);
+		/* Keep the objects aligned naturally despite slab coloring */
+		malloc_caches[i] = slab_cache_create(malloc_names[i], size,
+		    min(size, PAGE_SIZE), NULL, NULL, SLAB_CACHE_MAGDEFERRED);
 	}
 }
 
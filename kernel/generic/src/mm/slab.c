@@ -43,10 +43,10 @@
  * @li empty magazines are deallocated when not needed
  *     (in Solaris they are held in linked list in slab cache)
  *
- * Following features are not currently supported but would be easy to do:
- * @li cache coloring
- * @li dynamic magazine growing (different magazine sizes are already
- *     supported, but we would need to adjust allocation strategy)
+ * The slabs are colored, i.e. the first object of consecutive slabs is
+ * placed at different offsets within the space which would be otherwise
+ * wasted, so that objects at the same index of different slabs do not all
+ * map to the same cache lines.
  *
  * The slab allocator supports per-CPU caches ('magazines') to facilitate
  * good SMP scaling.
@@ -66,6 +66,12 @@
  * size boundary. LIFO order is enforced, which should avoid fragmentation
  * as much as possible.
  *
+ * The magazines of a cache start small and grow when the lock of the
+ * cpu-shared list of magazines becomes contended, so that busy caches
+ * exchange magazines with the list less often. Each magazine keeps its
+ * size, magazines of different sizes are allocated from different caches.
+ * The magazines shrink back to the initial size on memory stress.
+ *
  * Every cache contains list of full slabs and list of partially full slabs.
  * Empty slabs are immediately freed (thrashing will be avoided because
  * of magazines).
@@ -116,12 +122,21 @@
 #include <macros.h>
 #include <cpu.h>
 #include <stdlib.h>
+#include <str.h>
 
 IRQ_SPINLOCK_STATIC_INITIALIZE(slab_cache_lock);
 static LIST_INITIALIZE(slab_cache_list);
 
-/** Magazine cache */
-static slab_cache_t mag_cache;
+/** Magazine caches, one for each magazine size */
+static slab_cache_t mag_cache[SLAB_MAG_SIZES];
+
+static const char *mag_cache_names[SLAB_MAG_SIZES] = {
+	"slab_magazine_t-4",
+	"slab_magazine_t-8",
+	"slab_magazine_t-16",
+	"slab_magazine_t-32",
+	"slab_magazine_t-64"
+};
 
 /** Cache for cache descriptors */
 static slab_cache_t slab_cache_cache;
@@ -141,6 +156,7 @@ static slab_cache_t *slab_extern_cache;
 typedef struct {
 	slab_cache_t *cache;  /**< Pointer to parent cache. */
 	link_t link;          /**< List of full/partial slabs. */
+	void *data;           /**< Start address of the slab's frames. */
 	void *start;          /**< Start address of first available item. */
 	size_t available;     /**< Count of available items in this slab. */
 	size_t nextavail;     /**< The index of next available item. */
@@ -188,7 +204,10 @@ _NO_TRACE static slab_t *slab_space_alloc(slab_cache_t *cache,
 	for (i = 0; i < cache->frames; i++)
 		frame_set_parent(ADDR2PFN(KA2PA(data)) + i, slab, zone);
 
-	slab->start = data;
+	size_t color = atomic_postinc(&cache->color_next) % cache->colors;
+
+	slab->data = data;
+	slab->start = data + color * cache->color_size;
 	slab->available = cache->objects;
 	slab->nextavail = 0;
 	slab->cache = cache;
@@ -207,7 +226,7 @@ _NO_TRACE static slab_t *slab_space_alloc(slab_cache_t *cache,
  */
 _NO_TRACE static size_t slab_space_free(slab_cache_t *cache, slab_t *slab)
 {
-	frame_free(KA2PA(slab->start), slab->cache->frames);
+	frame_free(KA2PA(slab->data), slab->cache->frames);
 	if (!(cache->flags & SLAB_CACHE_SLINSIDE))
 		slab_free(slab_extern_cache, slab);
 
@@ -326,6 +345,46 @@ _NO_TRACE static void *slab_obj_create(slab_cache_t *cache, unsigned int flags)
  * CPU-Cache slab functions
  */
 
+/** Return magazine cache for magazines of given size */
+_NO_TRACE static slab_cache_t *mag_cache_for(size_t size)
+{
+	size_t idx = fnzb(size / SLAB_MAG_SIZE);
+
+	assert(idx < SLAB_MAG_SIZES);
+	assert(size == (SLAB_MAG_SIZE << idx));
+
+	return &mag_cache[idx];
+}
+
+/** Lock magazine list of cache and account for contention
+ *
+ * If the lock was contended in at least 1 of SLAB_MAG_CONTENTION accesses
+ * during the last SLAB_MAG_WINDOW accesses, the size of newly allocated
+ * magazines is doubled.
+ *
+ * Interrupts must be disabled.
+ *
+ */
+_NO_TRACE static void maglock_lock(slab_cache_t *cache)
+{
+	if (!irq_spinlock_trylock(&cache->maglock)) {
+		irq_spinlock_lock(&cache->maglock, false);
+		atomic_inc(&cache->magazine_contention);
+		cache->maglock_contended++;
+	}
+
+	if (++cache->maglock_accesses < SLAB_MAG_WINDOW)
+		return;
+
+	size_t size = atomic_load(&cache->magazine_size);
+	if ((cache->maglock_contended * SLAB_MAG_CONTENTION >= SLAB_MAG_WINDOW) &&
+	    (size < SLAB_MAG_SIZE_MAX))
+		atomic_store(&cache->magazine_size, size << 1);
+
+	cache->maglock_accesses = 0;
+	cache->maglock_contended = 0;
+}
+
 /** Find a full magazine in cache, take it from list and return it
  *
  * @param first If true, return first, else last mag.
@@ -337,7 +396,9 @@ _NO_TRACE static slab_magazine_t *get_mag_from_cache(slab_cache_t *cache,
 	slab_magazine_t *mag = NULL;
 	link_t *cur;
 
-	irq_spinlock_lock(&cache->maglock, true);
+	ipl_t ipl = interrupts_disable();
+	maglock_lock(cache);
+
 	if (!list_empty(&cache->magazines)) {
 		if (first)
 			cur = list_first(&cache->magazines);
@@ -348,7 +409,9 @@ _NO_TRACE static slab_magazine_t *get_mag_from_cache(slab_cache_t *cache,
 		list_remove(&mag->link);
 		atomic_dec(&cache->magazine_counter);
 	}
-	irq_spinlock_unlock(&cache->maglock, true);
+
+	irq_spinlock_unlock(&cache->maglock, false);
+	interrupts_restore(ipl);
 
 	return mag;
 }
@@ -359,12 +422,14 @@ _NO_TRACE static slab_magazine_t *get_mag_from_cache(slab_cache_t *cache,
 _NO_TRACE static void put_mag_to_cache(slab_cache_t *cache,
     slab_magazine_t *mag)
 {
-	irq_spinlock_lock(&cache->maglock, true);
+	ipl_t ipl = interrupts_disable();
+	maglock_lock(cache);
 
 	list_prepend(&mag->link, &cache->magazines);
 	atomic_inc(&cache->magazine_counter);
 
-	irq_spinlock_unlock(&cache->maglock, true);
+	irq_spinlock_unlock(&cache->maglock, false);
+	interrupts_restore(ipl);
 }
 
 /** Free all objects in magazine and free memory associated with magazine
@@ -383,7 +448,7 @@ _NO_TRACE static size_t magazine_destroy(slab_cache_t *cache,
 		atomic_dec(&cache->cached_objs);
 	}
 
-	slab_free(&mag_cache, mag);
+	slab_free(mag_cache_for(mag->size), mag);
 
 	return frames;
 }
@@ -437,11 +502,13 @@ _NO_TRACE static void *magazine_obj_get(slab_cache_t *cache)
 
 	slab_magazine_t *mag = get_full_current_mag(cache);
 	if (!mag) {
+		cache->mag_cache[CPU->id].misses++;
 		irq_spinlock_unlock(&cache->mag_cache[CPU->id].lock, true);
 		return NULL;
 	}
 
 	void *obj = mag->objs[--mag->busy];
+	cache->mag_cache[CPU->id].hits++;
 	irq_spinlock_unlock(&cache->mag_cache[CPU->id].lock, true);
 
 	atomic_dec(&cache->cached_objs);
@@ -484,12 +551,13 @@ _NO_TRACE static slab_magazine_t *make_empty_current_mag(slab_cache_t *cache)
 	 * this would deadlock.
 	 *
 	 */
-	slab_magazine_t *newmag = slab_alloc(&mag_cache,
+	size_t size = atomic_load(&cache->magazine_size);
+	slab_magazine_t *newmag = slab_alloc(mag_cache_for(size),
 	    FRAME_ATOMIC | FRAME_NO_RECLAIM);
 	if (!newmag)
 		return NULL;
 
-	newmag->size = SLAB_MAG_SIZE;
+	newmag->size = size;
 	newmag->busy = 0;
 
 	/* Flush last to magazine list */
@@ -609,6 +677,7 @@ _NO_TRACE static void _slab_cache_create(slab_cache_t *cache, const char *name,
 
 	irq_spinlock_initialize(&cache->slablock, "slab.cache.slablock");
 	irq_spinlock_initialize(&cache->maglock, "slab.cache.maglock");
+	atomic_store(&cache->magazine_size, SLAB_MAG_SIZE);
 
 	if (!(cache->flags & SLAB_CACHE_NOMAGAZINE))
 		(void) make_magcache(cache);
@@ -629,6 +698,10 @@ _NO_TRACE static void _slab_cache_create(slab_cache_t *cache, const char *name,
 	if (badness(cache) > sizeof(slab_t))
 		cache->flags |= SLAB_CACHE_SLINSIDE;
 
+	/* Use the remaining wasted space for coloring */
+	cache->color_size = max(align, SLAB_COLOR_SIZE);
+	cache->colors = badness(cache) / cache->color_size + 1;
+
 	/* Add cache to cache list */
 	irq_spinlock_lock(&slab_cache_lock, true);
 	list_append(&cache->link, &slab_cache_list);
@@ -680,6 +753,9 @@ _NO_TRACE static size_t _slab_reclaim(slab_cache_t *cache, unsigned int flags)
 	}
 
 	if (flags & SLAB_RECLAIM_ALL) {
+		/* Do not cache that much under memory stress */
+		atomic_store(&cache->magazine_size, SLAB_MAG_SIZE);
+
 		/* Free cpu-bound magazines */
 		/* Destroy CPU magazines */
 		size_t i;
@@ -803,11 +879,69 @@ size_t slab_reclaim(unsigned int flags)
 	return frames;
 }
 
+/** Gather statistics of cache
+ *
+ * The counters are read without locking, the statistics are
+ * therefore only approximate.
+ *
+ */
+_NO_TRACE static void slab_cache_stats(slab_cache_t *cache,
+    stats_slab_t *stats)
+{
+	str_cpy(stats->name, SLAB_NAME_BUFLEN, cache->name);
+	stats->size = cache->size;
+	stats->frames = cache->frames;
+	stats->objects = cache->objects;
+	stats->colors = cache->colors;
+	stats->slabs = atomic_load(&cache->allocated_slabs);
+	stats->cached = atomic_load(&cache->cached_objs);
+	stats->allocated = atomic_load(&cache->allocated_objs);
+	stats->magazine_size = 0;
+	stats->hits = 0;
+	stats->misses = 0;
+	stats->contention = atomic_load(&cache->magazine_contention);
+
+	if ((cache->flags & SLAB_CACHE_NOMAGAZINE) || (!cache->mag_cache))
+		return;
+
+	stats->magazine_size = atomic_load(&cache->magazine_size);
+
+	for (size_t i = 0; i < config.cpu_count; i++) {
+		stats->hits += cache->mag_cache[i].hits;
+		stats->misses += cache->mag_cache[i].misses;
+	}
+}
+
+/** Get statistics of all caches
+ *
+ * @param stats Array to store the statistics to.
+ * @param count Number of items in the array.
+ *
+ * @return Number of existing caches, which might be more than @a count.
+ *
+ */
+size_t slab_stats(stats_slab_t *stats, size_t count)
+{
+	irq_spinlock_lock(&slab_cache_lock, true);
+
+	size_t i = 0;
+	list_foreach(slab_cache_list, link, slab_cache_t, cache) {
+		if (i < count)
+			slab_cache_stats(cache, &stats[i]);
+
+		i++;
+	}
+
+	irq_spinlock_unlock(&slab_cache_lock, true);
+
+	return i;
+}
+
 /* Print list of caches */
 void slab_print_list(void)
 {
 	printf("[cache name      ] [size  ] [pages ] [obj/pg] [slabs ]"
-	    " [cached] [alloc ] [ctl]\n");
+	    " [cached] [alloc ] [ctl] [mag] [hits    ] [misses  ] [cont  ]\n");
 
 	size_t skip = 0;
 	while (true) {
@@ -852,31 +986,33 @@ void slab_print_list(void)
 
 		slab_cache_t *cache = list_get_instance(cur, slab_cache_t, link);
 
-		const char *name = cache->name;
-		size_t frames = cache->frames;
-		size_t size = cache->size;
-		size_t objects = cache->objects;
-		long allocated_slabs = atomic_load(&cache->allocated_slabs);
-		long cached_objs = atomic_load(&cache->cached_objs);
-		long allocated_objs = atomic_load(&cache->allocated_objs);
+		stats_slab_t stats;
+		slab_cache_stats(cache, &stats);
 		unsigned int flags = cache->flags;
 
 		irq_spinlock_unlock(&slab_cache_lock, true);
 
-		printf("%-18s %8zu %8zu %8zu %8ld %8ld %8ld %-5s\n",
-		    name, size, frames, objects, allocated_slabs,
-		    cached_objs, allocated_objs,
-		    flags & SLAB_CACHE_SLINSIDE ? "in" : "out");
+		printf("%-18s %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64
+		    " %8" PRIu64 " %8" PRIu64 " %-5s %5" PRIu64 " %10" PRIu64
+		    " %10" PRIu64 " %8" PRIu64 "\n",
+		    stats.name, stats.size, stats.frames, stats.objects,
+		    stats.slabs, stats.cached, stats.allocated,
+		    flags & SLAB_CACHE_SLINSIDE ? "in" : "out",
+		    stats.magazine_size, stats.hits, stats.misses,
+		    stats.contention);
 	}
 }
 
 void slab_cache_init(void)
 {
-	/* Initialize magazine cache */
-	_slab_cache_create(&mag_cache, "slab_magazine_t",
-	    sizeof(slab_magazine_t) + SLAB_MAG_SIZE * sizeof(void *),
-	    sizeof(uintptr_t), NULL, NULL, SLAB_CACHE_NOMAGAZINE |
-	    SLAB_CACHE_SLINSIDE);
+	/* Initialize magazine caches */
+	for (size_t i = 0; i < SLAB_MAG_SIZES; i++) {
+		_slab_cache_create(&mag_cache[i], mag_cache_names[i],
+		    sizeof(slab_magazine_t) +
+		    (SLAB_MAG_SIZE << i) * sizeof(void *),
+		    sizeof(uintptr_t), NULL, NULL, SLAB_CACHE_NOMAGAZINE |
+		    SLAB_CACHE_SLINSIDE);
+	}
 
 	/* Initialize slab_cache cache */
 	_slab_cache_create(&slab_cache_cache, "slab_cache_cache",
@@ -35,12 +35,19 @@
  * @brief Generic TLB shootdown algorithm.
  *
  * The algorithm implemented here is based on the CMU TLB shootdown
- * algorithm and is further simplified (e.g. all CPUs receive all TLB
- * shootdown messages).
+ * algorithm and is further simplified. Shootdowns of a user address
+ * space are delivered only to the CPUs which may cache its entries (see
+ * as_t.cpu_mask), all other shootdowns are delivered to all CPUs.
+ * Messages queued on a CPU are coalesced whenever possible.
  */
 
 #include <mm/tlb.h>
 #include <mm/asid.h>
+#include <mm/as.h>
+#include <mm/page.h>
+#include <cpu/cpu_mask.h>
+#include <barrier.h>
+#include <macros.h>
 #include <arch/mm/tlb.h>
 #include <assert.h>
 #include <smp/ipi.h>
@@ -67,6 +74,137 @@ void tlb_init(void)
  */
 IRQ_SPINLOCK_STATIC_INITIALIZE(tlblock);
 
+/** Address space whose TLB shootdown is in progress. Protected by tlblock. */
+static as_t *shootdown_as = NULL;
+
+/** Enqueue TLB shootdown message on a CPU.
+ *
+ * The message is merged with a queued one if the queued message already
+ * covers it or if both invalidate overlapping or adjacent page ranges of
+ * the same address space, so that a burst of shootdowns results in as few
+ * invalidations on the recipient as possible.
+ *
+ * The CPU's tlb_lock must be held.
+ *
+ * @param cpu   Recipient.
+ * @param type  Type describing scope of shootdown.
+ * @param asid  Address space, if required by type.
+ * @param page  Virtual page address, if required by type.
+ * @param count Number of pages, if required by type.
+ *
+ */
+static void tlb_message_enqueue(cpu_t *cpu, tlb_invalidate_type_t type,
+    asid_t asid, uintptr_t page, size_t count)
+{
+	if (type == TLB_INVL_ALL)
+		goto invalidate_all;
+
+	for (size_t i = 0; i < cpu->tlb_messages_count; i++) {
+		tlb_shootdown_msg_t *msg = &cpu->tlb_messages[i];
+
+		if (msg->type == TLB_INVL_ALL)
+			return;
+
+		if (msg->asid != asid)
+			continue;
+
+		if (msg->type == TLB_INVL_ASID)
+			return;
+
+		if (type == TLB_INVL_ASID) {
+			msg->type = TLB_INVL_ASID;
+			msg->page = 0;
+			msg->count = 0;
+			return;
+		}
+
+		uintptr_t end = page + P2SZ(count);
+		uintptr_t msg_end = msg->page + P2SZ(msg->count);
+
+		/* Do not merge ranges which wrap around the address space. */
+		if ((end <= page) || (msg_end <= msg->page))
+			continue;
+
+		if ((page <= msg_end) && (msg->page <= end)) {
+			msg->page = min(page, msg->page);
+			msg->count = (max(end, msg_end) - msg->page) / PAGE_SIZE;
+			return;
+		}
+	}
+
+	if (cpu->tlb_messages_count < TLB_MESSAGE_QUEUE_LEN) {
+		size_t idx = cpu->tlb_messages_count++;
+		cpu->tlb_messages[idx].type = type;
+		cpu->tlb_messages[idx].asid = asid;
+		cpu->tlb_messages[idx].page = page;
+		cpu->tlb_messages[idx].count = count;
+		return;
+	}
+
+invalidate_all:
+	/*
+	 * The message queue is full or the whole TLB is to be invalidated.
+	 * Erase the queue and store one TLB_INVL_ALL message.
+	 */
+	cpu->tlb_messages_count = 1;
+	cpu->tlb_messages[0].type = TLB_INVL_ALL;
+	cpu->tlb_messages[0].asid = ASID_INVALID;
+	cpu->tlb_messages[0].page = 0;
+	cpu->tlb_messages[0].count = 0;
+}
+
+/** Deliver TLB shootdown message.
+ *
+ * Enqueue the message on the target processors, interrupt them and wait
+ * until all of them have entered tlb_shootdown_ipi_recv(). tlblock must
+ * be held.
+ *
+ * @param targets Mask of target processors or NULL for all processors.
+ * @param type    Type describing scope of shootdown.
+ * @param asid    Address space, if required by type.
+ * @param page    Virtual page address, if required by type.
+ * @param count   Number of pages, if required by type.
+ *
+ */
+static void tlb_shootdown_deliver(cpu_mask_t *targets,
+    tlb_invalidate_type_t type, asid_t asid, uintptr_t page, size_t count)
+{
+	size_t ntargets = 0;
+
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		cpu_t *cpu = &cpus[i];
+
+		cpu->tlb_target = (i != CPU->id) &&
+		    ((!targets) || (cpu_mask_is_set(targets, i)));
+		if (!cpu->tlb_target)
+			continue;
+
+		irq_spinlock_lock(&cpu->tlb_lock, false);
+		tlb_message_enqueue(cpu, type, asid, page, count);
+		irq_spinlock_unlock(&cpu->tlb_lock, false);
+
+		ntargets++;
+	}
+
+	if (ntargets == 0)
+		return;
+
+	if (ntargets == config.cpu_count - 1) {
+		tlb_shootdown_ipi_send();
+	} else {
+		for (unsigned int i = 0; i < config.cpu_count; i++) {
+			if (cpus[i].tlb_target)
+				ipi_unicast(i, VECTOR_TLB_SHOOTDOWN_IPI);
+		}
+	}
+
+busy_wait:
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		if ((cpus[i].tlb_target) && (cpus[i].tlb_active))
+			goto busy_wait;
+	}
+}
+
 /** Send TLB shootdown message.
  *
  * This function attempts to deliver TLB shootdown message
@@ -87,44 +225,47 @@ ipl_t tlb_shootdown_start(tlb_invalidate_type_t type, asid_t asid,
 	CPU->tlb_active = false;
 	irq_spinlock_lock(&tlblock, false);
 
-	size_t i;
-	for (i = 0; i < config.cpu_count; i++) {
-		if (i == CPU->id)
-			continue;
+	tlb_shootdown_deliver(NULL, type, asid, page, count);
 
-		cpu_t *cpu = &cpus[i];
+	return ipl;
+}
 
-		irq_spinlock_lock(&cpu->tlb_lock, false);
-		if (cpu->tlb_messages_count == TLB_MESSAGE_QUEUE_LEN) {
-			/*
-			 * The message queue is full.
-			 * Erase the queue and store one TLB_INVL_ALL message.
-			 */
-			cpu->tlb_messages_count = 1;
-			cpu->tlb_messages[0].type = TLB_INVL_ALL;
-			cpu->tlb_messages[0].asid = ASID_INVALID;
-			cpu->tlb_messages[0].page = 0;
-			cpu->tlb_messages[0].count = 0;
-		} else {
-			/*
-			 * Enqueue the message.
-			 */
-			size_t idx = cpu->tlb_messages_count++;
-			cpu->tlb_messages[idx].type = type;
-			cpu->tlb_messages[idx].asid = asid;
-			cpu->tlb_messages[idx].page = page;
-			cpu->tlb_messages[idx].count = count;
-		}
-		irq_spinlock_unlock(&cpu->tlb_lock, false);
+/** Send TLB shootdown message concerning one address space.
+ *
+ * The message is delivered only to the processors which may hold TLB
+ * entries of the address space. Until tlb_shootdown_finalize() is called,
+ * no other processor can activate the address space.
+ *
+ * @param as    Address space.
+ * @param type  Type describing scope of shootdown.
+ * @param page  Virtual page address, if required by type.
+ * @param count Number of pages, if required by type.
+ *
+ * @return The interrupt priority level as it existed prior to this call.
+ *
+ */
+ipl_t tlb_shootdown_start_as(as_t *as, tlb_invalidate_type_t type,
+    uintptr_t page, size_t count)
+{
+	ipl_t ipl = interrupts_disable();
+	CPU->tlb_active = false;
+	irq_spinlock_lock(&tlblock, false);
+
+	if (!as->cpu_mask) {
+		tlb_shootdown_deliver(NULL, type, as->asid, page, count);
+		return ipl;
 	}
 
-	tlb_shootdown_ipi_send();
+	/*
+	 * Processors activating the address space from now on wait in
+	 * as_switch() until the shootdown is finalized. Those which have
+	 * activated it before are guaranteed to be seen in the mask.
+	 */
+	atomic_store(&as->tlb_shootdown, true);
+	memory_barrier();
+	shootdown_as = as;
 
-busy_wait:
-	for (i = 0; i < config.cpu_count; i++) {
-		if (cpus[i].tlb_active)
-			goto busy_wait;
-	}
+	tlb_shootdown_deliver(as->cpu_mask, type, as->asid, page, count);
 
 	return ipl;
 }
@@ -136,6 +277,11 @@ busy_wait:
  */
 void tlb_shootdown_finalize(ipl_t ipl)
 {
+	if (shootdown_as) {
+		atomic_store(&shootdown_as->tlb_shootdown, false);
+		shootdown_as = NULL;
+	}
+
 	irq_spinlock_unlock(&tlblock, false);
 	CPU->tlb_active = true;
 	interrupts_restore(ipl);
@@ -1000,10 +1000,19 @@ sys_errno_t sys_thread_create(sysarg_t pc, sysarg_t sp,
 }
 
 /** Process syscall to terminate thread.
+ *
+ * @param uspace_status Exit status. Currently not used.
+ * @param uspace_stack  Address of the address space area with the userspace
+ *                      stack of the thread or zero. The thread cannot destroy
+ *                      the area itself while it is running on it, so it is
+ *                      destroyed here once the thread has left userspace.
  *
  */
-sys_errno_t sys_thread_exit(int uspace_status)
+sys_errno_t sys_thread_exit(int uspace_status, uintptr_t uspace_stack)
 {
+	if (uspace_stack != 0)
+		(void) as_area_destroy(AS, uspace_stack);
+
 	thread_exit();
 }
 
@@ -43,6 +43,7 @@
 #include <synch/mutex.h>
 #include <time/clock.h>
 #include <mm/frame.h>
+#include <mm/slab.h>
 #include <proc/task.h>
 #include <proc/thread.h>
 #include <interrupt.h>
@@ -52,6 +53,7 @@
 #include <cpu.h>
 #include <arch.h>
 #include <stdlib.h>
+#include <macros.h>
 
 /** Bits of fixed-point precision for load */
 #define LOAD_FIXED_SHIFT  11
@@ -764,10 +766,47 @@ static void *get_stats_physmem(struct sysinfo_item *item, size_t *size,
 
 	zones_stats(&(stats_physmem->total), &(stats_physmem->unavail),
 	    &(stats_physmem->used), &(stats_physmem->free));
+	zones_buddy_stats(stats_physmem->free_blocks);
 
 	return ((void *) stats_physmem);
 }
 
+/** Get slab cache statistics
+ *
+ * @param item    Sysinfo item (unused).
+ * @param size    Size of the returned data.
+ * @param dry_run Do not get the data, just calculate the size.
+ * @param data    Unused.
+ *
+ * @return Data containing several stats_slab_t structures.
+ *         If the return value is not NULL, it should be freed
+ *         in the context of the sysinfo request.
+ */
+static void *get_stats_slabs(struct sysinfo_item *item, size_t *size,
+    bool dry_run, void *data)
+{
+	/*
+	 * The slab cache list cannot be locked while allocating
+	 * memory, caches created in the meantime are omitted.
+	 */
+	size_t count = slab_stats(NULL, 0);
+
+	*size = sizeof(stats_slab_t) * count;
+	if ((dry_run) || (count == 0))
+		return NULL;
+
+	stats_slab_t *stats_slabs = (stats_slab_t *) malloc(*size);
+	if (stats_slabs == NULL) {
+		*size = 0;
+		return NULL;
+	}
+
+	count = min(count, slab_stats(stats_slabs, count));
+	*size = sizeof(stats_slab_t) * count;
+
+	return ((void *) stats_slabs);
+}
+
 /** Get system load
  *
  * @param item    Sysinfo item (unused).
@@ -847,6 +886,7 @@ void stats_init(void)
 {
 	sysinfo_set_item_gen_data("system.cpus", NULL, get_stats_cpus, NULL);
 	sysinfo_set_item_gen_data("system.physmem", NULL, get_stats_physmem, NULL);
+	sysinfo_set_item_gen_data("system.slabs", NULL, get_stats_slabs, NULL);
 	sysinfo_set_item_gen_data("system.load", NULL, get_stats_load, NULL);
 	sysinfo_set_item_gen_data("system.tasks", NULL, get_stats_tasks, NULL);
 	sysinfo_set_item_gen_data("system.threads", NULL, get_stats_threads, NULL);
@@ -34,6 +34,12 @@
 /**
  * @file
  * @brief Timeout management functions.
+ *
+ * Active timeouts of each processor are kept in a hierarchical timing
+ * wheel (see timeout_wheel_t), so that registering and unregistering a
+ * timeout takes constant time and the work done on each clock tick is
+ * bounded by the number of wheel levels plus the number of expired
+ * timeouts.
  */
 
 #include <time/timeout.h>
@@ -53,8 +59,19 @@
  */
 void timeout_init(void)
 {
+	timeout_wheel_t *wheel = &CPU->timeout_wheel;
+
 	irq_spinlock_initialize(&CPU->timeoutlock, "cpu.timeoutlock");
-	list_initialize(&CPU->timeout_active_list);
+
+	wheel->tick = CPU_LOCAL->current_clock_tick;
+	wheel->count = 0;
+
+	for (unsigned int level = 0; level < TIMEOUT_WHEEL_LEVELS; level++) {
+		for (unsigned int slot = 0; slot < TIMEOUT_WHEEL_SLOTS; slot++)
+			list_initialize(&wheel->slots[level][slot]);
+	}
+
+	list_initialize(&wheel->overflow);
 }
 
 /** Initialize timeout
@@ -79,6 +96,83 @@ deadline_t timeout_deadline_in_usec(uint32_t usec)
 	return CPU_LOCAL->current_clock_tick + us2ticks(usec);
 }
 
+/** Insert timeout into the timing wheel
+ *
+ * The timeout is put into the lowest level whose range covers its
+ * expiration tick. Must be called with the wheel's lock held.
+ *
+ * @param wheel   Timing wheel.
+ * @param timeout Timeout to insert.
+ *
+ */
+static void timeout_wheel_insert(timeout_wheel_t *wheel, timeout_t *timeout)
+{
+	/* The timeout expires when the clock tick exceeds the deadline. */
+	uint64_t expiry = (timeout->deadline == DEADLINE_NEVER) ?
+	    DEADLINE_NEVER : timeout->deadline + 1;
+
+	if (expiry < wheel->tick)
+		expiry = wheel->tick;
+
+	uint64_t delta = expiry - wheel->tick;
+
+	for (unsigned int level = 0; level < TIMEOUT_WHEEL_LEVELS; level++) {
+		unsigned int shift = level * TIMEOUT_WHEEL_BITS;
+
+		if (delta < ((uint64_t) TIMEOUT_WHEEL_SLOTS << shift)) {
+			list_append(&timeout->link, &wheel->slots[level]
+			    [(expiry >> shift) & TIMEOUT_WHEEL_MASK]);
+			return;
+		}
+	}
+
+	list_append(&timeout->link, &wheel->overflow);
+}
+
+/** Reinsert all timeouts of a list into the timing wheel
+ *
+ * @param wheel Timing wheel.
+ * @param list  Wheel slot or the overflow list.
+ *
+ */
+static void timeout_wheel_requeue(timeout_wheel_t *wheel, list_t *list)
+{
+	list_t pending;
+	list_initialize(&pending);
+	list_concat(&pending, list);
+
+	link_t *cur;
+	while ((cur = list_first(&pending)) != NULL) {
+		list_remove(cur);
+		timeout_wheel_insert(wheel,
+		    list_get_instance(cur, timeout_t, link));
+	}
+}
+
+/** Cascade timeouts down the timing wheel
+ *
+ * Called whenever level 0 wraps around. Moves the timeouts of the next
+ * slot of level 1 to level 0 and continues with the higher levels as
+ * long as the lower ones wrap around, too.
+ *
+ * @param wheel Timing wheel.
+ *
+ */
+static void timeout_wheel_cascade(timeout_wheel_t *wheel)
+{
+	for (unsigned int level = 1; level < TIMEOUT_WHEEL_LEVELS; level++) {
+		unsigned int slot = (wheel->tick >> (level * TIMEOUT_WHEEL_BITS)) &
+		    TIMEOUT_WHEEL_MASK;
+
+		timeout_wheel_requeue(wheel, &wheel->slots[level][slot]);
+
+		if (slot != 0)
+			return;
+	}
+
+	timeout_wheel_requeue(wheel, &wheel->overflow);
+}
+
 static void timeout_register_deadline_locked(timeout_t *timeout, deadline_t deadline,
     timeout_handler_t handler, void *arg)
 {
@@ -92,21 +186,8 @@ static void timeout_register_deadline_locked(timeout_t *timeout, deadline_t dead
 		.finished = ATOMIC_VAR_INIT(false),
 	};
 
-	/* Insert timeout into the active timeouts list according to timeout->deadline. */
-
-	link_t *last = list_last(&CPU->timeout_active_list);
-	if (last == NULL || timeout->deadline >= list_get_instance(last, timeout_t, link)->deadline) {
-		list_append(&timeout->link, &CPU->timeout_active_list);
-	} else {
-		for (link_t *cur = list_first(&CPU->timeout_active_list); cur != NULL;
-		    cur = list_next(cur, &CPU->timeout_active_list)) {
-
-			if (timeout->deadline < list_get_instance(cur, timeout_t, link)->deadline) {
-				list_insert_before(&timeout->link, cur);
-				break;
-			}
-		}
-	}
+	timeout_wheel_insert(&CPU->timeout_wheel, timeout);
+	CPU->timeout_wheel.count++;
 }
 
 /** Register timeout
@@ -139,7 +220,7 @@ void timeout_register_deadline(timeout_t *timeout, deadline_t deadline,
 
 /** Unregister timeout
  *
- * Remove timeout from timeout list.
+ * Remove timeout from the timing wheel.
  *
  * @param timeout Timeout to unregister.
  *
@@ -159,6 +240,7 @@ bool timeout_unregister(timeout_t *timeout)
 	bool success = link_in_use(&timeout->link);
 	if (success) {
 		list_remove(&timeout->link);
+		timeout->cpu->timeout_wheel.count--;
 	}
 
 	irq_spinlock_unlock(&timeout->cpu->timeoutlock, true);
@@ -172,5 +254,65 @@ bool timeout_unregister(timeout_t *timeout)
 	return success;
 }
 
+/** Run expired timeouts
+ *
+ * Advance the timing wheel of the current processor up to the given clock
+ * tick and run the handlers of all timeouts which have expired. Called from
+ * the clock interrupt handler with interrupts disabled.
+ *
+ * @param current_clock_tick Current clock tick of the processor.
+ *
+ */
+void timeout_expire(uint64_t current_clock_tick)
+{
+	timeout_wheel_t *wheel = &CPU->timeout_wheel;
+
+	/*
+	 * To avoid lock ordering problems,
+	 * run all expired timeouts as you visit them.
+	 *
+	 */
+
+	irq_spinlock_lock(&CPU->timeoutlock, false);
+
+	while (wheel->tick <= current_clock_tick) {
+		if (wheel->count == 0) {
+			/* Nothing to cascade or expire, skip the idle ticks. */
+			wheel->tick = current_clock_tick + 1;
+			break;
+		}
+
+		if ((wheel->tick & TIMEOUT_WHEEL_MASK) == 0)
+			timeout_wheel_cascade(wheel);
+
+		list_t *slot = &wheel->slots[0][wheel->tick & TIMEOUT_WHEEL_MASK];
+
+		link_t *cur;
+		while ((cur = list_first(slot)) != NULL) {
+			timeout_t *timeout = list_get_instance(cur, timeout_t, link);
+
+			list_remove(cur);
+			wheel->count--;
+
+			timeout_handler_t handler = timeout->handler;
+			void *arg = timeout->arg;
+			atomic_bool *finished = &timeout->finished;
+
+			irq_spinlock_unlock(&CPU->timeoutlock, false);
+
+			handler(arg);
+
+			/* Signal that the handler is finished. */
+			atomic_store_explicit(finished, true, memory_order_release);
+
+			irq_spinlock_lock(&CPU->timeoutlock, false);
+		}
+
+		wheel->tick++;
+	}
+
+	irq_spinlock_unlock(&CPU->timeoutlock, false);
+}
+
 /** @}
  */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <mm/frame.h>
+#include <arch/mm/page.h>
+#include <typedefs.h>
+#include <stdlib.h>
+
+#define MAX_ORDER   8
+#define MAX_BLOCKS  32
+
+static void print_free_blocks(void)
+{
+	uint64_t free_blocks[ZONE_BUDDY_ORDERS];
+	zones_buddy_stats(free_blocks);
+
+	TPRINTF("Free blocks by order:");
+	for (unsigned int order = 0; order < ZONE_BUDDY_ORDERS; order++)
+		TPRINTF(" %" PRIu64, free_blocks[order]);
+	TPRINTF("\n");
+}
+
+const char *test_falloc3(void)
+{
+	uintptr_t *frames = (uintptr_t *)
+	    malloc(MAX_BLOCKS * sizeof(uintptr_t));
+	if (frames == NULL)
+		return "Unable to allocate frames";
+
+	print_free_blocks();
+
+	for (unsigned int order = 0; order <= MAX_ORDER; order++) {
+		size_t count = (size_t) 1 << order;
+		uintptr_t constraint = FRAMES2SIZE(count) - 1;
+
+		TPRINTF("Allocating aligned blocks of %zu frames ... ", count);
+
+		unsigned int allocated = 0;
+		for (unsigned int i = 0; i < MAX_BLOCKS; i++) {
+			frames[allocated] = frame_alloc(count, FRAME_ATOMIC,
+			    constraint);
+			if (frames[allocated] == 0)
+				break;
+
+			if ((frames[allocated] & constraint) != 0) {
+				for (unsigned int j = 0; j <= allocated; j++)
+					frame_free(frames[j], count);
+
+				free(frames);
+				return "Block is not aligned";
+			}
+
+			allocated++;
+		}
+
+		TPRINTF("%u blocks allocated.\n", allocated);
+
+		for (unsigned int i = 0; i < allocated; i++)
+			frame_free(frames[i], count);
+
+		/*
+		 * Blocks which are not a power of two leave a free tail
+		 * in the split block, which has to be returned.
+		 */
+
+		count += (count + 1) / 2;
+
+		TPRINTF("Allocating blocks of %zu frames ... ", count);
+
+		allocated = 0;
+		for (unsigned int i = 0; i < MAX_BLOCKS; i++) {
+			frames[allocated] = frame_alloc(count, FRAME_ATOMIC, 0);
+			if (frames[allocated] == 0)
+				break;
+
+			allocated++;
+		}
+
+		TPRINTF("%u blocks allocated.\n", allocated);
+
+		for (unsigned int i = 0; i < allocated; i++)
+			frame_free(frames[i], count);
+	}
+
+	print_free_blocks();
+
+	free(frames);
+
+	return NULL;
+}
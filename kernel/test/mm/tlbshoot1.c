@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <mm/as.h>
+#include <mm/tlb.h>
+#include <mm/asid.h>
+#include <cpu/cpu_mask.h>
+#include <arch/cycle.h>
+#include <preemption.h>
+#include <config.h>
+#include <cpu.h>
+#include <arch.h>
+#include <typedefs.h>
+
+#define ITERATIONS  1000
+
+/** Measure average latency of TLB shootdown of one page.
+ *
+ * @param as Address space to shoot down or NULL for a global shootdown.
+ *
+ * @return Average number of cycles per shootdown.
+ *
+ */
+static uint64_t shootdown_latency(as_t *as)
+{
+	uint64_t start = get_cycle();
+
+	for (unsigned int i = 0; i < ITERATIONS; i++) {
+		ipl_t ipl;
+
+		/*
+		 * The page at address zero is never mapped and no address
+		 * space uses ASID_INVALID, so the invalidation is harmless.
+		 */
+		if (as)
+			ipl = tlb_shootdown_start_as(as, TLB_INVL_PAGES, 0, 1);
+		else
+			ipl = tlb_shootdown_start(TLB_INVL_PAGES, ASID_INVALID,
+			    0, 1);
+
+		tlb_shootdown_finalize(ipl);
+	}
+
+	return (get_cycle() - start) / ITERATIONS;
+}
+
+const char *test_tlbshoot1(void)
+{
+	as_t *as = as_create(0);
+	if (as == NULL)
+		return "Unable to create address space";
+
+	/* Keep CPU->id stable while building the masks. */
+	preemption_disable();
+
+	TPRINTF("Targeted shootdown:\n");
+
+	for (unsigned int targets = 0; targets < config.cpu_count;
+	    targets++) {
+		/*
+		 * Pretend that the address space is cached by this
+		 * processor and by the given number of others.
+		 */
+		cpu_mask_none(as->cpu_mask);
+		cpu_mask_set(as->cpu_mask, CPU->id);
+
+		unsigned int added = 0;
+		for (unsigned int i = 0; (i < config.cpu_count) &&
+		    (added < targets); i++) {
+			if (i == CPU->id)
+				continue;
+
+			cpu_mask_set(as->cpu_mask, i);
+			added++;
+		}
+
+		TPRINTF("  %u other cpu(s): %" PRIu64 " cycles\n", targets,
+		    shootdown_latency(as));
+	}
+
+	TPRINTF("Global shootdown (%u other cpu(s)): %" PRIu64 " cycles\n",
+	    config.cpu_count - 1, shootdown_latency(NULL));
+
+	preemption_enable();
+
+	as_release(as);
+
+	return NULL;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <time/timeout.h>
+#include <arch/cycle.h>
+#include <atomic.h>
+#include <typedefs.h>
+#include <macros.h>
+#include <stdlib.h>
+
+#define TIMEOUTS  100000
+
+/** Timeouts expire between one minute and one hour from now. */
+#define TIMEOUT_MIN_USEC    60000000
+#define TIMEOUT_RANGE_USEC  3540000000U
+
+/** Count the timeouts which fired before they were unregistered. */
+static void timeout_handler(void *arg)
+{
+	atomic_size_t *fired = (atomic_size_t *) arg;
+	atomic_inc(fired);
+}
+
+const char *test_timeout1(void)
+{
+	timeout_t *timeouts = (timeout_t *) malloc(TIMEOUTS * sizeof(timeout_t));
+	if (timeouts == NULL)
+		return "Unable to allocate timeouts";
+
+	atomic_size_t fired = 0;
+	uint64_t longest = 0;
+	uint32_t seed = 1;
+
+	TPRINTF("Registering %u timeouts ... ", TIMEOUTS);
+
+	uint64_t start = get_cycle();
+	for (unsigned int i = 0; i < TIMEOUTS; i++) {
+		uint64_t before = get_cycle();
+
+		seed = seed * 1103515245 + 12345;
+		timeout_initialize(&timeouts[i]);
+		timeout_register(&timeouts[i],
+		    TIMEOUT_MIN_USEC + seed % TIMEOUT_RANGE_USEC,
+		    timeout_handler, &fired);
+
+		longest = max(longest, get_cycle() - before);
+	}
+
+	TPRINTF("%" PRIu64 " cycles on average, %" PRIu64 " at most\n",
+	    (get_cycle() - start) / TIMEOUTS, longest);
+
+	TPRINTF("Unregistering %u timeouts ... ", TIMEOUTS);
+
+	unsigned int not_found = 0;
+	longest = 0;
+
+	start = get_cycle();
+	for (unsigned int i = 0; i < TIMEOUTS; i++) {
+		/* Cancel in a different order than registered. */
+		unsigned int idx = (i * 7919) % TIMEOUTS;
+		uint64_t before = get_cycle();
+
+		if (!timeout_unregister(&timeouts[idx]))
+			not_found++;
+
+		longest = max(longest, get_cycle() - before);
+	}
+
+	TPRINTF("%" PRIu64 " cycles on average, %" PRIu64 " at most\n",
+	    (get_cycle() - start) / TIMEOUTS, longest);
+
+	free(timeouts);
+
+	if (atomic_load(&fired) > 0)
+		return "Timeouts fired before their deadline";
+
+	if (not_found > 0)
+		return "Timeouts not found when unregistering";
+
+	return NULL;
+}
@@ -47,6 +47,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
@@ -63,6 +64,7 @@
 #include <list>
 #include <locale>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <new>
 #include <numeric>
@@ -79,6 +81,7 @@
 #include <typeindex>
 #include <typeinfo>
 #include <utility>
+#include <valarray>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -87,6 +90,7 @@
 #include <map>
 #include <bitset>
 #include <random>
+#include <regex>
 #include <iomanip>
 #include <system_error>
 #include <stdexcept>
@@ -100,8 +104,26 @@
 
 #include <__bits/trycatch.hpp>
 
-int main()
+static int run_benchmarks()
 {
+    std::test::test_set bs{};
+    bs.add<std::test::hash_bench>();
+    bs.add<std::test::hash_table_bench>();
+    bs.add<std::test::regex_bench>();
+    bs.add<std::test::shared_ptr_bench>();
+    bs.add<std::test::sort_bench>();
+    bs.add<std::test::string_bench>();
+    bs.add<std::test::valarray_bench>();
+    bs.add<std::test::memory_resource_bench>();
+
+    return bs.run(true) ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::strcmp(argv[1], "-b") == 0)
+        return run_benchmarks();
+
     std::test::test_set ts{};
     ts.add<std::test::vector_test>();
     ts.add<std::test::string_test>();
@@ -113,6 +135,7 @@ int main()
     ts.add<std::test::set_test>();
     ts.add<std::test::unordered_map_test>();
     ts.add<std::test::unordered_set_test>();
+    ts.add<std::test::flat_hash_map_test>();
     ts.add<std::test::numeric_test>();
     ts.add<std::test::adaptors_test>();
     ts.add<std::test::memory_test>();
@@ -120,7 +143,12 @@ int main()
     ts.add<std::test::ratio_test>();
     ts.add<std::test::functional_test>();
     ts.add<std::test::algorithm_test>();
+    ts.add<std::test::atomic_test>();
+    ts.add<std::test::mutex_test>();
+    ts.add<std::test::regex_test>();
+    ts.add<std::test::valarray_test>();
     ts.add<std::test::future_test>();
+    ts.add<std::test::memory_resource_test>();
 
     return ts.run(true) ? 0 : 1;
 }
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <adt/hash_table.h>
+#include <inttypes.h>
+#include <perf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../hbench.h"
+
+/*
+ * Fill an empty hash table with 'items' entries (100000 by default) and time
+ * every single insert. Besides the overall throughput, the latency
+ * percentiles of the inserts are printed after each run, so that the
+ * pauses caused by resizing the table show up.
+ */
+
+#define MAX_ITEMS 10000000
+
+/* Latencies are collected into power of two buckets. */
+#define LATENCY_BUCKETS 64
+
+typedef struct {
+	ht_link_t link;
+	size_t key;
+} item_t;
+
+static size_t item_key_hash(const void *key)
+{
+	return *(const size_t *) key;
+}
+
+static size_t item_hash(const ht_link_t *item)
+{
+	return hash_table_get_inst(item, item_t, link)->key;
+}
+
+static bool item_equal(const ht_link_t *a, const ht_link_t *b)
+{
+	return hash_table_get_inst(a, item_t, link)->key ==
+	    hash_table_get_inst(b, item_t, link)->key;
+}
+
+static bool item_key_equal(const void *key, size_t hash, const ht_link_t *item)
+{
+	return *(const size_t *) key == hash_table_get_inst(item, item_t, link)->key;
+}
+
+static const hash_table_ops_t item_ops = {
+	.hash = item_hash,
+	.key_hash = item_key_hash,
+	.key_equal = item_key_equal,
+	.equal = item_equal,
+	.remove_callback = NULL
+};
+
+static unsigned int latency_bucket(nsec_t nanos)
+{
+	unsigned int b = 0;
+
+	while (b < LATENCY_BUCKETS - 1 && nanos >= ((nsec_t) 1 << b))
+		b++;
+
+	return b;
+}
+
+/** Upper bound of the latency of the given fraction of the inserts. */
+static nsec_t latency_percentile(uint64_t *hist, uint64_t total,
+    unsigned int permille)
+{
+	uint64_t limit = (total * permille + 999) / 1000;
+	uint64_t seen = 0;
+
+	for (unsigned int b = 0; b < LATENCY_BUCKETS; b++) {
+		seen += hist[b];
+		if (seen >= limit)
+			return (nsec_t) 1 << b;
+	}
+
+	return (nsec_t) 1 << (LATENCY_BUCKETS - 1);
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *items_str = bench_env_param_get(env, "items", "100000");
+	size_t count;
+
+	int nitem = sscanf(items_str, "%zu", &count);
+	if (nitem < 1 || count == 0 || count > MAX_ITEMS) {
+		return bench_run_fail(run, "'items' must be a number "
+		    "between 1 and %d.", MAX_ITEMS);
+	}
+
+	item_t *items = calloc(count, sizeof(item_t));
+	if (items == NULL)
+		return bench_run_fail(run, "failed to allocate items");
+
+	uint64_t hist[LATENCY_BUCKETS] = { 0 };
+	nsec_t worst = 0;
+	size_t seed = 1;
+
+	for (size_t i = 0; i < count; i++) {
+		seed = seed * 1103515245 + 12345;
+		items[i].key = seed;
+	}
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		hash_table_t table;
+
+		if (!hash_table_create(&table, 0, 0, &item_ops)) {
+			bench_run_stop(run);
+			free(items);
+			return bench_run_fail(run, "failed to create hash table");
+		}
+
+		for (size_t j = 0; j < count; j++) {
+			stopwatch_t sw;
+
+			stopwatch_init(&sw);
+			stopwatch_start(&sw);
+			hash_table_insert(&table, &items[j].link);
+			stopwatch_stop(&sw);
+
+			nsec_t nanos = stopwatch_get_nanos(&sw);
+			hist[latency_bucket(nanos)]++;
+			if (nanos > worst)
+				worst = nanos;
+		}
+
+		hash_table_destroy(&table);
+	}
+	bench_run_stop(run);
+
+	uint64_t total = size * count;
+	printf("Insert latency: p50 <%lld ns, p99 <%lld ns, "
+	    "p99.9 <%lld ns, max %lld ns.\n",
+	    latency_percentile(hist, total, 500),
+	    latency_percentile(hist, total, 990),
+	    latency_percentile(hist, total, 999), worst);
+
+	free(items);
+	return true;
+}
+
+benchmark_t benchmark_hash_insert = {
+	.name = "hash_insert",
+	.desc = "Insert 'items' keys into an empty hash table, "
+	    "report insert latency percentiles.",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
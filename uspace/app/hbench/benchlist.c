@@ -39,17 +39,28 @@
 
 benchmark_t *benchmarks[] = {
 	&benchmark_dir_read,
+	&benchmark_fibril_create,
 	&benchmark_fibril_mutex,
+	&benchmark_fibril_pingpong,
+	&benchmark_fibril_timeout,
 	&benchmark_file_read,
+	&benchmark_hash_insert,
 	&benchmark_rand_read,
 	&benchmark_seq_read,
 	&benchmark_malloc1,
 	&benchmark_malloc2,
+	&benchmark_memcpy,
+	&benchmark_memset,
 	&benchmark_ns_ping,
 	&benchmark_ping_pong,
 	&benchmark_read1k,
+	&benchmark_read_bulk,
+	&benchmark_sort,
+	&benchmark_str_scan,
 	&benchmark_taskgetid,
+	&benchmark_thread_scaling,
 	&benchmark_write1k,
+	&benchmark_write_bulk,
 };
 
 size_t benchmark_count = sizeof(benchmarks) / sizeof(benchmarks[0]);
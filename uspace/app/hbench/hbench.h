@@ -89,6 +89,13 @@ typedef bool (*benchmark_entry_t)(bench_env_t *, bench_run_t *, uint64_t);
  */
 typedef bool (*benchmark_helper_t)(bench_env_t *, bench_run_t *);
 
+/** Workload of a single worker of a parallel benchmark.
+ *
+ * The first argument is used to report errors of the worker and the second
+ * one is the share of the workload size for the worker.
+ */
+typedef bool (*bench_worker_t)(bench_run_t *, uint64_t);
+
 typedef struct {
 	const char *name;
 	const char *desc;
@@ -99,6 +106,8 @@ typedef struct {
 
 extern void bench_run_init(bench_run_t *, char *, size_t);
 extern bool bench_run_fail(bench_run_t *, const char *, ...);
+extern bool bench_run_workers(bench_env_t *, bench_run_t *, uint64_t,
+    const char *, bench_worker_t);
 
 /*
  * We keep the following two functions inline to ensure that we start
@@ -132,17 +141,28 @@ extern size_t benchmark_count;
 
 /* Put your benchmark descriptors here (and also to benchlist.c). */
 extern benchmark_t benchmark_dir_read;
+extern benchmark_t benchmark_fibril_create;
 extern benchmark_t benchmark_fibril_mutex;
+extern benchmark_t benchmark_fibril_pingpong;
+extern benchmark_t benchmark_fibril_timeout;
 extern benchmark_t benchmark_file_read;
+extern benchmark_t benchmark_hash_insert;
 extern benchmark_t benchmark_rand_read;
 extern benchmark_t benchmark_seq_read;
 extern benchmark_t benchmark_malloc1;
 extern benchmark_t benchmark_malloc2;
+extern benchmark_t benchmark_memcpy;
+extern benchmark_t benchmark_memset;
 extern benchmark_t benchmark_ns_ping;
 extern benchmark_t benchmark_ping_pong;
 extern benchmark_t benchmark_read1k;
+extern benchmark_t benchmark_read_bulk;
+extern benchmark_t benchmark_sort;
+extern benchmark_t benchmark_str_scan;
 extern benchmark_t benchmark_taskgetid;
+extern benchmark_t benchmark_thread_scaling;
 extern benchmark_t benchmark_write1k;
+extern benchmark_t benchmark_write_bulk;
 
 #endif
 
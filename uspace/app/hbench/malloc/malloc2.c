@@ -34,10 +34,8 @@
 #include <stdio.h>
 #include "../hbench.h"
 
-static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+static bool worker(bench_run_t *run, uint64_t niter)
 {
-	bench_run_start(run);
-
 	void **p = malloc(niter * sizeof(void *));
 	if (p == NULL) {
 		return bench_run_fail(run, "failed to allocate backend array (%" PRIu64 "B)",
@@ -62,14 +60,18 @@ static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
 
 	free(p);
 
-	bench_run_stop(run);
-
 	return true;
 }
 
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	return bench_run_workers(env, run, niter, "1", worker);
+}
+
 benchmark_t benchmark_malloc2 = {
 	.name = "malloc2",
-	.desc = "User-space memory allocator benchmark, allocate many small blocks",
+	.desc = "User-space memory allocator benchmark, allocate many small blocks "
+	    "(in 'workers' threads or fibrils with mode=fibril)",
 	.entry = &runner,
 	.setup = NULL,
 	.teardown = NULL
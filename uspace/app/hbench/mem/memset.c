@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <mem.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../hbench.h"
+
+/*
+ * Fill a block of 'bytes' bytes (4096 by default) starting 'offset' bytes
+ * (0 by default) off the alignment of the allocation. Run it with several
+ * values of 'bytes' to sweep over block sizes.
+ */
+
+#define MAX_BYTES (16 * 1024 * 1024)
+#define MAX_OFFSET 63
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *bytes_str = bench_env_param_get(env, "bytes", "4096");
+	const char *offset_str = bench_env_param_get(env, "offset", "0");
+	size_t bytes;
+	size_t offset;
+
+	int nitem = sscanf(bytes_str, "%zu", &bytes);
+	if (nitem < 1 || bytes > MAX_BYTES) {
+		return bench_run_fail(run, "'bytes' must be a number "
+		    "between 0 and %d.", MAX_BYTES);
+	}
+
+	nitem = sscanf(offset_str, "%zu", &offset);
+	if (nitem < 1 || offset > MAX_OFFSET) {
+		return bench_run_fail(run, "'offset' must be a number "
+		    "between 0 and %d.", MAX_OFFSET);
+	}
+
+	char *buf = malloc(bytes + MAX_OFFSET + 1);
+	if (buf == NULL)
+		return bench_run_fail(run, "failed to allocate buffer");
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++)
+		memset(buf + offset, (int) i, bytes);
+	bench_run_stop(run);
+
+	free(buf);
+
+	return true;
+}
+
+benchmark_t benchmark_memset = {
+	.name = "memset",
+	.desc = "Fill a block of 'bytes' bytes starting 'offset' bytes off "
+	    "the alignment.",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <gsort.h>
+#include <qsort.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Sort an array of 'count' integers (10000 by default) with 'algo' (gsort
+ * or qsort). The initial order is given by 'order', which is either random,
+ * sorted or reverse.
+ */
+
+#define MAX_COUNT 10000000
+
+static int int_cmp(const void *a, const void *b)
+{
+	int ia = *(const int *) a;
+	int ib = *(const int *) b;
+
+	if (ia == ib)
+		return 0;
+
+	return ia < ib ? -1 : 1;
+}
+
+static int int_gcmp(void *a, void *b, void *arg)
+{
+	return int_cmp(a, b);
+}
+
+static void fill(int *data, size_t count, const char *order)
+{
+	unsigned int seed = 1;
+
+	for (size_t i = 0; i < count; i++) {
+		if (str_cmp(order, "sorted") == 0) {
+			data[i] = i;
+		} else if (str_cmp(order, "reverse") == 0) {
+			data[i] = count - i;
+		} else {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 8;
+		}
+	}
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *count_str = bench_env_param_get(env, "count", "10000");
+	const char *algo = bench_env_param_get(env, "algo", "gsort");
+	const char *order = bench_env_param_get(env, "order", "random");
+	size_t count;
+
+	int nitem = sscanf(count_str, "%zu", &count);
+	if (nitem < 1 || count == 0 || count > MAX_COUNT) {
+		return bench_run_fail(run, "'count' must be a number "
+		    "between 1 and %d.", MAX_COUNT);
+	}
+
+	bool use_gsort = str_cmp(algo, "gsort") == 0;
+	if (!use_gsort && str_cmp(algo, "qsort") != 0)
+		return bench_run_fail(run, "'algo' must be gsort or qsort.");
+
+	if (str_cmp(order, "random") != 0 && str_cmp(order, "sorted") != 0 &&
+	    str_cmp(order, "reverse") != 0) {
+		return bench_run_fail(run, "'order' must be random, sorted "
+		    "or reverse.");
+	}
+
+	int *data = calloc(count, sizeof(int));
+	if (data == NULL)
+		return bench_run_fail(run, "failed to allocate data");
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		fill(data, count, order);
+
+		if (use_gsort) {
+			if (!gsort(data, count, sizeof(int), int_gcmp, NULL)) {
+				bench_run_stop(run);
+				free(data);
+				return bench_run_fail(run, "gsort failed");
+			}
+		} else {
+			qsort(data, count, sizeof(int), int_cmp);
+		}
+	}
+	bench_run_stop(run);
+
+	free(data);
+	return true;
+}
+
+benchmark_t benchmark_sort = {
+	.name = "sort",
+	.desc = "Sort 'count' integers in 'order' (random, sorted, reverse) "
+	    "with 'algo' (gsort or qsort).",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
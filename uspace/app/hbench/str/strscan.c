@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <mem.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Run the common string scanning functions (size, length, comparison,
+ * character and substring search) over a 'bytes' long string (1024 by
+ * default). With text=ascii the string is plain ASCII, with text=utf8 every
+ * fourth character is a two-byte or three-byte UTF-8 sequence.
+ */
+
+#define MAX_BYTES (1024 * 1024)
+
+static const char *fill_ascii[] = { "path", "/", "name", "." };
+static const char *fill_utf8[] = { "cesta", "/", "š", "€", "jméno", "." };
+
+static char *make_text(size_t bytes, bool utf8)
+{
+	const char **fill = utf8 ? fill_utf8 : fill_ascii;
+	size_t nfill = utf8 ? 6 : 4;
+
+	char *text = malloc(bytes + 1);
+	if (text == NULL)
+		return NULL;
+
+	size_t size = 0;
+	for (size_t i = 0; true; i++) {
+		const char *piece = fill[i % nfill];
+		size_t psize = str_size(piece);
+		if (size + psize > bytes)
+			break;
+
+		memcpy(text + size, piece, psize);
+		size += psize;
+	}
+
+	text[size] = '\0';
+	return text;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *bytes_str = bench_env_param_get(env, "bytes", "1024");
+	const char *text_str = bench_env_param_get(env, "text", "ascii");
+	size_t bytes;
+	bool utf8;
+
+	int nitem = sscanf(bytes_str, "%zu", &bytes);
+	if (nitem < 1 || bytes < 16 || bytes > MAX_BYTES) {
+		return bench_run_fail(run, "'bytes' must be a number "
+		    "between 16 and %d.", MAX_BYTES);
+	}
+
+	if (str_cmp(text_str, "ascii") == 0) {
+		utf8 = false;
+	} else if (str_cmp(text_str, "utf8") == 0) {
+		utf8 = true;
+	} else {
+		return bench_run_fail(run, "'text' must be 'ascii' or "
+		    "'utf8'.");
+	}
+
+	char *text = make_text(bytes, utf8);
+	char *copy = make_text(bytes, utf8);
+	if (text == NULL || copy == NULL) {
+		free(text);
+		free(copy);
+		return bench_run_fail(run, "failed to allocate strings");
+	}
+
+	size_t total = 0;
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		total += str_size(text);
+		total += str_length(text);
+		total += str_cmp(text, copy);
+		total += str_chr(text, '#') != NULL;
+		total += str_rchr(text, '/') != NULL;
+		total += str_str(text, "name.path/nomatch") != NULL;
+	}
+	bench_run_stop(run);
+
+	free(text);
+	free(copy);
+
+	if (total == 0)
+		return bench_run_fail(run, "strings are empty");
+
+	return true;
+}
+
+benchmark_t benchmark_str_scan = {
+	.name = "str_scan",
+	.desc = "Measure, compare and search a 'bytes' long string of "
+	    "'text' (ascii or utf8).",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../hbench.h"
+
+/*
+ * Fibril ping-pong benchmark. Pairs of fibrils pass a token back and forth
+ * through a pair of semaphores, so the benchmark measures how fast fibrils
+ * are woken up and switched to. The 'pairs' param sets the number of pairs
+ * (16 by default) and the 'runners' param sets how many extra threads run
+ * the fibrils (3 by default). Runner threads cannot be stopped, so once
+ * spawned, they are reused by the following runs.
+ */
+
+#define MAX_PAIRS 1024
+#define MAX_RUNNERS 64
+
+typedef struct {
+	fibril_semaphore_t ping;
+	fibril_semaphore_t pong;
+	fibril_semaphore_t *done;
+	uint64_t rounds;
+} pair_t;
+
+static int runners_spawned = 0;
+
+static errno_t pinger(void *arg)
+{
+	pair_t *pair = arg;
+
+	for (uint64_t i = 0; i < pair->rounds; i++) {
+		fibril_semaphore_up(&pair->ping);
+		fibril_semaphore_down(&pair->pong);
+	}
+
+	fibril_semaphore_up(pair->done);
+	return EOK;
+}
+
+static errno_t ponger(void *arg)
+{
+	pair_t *pair = arg;
+
+	for (uint64_t i = 0; i < pair->rounds; i++) {
+		fibril_semaphore_down(&pair->ping);
+		fibril_semaphore_up(&pair->pong);
+	}
+
+	fibril_semaphore_up(pair->done);
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *pairs_str = bench_env_param_get(env, "pairs", "16");
+	const char *runners_str = bench_env_param_get(env, "runners", "3");
+	fibril_semaphore_t done;
+	unsigned int pairs;
+	int runners;
+
+	int nitem = sscanf(pairs_str, "%u", &pairs);
+	if (nitem < 1 || pairs == 0 || pairs > MAX_PAIRS) {
+		return bench_run_fail(run, "'pairs' must be a number "
+		    "between 1 and %d.", MAX_PAIRS);
+	}
+
+	nitem = sscanf(runners_str, "%d", &runners);
+	if (nitem < 1 || runners < 0 || runners > MAX_RUNNERS) {
+		return bench_run_fail(run, "'runners' must be a number "
+		    "between 0 and %d.", MAX_RUNNERS);
+	}
+
+	if (runners > runners_spawned) {
+		runners_spawned += fibril_test_spawn_runners(runners -
+		    runners_spawned);
+		if (runners > runners_spawned) {
+			return bench_run_fail(run, "failed to spawn runner "
+			    "%d (out of %d)", runners_spawned + 1, runners);
+		}
+	}
+
+	pair_t *pair = calloc(pairs, sizeof(pair_t));
+	if (pair == NULL)
+		return bench_run_fail(run, "failed to allocate pairs");
+
+	fibril_semaphore_initialize(&done, 0);
+
+	unsigned int started = 0;
+	bench_run_start(run);
+	for (; started < pairs; started++) {
+		pair_t *p = &pair[started];
+
+		fibril_semaphore_initialize(&p->ping, 0);
+		fibril_semaphore_initialize(&p->pong, 0);
+		p->done = &done;
+		p->rounds = size / pairs + (started < size % pairs ? 1 : 0);
+
+		fid_t ping = fibril_create(pinger, p);
+		if (ping == 0)
+			break;
+
+		fid_t pong = fibril_create(ponger, p);
+		if (pong == 0) {
+			fibril_destroy(ping);
+			break;
+		}
+
+		fibril_add_ready(ping);
+		fibril_add_ready(pong);
+	}
+
+	for (unsigned int i = 0; i < 2 * started; i++)
+		fibril_semaphore_down(&done);
+	bench_run_stop(run);
+
+	free(pair);
+
+	if (started < pairs) {
+		return bench_run_fail(run, "failed to create fibrils for "
+		    "pair %u (out of %u)", started, pairs);
+	}
+
+	return true;
+}
+
+benchmark_t benchmark_fibril_pingpong = {
+	.name = "fibril_pingpong",
+	.desc = "Pass a token between pairs of fibrils running on "
+	    "'runners' threads.",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
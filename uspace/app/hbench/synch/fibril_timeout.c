@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../hbench.h"
+
+/*
+ * Fibril timeout benchmark. Each of 'armed' fibrils (1000 by default) keeps
+ * a timeout armed by waiting on its own semaphore with a timeout that never
+ * expires. The benchmark wakes them up one after another, so every wakeup
+ * cancels one timeout and arms a new one while the others stay armed.
+ */
+
+#define MAX_ARMED 100000
+
+/* Long enough not to expire during the benchmark. */
+#define WAIT_TIMEOUT  SEC2USEC(3600)
+
+typedef struct {
+	fibril_semaphore_t ack;
+	fibril_semaphore_t done;
+	volatile bool stop;
+} shared_t;
+
+typedef struct {
+	fibril_semaphore_t wakeup;
+	shared_t *shared;
+} waiter_t;
+
+static errno_t waiter_fn(void *arg)
+{
+	waiter_t *waiter = arg;
+	shared_t *shared = waiter->shared;
+
+	while (true) {
+		errno_t rc = fibril_semaphore_down_timeout(&waiter->wakeup,
+		    WAIT_TIMEOUT);
+		if (shared->stop)
+			break;
+		if (rc == EOK)
+			fibril_semaphore_up(&shared->ack);
+	}
+
+	fibril_semaphore_up(&shared->done);
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *armed_str = bench_env_param_get(env, "armed", "1000");
+	shared_t shared;
+	unsigned int armed;
+
+	int nitem = sscanf(armed_str, "%u", &armed);
+	if (nitem < 1 || armed == 0 || armed > MAX_ARMED) {
+		return bench_run_fail(run, "'armed' must be a number "
+		    "between 1 and %d.", MAX_ARMED);
+	}
+
+	waiter_t *waiter = calloc(armed, sizeof(waiter_t));
+	if (waiter == NULL)
+		return bench_run_fail(run, "failed to allocate waiters");
+
+	fibril_semaphore_initialize(&shared.ack, 0);
+	fibril_semaphore_initialize(&shared.done, 0);
+	shared.stop = false;
+
+	unsigned int started = 0;
+	for (; started < armed; started++) {
+		fibril_semaphore_initialize(&waiter[started].wakeup, 0);
+		waiter[started].shared = &shared;
+
+		fid_t fid = fibril_create(waiter_fn, &waiter[started]);
+		if (fid == 0)
+			break;
+
+		fibril_add_ready(fid);
+	}
+
+	bool ok = started == armed;
+	if (ok) {
+		/* Let all waiters arm their timeouts. */
+		fibril_usleep(1000);
+
+		bench_run_start(run);
+		for (uint64_t i = 0; i < size; i++) {
+			fibril_semaphore_up(&waiter[i % armed].wakeup);
+			fibril_semaphore_down(&shared.ack);
+		}
+		bench_run_stop(run);
+	}
+
+	shared.stop = true;
+	for (unsigned int i = 0; i < started; i++)
+		fibril_semaphore_up(&waiter[i].wakeup);
+	for (unsigned int i = 0; i < started; i++)
+		fibril_semaphore_down(&shared.done);
+
+	free(waiter);
+
+	if (!ok) {
+		return bench_run_fail(run, "failed to create waiter %u "
+		    "(out of %u)", started, armed);
+	}
+
+	return true;
+}
+
+benchmark_t benchmark_fibril_timeout = {
+	.name = "fibril_timeout",
+	.desc = "Cancel and rearm timeouts while 'armed' timeouts are "
+	    "pending.",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdio.h>
+#include "../hbench.h"
+
+/*
+ * Fibril creation benchmark. Creates fibrils that exit right away and
+ * waits for them to finish, which is what async servers do for each
+ * incoming connection. The 'batch' param sets how many fibrils are
+ * alive at the same time (1 by default), use it to see what happens
+ * when there are more of them than stacks kept for reuse.
+ */
+
+#define MAX_BATCH 1024
+
+static errno_t fibril_fn(void *arg)
+{
+	fibril_semaphore_t *done = arg;
+
+	fibril_semaphore_up(done);
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *batch_str = bench_env_param_get(env, "batch", "1");
+	fibril_semaphore_t done;
+	unsigned int batch;
+
+	int nitem = sscanf(batch_str, "%u", &batch);
+	if (nitem < 1 || batch == 0 || batch > MAX_BATCH) {
+		return bench_run_fail(run, "'batch' must be a number "
+		    "between 1 and %d.", MAX_BATCH);
+	}
+
+	fibril_semaphore_initialize(&done, 0);
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i += batch) {
+		unsigned int count = 0;
+
+		for (; count < batch && i + count < size; count++) {
+			fid_t fid = fibril_create(fibril_fn, &done);
+			if (fid == 0) {
+				/* Let the already started fibrils finish. */
+				for (unsigned int j = 0; j < count; j++)
+					fibril_semaphore_down(&done);
+
+				return bench_run_fail(run, "failed to create "
+				    "fibril %" PRIu64 " (out of %" PRIu64 ")",
+				    i + count, size);
+			}
+
+			fibril_add_ready(fid);
+		}
+
+		for (unsigned int j = 0; j < count; j++)
+			fibril_semaphore_down(&done);
+	}
+	bench_run_stop(run);
+
+	return true;
+}
+
+benchmark_t benchmark_fibril_create = {
+	.name = "fibril_create",
+	.desc = "Create fibrils (in batches of 'batch' fibrils) and wait "
+	    "until they exit.",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <stdint.h>
+#include "../hbench.h"
+
+/*
+ * Multi-core scaling benchmark. The workload is split evenly among
+ * the given number of workers (use 'workers' param to alter the default
+ * of 4) that only compute and do not share any data, so the run time
+ * should drop linearly with the number of workers up to the number
+ * of processors. Workers are kernel threads unless the 'mode' param
+ * is set to 'fibril', in which case they share the runner threads
+ * of the task.
+ */
+
+static bool worker(bench_run_t *run, uint64_t iterations)
+{
+	/* Xorshift, so that the compiler cannot fold the loop away. */
+	volatile uint64_t result;
+	uint64_t state = iterations | 1;
+	for (uint64_t i = 0; i < iterations; i++) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+	}
+
+	result = state;
+	(void) result;
+
+	return true;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	return bench_run_workers(env, run, size, "4", worker);
+}
+
+benchmark_t benchmark_thread_scaling = {
+	.name = "thread_scaling",
+	.desc = "Split computation among 'workers' threads (or fibrils "
+	    "with mode=fibril) to measure multi-core scaling.",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
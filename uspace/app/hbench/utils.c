@@ -33,10 +33,27 @@
  * @file
  */
 
+#include <fibril.h>
+#include <fibril_synch.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <str.h>
+#include <str_error.h>
+#include <thread.h>
 #include "hbench.h"
 
+#define MAX_WORKERS 64
+#define WORKER_ERROR_LENGTH 128
+
+typedef struct {
+	fibril_semaphore_t *done;
+	bench_worker_t fn;
+	uint64_t size;
+	bool ok;
+	bench_run_t run;
+	char error[WORKER_ERROR_LENGTH];
+} worker_t;
+
 /** Initialize bench run structure.
  *
  * @param run Structure to intialize.
@@ -75,5 +92,121 @@ bool bench_run_fail(bench_run_t *run, const char *fmt, ...)
 	return false;
 }
 
+static errno_t worker_main(void *arg)
+{
+	worker_t *worker = arg;
+
+	worker->ok = worker->fn(&worker->run, worker->size);
+	fibril_semaphore_up(worker->done);
+
+	return EOK;
+}
+
+/** Run a benchmark workload in parallel.
+ *
+ * The workload is split evenly among the number of workers given by the
+ * 'workers' param. Workers are kernel threads unless the 'mode' param is
+ * set to 'fibril', in which case they share the runner threads of the task.
+ * With a single worker, the workload runs directly in the calling fibril.
+ *
+ * The measured time includes the creation of the workers.
+ *
+ * @param env Benchmark environment.
+ * @param run Current benchmark run.
+ * @param size Size of the whole workload.
+ * @param default_workers Number of workers if the param is not set.
+ * @param fn Workload of a single worker.
+ * @return Whether all workers succeeded.
+ */
+bool bench_run_workers(bench_env_t *env, bench_run_t *run, uint64_t size,
+    const char *default_workers, bench_worker_t fn)
+{
+	const char *workers_str = bench_env_param_get(env, "workers",
+	    default_workers);
+	const char *mode = bench_env_param_get(env, "mode", "thread");
+	worker_t workers[MAX_WORKERS];
+	fibril_semaphore_t done;
+	unsigned int count;
+	bool threads;
+	errno_t rc;
+
+	int nitem = sscanf(workers_str, "%u", &count);
+	if (nitem < 1 || count == 0 || count > MAX_WORKERS) {
+		return bench_run_fail(run, "'workers' must be a number "
+		    "between 1 and %d.", MAX_WORKERS);
+	}
+
+	if (str_cmp(mode, "thread") == 0) {
+		threads = true;
+	} else if (str_cmp(mode, "fibril") == 0) {
+		threads = false;
+	} else {
+		return bench_run_fail(run, "'mode' must be either 'thread' "
+		    "or 'fibril'.");
+	}
+
+	if (count == 1) {
+		bench_run_start(run);
+		bool ok = fn(run, size);
+		bench_run_stop(run);
+
+		return ok;
+	}
+
+	/* Workers block on fibril synchronization across threads. */
+	fibril_enable_multithreaded();
+	fibril_semaphore_initialize(&done, 0);
+
+	for (unsigned int i = 0; i < count; i++) {
+		workers[i].done = &done;
+		workers[i].fn = fn;
+		workers[i].size = size / count;
+		workers[i].ok = false;
+		bench_run_init(&workers[i].run, workers[i].error,
+		    WORKER_ERROR_LENGTH);
+	}
+
+	bench_run_start(run);
+	for (unsigned int i = 0; i < count; i++) {
+		if (threads) {
+			rc = thread_create(worker_main, &workers[i],
+			    "hbench worker", NULL);
+			if (rc != EOK) {
+				/* Let the already started workers finish. */
+				for (unsigned int j = 0; j < i; j++)
+					fibril_semaphore_down(&done);
+
+				return bench_run_fail(run, "failed to create "
+				    "thread: %s", str_error(rc));
+			}
+		} else {
+			fid_t fid = fibril_create(worker_main, &workers[i]);
+			if (fid == 0) {
+				for (unsigned int j = 0; j < i; j++)
+					fibril_semaphore_down(&done);
+
+				return bench_run_fail(run, "failed to create "
+				    "fibril");
+			}
+
+			fibril_detach(fid);
+			fibril_add_ready(fid);
+		}
+	}
+
+	for (unsigned int i = 0; i < count; i++)
+		fibril_semaphore_down(&done);
+	bench_run_stop(run);
+
+	for (unsigned int i = 0; i < count; i++) {
+		if (!workers[i].ok) {
+			return bench_run_fail(run, "worker %u: %s", i,
+			    workers[i].error);
+		}
+	}
+
+	return true;
+}
+
 /** @}
  */
@@ -60,6 +60,8 @@ typedef enum {
 	LIST_IPCCS,
 	LIST_CPUS,
 	PRINT_LOAD,
+	PRINT_MEMORY,
+	LIST_SLABS,
 	PRINT_UPTIME,
 	PRINT_ARCH
 } output_toggle_t;
@@ -217,6 +219,61 @@ static void print_load(void)
 	free(load);
 }
 
+static void print_memory(void)
+{
+	stats_physmem_t *physmem = stats_get_physmem();
+
+	if (physmem == NULL) {
+		fprintf(stderr, "%s: Unable to get physical memory statistics\n",
+		    NAME);
+		return;
+	}
+
+	uint64_t total, unavail, used, free_mem;
+	const char *total_suffix, *unavail_suffix, *used_suffix, *free_suffix;
+
+	bin_order_suffix(physmem->total, &total, &total_suffix, false);
+	bin_order_suffix(physmem->unavail, &unavail, &unavail_suffix, false);
+	bin_order_suffix(physmem->used, &used, &used_suffix, false);
+	bin_order_suffix(physmem->free, &free_mem, &free_suffix, false);
+
+	printf("%s: Memory: %" PRIu64 "%s total, %" PRIu64 "%s unavail, %"
+	    PRIu64 "%s used, %" PRIu64 "%s free\n", NAME, total, total_suffix,
+	    unavail, unavail_suffix, used, used_suffix, free_mem, free_suffix);
+
+	printf("[order] [free blocks]\n");
+
+	for (unsigned int order = 0; order < STATS_PHYSMEM_ORDERS; order++)
+		printf("%7u %13" PRIu64 "\n", order, physmem->free_blocks[order]);
+
+	free(physmem);
+}
+
+static void list_slabs(void)
+{
+	size_t count;
+	stats_slab_t *slabs = stats_get_slabs(&count);
+
+	if (slabs == NULL) {
+		fprintf(stderr, "%s: Unable to get slab cache statistics\n",
+		    NAME);
+		return;
+	}
+
+	printf("[cache name      ] [size  ] [colors] [alloc   ] [mag]"
+	    " [hits      ] [misses    ] [contention]\n");
+
+	for (size_t i = 0; i < count; i++) {
+		printf("%-18s %8" PRIu64 " %8" PRIu64 " %10" PRIu64 " %5" PRIu64
+		    " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+		    slabs[i].name, slabs[i].size, slabs[i].colors,
+		    slabs[i].allocated, slabs[i].magazine_size, slabs[i].hits,
+		    slabs[i].misses, slabs[i].contention);
+	}
+
+	free(slabs);
+}
+
 static void print_uptime(void)
 {
 	struct timespec uptime;
@@ -367,7 +424,7 @@ static void print_arch(void)
 static void usage(const char *name)
 {
 	printf(
-	    "Usage: %s [-t task_id] [-i task_id] [-at] [-ai] [-c] [-l] [-u] [-d]\n"
+	    "Usage: %s [-t task_id] [-i task_id] [-at] [-ai] [-c] [-l] [-m] [-s] [-u] [-d]\n"
 	    "\n"
 	    "Options:\n"
 	    "\t-t task_id | --task=task_id\n"
@@ -388,6 +445,12 @@ static void usage(const char *name)
 	    "\t-l | --load\n"
 	    "\t\tPrint system load\n"
 	    "\n"
+	    "\t-m | --memory\n"
+	    "\t\tPrint physical memory usage and free blocks by order\n"
+	    "\n"
+	    "\t-s | --slabs\n"
+	    "\t\tList kernel slab caches\n"
+	    "\n"
 	    "\t-u | --uptime\n"
 	    "\t\tPrint system uptime\n"
 	    "\n"
@@ -474,6 +537,18 @@ int main(int argc, char *argv[])
 			continue;
 		}
 
+		/* Memory */
+		if ((off = arg_parse_short_long(argv[i], "-m", "--memory")) != -1) {
+			output_toggle = PRINT_MEMORY;
+			continue;
+		}
+
+		/* Slab caches */
+		if ((off = arg_parse_short_long(argv[i], "-s", "--slabs")) != -1) {
+			output_toggle = LIST_SLABS;
+			continue;
+		}
+
 		/* Uptime */
 		if ((off = arg_parse_short_long(argv[i], "-u", "--uptime")) != -1) {
 			output_toggle = PRINT_UPTIME;
@@ -503,6 +578,12 @@ int main(int argc, char *argv[])
 	case PRINT_LOAD:
 		print_load();
 		break;
+	case PRINT_MEMORY:
+		print_memory();
+		break;
+	case LIST_SLABS:
+		list_slabs();
+		break;
 	case PRINT_UPTIME:
 		print_uptime();
 		break;
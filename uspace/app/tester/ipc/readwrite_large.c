@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <mem.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ipc_test.h>
+#include "../tester.h"
+
+enum {
+	/** Large enough for the kernel to pin the buffer instead of copying */
+	rw_buf_size = 1024 * 1024 + 17,
+	/** Make the buffer start in the middle of a page */
+	rw_buf_offset = 123
+};
+
+const char *test_readwrite_large(void)
+{
+	ipc_test_t *test = NULL;
+	uint8_t *buf;
+	uint8_t *rw_buf;
+	size_t i;
+	errno_t rc;
+
+	buf = malloc(rw_buf_size + rw_buf_offset);
+	if (buf == NULL)
+		return "Out of memory.";
+
+	rw_buf = buf + rw_buf_offset;
+
+	rc = ipc_test_create(&test);
+	if (rc != EOK) {
+		free(buf);
+		return "Error contacting IPC test service.";
+	}
+
+	rc = ipc_test_set_rw_buf_size(test, rw_buf_size);
+	if (rc != EOK) {
+		ipc_test_destroy(test);
+		free(buf);
+		return "Error setting read/write buffer size.";
+	}
+
+	/*
+	 * Write a pattern to remote buffer
+	 */
+	for (i = 0; i < rw_buf_size; i++)
+		rw_buf[i] = (uint8_t) (i * 7 + i / 4096);
+
+	rc = ipc_test_write(test, rw_buf, rw_buf_size);
+	if (rc != EOK) {
+		ipc_test_destroy(test);
+		free(buf);
+		return "Error writing remote buffer.";
+	}
+
+	TPRINTF("Successfully wrote %zu bytes to remote buffer.\n",
+	    (size_t) rw_buf_size);
+
+	/*
+	 * Read back contents of remote buffer and verify
+	 */
+	memset(rw_buf, 0, rw_buf_size);
+	rc = ipc_test_read(test, rw_buf, rw_buf_size);
+	if (rc != EOK) {
+		ipc_test_destroy(test);
+		free(buf);
+		return "Error reading remote buffer.";
+	}
+
+	TPRINTF("Successfully read back remote buffer.\n");
+
+	for (i = 0; i < rw_buf_size; i++) {
+		if (rw_buf[i] != (uint8_t) (i * 7 + i / 4096)) {
+			ipc_test_destroy(test);
+			free(buf);
+			return "Failed verification of read data.";
+		}
+	}
+
+	TPRINTF("Read data succeeded verification.\n");
+
+	ipc_test_destroy(test);
+	free(buf);
+	return NULL;
+}
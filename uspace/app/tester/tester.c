@@ -70,6 +70,7 @@ test_t tests[] = {
 #include "float/float2.def"
 #include "vfs/vfs1.def"
 #include "ipc/readwrite.def"
+#include "ipc/readwrite_large.def"
 #include "ipc/sharein.def"
 #include "ipc/starve.def"
 #include "loop/loop1.def"
@@ -101,6 +101,7 @@ extern const char *test_float2(void);
 extern const char *test_vfs1(void);
 extern const char *test_ping_pong(void);
 extern const char *test_readwrite(void);
+extern const char *test_readwrite_large(void);
 extern const char *test_sharein(void);
 extern const char *test_starve_ipc(void);
 extern const char *test_loop1(void);
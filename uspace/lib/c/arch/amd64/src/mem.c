@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file Memory block operations using SSE2 and enhanced rep movsb/stosb.
+ *
+ * SSE2 is part of the amd64 baseline, so it is used unconditionally. Whether
+ * the CPU implements enhanced rep movsb/stosb (ERMS) is detected at run time
+ * on first use.
+ */
+
+#include <mem.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../../../generic/private/cc.h"
+
+#undef memset
+#undef memcpy
+#undef memcmp
+#undef memmove
+#undef memchr
+
+/** Blocks at least this long are handled by rep movsb/stosb if ERMS. */
+#define ERMS_THRESHOLD  2048
+
+#define CPUID_ERMS  (1 << 9)
+
+#define MEM_FEATURES_VALID  (1 << 0)
+#define MEM_FEATURES_ERMS   (1 << 1)
+
+typedef uint8_t vec_t __attribute__((vector_size(16), aligned(1), may_alias));
+typedef char vec_mask_t __attribute__((vector_size(16)));
+typedef uint64_t u64_t __attribute__((aligned(1), may_alias));
+typedef uint32_t u32_t __attribute__((aligned(1), may_alias));
+
+/** CPU features, detected lazily. */
+static atomic_uint mem_features;
+
+static unsigned int mem_features_get(void)
+{
+	unsigned int features = atomic_load_explicit(&mem_features,
+	    memory_order_relaxed);
+	if (features != 0)
+		return features;
+
+	uint32_t eax, ebx, ecx, edx;
+
+	features = MEM_FEATURES_VALID;
+
+	asm volatile (
+	    "cpuid\n"
+	    : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+	    : "a" (0), "c" (0)
+	);
+
+	if (eax >= 7) {
+		asm volatile (
+		    "cpuid\n"
+		    : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+		    : "a" (7), "c" (0)
+		);
+
+		if (ebx & CPUID_ERMS)
+			features |= MEM_FEATURES_ERMS;
+	}
+
+	atomic_store_explicit(&mem_features, features, memory_order_relaxed);
+	return features;
+}
+
+static inline vec_t vec_load(const uint8_t *src)
+{
+	return *(const vec_t *) src;
+}
+
+static inline void vec_store(uint8_t *dst, vec_t val)
+{
+	*(vec_t *) dst = val;
+}
+
+static inline unsigned int vec_eq_mask(vec_t a, vec_t b)
+{
+	return __builtin_ia32_pmovmskb128((vec_mask_t) (a == b));
+}
+
+/** Copy less than 16 bytes.
+ *
+ * All bytes are loaded before any is stored, so the blocks may overlap.
+ */
+static inline void copy_small(uint8_t *dst, const uint8_t *src, size_t n)
+{
+	if (n >= 8) {
+		uint64_t a = *(const u64_t *) src;
+		uint64_t b = *(const u64_t *) (src + n - 8);
+		*(u64_t *) dst = a;
+		*(u64_t *) (dst + n - 8) = b;
+	} else if (n >= 4) {
+		uint32_t a = *(const u32_t *) src;
+		uint32_t b = *(const u32_t *) (src + n - 4);
+		*(u32_t *) dst = a;
+		*(u32_t *) (dst + n - 4) = b;
+	} else if (n > 0) {
+		uint8_t a = src[0];
+		uint8_t b = src[n / 2];
+		uint8_t c = src[n - 1];
+		dst[0] = a;
+		dst[n / 2] = b;
+		dst[n - 1] = c;
+	}
+}
+
+/** Copy at least 16 bytes from lower to higher addresses.
+ *
+ * The stores are aligned. The blocks may overlap if @a dst is below @a src.
+ */
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+static void copy_forward(uint8_t *dst, const uint8_t *src, size_t n)
+{
+	vec_t head = vec_load(src);
+	vec_t tail = vec_load(src + n - 16);
+
+	if (n > 32) {
+		size_t off = 16 - ((uintptr_t) dst & 15);
+
+		while (n - off > 64) {
+			vec_t a = vec_load(src + off);
+			vec_t b = vec_load(src + off + 16);
+			vec_t c = vec_load(src + off + 32);
+			vec_t d = vec_load(src + off + 48);
+			vec_store(dst + off, a);
+			vec_store(dst + off + 16, b);
+			vec_store(dst + off + 32, c);
+			vec_store(dst + off + 48, d);
+			off += 64;
+		}
+
+		while (n - off > 16) {
+			vec_store(dst + off, vec_load(src + off));
+			off += 16;
+		}
+	}
+
+	vec_store(dst, head);
+	vec_store(dst + n - 16, tail);
+}
+
+/** Copy at least 16 bytes from higher to lower addresses.
+ *
+ * The stores are aligned. The blocks may overlap if @a dst is above @a src.
+ */
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+static void copy_backward(uint8_t *dst, const uint8_t *src, size_t n)
+{
+	vec_t head = vec_load(src);
+	vec_t tail = vec_load(src + n - 16);
+
+	if (n > 32) {
+		size_t off = n - ((uintptr_t) (dst + n) & 15);
+		if (off == n)
+			off -= 16;
+
+		while (off > 64) {
+			vec_t a = vec_load(src + off - 16);
+			vec_t b = vec_load(src + off - 32);
+			vec_t c = vec_load(src + off - 48);
+			vec_t d = vec_load(src + off - 64);
+			vec_store(dst + off - 16, a);
+			vec_store(dst + off - 32, b);
+			vec_store(dst + off - 48, c);
+			vec_store(dst + off - 64, d);
+			off -= 64;
+		}
+
+		while (off > 16) {
+			vec_store(dst + off - 16, vec_load(src + off - 16));
+			off -= 16;
+		}
+	}
+
+	vec_store(dst + n - 16, tail);
+	vec_store(dst, head);
+}
+
+/** Fill memory block with a constant value. */
+DO_NOT_DISCARD
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+void *memset(void *dest, int b, size_t n)
+{
+	uint8_t *dst = dest;
+
+	if (n < 16) {
+		uint64_t pattern = (uint8_t) b * UINT64_C(0x0101010101010101);
+
+		if (n >= 8) {
+			*(u64_t *) dst = pattern;
+			*(u64_t *) (dst + n - 8) = pattern;
+		} else if (n >= 4) {
+			*(u32_t *) dst = pattern;
+			*(u32_t *) (dst + n - 4) = pattern;
+		} else {
+			while (n-- != 0)
+				*dst++ = b;
+		}
+
+		return dest;
+	}
+
+	if (n >= ERMS_THRESHOLD && (mem_features_get() & MEM_FEATURES_ERMS)) {
+		asm volatile (
+		    "rep stosb\n"
+		    : "+D" (dst), "+c" (n)
+		    : "a" (b)
+		    : "memory"
+		);
+
+		return dest;
+	}
+
+	vec_t pattern = (vec_t) { 0 } + (uint8_t) b;
+
+	vec_store(dst, pattern);
+	for (size_t off = 16 - ((uintptr_t) dst & 15); n - off > 16; off += 16)
+		vec_store(dst + off, pattern);
+	vec_store(dst + n - 16, pattern);
+
+	return dest;
+}
+
+/** Copy memory block. */
+DO_NOT_DISCARD
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+void *memcpy(void *dst, const void *src, size_t n)
+{
+	if (n < 16) {
+		copy_small(dst, src, n);
+		return dst;
+	}
+
+	if (n >= ERMS_THRESHOLD && (mem_features_get() & MEM_FEATURES_ERMS)) {
+		void *d = dst;
+
+		asm volatile (
+		    "rep movsb\n"
+		    : "+D" (d), "+S" (src), "+c" (n)
+		    :
+		    : "memory"
+		);
+
+		return dst;
+	}
+
+	copy_forward(dst, src, n);
+	return dst;
+}
+
+/** Move memory block with possible overlapping. */
+DO_NOT_DISCARD
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+void *memmove(void *dst, const void *src, size_t n)
+{
+	/* Nothing to do? */
+	if (src == dst)
+		return dst;
+
+	/* Non-overlapping? */
+	if ((uintptr_t) dst - (uintptr_t) src >= n &&
+	    (uintptr_t) src - (uintptr_t) dst >= n)
+		return memcpy(dst, src, n);
+
+	if (n < 16)
+		copy_small(dst, src, n);
+	else if (dst < src)
+		copy_forward(dst, src, n);
+	else
+		copy_backward(dst, src, n);
+
+	return dst;
+}
+
+/** Compare two memory areas.
+ *
+ * @param s1  Pointer to the first area to compare.
+ * @param s2  Pointer to the second area to compare.
+ * @param len Size of the areas in bytes.
+ *
+ * @return Zero if areas have the same contents. If they differ,
+ *	   the sign of the result is the same as the sign of the
+ *	   difference of the first pair of different bytes.
+ *
+ */
+DO_NOT_DISCARD
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+int memcmp(const void *s1, const void *s2, size_t len)
+{
+	const uint8_t *u1 = s1;
+	const uint8_t *u2 = s2;
+	size_t i = 0;
+
+	for (; len - i >= 16; i += 16) {
+		unsigned int mask = vec_eq_mask(vec_load(u1 + i),
+		    vec_load(u2 + i));
+		if (mask != 0xffff) {
+			i += __builtin_ctz(~mask);
+			return (int) u1[i] - (int) u2[i];
+		}
+	}
+
+	for (; i < len; i++) {
+		if (u1[i] != u2[i])
+			return (int) u1[i] - (int) u2[i];
+	}
+
+	return 0;
+}
+
+/** Search memory area.
+ *
+ * @param s Memory area
+ * @param c Character (byte) to search for
+ * @param n Size of memory area in bytes
+ *
+ * @return Pointer to the first occurrence of @a c in the first @a n
+ *         bytes of @a s or @c NULL if not found.
+ */
+DO_NOT_DISCARD
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+void *memchr(const void *s, int c, size_t n)
+{
+	const uint8_t *u = s;
+	uint8_t uc = (uint8_t) c;
+	size_t i = 0;
+
+	if (n >= 16) {
+		vec_t needle = (vec_t) { 0 } + uc;
+
+		for (; n - i >= 16; i += 16) {
+			unsigned int mask = vec_eq_mask(vec_load(u + i), needle);
+			if (mask != 0)
+				return (void *) &u[i + __builtin_ctz(mask)];
+		}
+	}
+
+	for (; i < n; i++) {
+		if (u[i] == uc)
+			return (void *) &u[i];
+	}
+
+	return NULL;
+}
+
+/** @}
+ */
@@ -1316,6 +1316,9 @@ errno_t async_share_out_finalize(ipc_call_t *call, void **dst)
  *
  * So far, this wrapper is to be used from within a connection fibril.
  *
+ * Requests for more than DATA_XFER_LIMIT bytes are refused, use
+ * async_data_read_receive_max() to accept them.
+ *
  * @param call Storage for the data of the IPC_M_DATA_READ.
  * @param size Storage for the maximum size. Can be NULL.
  *
@@ -1323,6 +1326,25 @@ errno_t async_share_out_finalize(ipc_call_t *call, void **dst)
  *
  */
 bool async_data_read_receive(ipc_call_t *call, size_t *size)
+{
+	return async_data_read_receive_max(call, size, DATA_XFER_LIMIT);
+}
+
+/** Wrapper for receiving the IPC_M_DATA_READ calls of a limited size.
+ *
+ * Like async_data_read_receive(), but the recipient chooses the largest
+ * request it is prepared to answer, up to DATA_XFER_PIN_LIMIT.
+ *
+ * @param call Storage for the data of the IPC_M_DATA_READ.
+ * @param size Storage for the maximum size. Can be NULL.
+ * @param max  Largest size of the request to accept.
+ *
+ * @return True on success, false on failure or if the request
+ *         is larger than @a max. The call has to be answered
+ *         in both cases.
+ *
+ */
+bool async_data_read_receive_max(ipc_call_t *call, size_t *size, size_t max)
 {
 	assert(call);
 
@@ -1331,6 +1353,9 @@ bool async_data_read_receive(ipc_call_t *call, size_t *size)
 	if (ipc_get_imethod(call) != IPC_M_DATA_READ)
 		return false;
 
+	if ((size_t) ipc_get_arg2(call) > max)
+		return false;
+
 	if (size)
 		*size = (size_t) ipc_get_arg2(call);
 
@@ -1372,8 +1397,9 @@ static errno_t async_data_read_forward_fast(async_exch_t *exch, sysarg_t imethod
 	if (exch == NULL)
 		return ENOENT;
 
+	/* The final recipient of the request limits its size. */
 	ipc_call_t call;
-	if (!async_data_read_receive(&call, NULL)) {
+	if (!async_data_read_receive_max(&call, NULL, DATA_XFER_PIN_LIMIT)) {
 		async_answer_0(&call, EINVAL);
 		return EINVAL;
 	}
@@ -1475,6 +1501,9 @@ errno_t async_data_read_forward_4_1(async_exch_t *exch, sysarg_t imethod,
  *
  * So far, this wrapper is to be used from within a connection fibril.
  *
+ * Requests for more than DATA_XFER_LIMIT bytes are refused, use
+ * async_data_write_receive_max() to accept them.
+ *
  * @param call Storage for the data of the IPC_M_DATA_WRITE.
  * @param size Storage for the suggested size. May be NULL.
  *
@@ -1482,6 +1511,25 @@ errno_t async_data_read_forward_4_1(async_exch_t *exch, sysarg_t imethod,
  *
  */
 bool async_data_write_receive(ipc_call_t *call, size_t *size)
+{
+	return async_data_write_receive_max(call, size, DATA_XFER_LIMIT);
+}
+
+/** Wrapper for receiving the IPC_M_DATA_WRITE calls of a limited size.
+ *
+ * Like async_data_write_receive(), but the recipient chooses the largest
+ * request it is prepared to accept, up to DATA_XFER_PIN_LIMIT.
+ *
+ * @param call Storage for the data of the IPC_M_DATA_WRITE.
+ * @param size Storage for the suggested size. May be NULL.
+ * @param max  Largest size of the request to accept.
+ *
+ * @return True on success, false on failure or if the request
+ *         is larger than @a max. The call has to be answered
+ *         in both cases.
+ *
+ */
+bool async_data_write_receive_max(ipc_call_t *call, size_t *size, size_t max)
 {
 	assert(call);
 
@@ -1490,6 +1538,9 @@ bool async_data_write_receive(ipc_call_t *call, size_t *size)
 	if (ipc_get_imethod(call) != IPC_M_DATA_WRITE)
 		return false;
 
+	if ((size_t) ipc_get_arg2(call) > max)
+		return false;
+
 	if (size)
 		*size = (size_t) ipc_get_arg2(call);
 
@@ -1529,7 +1580,7 @@ errno_t async_data_write_finalize(ipc_call_t *call, void *dst, size_t size)
  *                   raw transmitted data.
  * @param min_size   Minimum size (in bytes) of the data to receive.
  * @param max_size   Maximum size (in bytes) of the data to receive. 0 means
- *                   no limit.
+ *                   DATA_XFER_LIMIT.
  * @param granulariy If non-zero then the size of the received data has to
  *                   be divisible by this value.
  * @param received   If not NULL, the size of the received data is stored here.
@@ -1545,7 +1596,8 @@ errno_t async_data_write_accept(void **data, const bool nullterm,
 
 	ipc_call_t call;
 	size_t size;
-	if (!async_data_write_receive(&call, &size)) {
+	if (!async_data_write_receive_max(&call, &size,
+	    (max_size > 0) ? max_size : DATA_XFER_LIMIT)) {
 		async_answer_0(&call, EINVAL);
 		return EINVAL;
 	}
@@ -1555,11 +1607,6 @@ errno_t async_data_write_accept(void **data, const bool nullterm,
 		return EINVAL;
 	}
 
-	if ((max_size > 0) && (size > max_size)) {
-		async_answer_0(&call, EINVAL);
-		return EINVAL;
-	}
-
 	if ((granularity > 0) && ((size % granularity) != 0)) {
 		async_answer_0(&call, EINVAL);
 		return EINVAL;
@@ -1617,8 +1664,9 @@ static errno_t async_data_write_forward_fast(async_exch_t *exch,
 	if (exch == NULL)
 		return ENOENT;
 
+	/* The final recipient of the request limits its size. */
 	ipc_call_t call;
-	if (!async_data_write_receive(&call, NULL)) {
+	if (!async_data_write_receive_max(&call, NULL, DATA_XFER_PIN_LIMIT)) {
 		async_answer_0(&call, EINVAL);
 		return EINVAL;
 	}
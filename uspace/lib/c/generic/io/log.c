@@ -31,14 +31,17 @@
  * @{
  */
 
+#include <as.h>
 #include <assert.h>
 #include <errno.h>
 #include <fibril_synch.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <async.h>
 #include <io/log.h>
+#include <io/logger_ring.h>
 #include <ipc/logger.h>
 #include <str.h>
 #include <ns.h>
@@ -63,6 +66,16 @@ static const char *log_level_names[] = {
 /** IPC session with the logger service. */
 static async_sess_t *logger_session;
 
+/** Ring buffer shared with the logger, NULL if not available. */
+static logger_ring_t *log_ring;
+
+/** Serializes writers of log_ring and log_ids. */
+static FIBRIL_MUTEX_INITIALIZE(log_ring_guard);
+
+/** Ids of logs we created, by their index in log_ring->levels. */
+static log_t log_ids[LOGGER_MAX_LOGS];
+static atomic_size_t log_ids_count;
+
 /** Maximum length of a single log message (in bytes). */
 #define MESSAGE_BUFFER_SIZE 4096
 
@@ -83,9 +96,6 @@ static errno_t logger_message(async_sess_t *session, log_t log, log_level_t leve
 	if (log == LOG_DEFAULT)
 		log = default_log_id;
 
-	// FIXME: remove when all USB drivers use libc logging explicitly
-	str_rtrim(message, '\n');
-
 	aid_t reg_msg = async_send_2(exchange, LOGGER_WRITER_MESSAGE,
 	    log, level, NULL);
 	errno_t rc = async_data_write_start(exchange, message, str_size(message));
@@ -108,6 +118,119 @@ static errno_t logger_message(async_sess_t *session, log_t log, log_level_t leve
 	return reg_msg_rc;
 }
 
+/** Ask the logger to write out messages from the ring buffer.
+ *
+ * @param wait Wait until the logger is done.
+ * @return Error code.
+ */
+static errno_t log_ring_flush(bool wait)
+{
+	async_exch_t *exchange = async_exchange_begin(logger_session);
+	if (exchange == NULL)
+		return ENOMEM;
+
+	errno_t rc = EOK;
+	if (wait)
+		rc = async_req_0_0(exchange, LOGGER_WRITER_FLUSH);
+	else
+		async_msg_0(exchange, LOGGER_WRITER_FLUSH);
+
+	async_exchange_end(exchange);
+	return rc;
+}
+
+/** Append message to the ring buffer shared with the logger.
+ *
+ * Waits for the logger if the buffer is full.
+ *
+ * @param log Log to use.
+ * @param level Verbosity level of the message.
+ * @param message The actual message.
+ * @return Error code, the message was not sent unless EOK.
+ */
+static errno_t log_ring_write(log_t log, log_level_t level, const char *message)
+{
+	fibril_mutex_lock(&log_ring_guard);
+
+	errno_t rc = logger_ring_append(log_ring, log, level, message);
+	if (rc == EBUSY) {
+		/* Full, wait for the logger to catch up. */
+		rc = log_ring_flush(true);
+		if (rc == EOK)
+			rc = logger_ring_append(log_ring, log, level, message);
+	}
+
+	if (rc != EOK) {
+		fibril_mutex_unlock(&log_ring_guard);
+		return rc;
+	}
+
+	bool notify = atomic_exchange(&log_ring->armed, false);
+
+	fibril_mutex_unlock(&log_ring_guard);
+
+	if (notify)
+		(void) log_ring_flush(false);
+
+	return EOK;
+}
+
+/** Check whether the logger would discard a message.
+ *
+ * @param log Log to use.
+ * @param level Verbosity level of the message.
+ * @return @c false if the message would be discarded.
+ */
+static bool log_level_enabled(log_t log, log_level_t level)
+{
+	if (log_ring == NULL)
+		return true;
+
+	size_t count = atomic_load_explicit(&log_ids_count,
+	    memory_order_acquire);
+	for (size_t i = 0; i < count; i++) {
+		if (log_ids[i] == log) {
+			return level <= atomic_load_explicit(&log_ring->levels[i],
+			    memory_order_relaxed);
+		}
+	}
+
+	return true;
+}
+
+/** Set up the ring buffer shared with the logger.
+ *
+ * If this fails, messages are sent to the logger one by one.
+ */
+static void log_ring_init(void)
+{
+	logger_ring_t *ring = as_area_create(AS_AREA_ANY, LOGGER_RING_SIZE,
+	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE, AS_AREA_UNPAGED);
+	if (ring == AS_MAP_FAILED)
+		return;
+
+	async_exch_t *exchange = async_exchange_begin(logger_session);
+	if (exchange == NULL) {
+		as_area_destroy(ring);
+		return;
+	}
+
+	aid_t reg_msg = async_send_0(exchange, LOGGER_WRITER_SET_RING, NULL);
+	errno_t rc = async_share_out_start(exchange, ring,
+	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE);
+	errno_t reg_msg_rc;
+	async_wait_for(reg_msg, &reg_msg_rc);
+
+	async_exchange_end(exchange);
+
+	if ((rc != EOK) || (reg_msg_rc != EOK)) {
+		as_area_destroy(ring);
+		return;
+	}
+
+	log_ring = ring;
+}
+
 /** Get name of the log level.
  *
  * @param level The log level.
@@ -172,6 +295,8 @@ errno_t log_init(const char *prog_name)
 	if (logger_session == NULL)
 		return rc;
 
+	log_ring_init();
+
 	default_log_id = log_create(prog_name, LOG_NO_PARENT);
 
 	return EOK;
@@ -207,7 +332,22 @@ log_t log_create(const char *name, log_t parent)
 	if ((rc != EOK) || (reg_msg_rc != EOK))
 		return parent;
 
-	return ipc_get_arg1(&answer);
+	log_t log = ipc_get_arg1(&answer);
+	size_t idx = ipc_get_arg2(&answer);
+
+	/* Remember where the logger publishes the level of the log. */
+	if (idx < LOGGER_MAX_LOGS) {
+		fibril_mutex_lock(&log_ring_guard);
+		log_ids[idx] = log;
+		if (idx >= atomic_load_explicit(&log_ids_count,
+		    memory_order_relaxed)) {
+			atomic_store_explicit(&log_ids_count, idx + 1,
+			    memory_order_release);
+		}
+		fibril_mutex_unlock(&log_ring_guard);
+	}
+
+	return log;
 }
 
 /** Write an entry to the log.
@@ -239,12 +379,26 @@ void log_msgv(log_t ctx, log_level_t level, const char *fmt, va_list args)
 {
 	assert(level < LVL_LIMIT);
 
+	if (ctx == LOG_DEFAULT)
+		ctx = default_log_id;
+
+	/* Do not even format messages the logger would discard. */
+	if (!log_level_enabled(ctx, level))
+		return;
+
 	char *message_buffer = malloc(MESSAGE_BUFFER_SIZE);
 	if (message_buffer == NULL)
 		return;
 
 	vsnprintf(message_buffer, MESSAGE_BUFFER_SIZE, fmt, args);
-	logger_message(logger_session, ctx, level, message_buffer);
+
+	// FIXME: remove when all USB drivers use libc logging explicitly
+	str_rtrim(message_buffer, '\n');
+
+	if ((log_ring == NULL) ||
+	    (log_ring_write(ctx, level, message_buffer) != EOK))
+		logger_message(logger_session, ctx, level, message_buffer);
+
 	free(message_buffer);
 }
 
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file Ring buffer shared by a client with the logger.
+ */
+
+#include <align.h>
+#include <assert.h>
+#include <io/logger_ring.h>
+#include <mem.h>
+#include <stdatomic.h>
+#include <str.h>
+
+static_assert((LOGGER_RING_DATA_SIZE & (LOGGER_RING_DATA_SIZE - 1)) == 0,
+    "LOGGER_RING_DATA_SIZE must be a power of two");
+static_assert(LOGGER_RING_DATA_SIZE % LOGGER_RING_ALIGN == 0, "");
+
+/** Append a record to the ring buffer.
+ *
+ * The caller must serialize appends to the same ring.
+ *
+ * @param ring Ring buffer.
+ * @param log Log id.
+ * @param level Message severity level.
+ * @param message The message.
+ * @return EOK on success, ELIMIT if the message can never fit in the ring
+ *         or EBUSY if there is not enough free space in the ring now.
+ */
+errno_t logger_ring_append(logger_ring_t *ring, sysarg_t log, uint32_t level,
+    const char *message)
+{
+	size_t len = str_size(message) + 1;
+	size_t size = ALIGN_UP(sizeof(logger_ring_rec_t) + len,
+	    LOGGER_RING_ALIGN);
+	if (size > LOGGER_RING_DATA_SIZE)
+		return ELIMIT;
+
+	size_t head = atomic_load_explicit(&ring->head,
+	    memory_order_relaxed);
+	size_t pos = head % LOGGER_RING_DATA_SIZE;
+	size_t pad = 0;
+	if (LOGGER_RING_DATA_SIZE - pos < size)
+		pad = LOGGER_RING_DATA_SIZE - pos;
+
+	size_t tail = atomic_load_explicit(&ring->tail,
+	    memory_order_acquire);
+	if (head + pad + size - tail > LOGGER_RING_DATA_SIZE)
+		return EBUSY;
+
+	logger_ring_rec_t *rec;
+	if (pad > 0) {
+		rec = (logger_ring_rec_t *) &ring->data[pos];
+		rec->size = pad;
+		rec->level = LOGGER_RING_PAD;
+		head += pad;
+		pos = 0;
+	}
+
+	rec = (logger_ring_rec_t *) &ring->data[pos];
+	rec->size = size;
+	rec->level = level;
+	rec->log = log;
+	memcpy(rec->message, message, len);
+
+	atomic_store_explicit(&ring->head, head + size,
+	    memory_order_release);
+	return EOK;
+}
+
+/** Find and validate the record at tail of the ring buffer.
+ *
+ * The ring buffer is writable by the client, so the record is
+ * only used if it lies completely between tail and head.
+ *
+ * @param ring Ring buffer.
+ * @param head Head of the ring, must differ from @a tail.
+ * @param tail Tail of the ring.
+ * @param size Place to store the validated size of the record.
+ * @return The record or NULL if the ring is corrupted.
+ */
+const logger_ring_rec_t *logger_ring_read(logger_ring_t *ring, size_t head,
+    size_t tail, size_t *size)
+{
+	if (head - tail > LOGGER_RING_DATA_SIZE)
+		return NULL;
+
+	size_t pos = tail % LOGGER_RING_DATA_SIZE;
+	const logger_ring_rec_t *rec =
+	    (const logger_ring_rec_t *) &ring->data[pos];
+	size_t rec_size = rec->size;
+
+	if ((rec_size < sizeof(logger_ring_rec_t)) ||
+	    (rec_size % LOGGER_RING_ALIGN != 0) ||
+	    (rec_size > LOGGER_RING_DATA_SIZE - pos) ||
+	    (rec_size > head - tail))
+		return NULL;
+
+	*size = rec_size;
+	return rec;
+}
+
+/** @}
+ */
@@ -47,6 +47,8 @@
 #include <mem.h>
 #include <stdlib.h>
 #include <adt/gcdlcm.h>
+#include <adt/list.h>
+#include <fibril.h>
 #include <malloc.h>
 
 #include "private/malloc.h"
@@ -61,6 +63,15 @@
 /** Magic used in heap descriptor. */
 #define HEAP_AREA_MAGIC  UINT32_C(0xBEEFCAFE)
 
+/** Magic used in headers of allocated small blocks. */
+#define HEAP_SMALL_USED_MAGIC  UINT32_C(0xBEEF0303)
+
+/** Magic used in headers of free small blocks. */
+#define HEAP_SMALL_FREE_MAGIC  UINT32_C(0xBEEF0404)
+
+/** Magic used in run descriptor. */
+#define HEAP_RUN_MAGIC  UINT32_C(0xBEEFF00D)
+
 /** Allocation alignment.
  *
  * This also covers the alignment of fields
@@ -79,6 +90,56 @@
  */
 #define SHRINK_GRANULARITY  (64 * PAGE_SIZE)
 
+/** Number of small size classes. */
+#define SMALL_CLASS_COUNT  20
+
+/** Largest size served from the small size classes.
+ *
+ * Larger allocations (and allocations with alignment
+ * stricter than the base alignment) go directly to
+ * the heap areas.
+ *
+ */
+#define SMALL_MAX_SIZE  1024
+
+/** Minimal gross size of a run. */
+#define RUN_MIN_SIZE  (4 * PAGE_SIZE)
+
+/** Minimal number of blocks in a run. */
+#define RUN_MIN_BLOCKS  32
+
+/** Number of bytes a fibril cache may hold per size class.
+ *
+ * Each fibril keeps its own cache, so the limit
+ * also bounds the memory that sits unused in
+ * the caches of idle fibrils.
+ *
+ */
+#define CACHE_CLASS_BYTES  4096
+
+/** Bounds of the number of blocks in a fibril cache per size class. */
+#define CACHE_MIN_COUNT  4
+#define CACHE_MAX_COUNT  64
+
+/** Size of the header of a small block (including padding). */
+#define SMALL_HEAD_SIZE \
+	(ALIGN_UP(sizeof(heap_small_head_t), BASE_ALIGN))
+
+/** Size of the run descriptor (including padding). */
+#define RUN_HEAD_SIZE \
+	(ALIGN_UP(sizeof(heap_run_t), BASE_ALIGN))
+
+/** Get header of a small block.
+ *
+ * Because the magic values of the small block header
+ * and the heap block header are at the same offset from
+ * the block address, this can also be used to tell small
+ * and heap blocks apart.
+ *
+ */
+#define SMALL_HEAD(addr) \
+	((heap_small_head_t *) (((uintptr_t) (addr)) - sizeof(heap_small_head_t)))
+
 /** Overhead of each heap block. */
 #define STRUCT_OVERHEAD \
 	(sizeof(heap_block_head_t) + sizeof(heap_block_foot_t))
@@ -187,6 +248,103 @@ typedef struct {
 	uint32_t magic;
 } heap_block_foot_t;
 
+/** Header of a small block
+ *
+ * Small blocks are carved from runs and the header
+ * is placed right before the block itself.
+ *
+ */
+typedef struct {
+	/** Run this block belongs to */
+	struct heap_run *run;
+
+	/* A magic value to detect overwrite and double free */
+	uint32_t magic;
+} heap_small_head_t;
+
+struct heap_class;
+
+/** Run of small blocks
+ *
+ * A run is an ordinary heap block that is split
+ * into equally sized small blocks of a single size
+ * class. This structure is at its very beginning.
+ *
+ */
+typedef struct heap_run {
+	/** Link to the list of runs of the size class */
+	link_t link;
+
+	/** Size class of the run */
+	struct heap_class *cls;
+
+	/** Singly linked list of free blocks */
+	void *free;
+
+	/** First slot that has never been allocated */
+	void *top;
+
+	/** End of the run */
+	void *end;
+
+	/** Number of allocated blocks (including cached ones) */
+	size_t used;
+
+	/** A magic value */
+	uint32_t magic;
+} heap_run_t;
+
+/** Size class of small blocks
+ *
+ * Each size class has its own lock, so that allocations
+ * of different sizes do not contend with each other and
+ * with the heap areas.
+ *
+ */
+typedef struct heap_class {
+	/** Lock protecting the runs of the size class */
+	fibril_rmutex_t lock;
+
+	/** Runs with at least one free slot */
+	list_t partial;
+
+	/** Runs without free slots */
+	list_t full;
+
+	/** Number of empty runs on the partial list */
+	size_t empty;
+
+	/** Net size of blocks */
+	size_t size;
+
+	/** Size of a slot (block and its header) */
+	size_t slot;
+
+	/** Net size of runs */
+	size_t run_size;
+
+	/** Maximal number of blocks in a fibril cache */
+	size_t cache_max;
+} heap_class_t;
+
+/** Fibril cache of small blocks
+ *
+ * Fibrils allocate and free small blocks from their
+ * own cache without any locking and only access the
+ * size class in batches.
+ *
+ */
+typedef struct {
+	/** Singly linked lists of cached blocks */
+	void *blocks[SMALL_CLASS_COUNT];
+
+	/** Number of blocks in the lists */
+	size_t count[SMALL_CLASS_COUNT];
+
+	/** The fibril is exiting and must not cache any more blocks */
+	bool disabled;
+} heap_cache_t;
+
 /** First heap area */
 static heap_area_t *first_heap_area = NULL;
 
@@ -199,6 +357,21 @@ static heap_block_head_t *next_fit = NULL;
 /** Futex for thread-safe heap manipulation */
 static fibril_rmutex_t malloc_mutex;
 
+/** Net block sizes of the small size classes */
+static const size_t small_sizes[SMALL_CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128, 160, 192,
+	224, 256, 320, 384, 448, 512, 640, 768, 896, 1024
+};
+
+/** Small size classes */
+static heap_class_t small_classes[SMALL_CLASS_COUNT];
+
+/** Size class index for each multiple of the base alignment */
+static uint8_t small_index[SMALL_MAX_SIZE / BASE_ALIGN + 1];
+
+/** Cache of small blocks of the current fibril */
+static fibril_local heap_cache_t fibril_cache;
+
 #define malloc_assert(expr) safe_assert(expr)
 
 /*
@@ -208,6 +381,14 @@ static_assert(BASE_ALIGN >= alignof(heap_area_t), "");
 static_assert(BASE_ALIGN >= alignof(heap_block_head_t), "");
 static_assert(BASE_ALIGN >= alignof(heap_block_foot_t), "");
 static_assert(BASE_ALIGN >= alignof(max_align_t), "");
+static_assert(BASE_ALIGN >= alignof(heap_small_head_t), "");
+static_assert(BASE_ALIGN >= alignof(heap_run_t), "");
+
+/*
+ * Make sure small blocks can be told apart from heap blocks.
+ */
+static_assert(sizeof(heap_small_head_t) - offsetof(heap_small_head_t, magic) ==
+    sizeof(heap_block_head_t) - offsetof(heap_block_head_t, magic), "");
 
 /** Serializes access to the heap from multiple threads. */
 static inline void heap_lock(void)
@@ -499,10 +680,38 @@ void __malloc_init(void)
 
 	if (!area_create(PAGE_SIZE))
 		abort();
+
+	size_t index = 0;
+
+	for (size_t i = 0; i < SMALL_CLASS_COUNT; i++) {
+		heap_class_t *cls = &small_classes[i];
+
+		if (fibril_rmutex_initialize(&cls->lock) != EOK)
+			abort();
+
+		list_initialize(&cls->partial);
+		list_initialize(&cls->full);
+		cls->empty = 0;
+		cls->size = small_sizes[i];
+		cls->slot = SMALL_HEAD_SIZE + cls->size;
+		cls->run_size = max(RUN_MIN_SIZE,
+		    RUN_HEAD_SIZE + RUN_MIN_BLOCKS * cls->slot);
+		cls->cache_max = min(CACHE_MAX_COUNT,
+		    max(CACHE_MIN_COUNT, CACHE_CLASS_BYTES / cls->size));
+
+		/* Map each multiple of the base alignment to the class. */
+		while (index * BASE_ALIGN <= cls->size)
+			small_index[index++] = i;
+	}
+
+	assert(small_sizes[SMALL_CLASS_COUNT - 1] == SMALL_MAX_SIZE);
 }
 
 void __malloc_fini(void)
 {
+	for (size_t i = 0; i < SMALL_CLASS_COUNT; i++)
+		fibril_rmutex_destroy(&small_classes[i].lock);
+
 	fibril_rmutex_destroy(&malloc_mutex);
 }
 
@@ -701,8 +910,17 @@ static void *heap_grow_and_alloc(size_t size, size_t align)
 		}
 	}
 
-	/* Eventually try to create a new area */
-	if (area_create(AREA_OVERHEAD(size + align))) {
+	/*
+	 * Eventually try to create a new area. If there is not enough
+	 * memory, give up the cached fibril stacks first.
+	 */
+	bool created = area_create(AREA_OVERHEAD(size + align));
+	if (!created) {
+		fibril_stack_cache_trim();
+		created = area_create(AREA_OVERHEAD(size + align));
+	}
+
+	if (created) {
 		heap_block_head_t *first =
 		    (heap_block_head_t *) AREA_FIRST_BLOCK_HEAD(last_heap_area);
 
@@ -777,6 +995,388 @@ static void *malloc_internal(size_t size, size_t align)
 	return heap_grow_and_alloc(gross_size, falign);
 }
 
+/** Free a heap block
+ *
+ * Should be called only inside the critical section.
+ *
+ * @param addr The address of the block.
+ *
+ */
+static void free_internal(void *const addr)
+{
+	/* Calculate the position of the header. */
+	heap_block_head_t *head =
+	    (heap_block_head_t *) (addr - sizeof(heap_block_head_t));
+
+	block_check(head);
+	malloc_assert(!head->free);
+
+	heap_area_t *area = head->area;
+
+	area_check(area);
+	malloc_assert((void *) head >= (void *) AREA_FIRST_BLOCK_HEAD(area));
+	malloc_assert((void *) head < area->end);
+
+	/* Mark the block itself as free. */
+	head->free = true;
+
+	/* Look at the next block. If it is free, merge the two. */
+	heap_block_head_t *next_head =
+	    (heap_block_head_t *) (((void *) head) + head->size);
+
+	if ((void *) next_head < area->end) {
+		block_check(next_head);
+		if (next_head->free)
+			block_init(head, head->size + next_head->size, true, area);
+	}
+
+	/* Look at the previous block. If it is free, merge the two. */
+	if ((void *) head > (void *) AREA_FIRST_BLOCK_HEAD(area)) {
+		heap_block_foot_t *prev_foot =
+		    (heap_block_foot_t *) (((void *) head) - sizeof(heap_block_foot_t));
+
+		heap_block_head_t *prev_head =
+		    (heap_block_head_t *) (((void *) head) - prev_foot->size);
+
+		block_check(prev_head);
+
+		if (prev_head->free)
+			block_init(prev_head, prev_head->size + head->size, true,
+			    area);
+	}
+
+	heap_shrink(area);
+}
+
+/** Check whether a run has no free slot left
+ *
+ * Should be called only inside the critical section
+ * of the size class.
+ *
+ * @param run Run to check.
+ *
+ */
+static bool run_full(heap_run_t *run)
+{
+	return (run->free == NULL) &&
+	    (run->top + run->cls->slot > run->end);
+}
+
+/** Create new run of small blocks
+ *
+ * Should be called only inside the critical section
+ * of the size class. The heap lock is taken while
+ * allocating the run itself.
+ *
+ * @param cls Size class of the run.
+ *
+ * @return New run or NULL on not enough memory.
+ *
+ */
+static heap_run_t *run_create(heap_class_t *cls)
+{
+	heap_lock();
+	heap_run_t *run = malloc_internal(cls->run_size, BASE_ALIGN);
+	heap_unlock();
+
+	if (run == NULL)
+		return NULL;
+
+	link_initialize(&run->link);
+	run->cls = cls;
+	run->free = NULL;
+	run->top = ((void *) run) + RUN_HEAD_SIZE;
+	run->end = ((void *) run) + cls->run_size;
+	run->used = 0;
+	run->magic = HEAP_RUN_MAGIC;
+
+	list_prepend(&run->link, &cls->partial);
+	cls->empty++;
+
+	return run;
+}
+
+/** Return an empty run to the heap
+ *
+ * Should be called only inside the critical section
+ * of the size class.
+ *
+ * @param run Run to destroy.
+ *
+ */
+static void run_destroy(heap_run_t *run)
+{
+	malloc_assert(run->used == 0);
+
+	list_remove(&run->link);
+	run->magic = 0;
+
+	heap_lock();
+	free_internal(run);
+	heap_unlock();
+}
+
+/** Take a free block from a run
+ *
+ * Should be called only inside the critical section
+ * of the size class.
+ *
+ * @param run Run with at least one free slot.
+ *
+ * @return Address of the block.
+ *
+ */
+static void *run_alloc(heap_run_t *run)
+{
+	heap_class_t *cls = run->cls;
+	void *addr;
+
+	if (run->free != NULL) {
+		addr = run->free;
+		run->free = *((void **) addr);
+	} else {
+		/* Carve a new block from the unused part of the run. */
+		addr = run->top + SMALL_HEAD_SIZE;
+		run->top += cls->slot;
+
+		heap_small_head_t *head = SMALL_HEAD(addr);
+		head->run = run;
+		head->magic = HEAP_SMALL_FREE_MAGIC;
+	}
+
+	if (run->used == 0)
+		cls->empty--;
+
+	run->used++;
+
+	if (run_full(run)) {
+		list_remove(&run->link);
+		list_append(&run->link, &cls->full);
+	}
+
+	return addr;
+}
+
+/** Return a block to its run
+ *
+ * Should be called only inside the critical section
+ * of the size class. Empty runs beyond the first one
+ * are returned to the heap.
+ *
+ * @param run  Run the block belongs to.
+ * @param addr Address of the block.
+ *
+ */
+static void run_free(heap_run_t *run, void *addr)
+{
+	heap_class_t *cls = run->cls;
+
+	if (run_full(run)) {
+		list_remove(&run->link);
+		list_prepend(&run->link, &cls->partial);
+	}
+
+	*((void **) addr) = run->free;
+	run->free = addr;
+
+	malloc_assert(run->used > 0);
+	run->used--;
+
+	if (run->used == 0) {
+		if (cls->empty > 0) {
+			run_destroy(run);
+		} else {
+			/*
+			 * Keep one empty run around so that we do not
+			 * pump the heap, but allocate from the other
+			 * runs first.
+			 */
+			cls->empty++;
+			list_remove(&run->link);
+			list_append(&run->link, &cls->partial);
+		}
+	}
+}
+
+/** Allocate a batch of small blocks
+ *
+ * The blocks are linked to the given singly linked list.
+ *
+ * @param cls   Size class to allocate from.
+ * @param list  List to add the blocks to.
+ * @param count Number of blocks to allocate.
+ *
+ * @return Number of allocated blocks.
+ *
+ */
+static size_t class_alloc(heap_class_t *cls, void **list, size_t count)
+{
+	size_t allocated = 0;
+
+	fibril_rmutex_lock(&cls->lock);
+
+	while (allocated < count) {
+		heap_run_t *run;
+
+		if (list_empty(&cls->partial)) {
+			run = run_create(cls);
+			if (run == NULL)
+				break;
+		} else {
+			run = list_get_instance(list_first(&cls->partial),
+			    heap_run_t, link);
+		}
+
+		void *addr = run_alloc(run);
+		*((void **) addr) = *list;
+		*list = addr;
+		allocated++;
+	}
+
+	fibril_rmutex_unlock(&cls->lock);
+
+	return allocated;
+}
+
+/** Free a batch of small blocks
+ *
+ * @param cls   Size class the blocks belong to.
+ * @param list  Singly linked list of the blocks.
+ * @param count Number of blocks to free from the list.
+ *
+ * @return The rest of the list.
+ *
+ */
+static void *class_free(heap_class_t *cls, void *list, size_t count)
+{
+	fibril_rmutex_lock(&cls->lock);
+
+	for (size_t i = 0; i < count; i++) {
+		malloc_assert(list != NULL);
+
+		void *addr = list;
+		list = *((void **) addr);
+
+		heap_run_t *run = SMALL_HEAD(addr)->run;
+		malloc_assert(run->magic == HEAP_RUN_MAGIC);
+		malloc_assert(run->cls == cls);
+
+		run_free(run, addr);
+	}
+
+	fibril_rmutex_unlock(&cls->lock);
+
+	return list;
+}
+
+/** Allocate a small block
+ *
+ * The block is taken from the cache of the current fibril,
+ * which is refilled from the size class when empty.
+ *
+ * @param size Number of bytes to allocate.
+ *
+ * @return Address of the allocated block or NULL on not enough memory.
+ *
+ */
+static void *malloc_small(size_t size)
+{
+	size_t index = small_index[(size + BASE_ALIGN - 1) / BASE_ALIGN];
+	heap_class_t *cls = &small_classes[index];
+	heap_cache_t *cache = &fibril_cache;
+	void *addr = NULL;
+
+	if (cache->disabled) {
+		(void) class_alloc(cls, &addr, 1);
+	} else {
+		if (cache->blocks[index] == NULL) {
+			cache->count[index] = class_alloc(cls,
+			    &cache->blocks[index], cls->cache_max / 2);
+		}
+
+		addr = cache->blocks[index];
+		if (addr != NULL) {
+			cache->blocks[index] = *((void **) addr);
+			cache->count[index]--;
+		}
+	}
+
+	if (addr == NULL)
+		return NULL;
+
+	heap_small_head_t *head = SMALL_HEAD(addr);
+	malloc_assert(head->magic == HEAP_SMALL_FREE_MAGIC);
+	head->magic = HEAP_SMALL_USED_MAGIC;
+
+	return addr;
+}
+
+/** Free a small block
+ *
+ * The block is put to the cache of the current fibril.
+ * When the cache grows over its limit, half of it is
+ * returned to the size class.
+ *
+ * @param addr The address of the block.
+ *
+ */
+static void free_small(void *const addr)
+{
+	heap_small_head_t *head = SMALL_HEAD(addr);
+
+	malloc_assert(head->magic == HEAP_SMALL_USED_MAGIC);
+	malloc_assert(head->run->magic == HEAP_RUN_MAGIC);
+
+	head->magic = HEAP_SMALL_FREE_MAGIC;
+
+	heap_class_t *cls = head->run->cls;
+	size_t index = cls - small_classes;
+	heap_cache_t *cache = &fibril_cache;
+
+	if (cache->disabled) {
+		(void) class_free(cls, addr, 1);
+		return;
+	}
+
+	*((void **) addr) = cache->blocks[index];
+	cache->blocks[index] = addr;
+	cache->count[index]++;
+
+	if (cache->count[index] > cls->cache_max) {
+		size_t excess = cache->count[index] - cls->cache_max / 2;
+
+		cache->blocks[index] = class_free(cls, cache->blocks[index],
+		    excess);
+		cache->count[index] -= excess;
+	}
+}
+
+/** Return the cache of the current fibril to the size classes
+ *
+ * Called when the fibril is about to exit, otherwise
+ * the cached blocks would never be reused. The cache
+ * stays disabled afterwards, so that the blocks freed
+ * while tearing down the fibril (including its TLS)
+ * go directly to the size classes.
+ *
+ */
+void __malloc_cache_flush(void)
+{
+	heap_cache_t *cache = &fibril_cache;
+
+	for (size_t i = 0; i < SMALL_CLASS_COUNT; i++) {
+		if (cache->count[i] > 0) {
+			cache->blocks[i] = class_free(&small_classes[i],
+			    cache->blocks[i], cache->count[i]);
+			cache->count[i] = 0;
+		}
+
+		malloc_assert(cache->blocks[i] == NULL);
+	}
+
+	cache->disabled = true;
+}
+
 /** Allocate memory
  *
  * @param size Number of bytes to allocate.
@@ -786,6 +1386,9 @@ static void *malloc_internal(size_t size, size_t align)
  */
 void *malloc(const size_t size)
 {
+	if (size <= SMALL_MAX_SIZE)
+		return malloc_small(size);
+
 	heap_lock();
 	void *block = malloc_internal(size, BASE_ALIGN);
 	heap_unlock();
@@ -809,6 +1412,9 @@ void *memalign(const size_t align, const size_t size)
 	size_t palign =
 	    1 << (fnzb(max(sizeof(void *), align) - 1) + 1);
 
+	if ((palign <= BASE_ALIGN) && (size <= SMALL_MAX_SIZE))
+		return malloc_small(size);
+
 	heap_lock();
 	void *block = malloc_internal(size, palign);
 	heap_unlock();
@@ -834,6 +1440,24 @@ void *realloc(void *const addr, size_t size)
 	if (addr == NULL)
 		return malloc(size);
 
+	heap_small_head_t *small = SMALL_HEAD(addr);
+	if (small->magic != HEAP_BLOCK_HEAD_MAGIC) {
+		malloc_assert(small->magic == HEAP_SMALL_USED_MAGIC);
+
+		/* Small blocks are never resized in place beyond their class. */
+		size_t small_size = small->run->cls->size;
+		if (size <= small_size)
+			return addr;
+
+		void *ptr = malloc(size);
+		if (ptr != NULL) {
+			memcpy(ptr, addr, small_size);
+			free(addr);
+		}
+
+		return ptr;
+	}
+
 	heap_lock();
 
 	/* Calculate the position of the header. */
@@ -962,62 +1586,29 @@ void free(void *const addr)
 	if (addr == NULL)
 		return;
 
-	heap_lock();
-
-	/* Calculate the position of the header. */
-	heap_block_head_t *head =
-	    (heap_block_head_t *) (addr - sizeof(heap_block_head_t));
-
-	block_check(head);
-	malloc_assert(!head->free);
-
-	heap_area_t *area = head->area;
-
-	area_check(area);
-	malloc_assert((void *) head >= (void *) AREA_FIRST_BLOCK_HEAD(area));
-	malloc_assert((void *) head < area->end);
-
-	/* Mark the block itself as free. */
-	head->free = true;
-
-	/* Look at the next block. If it is free, merge the two. */
-	heap_block_head_t *next_head =
-	    (heap_block_head_t *) (((void *) head) + head->size);
-
-	if ((void *) next_head < area->end) {
-		block_check(next_head);
-		if (next_head->free)
-			block_init(head, head->size + next_head->size, true, area);
-	}
-
-	/* Look at the previous block. If it is free, merge the two. */
-	if ((void *) head > (void *) AREA_FIRST_BLOCK_HEAD(area)) {
-		heap_block_foot_t *prev_foot =
-		    (heap_block_foot_t *) (((void *) head) - sizeof(heap_block_foot_t));
-
-		heap_block_head_t *prev_head =
-		    (heap_block_head_t *) (((void *) head) - prev_foot->size);
-
-		block_check(prev_head);
-
-		if (prev_head->free)
-			block_init(prev_head, prev_head->size + head->size, true,
-			    area);
+	heap_small_head_t *small = SMALL_HEAD(addr);
+	if (small->magic != HEAP_BLOCK_HEAD_MAGIC) {
+		free_small(addr);
+		return;
 	}
 
-	heap_shrink(area);
-
+	heap_lock();
+	free_internal(addr);
 	heap_unlock();
 }
 
-void *heap_check(void)
+/** Check consistency of the heap areas
+ *
+ * Should be called only inside the critical section.
+ *
+ * @return NULL if the heap areas are consistent.
+ * @return Address of the first corrupted structure otherwise.
+ *
+ */
+static void *heap_check_areas(void)
 {
-	heap_lock();
-
-	if (first_heap_area == NULL) {
-		heap_unlock();
+	if (first_heap_area == NULL)
 		return (void *) -1;
-	}
 
 	/* Walk all heap areas */
 	for (heap_area_t *area = first_heap_area; area != NULL;
@@ -1028,10 +1619,8 @@ void *heap_check(void)
 		    ((void *) area != area->start) ||
 		    (area->start >= area->end) ||
 		    (((uintptr_t) area->start % PAGE_SIZE) != 0) ||
-		    (((uintptr_t) area->end % PAGE_SIZE) != 0)) {
-			heap_unlock();
+		    (((uintptr_t) area->end % PAGE_SIZE) != 0))
 			return (void *) area;
-		}
 
 		/* Walk all heap blocks */
 		for (heap_block_head_t *head = (heap_block_head_t *)
@@ -1039,25 +1628,88 @@ void *heap_check(void)
 		    head = (heap_block_head_t *) (((void *) head) + head->size)) {
 
 			/* Check heap block consistency */
-			if (head->magic != HEAP_BLOCK_HEAD_MAGIC) {
-				heap_unlock();
+			if (head->magic != HEAP_BLOCK_HEAD_MAGIC)
 				return (void *) head;
-			}
 
 			heap_block_foot_t *foot = BLOCK_FOOT(head);
 
 			if ((foot->magic != HEAP_BLOCK_FOOT_MAGIC) ||
-			    (head->size != foot->size)) {
-				heap_unlock();
+			    (head->size != foot->size))
 				return (void *) foot;
-			}
 		}
 	}
 
-	heap_unlock();
+	return NULL;
+}
+
+/** Check consistency of the runs on a list
+ *
+ * Should be called only inside the critical section
+ * of the size class.
+ *
+ * @param cls  Size class of the runs.
+ * @param runs List of runs to check.
+ *
+ * @return NULL if the runs are consistent.
+ * @return Address of the first corrupted structure otherwise.
+ *
+ */
+static void *heap_check_runs(heap_class_t *cls, list_t *runs)
+{
+	list_foreach(*runs, link, heap_run_t, run) {
+		/* Check run consistency */
+		if ((run->magic != HEAP_RUN_MAGIC) || (run->cls != cls) ||
+		    (run->top > run->end))
+			return (void *) run;
+
+		/* The run itself has to be a used heap block */
+		heap_block_head_t *head = (heap_block_head_t *)
+		    (((void *) run) - sizeof(heap_block_head_t));
+
+		if ((head->magic != HEAP_BLOCK_HEAD_MAGIC) || (head->free))
+			return (void *) head;
+
+		/* Walk all small blocks carved from the run */
+		for (void *slot = ((void *) run) + RUN_HEAD_SIZE;
+		    slot < run->top; slot += cls->slot) {
+			heap_small_head_t *small = SMALL_HEAD(slot + SMALL_HEAD_SIZE);
+
+			/* Check small block consistency */
+			if (((small->magic != HEAP_SMALL_USED_MAGIC) &&
+			    (small->magic != HEAP_SMALL_FREE_MAGIC)) ||
+			    (small->run != run))
+				return (void *) small;
+		}
+	}
 
 	return NULL;
 }
 
+void *heap_check(void)
+{
+	for (size_t i = 0; i < SMALL_CLASS_COUNT; i++)
+		fibril_rmutex_lock(&small_classes[i].lock);
+
+	heap_lock();
+
+	void *res = heap_check_areas();
+
+	for (size_t i = 0; (res == NULL) && (i < SMALL_CLASS_COUNT); i++) {
+		res = heap_check_runs(&small_classes[i],
+		    &small_classes[i].partial);
+		if (res == NULL) {
+			res = heap_check_runs(&small_classes[i],
+			    &small_classes[i].full);
+		}
+	}
+
+	heap_unlock();
+
+	for (size_t i = SMALL_CLASS_COUNT; i > 0; i--)
+		fibril_rmutex_unlock(&small_classes[i - 1].lock);
+
+	return res;
+}
+
 /** @}
  */
@@ -46,6 +46,12 @@
 #define ATTRIBUTE_OPTIMIZE_NO_TLDP \
     ATTRIBUTE_OPTIMIZE("-fno-tree-loop-distribute-patterns")
 
+#ifdef CONFIG_LTO
+#define DO_NOT_DISCARD __attribute__ ((used))
+#else
+#define DO_NOT_DISCARD
+#endif
+
 #endif
 
 /** @}
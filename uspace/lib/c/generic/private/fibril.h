@@ -38,7 +38,7 @@
 #include "./futex.h"
 
 typedef struct {
-	fibril_t *fibril;
+	_Atomic(fibril_t *) fibril;
 } fibril_event_t;
 
 #define FIBRIL_EVENT_INIT ((fibril_event_t) {0})
@@ -60,8 +60,17 @@ struct fibril {
 
 	fibril_t *thread_ctx;
 
+	/* Fibril that switched to this one, see _fibril_switch_to(). */
+	fibril_t *switched_from;
+	/* Set while the context of the fibril is being saved. */
+	atomic_bool is_switching;
+	/* Ready queue owned by a helper fibril. */
+	struct fibril_runq *runq;
+
 	bool is_running : 1;
 	bool is_writer : 1;
+	/* Requeued by the fibril it switched to, see _fibril_switch_to(). */
+	bool is_yielding : 1;
 	/* In some places, we use fibril structs that can't be freed. */
 	bool is_freeable : 1;
 
@@ -35,14 +35,14 @@
 #ifndef _LIBC_PRIVATE_THREAD_H_
 #define _LIBC_PRIVATE_THREAD_H_
 
+#include <thread.h>
 #include <time.h>
 #include <libarch/thread.h>
 #include <abi/proc/thread.h>
 
 extern void __thread_entry(void);
 
-extern errno_t thread_create(errno_t (*)(void *), void *, const char *);
-extern void thread_exit(int) __attribute__((noreturn));
+extern void thread_exit(int, void *) __attribute__((noreturn));
 extern thread_id_t thread_get_id(void);
 extern void thread_usleep(usec_t);
 extern void thread_sleep(sec_t);
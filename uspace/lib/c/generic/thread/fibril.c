@@ -35,6 +35,8 @@
  */
 
 #include <adt/list.h>
+#include <adt/odict.h>
+#include <align.h>
 #include <fibril.h>
 #include <stack.h>
 #include <tls.h>
@@ -44,6 +46,7 @@
 #include <assert.h>
 
 #include <mem.h>
+#include <stdalign.h>
 #include <str.h>
 #include <ipc/ipc.h>
 #include <libarch/faddr.h>
@@ -52,13 +55,20 @@
 #include "../private/futex.h"
 #include "../private/fibril.h"
 #include "../private/libc.h"
+#include "../private/malloc.h"
 
 #define DPRINTF(...) ((void)0)
 #undef READY_DEBUG
 
-/** Member of timeout_list. */
+/** Default number of fibril stacks kept for reuse. */
+#define FIBRIL_STACK_CACHE_LIMIT  32
+
+/** Maximum number of ready queues, including the shared one. */
+#define FIBRIL_RUNQ_COUNT  64
+
+/** Member of timeout_dict. */
 typedef struct {
-	link_t link;
+	odlink_t link;
 	struct timespec expires;
 	fibril_event_t *event;
 } _timeout_t;
@@ -76,6 +86,28 @@ typedef struct {
 	ipc_call_t call;
 } _ipc_buffer_t;
 
+/** Cached fibril stack, stored at the top of the stack itself. */
+typedef struct {
+	link_t link;
+	void *stack;
+	size_t size;
+} _stack_cache_entry_t;
+
+/**
+ * Ready queue.
+ *
+ * Every helper fibril (i.e. every thread that runs fibrils) owns one
+ * queue. Fibrils made ready by a thread are appended to the queue of that
+ * thread, and a thread looking for work takes from its own queue first,
+ * stealing from queues of the other threads only when its own is empty.
+ */
+typedef struct fibril_runq {
+	futex_t futex;
+	list_t list;
+	/** Length of list, readable without holding futex. */
+	atomic_size_t count;
+} _runq_t;
+
 typedef enum {
 	SWITCH_FROM_DEAD,
 	SWITCH_FROM_HELPER,
@@ -85,16 +117,39 @@ typedef enum {
 
 static bool multithreaded = false;
 
-/* This futex serializes access to global data. */
+/* This futex serializes access to fibril_list. */
 static futex_t fibril_futex;
 static futex_t ready_semaphore;
 static long ready_st_count;
 
-static LIST_INITIALIZE(ready_list);
+/*
+ * Ready queues. The first one is shared by threads which do not have
+ * a helper fibril (and thus a queue of their own) yet.
+ */
+static _runq_t runqs[FIBRIL_RUNQ_COUNT];
+static atomic_size_t runqs_used = 1;
+/* Total number of fibrils in all ready queues. */
+static atomic_size_t ready_count;
+
 static LIST_INITIALIZE(fibril_list);
-static LIST_INITIALIZE(timeout_list);
+
+/*
+ * Armed timeouts ordered by expiration time. Servers may have thousands
+ * of them, so they are not kept in a sorted list.
+ */
+static futex_t timeout_futex;
+static odict_t timeout_dict;
 
 static futex_t ipc_lists_futex;
+
+/*
+ * Stacks of dead fibrils are kept for reuse, so that creating a fibril
+ * does not always need to create (and later destroy) an address space area.
+ */
+static fibril_rmutex_t stack_cache_lock;
+static LIST_INITIALIZE(stack_cache);
+static size_t stack_cache_count;
+static size_t stack_cache_limit = FIBRIL_STACK_CACHE_LIMIT;
 static LIST_INITIALIZE(ipc_waiter_list);
 static LIST_INITIALIZE(ipc_buffer_list);
 static LIST_INITIALIZE(ipc_buffer_free_list);
@@ -110,7 +165,7 @@ static inline void _ready_debug_check(void)
 {
 #ifdef READY_DEBUG
 	assert(!multithreaded);
-	long count = (long) list_count(&ready_list) +
+	long count = (long) atomic_load(&ready_count) +
 	    (long) list_count(&ipc_buffer_free_list);
 	assert(ready_st_count == count);
 #endif
@@ -138,6 +193,8 @@ static inline errno_t _ready_down(const struct timespec *expires)
 
 static atomic_int threads_in_ipc_wait;
 
+static void _fibril_switch_finish(void);
+
 /** Function that spans the whole life-cycle of a fibril.
  *
  * Each fibril begins execution in this function. Then the function implementing
@@ -147,8 +204,8 @@ static atomic_int threads_in_ipc_wait;
  */
 static void _fibril_main(void)
 {
-	/* fibril_futex is locked when a fibril is started. */
-	futex_unlock(&fibril_futex);
+	/* The fibril was started by a switch, finish it. */
+	_fibril_switch_finish();
 
 	fibril_t *fibril = fibril_self();
 
@@ -212,31 +269,105 @@ static fibril_t *_fibril_trigger_internal(fibril_event_t *event, fibril_t *reaso
 	assert(reason != _EVENT_INITIAL);
 	assert(reason == _EVENT_TIMED_OUT || reason == _EVENT_TRIGGERED);
 
-	futex_assert_is_locked(&fibril_futex);
+	fibril_t *f = atomic_load_explicit(&event->fibril, memory_order_acquire);
 
-	if (event->fibril == _EVENT_INITIAL) {
-		event->fibril = reason;
-		return NULL;
-	}
+	do {
+		if (f == _EVENT_TRIGGERED) {
+			/* Already triggered. Nothing to do. */
+			return NULL;
+		}
+
+		if (f == _EVENT_TIMED_OUT)
+			assert(reason == _EVENT_TRIGGERED);
+	} while (!atomic_compare_exchange_weak_explicit(&event->fibril, &f,
+	    reason, memory_order_acq_rel, memory_order_acquire));
 
-	if (event->fibril == _EVENT_TIMED_OUT) {
-		assert(reason == _EVENT_TRIGGERED);
-		event->fibril = reason;
+	if (f == _EVENT_INITIAL || f == _EVENT_TIMED_OUT)
 		return NULL;
+
+	assert(f->sleep_event == event);
+	return f;
+}
+
+/** Claim a ready queue for the calling helper fibril. */
+static _runq_t *_runq_register(void)
+{
+	size_t i = atomic_fetch_add_explicit(&runqs_used, 1,
+	    memory_order_relaxed);
+	if (i >= FIBRIL_RUNQ_COUNT) {
+		/* Out of queues, share the first one. */
+		atomic_store_explicit(&runqs_used, FIBRIL_RUNQ_COUNT,
+		    memory_order_relaxed);
+		return &runqs[0];
 	}
 
-	if (event->fibril == _EVENT_TRIGGERED) {
-		/* Already triggered. Nothing to do. */
+	_runq_t *q = &runqs[i];
+	list_initialize(&q->list);
+	if (futex_initialize(&q->futex, 1) != EOK)
+		abort();
+
+	return q;
+}
+
+/** @return the ready queue of the current thread. */
+static _runq_t *_runq_current(void)
+{
+	fibril_t *ctx = fibril_self()->thread_ctx;
+	if (ctx && ctx->runq)
+		return ctx->runq;
+
+	return &runqs[0];
+}
+
+static fibril_t *_runq_pop(_runq_t *q)
+{
+	if (atomic_load_explicit(&q->count, memory_order_relaxed) == 0)
 		return NULL;
-	}
 
-	fibril_t *f = event->fibril;
-	event->fibril = reason;
+	futex_lock(&q->futex);
+	fibril_t *f = list_pop(&q->list, fibril_t, link);
+	if (f) {
+		atomic_fetch_sub_explicit(&q->count, 1, memory_order_relaxed);
+		atomic_fetch_sub(&ready_count, 1);
+	}
+	futex_unlock(&q->futex);
 
-	assert(f->sleep_event == event);
 	return f;
 }
 
+/**
+ * Take a fibril from the ready queue of the current thread, or steal one
+ * from another queue if the local one is empty.
+ *
+ * Must be called with a token of ready_semaphore held.
+ * Returns NULL only if there was no fibril in any of the queues, in which
+ * case the token is one of the IPC wait tokens.
+ */
+static fibril_t *_runq_pop_any(void)
+{
+	_runq_t *local = _runq_current();
+
+	while (atomic_load(&ready_count) > 0) {
+		fibril_t *f = _runq_pop(local);
+		if (f)
+			return f;
+
+		size_t n = atomic_load_explicit(&runqs_used,
+		    memory_order_relaxed);
+		if (n > FIBRIL_RUNQ_COUNT)
+			n = FIBRIL_RUNQ_COUNT;
+
+		size_t start = local - runqs;
+		for (size_t i = 1; i < n; i++) {
+			f = _runq_pop(&runqs[(start + i) % n]);
+			if (f)
+				return f;
+		}
+	}
+
+	return NULL;
+}
+
 static errno_t _ipc_wait(ipc_call_t *call, const struct timespec *expires)
 {
 	if (!expires)
@@ -256,43 +387,39 @@ static errno_t _ipc_wait(ipc_call_t *call, const struct timespec *expires)
 }
 
 /*
- * Waits until a ready fibril is added to the list, or an IPC message arrives.
+ * Waits until a ready fibril is added to the queues, or an IPC message arrives.
  * Returns NULL on timeout and may also return NULL if returning from IPC
  * wait after new ready fibrils are added.
  */
-static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
+static fibril_t *_ready_list_pop(const struct timespec *expires)
 {
-	if (locked) {
-		futex_assert_is_locked(&fibril_futex);
-		assert(expires);
-		/* Must be nonblocking. */
-		assert(expires->tv_sec == 0);
-	} else {
-		futex_assert_is_not_locked(&fibril_futex);
-	}
-
 	errno_t rc = _ready_down(expires);
 	if (rc != EOK)
 		return NULL;
 
 	/*
 	 * Once we acquire a token from ready_semaphore, there are two options.
-	 * Either there is a ready fibril in the list, or it's our turn to
-	 * call `ipc_wait_cycle()`. There is one extra token on the semaphore
-	 * for each entry of the call buffer.
+	 * Either there is a ready fibril in one of the queues, or it's our
+	 * turn to call `ipc_wait_cycle()`. There is one extra token on the
+	 * semaphore for each entry of the call buffer.
 	 */
 
-	if (!locked)
-		futex_lock(&fibril_futex);
-	fibril_t *f = list_pop(&ready_list, fibril_t, link);
-	if (!f)
-		atomic_fetch_add_explicit(&threads_in_ipc_wait, 1,
-		    memory_order_relaxed);
-	if (!locked)
-		futex_unlock(&fibril_futex);
-
-	if (f)
-		return f;
+	fibril_t *f;
+	while (true) {
+		f = _runq_pop_any();
+		if (f)
+			return f;
+
+		/*
+		 * Pairs with the check in _ready_list_push(). Either the
+		 * pushing thread sees us going to IPC wait and pokes us,
+		 * or we see the newly pushed fibril here.
+		 */
+		atomic_fetch_add(&threads_in_ipc_wait, 1);
+		if (atomic_load(&ready_count) == 0)
+			break;
+		atomic_fetch_sub(&threads_in_ipc_wait, 1);
+	}
 
 	if (!multithreaded)
 		assert(list_empty(&ipc_buffer_list));
@@ -324,16 +451,17 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 	 * returned.
 	 */
 
-	if (!locked)
-		futex_lock(&fibril_futex);
-
 	futex_lock(&ipc_lists_futex);
 
 	_ipc_waiter_t *w = list_pop(&ipc_waiter_list, _ipc_waiter_t, link);
 	if (w) {
 		*w->call = call;
 		w->rc = rc;
-		/* We switch to the woken up fibril immediately if possible. */
+		/*
+		 * We switch to the woken up fibril immediately if possible,
+		 * so that it keeps running on the thread that received
+		 * the call.
+		 */
 		f = _fibril_trigger_internal(&w->event, _EVENT_TRIGGERED);
 
 		/* Return token. */
@@ -347,16 +475,13 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 
 	futex_unlock(&ipc_lists_futex);
 
-	if (!locked)
-		futex_unlock(&fibril_futex);
-
 	return f;
 }
 
-static fibril_t *_ready_list_pop_nonblocking(bool locked)
+static fibril_t *_ready_list_pop_nonblocking(void)
 {
 	struct timespec tv = { .tv_sec = 0, .tv_nsec = 0 };
-	return _ready_list_pop(&tv, locked);
+	return _ready_list_pop(&tv);
 }
 
 static void _ready_list_push(fibril_t *f)
@@ -364,13 +489,18 @@ static void _ready_list_push(fibril_t *f)
 	if (!f)
 		return;
 
-	futex_assert_is_locked(&fibril_futex);
+	/* Enqueue in the ready queue of the current thread. */
+	_runq_t *q = _runq_current();
+
+	futex_lock(&q->futex);
+	list_append(&f->link, &q->list);
+	atomic_fetch_add_explicit(&q->count, 1, memory_order_relaxed);
+	atomic_fetch_add(&ready_count, 1);
+	futex_unlock(&q->futex);
 
-	/* Enqueue in ready_list. */
-	list_append(&f->link, &ready_list);
 	_ready_up();
 
-	if (atomic_load_explicit(&threads_in_ipc_wait, memory_order_relaxed)) {
+	if (atomic_load(&threads_in_ipc_wait)) {
 		DPRINTF("Poking.\n");
 		/* Wakeup one thread sleeping in SYS_IPC_WAIT. */
 		ipc_poke();
@@ -380,8 +510,6 @@ static void _ready_list_push(fibril_t *f)
 /* Blocks the current fibril until an IPC call arrives. */
 static errno_t _wait_ipc(ipc_call_t *call, const struct timespec *expires)
 {
-	futex_assert_is_not_locked(&fibril_futex);
-
 	futex_lock(&ipc_lists_futex);
 	_ipc_buffer_t *buf = list_pop(&ipc_buffer_list, _ipc_buffer_t, link);
 	if (buf) {
@@ -420,31 +548,174 @@ static struct timespec *_handle_expired_timeouts(struct timespec *next_timeout)
 	struct timespec ts;
 	getuptime(&ts);
 
-	futex_lock(&fibril_futex);
+	futex_lock(&timeout_futex);
 
-	while (!list_empty(&timeout_list)) {
-		link_t *cur = list_first(&timeout_list);
-		_timeout_t *to = list_get_instance(cur, _timeout_t, link);
+	while (!odict_empty(&timeout_dict)) {
+		odlink_t *cur = odict_first(&timeout_dict);
+		_timeout_t *to = odict_get_instance(cur, _timeout_t, link);
 
 		if (ts_gt(&to->expires, &ts)) {
 			*next_timeout = to->expires;
-			futex_unlock(&fibril_futex);
+			futex_unlock(&timeout_futex);
 			return next_timeout;
 		}
 
-		list_remove(&to->link);
+		odict_remove(&to->link);
 
+		/*
+		 * Must be done with timeout_futex held, the waiting fibril
+		 * removes its timeout (and releases the event) under it.
+		 */
 		_ready_list_push(_fibril_trigger_internal(
 		    to->event, _EVENT_TIMED_OUT));
 	}
 
-	futex_unlock(&fibril_futex);
+	futex_unlock(&timeout_futex);
 	return NULL;
 }
 
+/**
+ * Get a fibril stack of the given size, preferably a cached one.
+ *
+ * New stacks are reserved lazily, so only the pages that are actually
+ * used get backed by memory. If there is not enough address space for
+ * a new stack, the stack cache is trimmed and the allocation retried.
+ *
+ * @param size  Size of the stack.
+ * @return      The stack or AS_MAP_FAILED.
+ */
+static void *_stack_get(size_t size)
+{
+	fibril_rmutex_lock(&stack_cache_lock);
+
+	list_foreach(stack_cache, link, _stack_cache_entry_t, entry) {
+		if (entry->size == size) {
+			list_remove(&entry->link);
+			stack_cache_count--;
+			fibril_rmutex_unlock(&stack_cache_lock);
+			return entry->stack;
+		}
+	}
+
+	bool cached = stack_cache_count > 0;
+	fibril_rmutex_unlock(&stack_cache_lock);
+
+	unsigned int flags = AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE |
+	    AS_AREA_GUARD | AS_AREA_LATE_RESERVE;
+
+	void *stack = as_area_create(AS_AREA_ANY, size, flags, AS_AREA_UNPAGED);
+	if (stack == AS_MAP_FAILED && cached) {
+		/* Stacks of other sizes might be in the way. */
+		fibril_stack_cache_trim();
+		stack = as_area_create(AS_AREA_ANY, size, flags,
+		    AS_AREA_UNPAGED);
+	}
+
+	return stack;
+}
+
+/**
+ * Return the stack of a dead fibril.
+ *
+ * The stack is cached for reuse unless the cache is full,
+ * in which case it is destroyed.
+ *
+ * @param stack  The stack.
+ * @param size   Size of the stack.
+ */
+static void _stack_put(void *stack, size_t size)
+{
+	assert(stack);
+
+	/*
+	 * The fibril started running at the top of the stack, so the
+	 * entry does not need any memory that is not backed already.
+	 * Keeping the entry out of the heap also allows malloc() to trim
+	 * the cache while it holds the heap lock.
+	 */
+	_stack_cache_entry_t *entry = (_stack_cache_entry_t *)
+	    ALIGN_DOWN((uintptr_t) stack + size - sizeof(_stack_cache_entry_t),
+	    alignof(_stack_cache_entry_t));
+
+	fibril_rmutex_lock(&stack_cache_lock);
+
+	if (stack_cache_count < stack_cache_limit) {
+		entry->stack = stack;
+		entry->size = size;
+		list_prepend(&entry->link, &stack_cache);
+		stack_cache_count++;
+
+		fibril_rmutex_unlock(&stack_cache_lock);
+		return;
+	}
+
+	fibril_rmutex_unlock(&stack_cache_lock);
+
+	as_area_destroy(stack);
+}
+
+/**
+ * Destroy cached stacks until at most the given number of them is left.
+ *
+ * @param limit  Number of stacks to keep.
+ */
+static void _stack_cache_shrink(size_t limit)
+{
+	list_t victims;
+	list_initialize(&victims);
+
+	fibril_rmutex_lock(&stack_cache_lock);
+
+	while (stack_cache_count > limit) {
+		/* The least recently cached stacks go first. */
+		link_t *link = list_last(&stack_cache);
+		list_remove(link);
+		list_append(link, &victims);
+		stack_cache_count--;
+	}
+
+	fibril_rmutex_unlock(&stack_cache_lock);
+
+	/* Destroy the stacks without holding the lock. */
+	while (!list_empty(&victims)) {
+		_stack_cache_entry_t *entry = list_get_instance(
+		    list_first(&victims), _stack_cache_entry_t, link);
+		list_remove(&entry->link);
+		as_area_destroy(entry->stack);
+	}
+}
+
+/**
+ * Set the maximal number of stacks of dead fibrils kept for reuse.
+ *
+ * Surplus cached stacks are destroyed right away.
+ *
+ * @param limit  Maximal number of cached stacks, zero disables the cache.
+ */
+void fibril_stack_cache_set_limit(size_t limit)
+{
+	fibril_rmutex_lock(&stack_cache_lock);
+	stack_cache_limit = limit;
+	fibril_rmutex_unlock(&stack_cache_lock);
+
+	_stack_cache_shrink(limit);
+}
+
+/**
+ * Destroy all stacks of dead fibrils kept for reuse.
+ *
+ * Called automatically when the task runs out of memory for new
+ * stacks or heap areas, but may be also called by the task itself
+ * when it knows it will not create more fibrils for a while.
+ */
+void fibril_stack_cache_trim(void)
+{
+	_stack_cache_shrink(0);
+}
+
 /**
  * Clean up after a dead fibril from which we restored context, if any.
- * Called after a switch is made and fibril_futex is unlocked.
+ * Called after a switch is made.
  */
 static void _fibril_cleanup_dead(void)
 {
@@ -452,56 +723,89 @@ static void _fibril_cleanup_dead(void)
 	if (!srcf->clean_after_me)
 		return;
 
-	void *stack = srcf->clean_after_me->stack;
-	assert(stack);
-	as_area_destroy(stack);
+	_stack_put(srcf->clean_after_me->stack,
+	    srcf->clean_after_me->stack_size);
 	fibril_teardown(srcf->clean_after_me);
 	srcf->clean_after_me = NULL;
 }
 
+/**
+ * Finish a switch to the current fibril.
+ *
+ * A fibril that yielded is only put in the ready queue now that its context
+ * is saved. A fibril that blocked may already have been woken up by another
+ * thread, which is now allowed to switch to it.
+ */
+static void _fibril_switch_finish(void)
+{
+	fibril_t *self = fibril_self();
+	fibril_t *prev = self->switched_from;
+
+	if (prev) {
+		self->switched_from = NULL;
+
+		if (prev->is_yielding) {
+			prev->is_yielding = false;
+			_ready_list_push(prev);
+		} else {
+			atomic_store_explicit(&prev->is_switching, false,
+			    memory_order_release);
+		}
+	}
+
+	_fibril_cleanup_dead();
+}
+
+/**
+ * Wait until a fibril that was woken up by another thread before it finished
+ * switching away has its context saved. This only takes a few instructions
+ * on the other thread, so we spin.
+ */
+static void _fibril_wait_switched(fibril_t *f)
+{
+	while (atomic_load_explicit(&f->is_switching, memory_order_acquire))
+		;
+}
+
 /** Switch to a fibril. */
-static void _fibril_switch_to(_switch_type_t type, fibril_t *dstf, bool locked)
+static void _fibril_switch_to(_switch_type_t type, fibril_t *dstf)
 {
 	assert(fibril_self()->rmutex_locks == 0);
 
-	if (!locked)
-		futex_lock(&fibril_futex);
-	else
-		futex_assert_is_locked(&fibril_futex);
-
 	fibril_t *srcf = fibril_self();
 	assert(srcf);
 	assert(dstf);
 
+	_fibril_wait_switched(dstf);
+
 	switch (type) {
 	case SWITCH_FROM_YIELD:
-		_ready_list_push(srcf);
+		srcf->is_yielding = true;
+		dstf->switched_from = srcf;
+		break;
+	case SWITCH_FROM_BLOCKED:
+		/* is_switching was set before the fibril became wakeable. */
+		dstf->switched_from = srcf;
 		break;
 	case SWITCH_FROM_DEAD:
 		dstf->clean_after_me = srcf;
 		break;
 	case SWITCH_FROM_HELPER:
-	case SWITCH_FROM_BLOCKED:
+		/* The helper is never switched to by other threads. */
 		break;
 	}
 
 	dstf->thread_ctx = srcf->thread_ctx;
 	srcf->thread_ctx = NULL;
 
-	/* Just some bookkeeping to allow better debugging of futex locks. */
-	futex_give_to(&fibril_futex, dstf);
-
 	/* Swap to the next fibril. */
 	context_swap(&srcf->ctx, &dstf->ctx);
 
 	assert(srcf == fibril_self());
 	assert(srcf->thread_ctx);
 
-	if (!locked) {
-		/* Must be after context_swap()! */
-		futex_unlock(&fibril_futex);
-		_fibril_cleanup_dead();
-	}
+	/* Must be after context_swap()! */
+	_fibril_switch_finish();
 }
 
 /**
@@ -517,15 +821,16 @@ static errno_t _helper_fibril_fn(void *arg)
 {
 	/* Set itself as the thread's own context. */
 	fibril_self()->thread_ctx = fibril_self();
+	fibril_self()->runq = _runq_register();
 
 	(void) arg;
 
 	struct timespec next_timeout;
 	while (true) {
 		struct timespec *to = _handle_expired_timeouts(&next_timeout);
-		fibril_t *f = _ready_list_pop(to, false);
+		fibril_t *f = _ready_list_pop(to);
 		if (f) {
-			_fibril_switch_to(SWITCH_FROM_HELPER, f, false);
+			_fibril_switch_to(SWITCH_FROM_HELPER, f);
 		}
 	}
 
@@ -550,9 +855,7 @@ fid_t fibril_create_generic(errno_t (*func)(void *), void *arg, size_t stksz)
 		return 0;
 
 	fibril->stack_size = stksz;
-	fibril->stack = as_area_create(AS_AREA_ANY, fibril->stack_size,
-	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE | AS_AREA_GUARD |
-	    AS_AREA_LATE_RESERVE, AS_AREA_UNPAGED);
+	fibril->stack = _stack_get(fibril->stack_size);
 	if (fibril->stack == AS_MAP_FAILED) {
 		fibril_teardown(fibril);
 		return 0;
@@ -591,26 +894,40 @@ void fibril_destroy(fid_t fid)
 
 	assert(!fibril->is_running);
 	assert(fibril->stack);
+
+	/*
+	 * Do not cache the stack, it might not be backed by memory at all
+	 * and caching it would fault in its top.
+	 */
 	as_area_destroy(fibril->stack);
 	fibril_teardown(fibril);
 }
 
-static void _insert_timeout(_timeout_t *timeout)
+/** Get key of a timeout for timeout_dict. */
+static void *_timeout_getkey(odlink_t *link)
 {
-	futex_assert_is_locked(&fibril_futex);
-	assert(timeout);
-
-	link_t *tmp = timeout_list.head.next;
-	while (tmp != &timeout_list.head) {
-		_timeout_t *cur = list_get_instance(tmp, _timeout_t, link);
+	return &odict_get_instance(link, _timeout_t, link)->expires;
+}
 
-		if (ts_gteq(&cur->expires, &timeout->expires))
-			break;
+/** Compare expiration times of two timeouts for timeout_dict. */
+static int _timeout_cmp(void *a, void *b)
+{
+	struct timespec *ta = a;
+	struct timespec *tb = b;
+
+	if (ts_gt(ta, tb))
+		return 1;
+	if (ts_gt(tb, ta))
+		return -1;
+	return 0;
+}
 
-		tmp = tmp->next;
-	}
+static void _insert_timeout(_timeout_t *timeout)
+{
+	futex_assert_is_locked(&timeout_futex);
+	assert(timeout);
 
-	list_insert_before(&timeout->link, tmp);
+	odict_insert(&timeout->link, &timeout_dict, NULL);
 }
 
 /**
@@ -637,73 +954,81 @@ errno_t fibril_wait_timeout(fibril_event_t *event,
 			return ENOMEM;
 	}
 
-	futex_lock(&fibril_futex);
+	fibril_t *srcf = fibril_self();
+	fibril_t *dstf = NULL;
 
-	if (event->fibril == _EVENT_TRIGGERED) {
+	if (atomic_load_explicit(&event->fibril, memory_order_acquire) ==
+	    _EVENT_TRIGGERED) {
 		DPRINTF("### Already triggered. Returning. \n");
-		event->fibril = _EVENT_INITIAL;
-		futex_unlock(&fibril_futex);
+		atomic_store_explicit(&event->fibril, _EVENT_INITIAL,
+		    memory_order_relaxed);
 		return EOK;
 	}
 
-	assert(event->fibril == _EVENT_INITIAL);
-
-	fibril_t *srcf = fibril_self();
-	fibril_t *dstf = NULL;
-
 	/*
-	 * We cannot block here waiting for another fibril becoming
-	 * ready, since that would require unlocking the fibril_futex,
-	 * and that in turn would allow another thread to restore
-	 * the source fibril before this thread finished switching.
+	 * Find the fibril to switch to before the source fibril becomes
+	 * visible to other threads. If no fibril is ready, we cannot block
+	 * here waiting for one, since the source fibril could then be woken
+	 * up while this thread still runs on its stack.
 	 *
 	 * Instead, we switch to an internal "helper" fibril whose only
 	 * job is to wait for an event, freeing the source fibril for
 	 * wakeups. There is always one for each running thread.
+	 *
+	 * Note that _ready_list_pop_nonblocking() may check for IPC, find
+	 * a pending message, and trigger the event on which we are trying
+	 * to sleep. This is handled below.
 	 */
 
-	dstf = _ready_list_pop_nonblocking(true);
+	dstf = _ready_list_pop_nonblocking();
 	if (!dstf) {
-		// XXX: It is possible for the _ready_list_pop_nonblocking() to
-		//      check for IPC, find a pending message, and trigger the
-		//      event on which we are currently trying to sleep.
-		if (event->fibril == _EVENT_TRIGGERED) {
-			event->fibril = _EVENT_INITIAL;
-			futex_unlock(&fibril_futex);
-			return EOK;
-		}
-
 		dstf = srcf->thread_ctx;
 		assert(dstf);
 	}
 
 	_timeout_t timeout = { 0 };
 	if (expires) {
+		odlink_initialize(&timeout.link);
 		timeout.expires = *expires;
 		timeout.event = event;
+
+		futex_lock(&timeout_futex);
 		_insert_timeout(&timeout);
+		futex_unlock(&timeout_futex);
 	}
 
-	assert(srcf);
+	/* Don't make others wait for us while we wait for dstf. */
+	_fibril_wait_switched(dstf);
 
-	event->fibril = srcf;
 	srcf->sleep_event = event;
+	atomic_store_explicit(&srcf->is_switching, true, memory_order_relaxed);
 
-	assert(event->fibril != _EVENT_INITIAL);
+	fibril_t *state = _EVENT_INITIAL;
+	if (atomic_compare_exchange_strong_explicit(&event->fibril, &state,
+	    srcf, memory_order_acq_rel, memory_order_acquire)) {
+		_fibril_switch_to(SWITCH_FROM_BLOCKED, dstf);
+	} else {
+		/* Triggered or timed out in the meantime, don't block. */
+		atomic_store_explicit(&srcf->is_switching, false,
+		    memory_order_relaxed);
+		if (dstf != srcf->thread_ctx)
+			_ready_list_push(dstf);
+	}
 
-	_fibril_switch_to(SWITCH_FROM_BLOCKED, dstf, true);
+	if (expires) {
+		futex_lock(&timeout_futex);
+		if (odlink_used(&timeout.link))
+			odict_remove(&timeout.link);
+		futex_unlock(&timeout_futex);
+	}
 
-	assert(event->fibril != srcf);
-	assert(event->fibril != _EVENT_INITIAL);
-	assert(event->fibril == _EVENT_TIMED_OUT || event->fibril == _EVENT_TRIGGERED);
+	state = atomic_exchange_explicit(&event->fibril, _EVENT_INITIAL,
+	    memory_order_acq_rel);
 
-	list_remove(&timeout.link);
-	errno_t rc = (event->fibril == _EVENT_TIMED_OUT) ? ETIMEOUT : EOK;
-	event->fibril = _EVENT_INITIAL;
+	assert(state != srcf);
+	assert(state == _EVENT_TIMED_OUT || state == _EVENT_TRIGGERED);
 
-	futex_unlock(&fibril_futex);
-	_fibril_cleanup_dead();
-	return rc;
+	return (state == _EVENT_TIMED_OUT) ? ETIMEOUT : EOK;
 }
 
 void fibril_wait_for(fibril_event_t *event)
@@ -721,9 +1046,7 @@ void fibril_wait_for(fibril_event_t *event)
  */
 void fibril_notify(fibril_event_t *event)
 {
-	futex_lock(&fibril_futex);
 	_ready_list_push(_fibril_trigger_internal(event, _EVENT_TRIGGERED));
-	futex_unlock(&fibril_futex);
 }
 
 /** Start a fibril that has not been running yet. */
@@ -736,9 +1059,9 @@ void fibril_start(fibril_t *fibril)
 	if (!link_in_use(&fibril->all_link))
 		list_append(&fibril->all_link, &fibril_list);
 
-	_ready_list_push(fibril);
-
 	futex_unlock(&fibril_futex);
+
+	_ready_list_push(fibril);
 }
 
 /** Start a fibril that has not been running yet. (obsolete) */
@@ -775,9 +1098,9 @@ void fibril_yield(void)
 	if (fibril_self()->rmutex_locks > 0)
 		return;
 
-	fibril_t *f = _ready_list_pop_nonblocking(false);
+	fibril_t *f = _ready_list_pop_nonblocking();
 	if (f)
-		_fibril_switch_to(SWITCH_FROM_YIELD, f, false);
+		_fibril_switch_to(SWITCH_FROM_YIELD, f);
 }
 
 static errno_t _runner_fn(void *arg)
@@ -808,7 +1131,7 @@ int fibril_test_spawn_runners(int n)
 	errno_t rc;
 
 	for (int i = 0; i < n; i++) {
-		rc = thread_create(_runner_fn, NULL, "fibril runner");
+		rc = thread_create(_runner_fn, NULL, "fibril runner", NULL);
 		if (rc != EOK)
 			return i;
 	}
@@ -854,11 +1177,14 @@ _Noreturn void fibril_exit(long retval)
 	// TODO: implement fibril_join() and remember retval
 	(void) retval;
 
-	fibril_t *f = _ready_list_pop_nonblocking(false);
+	/* Blocks cached by this fibril would be lost with its TLS. */
+	__malloc_cache_flush();
+
+	fibril_t *f = _ready_list_pop_nonblocking();
 	if (!f)
 		f = fibril_self()->thread_ctx;
 
-	_fibril_switch_to(SWITCH_FROM_DEAD, f, false);
+	_fibril_switch_to(SWITCH_FROM_DEAD, f);
 	__builtin_unreachable();
 }
 
@@ -866,8 +1192,16 @@ void __fibrils_init(void)
 {
 	if (futex_initialize(&fibril_futex, 1) != EOK)
 		abort();
+	if (futex_initialize(&timeout_futex, 1) != EOK)
+		abort();
+	odict_initialize(&timeout_dict, _timeout_getkey, _timeout_cmp);
+	if (futex_initialize(&runqs[0].futex, 1) != EOK)
+		abort();
+	list_initialize(&runqs[0].list);
 	if (futex_initialize(&ipc_lists_futex, 1) != EOK)
 		abort();
+	if (fibril_rmutex_initialize(&stack_cache_lock) != EOK)
+		abort();
 
 	/*
 	 * We allow a fixed, small amount of parallelism for IPC reads, but
@@ -887,7 +1221,10 @@ void __fibrils_init(void)
 void __fibrils_fini(void)
 {
 	futex_destroy(&fibril_futex);
+	futex_destroy(&timeout_futex);
+	futex_destroy(&runqs[0].futex);
 	futex_destroy(&ipc_lists_futex);
+	fibril_rmutex_destroy(&stack_cache_lock);
 }
 
 void fibril_usleep(usec_t timeout)
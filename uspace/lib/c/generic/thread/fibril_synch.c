@@ -215,6 +215,52 @@ bool fibril_mutex_trylock(fibril_mutex_t *fm)
 	return locked;
 }
 
+/** Lock fibril mutex, giving up at a deadline.
+ *
+ * Unlike fibril_mutex_lock(), a timed lock does not take part in deadlock
+ * detection, as the wait is guaranteed to end.
+ *
+ * @param fm      Fibril mutex to lock
+ * @param expires Deadline as returned by getuptime() or NULL to wait forever
+ *
+ * @return EOK if the mutex was locked, ETIMEOUT if the deadline passed first
+ */
+errno_t fibril_mutex_lock_until(fibril_mutex_t *fm,
+    const struct timespec *expires)
+{
+	fibril_t *f = (fibril_t *) fibril_get_id();
+
+	futex_lock(&fibril_synch_futex);
+
+	if (fm->counter-- > 0) {
+		fm->oi.owned_by = f;
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	awaiter_t wdata = AWAITER_INIT;
+	list_append(&wdata.link, &fm->waiters);
+
+	futex_unlock(&fibril_synch_futex);
+
+	errno_t rc = fibril_wait_timeout(&wdata.event, expires);
+	if (rc == EOK)
+		return EOK;
+
+	futex_lock(&fibril_synch_futex);
+	if (!link_in_use(&wdata.link)) {
+		/* The mutex was handed over to us after all. */
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	list_remove(&wdata.link);
+	fm->counter++;
+	futex_unlock(&fibril_synch_futex);
+
+	return rc;
+}
+
 static void _fibril_mutex_unlock_unsafe(fibril_mutex_t *fm)
 {
 	assert(fm->oi.owned_by == (fibril_t *) fibril_get_id());
@@ -307,6 +353,141 @@ void fibril_rwlock_write_lock(fibril_rwlock_t *frw)
 	fibril_wait_for(&wdata.event);
 }
 
+bool fibril_rwlock_read_trylock(fibril_rwlock_t *frw)
+{
+	bool locked = false;
+
+	futex_lock(&fibril_synch_futex);
+	if (!frw->writers && list_empty(&frw->waiters)) {
+		if (frw->readers++ == 0)
+			frw->oi.owned_by = (fibril_t *) fibril_get_id();
+		locked = true;
+	}
+	futex_unlock(&fibril_synch_futex);
+
+	return locked;
+}
+
+bool fibril_rwlock_write_trylock(fibril_rwlock_t *frw)
+{
+	bool locked = false;
+
+	futex_lock(&fibril_synch_futex);
+	if (!frw->writers && !frw->readers) {
+		frw->oi.owned_by = (fibril_t *) fibril_get_id();
+		frw->writers++;
+		locked = true;
+	}
+	futex_unlock(&fibril_synch_futex);
+
+	return locked;
+}
+
+/** Let in the waiters at the head of the queue that can hold the lock now.
+ *
+ * Either a single writer or a run of readers is admitted.
+ */
+static void _fibril_rwlock_admit_waiters(fibril_rwlock_t *frw)
+{
+	while (!frw->writers && !list_empty(&frw->waiters)) {
+		link_t *tmp = list_first(&frw->waiters);
+		awaiter_t *wdp;
+		fibril_t *f;
+
+		wdp = list_get_instance(tmp, awaiter_t, link);
+		f = (fibril_t *) wdp->fid;
+
+		if (f->is_writer) {
+			if (frw->readers)
+				break;
+			frw->writers++;
+		} else {
+			frw->readers++;
+		}
+
+		f->waits_for = NULL;
+		list_remove(&wdp->link);
+		frw->oi.owned_by = f;
+		fibril_notify(&wdp->event);
+	}
+}
+
+static errno_t _fibril_rwlock_lock_until(fibril_rwlock_t *frw, bool writer,
+    const struct timespec *expires)
+{
+	fibril_t *f = (fibril_t *) fibril_get_id();
+
+	futex_lock(&fibril_synch_futex);
+
+	if (writer && !frw->writers && !frw->readers) {
+		frw->oi.owned_by = f;
+		frw->writers++;
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	if (!writer && !frw->writers && list_empty(&frw->waiters)) {
+		if (frw->readers++ == 0)
+			frw->oi.owned_by = f;
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	f->is_writer = writer;
+
+	awaiter_t wdata = AWAITER_INIT;
+	list_append(&wdata.link, &frw->waiters);
+
+	futex_unlock(&fibril_synch_futex);
+
+	errno_t rc = fibril_wait_timeout(&wdata.event, expires);
+	if (rc == EOK)
+		return EOK;
+
+	futex_lock(&fibril_synch_futex);
+	if (!link_in_use(&wdata.link)) {
+		/* We were admitted after all. */
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	/*
+	 * A writer that gives up may have been the only thing keeping
+	 * the readers queued behind it from joining the current ones.
+	 */
+	list_remove(&wdata.link);
+	_fibril_rwlock_admit_waiters(frw);
+	futex_unlock(&fibril_synch_futex);
+
+	return rc;
+}
+
+/** Read-lock fibril rwlock, giving up at a deadline.
+ *
+ * @param frw     Fibril rwlock to lock
+ * @param expires Deadline as returned by getuptime() or NULL to wait forever
+ *
+ * @return EOK if the rwlock was locked, ETIMEOUT if the deadline passed first
+ */
+errno_t fibril_rwlock_read_lock_until(fibril_rwlock_t *frw,
+    const struct timespec *expires)
+{
+	return _fibril_rwlock_lock_until(frw, false, expires);
+}
+
+/** Write-lock fibril rwlock, giving up at a deadline.
+ *
+ * @param frw     Fibril rwlock to lock
+ * @param expires Deadline as returned by getuptime() or NULL to wait forever
+ *
+ * @return EOK if the rwlock was locked, ETIMEOUT if the deadline passed first
+ */
+errno_t fibril_rwlock_write_lock_until(fibril_rwlock_t *frw,
+    const struct timespec *expires)
+{
+	return _fibril_rwlock_lock_until(frw, true, expires);
+}
+
 static void _fibril_rwlock_common_unlock(fibril_rwlock_t *frw)
 {
 	if (frw->readers) {
@@ -336,30 +517,7 @@ static void _fibril_rwlock_common_unlock(fibril_rwlock_t *frw)
 
 	frw->oi.owned_by = NULL;
 
-	while (!list_empty(&frw->waiters)) {
-		link_t *tmp = list_first(&frw->waiters);
-		awaiter_t *wdp;
-		fibril_t *f;
-
-		wdp = list_get_instance(tmp, awaiter_t, link);
-		f = (fibril_t *) wdp->fid;
-
-		if (f->is_writer) {
-			if (frw->readers)
-				break;
-			frw->writers++;
-		} else {
-			frw->readers++;
-		}
-
-		f->waits_for = NULL;
-		list_remove(&wdp->link);
-		frw->oi.owned_by = f;
-		fibril_notify(&wdp->event);
-
-		if (frw->writers)
-			break;
-	}
+	_fibril_rwlock_admit_waiters(frw);
 }
 
 void fibril_rwlock_read_unlock(fibril_rwlock_t *frw)
@@ -407,31 +565,22 @@ void fibril_condvar_initialize(fibril_condvar_t *fcv)
 	list_initialize(&fcv->waiters);
 }
 
-/**
- * FIXME: If `timeout` is negative, the function returns ETIMEOUT immediately,
- *        and if `timeout` is 0, the wait never times out.
- *        This is not consistent with other similar APIs.
+/** Wait on fibril condition variable until a deadline.
+ *
+ * @param fcv     Condition variable to wait on
+ * @param fm      Mutex protecting the condition, locked by the caller
+ * @param expires Deadline as returned by getuptime() or NULL to wait forever
+ *
+ * @return EOK if woken up, ETIMEOUT if the deadline passed first
  */
-errno_t
-fibril_condvar_wait_timeout(fibril_condvar_t *fcv, fibril_mutex_t *fm,
-    usec_t timeout)
+errno_t fibril_condvar_wait_until(fibril_condvar_t *fcv, fibril_mutex_t *fm,
+    const struct timespec *expires)
 {
 	assert(fibril_mutex_is_locked(fm));
 
-	if (timeout < 0)
-		return ETIMEOUT;
-
 	awaiter_t wdata = AWAITER_INIT;
 	wdata.mutex = fm;
 
-	struct timespec ts;
-	struct timespec *expires = NULL;
-	if (timeout) {
-		getuptime(&ts);
-		ts_add_diff(&ts, USEC2NSEC(timeout));
-		expires = &ts;
-	}
-
 	futex_lock(&fibril_synch_futex);
 	_fibril_mutex_unlock_unsafe(fm);
 	list_append(&wdata.link, &fcv->waiters);
@@ -449,6 +598,31 @@ fibril_condvar_wait_timeout(fibril_condvar_t *fcv, fibril_mutex_t *fm,
 	return timed_out ? ETIMEOUT : EOK;
 }
 
+/**
+ * FIXME: If `timeout` is negative, the function returns ETIMEOUT immediately,
+ *        and if `timeout` is 0, the wait never times out.
+ *        This is not consistent with other similar APIs.
+ */
+errno_t
+fibril_condvar_wait_timeout(fibril_condvar_t *fcv, fibril_mutex_t *fm,
+    usec_t timeout)
+{
+	assert(fibril_mutex_is_locked(fm));
+
+	if (timeout < 0)
+		return ETIMEOUT;
+
+	struct timespec ts;
+	struct timespec *expires = NULL;
+	if (timeout) {
+		getuptime(&ts);
+		ts_add_diff(&ts, USEC2NSEC(timeout));
+		expires = &ts;
+	}
+
+	return fibril_condvar_wait_until(fcv, fm, expires);
+}
+
 void fibril_condvar_wait(fibril_condvar_t *fcv, fibril_mutex_t *fm)
 {
 	(void) fibril_condvar_wait_timeout(fcv, fm, 0);
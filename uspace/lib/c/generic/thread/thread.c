@@ -45,6 +45,7 @@
 
 #include "../private/thread.h"
 #include "../private/fibril.h"
+#include "../private/malloc.h"
 
 /** Main thread function.
  *
@@ -65,15 +66,16 @@ static void __thread_main(void *arg)
 	__tcb_set(fibril->tcb);
 
 	fibril->func(fibril->arg);
+
 	/*
-	 * XXX: we cannot free the userspace stack while running on it
-	 *
-	 * free(uarg->uspace_stack);
-	 * free(uarg);
+	 * We cannot free the userspace stack while running on it,
+	 * the kernel destroys it on our behalf.
 	 */
+	void *stack = fibril->stack;
 
+	__malloc_cache_flush();
 	fibril_teardown(fibril);
-	thread_exit(0);
+	thread_exit(0, stack);
 }
 
 /** Create userspace thread.
@@ -84,11 +86,13 @@ static void __thread_main(void *arg)
  * @param function Function implementing the thread.
  * @param arg Argument to be passed to thread.
  * @param name Symbolic name of the thread.
- * @param tid Thread ID of the newly created thread.
+ * @param fid If not NULL, the fibril ID the thread runs as, i.e. the value
+ *            fibril_get_id() returns in the new thread.
  *
  * @return Zero on success or a code from @ref errno.h on failure.
  */
-errno_t thread_create(errno_t (*func)(void *), void *arg, const char *name)
+errno_t thread_create(errno_t (*func)(void *), void *arg, const char *name,
+    fid_t *fid)
 {
 	fibril_t *fibril = fibril_alloc();
 	if (!fibril)
@@ -106,9 +110,19 @@ errno_t thread_create(errno_t (*func)(void *), void *arg, const char *name)
 		return ENOMEM;
 	}
 
+	fibril->stack = stack;
+	fibril->stack_size = stack_size;
+
 	uintptr_t sp = arch_thread_prepare(stack, stack_size, __thread_main,
 	    fibril);
 
+	/*
+	 * The new thread may run and even finish before the syscall returns,
+	 * so the ID has to be stored beforehand.
+	 */
+	if (fid)
+		*fid = fibril;
+
 	errno_t rc = (errno_t) __SYSCALL4(SYS_THREAD_CREATE,
 	    (sysarg_t) FADDR(__thread_entry), sp,
 	    (sysarg_t) name, (sysarg_t) str_size(name));
@@ -119,6 +133,7 @@ errno_t thread_create(errno_t (*func)(void *), void *arg, const char *name)
 		 * Free up the allocated data.
 		 */
 		as_area_destroy(stack);
+		fibril_teardown(fibril);
 	}
 
 	return rc;
@@ -127,11 +142,13 @@ errno_t thread_create(errno_t (*func)(void *), void *arg, const char *name)
 /** Terminate current thread.
  *
  * @param status Exit status. Currently not used.
+ * @param stack  Address space area with the stack of the thread to be
+ *               destroyed once the thread stops running on it or NULL.
  *
  */
-void thread_exit(int status)
+void thread_exit(int status, void *stack)
 {
-	__SYSCALL1(SYS_THREAD_EXIT, (sysarg_t) status);
+	__SYSCALL2(SYS_THREAD_EXIT, (sysarg_t) status, (sysarg_t) stack);
 
 	/* Unreachable */
 	while (true)
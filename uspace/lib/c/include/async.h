@@ -342,6 +342,7 @@ extern errno_t async_data_read_forward_4_1(async_exch_t *, sysarg_t, sysarg_t,
 extern aid_t async_data_read(async_exch_t *, void *, size_t, ipc_call_t *);
 extern errno_t async_data_read_start(async_exch_t *, void *, size_t);
 extern bool async_data_read_receive(ipc_call_t *, size_t *);
+extern bool async_data_read_receive_max(ipc_call_t *, size_t *, size_t);
 extern errno_t async_data_read_finalize(ipc_call_t *, const void *, size_t);
 
 extern errno_t async_data_write_forward_0_0(async_exch_t *, sysarg_t);
@@ -366,6 +367,7 @@ extern errno_t async_data_write_forward_4_1(async_exch_t *, sysarg_t, sysarg_t,
 
 extern errno_t async_data_write_start(async_exch_t *, const void *, size_t);
 extern bool async_data_write_receive(ipc_call_t *, size_t *);
+extern bool async_data_write_receive_max(ipc_call_t *, size_t *, size_t);
 extern errno_t async_data_write_finalize(ipc_call_t *, void *, size_t);
 
 extern errno_t async_data_write_accept(void **, const bool, const size_t,
@@ -70,6 +70,9 @@ extern int fibril_test_spawn_runners(int);
 
 extern void fibril_detach(fid_t fid);
 
+extern void fibril_stack_cache_set_limit(size_t);
+extern void fibril_stack_cache_trim(void);
+
 extern void fibril_start(fid_t);
 extern __noreturn void fibril_exit(long);
 
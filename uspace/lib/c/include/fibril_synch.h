@@ -167,12 +167,20 @@ static inline __CONSTEXPR void fibril_mutex_initialize(fibril_mutex_t *fm)
 
 extern void fibril_mutex_lock(fibril_mutex_t *);
 extern bool fibril_mutex_trylock(fibril_mutex_t *);
+extern errno_t fibril_mutex_lock_until(fibril_mutex_t *,
+    const struct timespec *);
 extern void fibril_mutex_unlock(fibril_mutex_t *);
 extern bool fibril_mutex_is_locked(fibril_mutex_t *);
 
 extern void fibril_rwlock_initialize(fibril_rwlock_t *);
 extern void fibril_rwlock_read_lock(fibril_rwlock_t *);
 extern void fibril_rwlock_write_lock(fibril_rwlock_t *);
+extern bool fibril_rwlock_read_trylock(fibril_rwlock_t *);
+extern bool fibril_rwlock_write_trylock(fibril_rwlock_t *);
+extern errno_t fibril_rwlock_read_lock_until(fibril_rwlock_t *,
+    const struct timespec *);
+extern errno_t fibril_rwlock_write_lock_until(fibril_rwlock_t *,
+    const struct timespec *);
 extern void fibril_rwlock_read_unlock(fibril_rwlock_t *);
 extern void fibril_rwlock_write_unlock(fibril_rwlock_t *);
 extern bool fibril_rwlock_is_read_locked(fibril_rwlock_t *);
@@ -182,6 +190,8 @@ extern bool fibril_rwlock_is_locked(fibril_rwlock_t *);
 extern void fibril_condvar_initialize(fibril_condvar_t *);
 extern errno_t fibril_condvar_wait_timeout(fibril_condvar_t *, fibril_mutex_t *,
     usec_t);
+extern errno_t fibril_condvar_wait_until(fibril_condvar_t *, fibril_mutex_t *,
+    const struct timespec *);
 extern void fibril_condvar_wait(fibril_condvar_t *, fibril_mutex_t *);
 extern void fibril_condvar_signal(fibril_condvar_t *);
 extern void fibril_condvar_broadcast(fibril_condvar_t *);
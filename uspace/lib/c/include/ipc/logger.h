@@ -34,6 +34,9 @@
 #define _LIBC_IPC_LOGGER_H_
 
 #include <ipc/common.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
 
 typedef enum {
 	/** Set (global) default displayed logging level.
@@ -61,7 +64,8 @@ typedef enum {
 	/** Create new log.
 	 *
 	 * Arguments: parent log id (0 for top-level log).
-	 * Returns: error code, log id
+	 * Returns: error code, log id, index of the log in
+	 *          logger_ring_t.levels
 	 * Followed by: string with log name.
 	 */
 	LOGGER_WRITER_CREATE_LOG = IPC_FIRST_USER_METHOD,
@@ -71,9 +75,81 @@ typedef enum {
 	 * Returns: error code
 	 * Followed by: string with the message.
 	 */
-	LOGGER_WRITER_MESSAGE
+	LOGGER_WRITER_MESSAGE,
+	/** Set up a ring buffer for messages.
+	 *
+	 * Returns: error code
+	 * Followed by: share out of the area with logger_ring_t
+	 *              (at least LOGGER_RING_SIZE bytes).
+	 */
+	LOGGER_WRITER_SET_RING,
+	/** Write out all messages in the ring buffer.
+	 *
+	 * Sent when the logger has set logger_ring_t.armed, or when
+	 * the ring buffer is full.
+	 *
+	 * Returns: error code
+	 */
+	LOGGER_WRITER_FLUSH
 } logger_writer_request_t;
 
+/** Maximum number of logs a client may create. */
+#define LOGGER_MAX_LOGS 100
+
+/** Alignment (and size granularity) of records in the ring buffer. */
+#define LOGGER_RING_ALIGN 16
+
+/** Record level of a record that only skips to the start of the buffer. */
+#define LOGGER_RING_PAD ((uint32_t) -1)
+
+/** Record in the ring buffer. */
+typedef struct {
+	/** Size of the whole record, multiple of LOGGER_RING_ALIGN. */
+	uint32_t size;
+	/** Message severity level (log_level_t) or LOGGER_RING_PAD. */
+	uint32_t level;
+	/** Log id. */
+	sysarg_t log;
+	/** NUL-terminated message. */
+	char message[];
+} logger_ring_rec_t;
+
+/** Shared area of a client for sending messages without waiting.
+ *
+ * The client appends records at head, the logger consumes them from tail.
+ * Both are free-running byte counters, the position in data is their
+ * value modulo the size of data. A record never wraps around the end
+ * of data, a padding record is inserted instead.
+ *
+ * The logger also publishes the level of each log of the client here,
+ * so that the client does not need to send messages that would be
+ * discarded anyway.
+ */
+typedef struct {
+	/** Level of logs by their index, written by the logger. */
+	atomic_uint levels[LOGGER_MAX_LOGS];
+	/** Written by the client. */
+	atomic_size_t head;
+	/** Written by the logger. */
+	atomic_size_t tail;
+	/**
+	 * Set by the logger when it runs out of messages. The client that
+	 * clears it sends LOGGER_WRITER_FLUSH.
+	 */
+	atomic_bool armed;
+	alignas(LOGGER_RING_ALIGN) uint8_t data[];
+} logger_ring_t;
+
+/** Size of logger_ring_t.data.
+ *
+ * Must be a power of two, so that the position of head and tail in data
+ * does not skip when the counters wrap around.
+ */
+#define LOGGER_RING_DATA_SIZE 65536
+
+/** Minimum size of the area with the ring buffer. */
+#define LOGGER_RING_SIZE (sizeof(logger_ring_t) + LOGGER_RING_DATA_SIZE)
+
 #endif
 
 /** @}
@@ -45,6 +45,7 @@
 
 extern stats_cpu_t *stats_get_cpus(size_t *);
 extern stats_physmem_t *stats_get_physmem(void);
+extern stats_slab_t *stats_get_slabs(size_t *);
 extern load_t *stats_get_load(size_t *);
 
 extern stats_task_t *stats_get_tasks(size_t *);
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <adt/hash_table.h>
+#include <pcut/pcut.h>
+#include <stdlib.h>
+
+/** Test entry */
+typedef struct {
+	ht_link_t link;
+	int key;
+} test_entry_t;
+
+enum {
+	/** Number of test entries, enough to cause several resizes */
+	test_seq_len = 1000
+};
+
+static test_entry_t entries[test_seq_len];
+
+static size_t test_key_hash(const void *key)
+{
+	return *(const int *) key;
+}
+
+static size_t test_hash(const ht_link_t *item)
+{
+	return hash_table_get_inst(item, test_entry_t, link)->key;
+}
+
+static bool test_equal(const ht_link_t *a, const ht_link_t *b)
+{
+	return hash_table_get_inst(a, test_entry_t, link)->key ==
+	    hash_table_get_inst(b, test_entry_t, link)->key;
+}
+
+static bool test_key_equal(const void *key, size_t hash, const ht_link_t *item)
+{
+	return *(const int *) key ==
+	    hash_table_get_inst(item, test_entry_t, link)->key;
+}
+
+static const hash_table_ops_t test_ops = {
+	.hash = test_hash,
+	.key_hash = test_key_hash,
+	.key_equal = test_key_equal,
+	.equal = test_equal,
+	.remove_callback = NULL
+};
+
+/** Check that exactly the entries from @a lo to @a hi are in the table. */
+static void check_range(hash_table_t *h, int lo, int hi)
+{
+	PCUT_ASSERT_INT_EQUALS(hi - lo, hash_table_size(h));
+
+	for (int i = 0; i < test_seq_len; i++) {
+		ht_link_t *link = hash_table_find(h, &i);
+
+		if (i >= lo && i < hi) {
+			PCUT_ASSERT_EQUALS(&entries[i].link, link);
+			PCUT_ASSERT_NULL(hash_table_find_next(h, link));
+		} else {
+			PCUT_ASSERT_NULL(link);
+		}
+	}
+}
+
+/** Count entries visited by hash_table_apply(). */
+static bool count_entry(ht_link_t *item, void *arg)
+{
+	(*(size_t *) arg)++;
+	return true;
+}
+
+/** Remove every entry with an even key during hash_table_apply(). */
+static bool remove_even(ht_link_t *item, void *arg)
+{
+	if (hash_table_get_inst(item, test_entry_t, link)->key % 2 == 0)
+		hash_table_remove_item(arg, item);
+
+	return true;
+}
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(hash_table);
+
+/** Entries remain reachable while the table grows and shrinks. */
+PCUT_TEST(grow_shrink)
+{
+	hash_table_t h;
+	int i;
+
+	PCUT_ASSERT_TRUE(hash_table_create(&h, 0, 0, &test_ops));
+
+	for (i = 0; i < test_seq_len; i++) {
+		entries[i].key = i;
+		PCUT_ASSERT_TRUE(hash_table_insert_unique(&h, &entries[i].link));
+		PCUT_ASSERT_FALSE(hash_table_insert_unique(&h,
+		    &entries[i].link));
+		if (i % 97 == 0)
+			check_range(&h, 0, i + 1);
+	}
+
+	check_range(&h, 0, test_seq_len);
+
+	for (i = 0; i < test_seq_len; i++) {
+		PCUT_ASSERT_INT_EQUALS(1, hash_table_remove(&h, &i));
+		if (i % 97 == 0)
+			check_range(&h, i + 1, test_seq_len);
+	}
+
+	PCUT_ASSERT_INT_EQUALS(0, hash_table_size(&h));
+	hash_table_destroy(&h);
+}
+
+/** Every entry is visited once when applying in the middle of a resize. */
+PCUT_TEST(apply_resize)
+{
+	hash_table_t h;
+	size_t cnt;
+	int i;
+
+	PCUT_ASSERT_TRUE(hash_table_create(&h, 0, 0, &test_ops));
+
+	for (i = 0; i < test_seq_len; i++) {
+		entries[i].key = i;
+		hash_table_insert(&h, &entries[i].link);
+
+		cnt = 0;
+		hash_table_apply(&h, count_entry, &cnt);
+		PCUT_ASSERT_INT_EQUALS(i + 1, cnt);
+	}
+
+	hash_table_apply(&h, remove_even, &h);
+	PCUT_ASSERT_INT_EQUALS(test_seq_len / 2, hash_table_size(&h));
+
+	for (i = 0; i < test_seq_len; i++) {
+		ht_link_t *link = hash_table_find(&h, &i);
+
+		if (i % 2 == 0)
+			PCUT_ASSERT_NULL(link);
+		else
+			PCUT_ASSERT_EQUALS(&entries[i].link, link);
+	}
+
+	hash_table_clear(&h);
+	PCUT_ASSERT_INT_EQUALS(0, hash_table_size(&h));
+	hash_table_destroy(&h);
+}
+
+PCUT_EXPORT(hash_table);
@@ -138,4 +138,52 @@ PCUT_TEST(fire)
 	fibril_timer_destroy(t);
 }
 
+#define ORDER_TIMERS 4
+
+typedef struct {
+	int *fired;
+	int order;
+} order_arg_t;
+
+static void test_order_fn(void *arg)
+{
+	order_arg_t *oa = (order_arg_t *)arg;
+
+	oa->order = (*oa->fired)++;
+}
+
+/** Timers fire in the order of their expiration, not of being set. */
+PCUT_TEST(fire_in_order)
+{
+	fibril_timer_t *t[ORDER_TIMERS];
+	order_arg_t oa[ORDER_TIMERS];
+	int fired;
+	int i;
+
+	fired = 0;
+
+	for (i = 0; i < ORDER_TIMERS; i++) {
+		t[i] = fibril_timer_create(NULL);
+		PCUT_ASSERT_NOT_NULL(t[i]);
+
+		oa[i].fired = &fired;
+		oa[i].order = -1;
+	}
+
+	/* Set in reverse order of expiration. */
+	for (i = 0; i < ORDER_TIMERS; i++) {
+		fibril_timer_set(t[i], (ORDER_TIMERS - i) * 20 * 1000,
+		    test_order_fn, &oa[i]);
+	}
+
+	fibril_usleep((ORDER_TIMERS + 1) * 20 * 1000);
+
+	PCUT_ASSERT_INT_EQUALS(ORDER_TIMERS, fired);
+	for (i = 0; i < ORDER_TIMERS; i++)
+		PCUT_ASSERT_INT_EQUALS(ORDER_TIMERS - 1 - i, oa[i].order);
+
+	for (i = 0; i < ORDER_TIMERS; i++)
+		fibril_timer_destroy(t[i]);
+}
+
 PCUT_EXPORT(fibril_timer);
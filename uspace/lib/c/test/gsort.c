@@ -28,6 +28,7 @@
 
 #include <pcut/pcut.h>
 #include <gsort.h>
+#include <stdlib.h>
 
 static int cmp_func(void *a, void *b, void *param)
 {
@@ -40,6 +41,22 @@ static int cmp_func(void *a, void *b, void *param)
 	return ia < ib ? -1 : 1;
 }
 
+typedef struct {
+	int key;
+	int idx;
+} stable_elem_t;
+
+static int stable_cmp_func(void *a, void *b, void *param)
+{
+	int ka = ((stable_elem_t *)a)->key;
+	int kb = ((stable_elem_t *)b)->key;
+
+	if (ka == kb)
+		return 0;
+
+	return ka < kb ? -1 : 1;
+}
+
 PCUT_INIT;
 
 PCUT_TEST_SUITE(gsort);
@@ -105,4 +122,29 @@ PCUT_TEST(gsort_desc)
 	}
 }
 
+/* sort long sequence with many equal keys, equal keys keep their order */
+PCUT_TEST(gsort_stable)
+{
+	int size = 1000;
+	stable_elem_t *data = calloc(size, sizeof(stable_elem_t));
+	PCUT_ASSERT_NOT_NULL(data);
+
+	for (int i = 0; i < size; i++) {
+		data[i].key = (i * 7919) % 13;
+		data[i].idx = i;
+	}
+
+	bool ret = gsort(data, size, sizeof(stable_elem_t), stable_cmp_func,
+	    NULL);
+	PCUT_ASSERT_TRUE(ret);
+
+	for (int i = 1; i < size; i++) {
+		PCUT_ASSERT_TRUE(data[i - 1].key <= data[i].key);
+		if (data[i - 1].key == data[i].key)
+			PCUT_ASSERT_TRUE(data[i - 1].idx < data[i].idx);
+	}
+
+	free(data);
+}
+
 PCUT_EXPORT(gsort);
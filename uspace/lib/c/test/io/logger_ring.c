@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <io/logger_ring.h>
+#include <pcut/pcut.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(logger_ring);
+
+/** Create an empty ring with head and tail set to @a start. */
+static logger_ring_t *ring_create(size_t start)
+{
+	logger_ring_t *ring = calloc(1, LOGGER_RING_SIZE);
+	PCUT_ASSERT_NOT_NULL(ring);
+
+	atomic_store(&ring->head, start);
+	atomic_store(&ring->tail, start);
+	return ring;
+}
+
+/** Consume the next message from the ring, skipping padding.
+ *
+ * @return The message or NULL if the ring is empty.
+ */
+static const char *ring_get(logger_ring_t *ring, uint32_t *level)
+{
+	size_t head = atomic_load(&ring->head);
+	size_t tail = atomic_load(&ring->tail);
+
+	while (tail != head) {
+		size_t size;
+		const logger_ring_rec_t *rec = logger_ring_read(ring, head,
+		    tail, &size);
+		PCUT_ASSERT_NOT_NULL(rec);
+
+		tail += size;
+		atomic_store(&ring->tail, tail);
+
+		if (rec->level != LOGGER_RING_PAD) {
+			*level = rec->level;
+			return rec->message;
+		}
+	}
+
+	return NULL;
+}
+
+/** Messages come out in the order they were appended. */
+PCUT_TEST(append_read)
+{
+	logger_ring_t *ring = ring_create(0);
+	uint32_t level;
+
+	PCUT_ASSERT_ERRNO_VAL(EOK, logger_ring_append(ring, 1, 2, "first"));
+	PCUT_ASSERT_ERRNO_VAL(EOK, logger_ring_append(ring, 1, 3, "second"));
+
+	PCUT_ASSERT_STR_EQUALS("first", ring_get(ring, &level));
+	PCUT_ASSERT_INT_EQUALS(2, level);
+	PCUT_ASSERT_STR_EQUALS("second", ring_get(ring, &level));
+	PCUT_ASSERT_INT_EQUALS(3, level);
+	PCUT_ASSERT_NULL(ring_get(ring, &level));
+
+	free(ring);
+}
+
+/** Head and tail wrapping around the end of size_t are harmless. */
+PCUT_TEST(counter_wraparound)
+{
+	/* Start just before the end of both data and the counters. */
+	size_t start = (size_t) -(2 * LOGGER_RING_ALIGN);
+	logger_ring_t *ring = ring_create(start);
+	char msg[64];
+	uint32_t level;
+
+	for (unsigned i = 0; i < 3 * LOGGER_RING_DATA_SIZE / 64; i++) {
+		/* Vary the length, so that some records need padding. */
+		snprintf(msg, sizeof(msg), "%*u", (int) (i % 40) + 1, i);
+		PCUT_ASSERT_ERRNO_VAL(EOK, logger_ring_append(ring, 1, i, msg));
+
+		PCUT_ASSERT_STR_EQUALS(msg, ring_get(ring, &level));
+		PCUT_ASSERT_INT_EQUALS(i, level);
+	}
+
+	/* The counters wrapped around and the ring is empty again. */
+	PCUT_ASSERT_TRUE(atomic_load(&ring->head) < start);
+	PCUT_ASSERT_INT_EQUALS(atomic_load(&ring->head),
+	    atomic_load(&ring->tail));
+
+	free(ring);
+}
+
+/** A full ring refuses new messages until the logger consumes some. */
+PCUT_TEST(full)
+{
+	size_t start = (size_t) -(LOGGER_RING_DATA_SIZE / 2);
+	logger_ring_t *ring = ring_create(start);
+	char msg[64];
+	uint32_t level;
+	unsigned count = 0;
+	errno_t rc;
+
+	while (true) {
+		snprintf(msg, sizeof(msg), "message %u", count);
+		rc = logger_ring_append(ring, 1, count, msg);
+		if (rc != EOK)
+			break;
+		++count;
+	}
+
+	PCUT_ASSERT_ERRNO_VAL(EBUSY, rc);
+	PCUT_ASSERT_TRUE(count > 0);
+	PCUT_ASSERT_TRUE(atomic_load(&ring->head) -
+	    atomic_load(&ring->tail) <= LOGGER_RING_DATA_SIZE);
+
+	/* Nothing was overwritten. */
+	PCUT_ASSERT_STR_EQUALS("message 0", ring_get(ring, &level));
+	PCUT_ASSERT_INT_EQUALS(0, level);
+
+	/* There is room for one more message now. */
+	snprintf(msg, sizeof(msg), "message %u", count);
+	PCUT_ASSERT_ERRNO_VAL(EOK, logger_ring_append(ring, 1, count, msg));
+
+	for (unsigned i = 1; i <= count; i++) {
+		snprintf(msg, sizeof(msg), "message %u", i);
+		PCUT_ASSERT_STR_EQUALS(msg, ring_get(ring, &level));
+		PCUT_ASSERT_INT_EQUALS(i, level);
+	}
+
+	PCUT_ASSERT_NULL(ring_get(ring, &level));
+
+	free(ring);
+}
+
+/** A message that cannot fit in the ring at all is refused. */
+PCUT_TEST(too_large)
+{
+	logger_ring_t *ring = ring_create(0);
+	char *msg = malloc(LOGGER_RING_DATA_SIZE + 1);
+	PCUT_ASSERT_NOT_NULL(msg);
+
+	memset(msg, 'x', LOGGER_RING_DATA_SIZE);
+	msg[LOGGER_RING_DATA_SIZE] = '\0';
+
+	PCUT_ASSERT_ERRNO_VAL(ELIMIT, logger_ring_append(ring, 1, 0, msg));
+	PCUT_ASSERT_INT_EQUALS(0, atomic_load(&ring->head));
+
+	free(msg);
+	free(ring);
+}
+
+/** A record pointing past head is reported as corrupted. */
+PCUT_TEST(corrupted)
+{
+	logger_ring_t *ring = ring_create(0);
+	size_t size;
+
+	PCUT_ASSERT_ERRNO_VAL(EOK, logger_ring_append(ring, 1, 0, "message"));
+
+	logger_ring_rec_t *rec = (logger_ring_rec_t *) ring->data;
+	rec->size += LOGGER_RING_ALIGN;
+
+	PCUT_ASSERT_NULL(logger_ring_read(ring, atomic_load(&ring->head), 0,
+	    &size));
+
+	free(ring);
+}
+
+PCUT_EXPORT(logger_ring);
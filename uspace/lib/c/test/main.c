@@ -38,11 +38,14 @@ PCUT_IMPORT(circ_buf);
 PCUT_IMPORT(double_to_str);
 PCUT_IMPORT(fibril_timer);
 PCUT_IMPORT(getopt);
+PCUT_IMPORT(hash_table);
 PCUT_IMPORT(gsort);
 PCUT_IMPORT(ieee_double);
 PCUT_IMPORT(imath);
 PCUT_IMPORT(inttypes);
 PCUT_IMPORT(loc);
+PCUT_IMPORT(logger_ring);
+PCUT_IMPORT(malloc);
 PCUT_IMPORT(mem);
 PCUT_IMPORT(odict);
 PCUT_IMPORT(perf);
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <malloc.h>
+#include <pcut/pcut.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(malloc);
+
+#define BLOCK_COUNT 256
+
+/** Fill a block with a pattern derived from its index. */
+static void fill_block(uint8_t *block, size_t size, size_t index)
+{
+	for (size_t i = 0; i < size; i++)
+		block[i] = (uint8_t) (index + i);
+}
+
+/** Check the pattern written by fill_block(). */
+static bool check_block(uint8_t *block, size_t size, size_t index)
+{
+	for (size_t i = 0; i < size; i++) {
+		if (block[i] != (uint8_t) (index + i))
+			return false;
+	}
+
+	return true;
+}
+
+/** Blocks of various sizes do not overlap and are aligned */
+PCUT_TEST(sizes)
+{
+	uint8_t *blocks[BLOCK_COUNT];
+
+	for (size_t i = 0; i < BLOCK_COUNT; i++) {
+		size_t size = i * 37 % 2048;
+
+		blocks[i] = malloc(size);
+		PCUT_ASSERT_NOT_NULL(blocks[i]);
+		PCUT_ASSERT_INT_EQUALS(0, (uintptr_t) blocks[i] % alignof(max_align_t));
+
+		fill_block(blocks[i], size, i);
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+
+	for (size_t i = 0; i < BLOCK_COUNT; i++) {
+		PCUT_ASSERT_TRUE(check_block(blocks[i], i * 37 % 2048, i));
+		free(blocks[i]);
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+/** Freed small blocks are reused */
+PCUT_TEST(reuse)
+{
+	void *first = malloc(40);
+	PCUT_ASSERT_NOT_NULL(first);
+	free(first);
+
+	void *second = malloc(40);
+	PCUT_ASSERT_TRUE(first == second);
+	free(second);
+}
+
+/** memalign returns blocks with the requested alignment */
+PCUT_TEST(memalign)
+{
+	for (size_t align = 1; align <= 4096; align *= 2) {
+		void *small = memalign(align, 24);
+		void *large = memalign(align, 5000);
+
+		PCUT_ASSERT_NOT_NULL(small);
+		PCUT_ASSERT_NOT_NULL(large);
+		PCUT_ASSERT_INT_EQUALS(0, (uintptr_t) small % align);
+		PCUT_ASSERT_INT_EQUALS(0, (uintptr_t) large % align);
+
+		free(small);
+		free(large);
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+/** realloc keeps the contents when moving between small and large blocks */
+PCUT_TEST(realloc)
+{
+	uint8_t *block = malloc(10);
+	PCUT_ASSERT_NOT_NULL(block);
+	fill_block(block, 10, 1);
+
+	/* Within the same size class */
+	block = realloc(block, 16);
+	PCUT_ASSERT_NOT_NULL(block);
+	PCUT_ASSERT_TRUE(check_block(block, 10, 1));
+	fill_block(block, 16, 1);
+
+	/* To a bigger size class */
+	block = realloc(block, 500);
+	PCUT_ASSERT_NOT_NULL(block);
+	PCUT_ASSERT_TRUE(check_block(block, 16, 1));
+	fill_block(block, 500, 1);
+
+	/* To a heap block */
+	block = realloc(block, 10000);
+	PCUT_ASSERT_NOT_NULL(block);
+	PCUT_ASSERT_TRUE(check_block(block, 500, 1));
+
+	/* And back */
+	block = realloc(block, 100);
+	PCUT_ASSERT_NOT_NULL(block);
+	PCUT_ASSERT_TRUE(check_block(block, 100, 1));
+
+	free(block);
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+typedef struct {
+	fibril_semaphore_t *done;
+	void *blocks[BLOCK_COUNT];
+} worker_t;
+
+static errno_t worker_fn(void *arg)
+{
+	worker_t *worker = arg;
+
+	for (size_t i = 0; i < BLOCK_COUNT; i++) {
+		/* Free blocks allocated by the other worker. */
+		free(worker->blocks[i]);
+		worker->blocks[i] = malloc(i * 4);
+		fibril_yield();
+	}
+
+	fibril_semaphore_up(worker->done);
+	return EOK;
+}
+
+/** Blocks can be freed by other fibrils, including exited ones */
+PCUT_TEST(fibrils)
+{
+	fibril_semaphore_t done;
+	worker_t workers[2];
+
+	fibril_semaphore_initialize(&done, 0);
+
+	for (size_t i = 0; i < BLOCK_COUNT; i++) {
+		workers[0].blocks[i] = malloc(i * 4);
+		workers[1].blocks[i] = NULL;
+	}
+
+	for (size_t round = 0; round < 4; round++) {
+		for (size_t i = 0; i < 2; i++) {
+			workers[i].done = &done;
+
+			fid_t fid = fibril_create(worker_fn, &workers[i]);
+			PCUT_ASSERT_TRUE(fid != 0);
+			fibril_add_ready(fid);
+		}
+
+		fibril_semaphore_down(&done);
+		fibril_semaphore_down(&done);
+
+		/* Hand the blocks over to the other worker. */
+		for (size_t i = 0; i < BLOCK_COUNT; i++) {
+			void *tmp = workers[0].blocks[i];
+			workers[0].blocks[i] = workers[1].blocks[i];
+			workers[1].blocks[i] = tmp;
+		}
+	}
+
+	for (size_t i = 0; i < BLOCK_COUNT; i++) {
+		free(workers[0].blocks[i]);
+		free(workers[1].blocks[i]);
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+PCUT_EXPORT(malloc);
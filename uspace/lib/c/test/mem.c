@@ -28,11 +28,36 @@
 
 #include <mem.h>
 #include <pcut/pcut.h>
+#include <stddef.h>
+#include <stdint.h>
 
 PCUT_INIT;
 
 PCUT_TEST_SUITE(mem);
 
+/** Large enough for the rep movsb/stosb path on amd64. */
+#define SWEEP_MAX 3000
+#define SWEEP_BUF (SWEEP_MAX + 64)
+
+static uint8_t sweep_src[SWEEP_BUF];
+static uint8_t sweep_dst[SWEEP_BUF];
+
+/** Sizes to sweep: every size up to 80, then a few larger ones. */
+static size_t sweep_next(size_t n)
+{
+	if (n < 80)
+		return n + 1;
+	if (n < SWEEP_MAX)
+		return n * 2 + 1 < SWEEP_MAX ? n * 2 + 1 : SWEEP_MAX;
+	return SIZE_MAX;
+}
+
+static void sweep_fill(uint8_t *buf, size_t size, uint8_t seed)
+{
+	for (size_t i = 0; i < size; i++)
+		buf[i] = (uint8_t) (i * 7 + seed);
+}
+
 /** memcpy function */
 PCUT_TEST(memcpy)
 {
@@ -115,4 +140,85 @@ PCUT_TEST(memset)
 	PCUT_ASSERT_INT_EQUALS('x', buf[4]);
 }
 
+/** memcpy with various sizes and alignments */
+PCUT_TEST(memcpy_sweep)
+{
+	sweep_fill(sweep_src, SWEEP_BUF, 1);
+
+	for (size_t n = 0; n <= SWEEP_MAX; n = sweep_next(n)) {
+		for (size_t off = 0; off < 32; off += 5) {
+			sweep_fill(sweep_dst, SWEEP_BUF, 2);
+
+			void *p = memcpy(sweep_dst + off, sweep_src + 3, n);
+			PCUT_ASSERT_TRUE(p == sweep_dst + off);
+
+			for (size_t i = 0; i < SWEEP_BUF; i++) {
+				uint8_t expect = (i >= off && i < off + n) ?
+				    sweep_src[3 + i - off] : (uint8_t) (i * 7 + 2);
+				PCUT_ASSERT_INT_EQUALS(expect, sweep_dst[i]);
+			}
+		}
+	}
+}
+
+/** memmove with overlapping blocks in both directions */
+PCUT_TEST(memmove_sweep)
+{
+	for (size_t n = 0; n <= SWEEP_MAX; n = sweep_next(n)) {
+		for (size_t off = 0; off < 40; off += 3) {
+			/* Move towards higher addresses. */
+			sweep_fill(sweep_dst, SWEEP_BUF, 3);
+			memmove(sweep_dst + off, sweep_dst, n);
+			for (size_t i = 0; i < n; i++) {
+				PCUT_ASSERT_INT_EQUALS((uint8_t) (i * 7 + 3),
+				    sweep_dst[off + i]);
+			}
+
+			/* Move towards lower addresses. */
+			sweep_fill(sweep_dst, SWEEP_BUF, 4);
+			memmove(sweep_dst, sweep_dst + off, n);
+			for (size_t i = 0; i < n; i++) {
+				PCUT_ASSERT_INT_EQUALS((uint8_t) ((off + i) * 7 + 4),
+				    sweep_dst[i]);
+			}
+		}
+	}
+}
+
+/** memset with various sizes and alignments */
+PCUT_TEST(memset_sweep)
+{
+	for (size_t n = 0; n <= SWEEP_MAX; n = sweep_next(n)) {
+		for (size_t off = 0; off < 32; off += 5) {
+			sweep_fill(sweep_dst, SWEEP_BUF, 5);
+			memset(sweep_dst + off, 0xa5, n);
+
+			for (size_t i = 0; i < SWEEP_BUF; i++) {
+				uint8_t expect = (i >= off && i < off + n) ?
+				    0xa5 : (uint8_t) (i * 7 + 5);
+				PCUT_ASSERT_INT_EQUALS(expect, sweep_dst[i]);
+			}
+		}
+	}
+}
+
+/** memcmp and memchr locating a byte far into the areas */
+PCUT_TEST(memcmp_memchr_sweep)
+{
+	memset(sweep_src, 0, SWEEP_MAX);
+
+	for (size_t n = 1; n <= SWEEP_MAX; n = sweep_next(n)) {
+		memset(sweep_dst, 0, SWEEP_MAX);
+		PCUT_ASSERT_INT_EQUALS(0, memcmp(sweep_src, sweep_dst, n));
+		PCUT_ASSERT_TRUE(memchr(sweep_dst, 1, n) == NULL);
+
+		sweep_dst[n - 1] = 1;
+		PCUT_ASSERT_TRUE(memcmp(sweep_src, sweep_dst, n) < 0);
+		PCUT_ASSERT_TRUE(memcmp(sweep_dst, sweep_src, n) > 0);
+		PCUT_ASSERT_INT_EQUALS(0, memcmp(sweep_src, sweep_dst, n - 1));
+		PCUT_ASSERT_TRUE(memchr(sweep_dst, 1, n) == sweep_dst + n - 1);
+		PCUT_ASSERT_TRUE(memchr(sweep_dst, 1, n - 1) == NULL);
+	}
+}
+
 PCUT_EXPORT(mem);
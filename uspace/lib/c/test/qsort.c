@@ -33,7 +33,9 @@
 
 enum {
 	/** Length of test number sequences */
-	test_seq_len = 5
+	test_seq_len = 5,
+	/** Length of sequences long enough to be partitioned */
+	test_long_seq_len = 1000
 };
 
 /** Test compare function.
@@ -171,4 +173,56 @@ PCUT_TEST(pseudorandom_seq)
 	free(seq2);
 }
 
+/** Test sorting long sequences of various shapes. */
+PCUT_TEST(long_seq)
+{
+	int *seq, *seq2;
+	int i, shape;
+	int v;
+
+	seq = calloc(test_long_seq_len, sizeof(int));
+	PCUT_ASSERT_NOT_NULL(seq);
+
+	seq2 = calloc(test_long_seq_len, sizeof(int));
+	PCUT_ASSERT_NOT_NULL(seq2);
+
+	for (shape = 0; shape < 4; shape++) {
+		v = 1;
+		for (i = 0; i < test_long_seq_len; i++) {
+			switch (shape) {
+			case 0:
+				/* Pseudorandom */
+				seq[i] = v;
+				break;
+			case 1:
+				/* Many duplicates */
+				seq[i] = v % 7;
+				break;
+			case 2:
+				/* Organ pipe */
+				seq[i] = i < test_long_seq_len / 2 ? i :
+				    test_long_seq_len - i;
+				break;
+			default:
+				/* Decreasing */
+				seq[i] = test_long_seq_len - i;
+				break;
+			}
+
+			seq2[i] = seq[i];
+			v = seq_next(v);
+		}
+
+		qsort(seq, test_long_seq_len, sizeof(int), test_cmp);
+		bubble_sort(seq2, test_long_seq_len);
+
+		for (i = 0; i < test_long_seq_len; i++) {
+			PCUT_ASSERT_INT_EQUALS(seq2[i], seq[i]);
+		}
+	}
+
+	free(seq);
+	free(seq2);
+}
+
 PCUT_EXPORT(qsort);
@@ -131,6 +131,49 @@ PCUT_TEST(str_str_empty_n)
 	PCUT_ASSERT_TRUE((const char *)p == hs);
 }
 
+PCUT_TEST(str_str_periodic)
+{
+	const char *hs = "aabaabaabaabaaabaabaab";
+	char *p;
+
+	p = str_str(hs, "aabaaab");
+	PCUT_ASSERT_TRUE((const char *)p == hs + 9);
+
+	p = str_str(hs, "baabaabaabaab");
+	PCUT_ASSERT_TRUE(p == NULL);
+
+	p = str_str(hs, "aab");
+	PCUT_ASSERT_TRUE((const char *)p == hs);
+}
+
+/* Scan at every alignment, so that both the bytewise and the word paths run */
+PCUT_TEST(str_word_scan)
+{
+	const char *text = "abcdefghijklmnopqrstuvwxyz/ščř/0123456789";
+
+	for (size_t off = 0; off < 16; off++) {
+		char *s = buffer + off;
+		str_cpy(s, BUFFER_SIZE - off, text);
+
+		PCUT_ASSERT_INT_EQUALS(44, str_size(s));
+		PCUT_ASSERT_INT_EQUALS(20, str_nsize(s, 20));
+		PCUT_ASSERT_INT_EQUALS(41, str_length(s));
+		PCUT_ASSERT_INT_EQUALS(29, str_nlength(s, 31));
+		PCUT_ASSERT_TRUE(str_chr(s, '/') == s + 26);
+		PCUT_ASSERT_TRUE(str_rchr(s, '/') == s + 33);
+		PCUT_ASSERT_TRUE(str_chr(s, L'ř') == s + 31);
+		PCUT_ASSERT_TRUE(str_chr(s, 'A') == NULL);
+		PCUT_ASSERT_TRUE(str_str(s, "z/šč") == s + 25);
+
+		PCUT_ASSERT_INT_EQUALS(0, str_cmp(s, text));
+		s[40] = 'X';
+		PCUT_ASSERT_INT_EQUALS(1, str_cmp(s, text));
+		PCUT_ASSERT_INT_EQUALS(-1, str_cmp(text, s));
+
+		memset(buffer, 0, BUFFER_SIZE);
+	}
+}
+
 PCUT_TEST(str_non_shortest)
 {
 	/* Overlong zero. */
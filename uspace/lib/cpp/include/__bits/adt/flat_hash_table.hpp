@@ -0,0 +1,850 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_FLAT_HASH_TABLE
+#define LIBCPP_BITS_ADT_FLAT_HASH_TABLE
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace std::aux
+{
+    /**
+     * Every slot of the flat hash table has one control byte.
+     * A full slot stores the low 7 bits of the hash of its key
+     * (we call these h2), while all special values have their
+     * most significant bit set. This allows us to classify
+     * a whole group of control bytes with a handful of word
+     * operations instead of looking at each of them separately.
+     */
+    struct flat_hash_ctrl
+    {
+        static constexpr uint8_t empty{0x80};
+        static constexpr uint8_t deleted{0xFE};
+
+        static constexpr bool is_full(uint8_t ctrl) noexcept
+        {
+            return (ctrl & 0x80) == 0;
+        }
+    };
+
+    /**
+     * A group of control bytes that are probed at once. We use
+     * plain 64bit words (SWAR) so that this works on all our
+     * architectures without depending on a particular SIMD
+     * extension. The masks returned by the match functions have
+     * the most significant bit of every matching byte set.
+     */
+    class flat_hash_group
+    {
+        public:
+            static constexpr size_t width{8};
+
+            explicit flat_hash_group(const uint8_t* ctrl) noexcept
+            {
+                memcpy(&ctrl_, ctrl, sizeof(ctrl_));
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                ctrl_ = __builtin_bswap64(ctrl_);
+#endif
+            }
+
+            /**
+             * Note: This can report false positives in the byte
+             *       that follows a real match, which is fine
+             *       because the keys get compared anyway.
+             */
+            uint64_t match(uint8_t h2) const noexcept
+            {
+                auto x = ctrl_ ^ (lsbs_ * h2);
+
+                return (x - lsbs_) & ~x & msbs_;
+            }
+
+            uint64_t match_empty() const noexcept
+            {
+                return ctrl_ & ~(ctrl_ << 6) & msbs_;
+            }
+
+            uint64_t match_empty_or_deleted() const noexcept
+            {
+                return ctrl_ & ~(ctrl_ << 7) & msbs_;
+            }
+
+            uint64_t match_full() const noexcept
+            {
+                return ~ctrl_ & msbs_;
+            }
+
+            static size_t lowest(uint64_t mask) noexcept
+            {
+                return static_cast<size_t>(__builtin_ctzll(mask)) >> 3;
+            }
+
+            static size_t highest_unmatched(uint64_t mask) noexcept
+            {
+                return static_cast<size_t>(__builtin_clzll(mask)) >> 3;
+            }
+
+            static uint64_t next(uint64_t mask) noexcept
+            {
+                return mask & (mask - 1);
+            }
+
+        private:
+            uint64_t ctrl_;
+
+            static constexpr uint64_t lsbs_{0x0101010101010101ULL};
+            static constexpr uint64_t msbs_{0x8080808080808080ULL};
+    };
+
+    template<class Value, class Reference, class Pointer>
+    class flat_hash_table_iterator
+    {
+        public:
+            using value_type      = Value;
+            using reference       = Reference;
+            using pointer         = Pointer;
+            using difference_type = ptrdiff_t;
+
+            using iterator_category = forward_iterator_tag;
+
+            flat_hash_table_iterator(const uint8_t* ctrl = nullptr,
+                                     pointer slot = nullptr,
+                                     const uint8_t* end = nullptr)
+                : ctrl_{ctrl}, slot_{slot}, end_{end}
+            { /* DUMMY BODY */ }
+
+            flat_hash_table_iterator(const flat_hash_table_iterator&) = default;
+            flat_hash_table_iterator& operator=(const flat_hash_table_iterator&) = default;
+
+            template<class R, class P>
+            flat_hash_table_iterator(
+                const flat_hash_table_iterator<Value, R, P>& other,
+                enable_if_t<is_convertible_v<P, pointer>>* = nullptr
+            )
+                : ctrl_{other.ctrl()}, slot_{other.slot()}, end_{other.end_ctrl()}
+            { /* DUMMY BODY */ }
+
+            reference operator*() const
+            {
+                return *slot_;
+            }
+
+            pointer operator->() const
+            {
+                return slot_;
+            }
+
+            flat_hash_table_iterator& operator++()
+            {
+                ++ctrl_;
+                ++slot_;
+                skip_empty();
+
+                return *this;
+            }
+
+            flat_hash_table_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+            const uint8_t* ctrl() const
+            {
+                return ctrl_;
+            }
+
+            pointer slot() const
+            {
+                return slot_;
+            }
+
+            const uint8_t* end_ctrl() const
+            {
+                return end_;
+            }
+
+            void skip_empty()
+            {
+                /**
+                 * Note: The control array has one group worth
+                 *       of cloned bytes after its end, so we can
+                 *       always load a whole group here, we just
+                 *       must not step past end_.
+                 */
+                while (ctrl_ < end_)
+                {
+                    auto mask = flat_hash_group{ctrl_}.match_full();
+                    size_t shift{flat_hash_group::width};
+                    if (mask)
+                        shift = flat_hash_group::lowest(mask);
+
+                    if (ctrl_ + shift >= end_)
+                    {
+                        slot_ += end_ - ctrl_;
+                        ctrl_ = end_;
+                    }
+                    else
+                    {
+                        ctrl_ += shift;
+                        slot_ += shift;
+                    }
+
+                    if (mask)
+                        break;
+                }
+            }
+
+        private:
+            const uint8_t* ctrl_;
+            pointer slot_;
+            const uint8_t* end_;
+    };
+
+    template<class Value, class R1, class P1, class R2, class P2>
+    bool operator==(const flat_hash_table_iterator<Value, R1, P1>& lhs,
+                    const flat_hash_table_iterator<Value, R2, P2>& rhs)
+    {
+        return lhs.slot() == rhs.slot();
+    }
+
+    template<class Value, class R1, class P1, class R2, class P2>
+    bool operator!=(const flat_hash_table_iterator<Value, R1, P1>& lhs,
+                    const flat_hash_table_iterator<Value, R2, P2>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * Open addressing hash table in the style of the Swiss table.
+     * Values are stored inline in one flat array of slots, next to
+     * which we keep an array of control bytes that is probed one
+     * group at a time. A lookup thus usually touches one cache line
+     * of control bytes and one slot, and inserting an element does
+     * not allocate unless the table has to grow.
+     * Unlike hash_table, this one does not give any pointer or
+     * iterator stability guarantees over insertions, which is why
+     * it backs the flat_hash_map and flat_hash_set extensions
+     * instead of the standard unordered containers.
+     */
+    template<
+        class Value, class Key, class KeyExtractor,
+        class Hasher, class KeyEq, class Alloc
+    >
+    class flat_hash_table
+    {
+        public:
+            using value_type     = Value;
+            using key_type       = Key;
+            using size_type      = size_t;
+            using allocator_type = Alloc;
+            using key_equal      = KeyEq;
+            using hasher         = Hasher;
+            using key_extract    = KeyExtractor;
+
+            using iterator = flat_hash_table_iterator<
+                value_type, value_type&, value_type*
+            >;
+            using const_iterator = flat_hash_table_iterator<
+                value_type, const value_type&, const value_type*
+            >;
+
+            flat_hash_table(size_type capacity = 0, const hasher& hf = hasher{},
+                            const key_equal& eql = key_equal{},
+                            const allocator_type& alloc = allocator_type{})
+                : ctrl_{}, slots_{}, capacity_{}, size_{}, growth_left_{},
+                  hasher_{hf}, key_eq_{eql}, key_extractor_{},
+                  slot_allocator_{alloc}, ctrl_allocator_{alloc}
+            {
+                if (capacity > 0)
+                    reserve(capacity);
+            }
+
+            flat_hash_table(const flat_hash_table& other)
+                : flat_hash_table{other.size_, other.hasher_, other.key_eq_,
+                                  other.get_allocator()}
+            {
+                for (const auto& x: other)
+                    insert_unique_(x);
+            }
+
+            flat_hash_table(flat_hash_table&& other)
+                : ctrl_{other.ctrl_}, slots_{other.slots_},
+                  capacity_{other.capacity_}, size_{other.size_},
+                  growth_left_{other.growth_left_}, hasher_{move(other.hasher_)},
+                  key_eq_{move(other.key_eq_)}, key_extractor_{move(other.key_extractor_)},
+                  slot_allocator_{move(other.slot_allocator_)},
+                  ctrl_allocator_{move(other.ctrl_allocator_)}
+            {
+                other.ctrl_ = nullptr;
+                other.slots_ = nullptr;
+                other.capacity_ = size_type{};
+                other.size_ = size_type{};
+                other.growth_left_ = size_type{};
+            }
+
+            flat_hash_table& operator=(const flat_hash_table& other)
+            {
+                flat_hash_table tmp{other};
+                tmp.swap(*this);
+
+                return *this;
+            }
+
+            flat_hash_table& operator=(flat_hash_table&& other)
+            {
+                flat_hash_table tmp{move(other)};
+                tmp.swap(*this);
+
+                return *this;
+            }
+
+            ~flat_hash_table()
+            {
+                destroy_slots_();
+                deallocate_(ctrl_, slots_, capacity_);
+            }
+
+            allocator_type get_allocator() const noexcept
+            {
+                return allocator_type{slot_allocator_};
+            }
+
+            bool empty() const noexcept
+            {
+                return size_ == 0;
+            }
+
+            size_type size() const noexcept
+            {
+                return size_;
+            }
+
+            size_type max_size() const noexcept
+            {
+                return allocator_traits<slot_allocator_type>::max_size(slot_allocator_);
+            }
+
+            iterator begin() noexcept
+            {
+                return iterator_at_(0, true);
+            }
+
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+
+            iterator end() noexcept
+            {
+                return iterator{ctrl_ + capacity_, slots_ + capacity_, ctrl_ + capacity_};
+            }
+
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+
+            const_iterator cbegin() const noexcept
+            {
+                return const_cast<flat_hash_table*>(this)->iterator_at_(0, true);
+            }
+
+            const_iterator cend() const noexcept
+            {
+                return const_cast<flat_hash_table*>(this)->end();
+            }
+
+            template<class... Args>
+            pair<iterator, bool> emplace(Args&&... args)
+            {
+                /**
+                 * Note: We need the key to find the slot, so
+                 *       the value has to be constructed first.
+                 *       If it is not inserted, we simply let
+                 *       it get destroyed.
+                 */
+                value_type val{forward<Args>(args)...};
+
+                return insert(move(val));
+            }
+
+            pair<iterator, bool> insert(const value_type& val)
+            {
+                return emplace_key_(key_extractor_(val), val);
+            }
+
+            pair<iterator, bool> insert(value_type&& val)
+            {
+                return emplace_key_(key_extractor_(val), move(val));
+            }
+
+            template<class K, class... Args>
+            pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+            {
+                /**
+                 * Note: The key is forwarded only after the lookup
+                 *       fails, so it is still intact when we use it
+                 *       for the search.
+                 */
+                return emplace_key_(key, forward<K>(key), forward<Args>(args)...);
+            }
+
+            size_type erase(const key_type& key)
+            {
+                auto idx = find_idx_(key);
+                if (idx == capacity_)
+                    return 0;
+
+                erase_at_(idx);
+
+                return 1;
+            }
+
+            iterator erase(const_iterator it)
+            {
+                if (it == cend())
+                    return end();
+
+                auto idx = static_cast<size_type>(it.slot() - slots_);
+                erase_at_(idx);
+
+                return iterator_at_(idx + 1, true);
+            }
+
+            void clear() noexcept
+            {
+                destroy_slots_();
+                if (capacity_ > 0)
+                    reset_ctrl_();
+                size_ = size_type{};
+            }
+
+            void swap(flat_hash_table& other)
+                noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
+                         noexcept(std::swap(declval<Hasher&>(), declval<Hasher&>())) &&
+                         noexcept(std::swap(declval<KeyEq&>(), declval<KeyEq&>())))
+            {
+                std::swap(ctrl_, other.ctrl_);
+                std::swap(slots_, other.slots_);
+                std::swap(capacity_, other.capacity_);
+                std::swap(size_, other.size_);
+                std::swap(growth_left_, other.growth_left_);
+                std::swap(hasher_, other.hasher_);
+                std::swap(key_eq_, other.key_eq_);
+                std::swap(slot_allocator_, other.slot_allocator_);
+                std::swap(ctrl_allocator_, other.ctrl_allocator_);
+            }
+
+            hasher hash_function() const
+            {
+                return hasher_;
+            }
+
+            key_equal key_eq() const
+            {
+                return key_eq_;
+            }
+
+            iterator find(const key_type& key)
+            {
+                return iterator_at_(find_idx_(key), false);
+            }
+
+            const_iterator find(const key_type& key) const
+            {
+                return const_cast<flat_hash_table*>(this)->find(key);
+            }
+
+            size_type count(const key_type& key) const
+            {
+                return find_idx_(key) == capacity_ ? 0 : 1;
+            }
+
+            size_type capacity() const noexcept
+            {
+                return capacity_;
+            }
+
+            float load_factor() const noexcept
+            {
+                if (capacity_ == 0)
+                    return 0.f;
+
+                return size_ / static_cast<float>(capacity_);
+            }
+
+            float max_load_factor() const noexcept
+            {
+                return max_load_num_ / static_cast<float>(max_load_den_);
+            }
+
+            void rehash(size_type count)
+            {
+                /**
+                 * Note: Capacities are always powers of two
+                 *       and there has to be at least one empty
+                 *       slot so that probing terminates.
+                 */
+                auto min_count = size_ + (size_ + max_load_num_ - 1) / max_load_num_;
+                if (count < min_count)
+                    count = min_count;
+
+                if (count == 0)
+                {
+                    if (size_ == 0)
+                    {
+                        deallocate_(ctrl_, slots_, capacity_);
+                        ctrl_ = nullptr;
+                        slots_ = nullptr;
+                        capacity_ = size_type{};
+                        growth_left_ = size_type{};
+                    }
+
+                    return;
+                }
+
+                size_type new_capacity{flat_hash_group::width};
+                while (new_capacity < count)
+                    new_capacity *= 2;
+
+                resize_(new_capacity);
+            }
+
+            void reserve(size_type count)
+            {
+                rehash(count + (count + max_load_num_ - 1) / max_load_num_);
+            }
+
+        private:
+            using slot_allocator_type = typename allocator_traits<
+                allocator_type
+            >::template rebind_alloc<value_type>;
+            using ctrl_allocator_type = typename allocator_traits<
+                allocator_type
+            >::template rebind_alloc<uint8_t>;
+
+            uint8_t* ctrl_;
+            value_type* slots_;
+            size_type capacity_;
+            size_type size_;
+            size_type growth_left_;
+            hasher hasher_;
+            key_equal key_eq_;
+            key_extract key_extractor_;
+            slot_allocator_type slot_allocator_;
+            ctrl_allocator_type ctrl_allocator_;
+
+            /**
+             * The table is allowed to get 7/8 full, with groups
+             * of 8 this keeps the expected probe length close
+             * to one group for most lookups.
+             */
+            static constexpr size_type max_load_num_{7};
+            static constexpr size_type max_load_den_{8};
+
+            static size_type mix_(size_t hash) noexcept
+            {
+                /**
+                 * Note: The bits of h1 and h2 need to be independent,
+                 *       but std::hash is not required to provide that,
+                 *       so we mix the hash with a multiplicative step.
+                 */
+                uint64_t h = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+
+                return static_cast<size_type>(h ^ (h >> 32));
+            }
+
+            static size_type h1_(size_type hash) noexcept
+            {
+                return hash >> 7;
+            }
+
+            static uint8_t h2_(size_type hash) noexcept
+            {
+                return static_cast<uint8_t>(hash & 0x7F);
+            }
+
+            static size_type growth_limit_(size_type capacity) noexcept
+            {
+                return capacity - capacity / max_load_den_;
+            }
+
+            size_type hash_(const key_type& key) const
+            {
+                return mix_(hasher_(key));
+            }
+
+            iterator iterator_at_(size_type idx, bool skip)
+            {
+                if (idx >= capacity_)
+                    return end();
+
+                iterator it{ctrl_ + idx, slots_ + idx, ctrl_ + capacity_};
+                if (skip)
+                    it.skip_empty();
+
+                return it;
+            }
+
+            void set_ctrl_(size_type idx, uint8_t ctrl) noexcept
+            {
+                ctrl_[idx] = ctrl;
+
+                /**
+                 * Note: The first group is cloned past the end
+                 *       of the array so that group loads never
+                 *       have to wrap around.
+                 */
+                if (idx < flat_hash_group::width)
+                    ctrl_[capacity_ + idx] = ctrl;
+            }
+
+            void reset_ctrl_() noexcept
+            {
+                memset(ctrl_, flat_hash_ctrl::empty,
+                       capacity_ + flat_hash_group::width);
+                growth_left_ = growth_limit_(capacity_);
+            }
+
+            size_type find_idx_(const key_type& key) const
+            {
+                if (size_ == 0)
+                    return capacity_;
+
+                auto hash = hash_(key);
+                auto h2 = h2_(hash);
+                auto mask = capacity_ - 1;
+                auto offset = h1_(hash) & mask;
+                size_type step{};
+
+                while (true)
+                {
+                    flat_hash_group group{ctrl_ + offset};
+
+                    for (auto m = group.match(h2); m; m = flat_hash_group::next(m))
+                    {
+                        auto idx = (offset + flat_hash_group::lowest(m)) & mask;
+                        if (key_eq_(key, key_extractor_(slots_[idx])))
+                            return idx;
+                    }
+
+                    if (group.match_empty())
+                        return capacity_;
+
+                    step += flat_hash_group::width;
+                    offset = (offset + step) & mask;
+                }
+            }
+
+            size_type find_first_non_full_(size_type hash) const noexcept
+            {
+                auto mask = capacity_ - 1;
+                auto offset = h1_(hash) & mask;
+                size_type step{};
+
+                while (true)
+                {
+                    flat_hash_group group{ctrl_ + offset};
+
+                    auto m = group.match_empty_or_deleted();
+                    if (m)
+                        return (offset + flat_hash_group::lowest(m)) & mask;
+
+                    step += flat_hash_group::width;
+                    offset = (offset + step) & mask;
+                }
+            }
+
+            template<class K, class... Args>
+            pair<iterator, bool> emplace_key_(const K& key, Args&&... args)
+            {
+                auto idx = find_idx_(key);
+                if (idx != capacity_)
+                    return make_pair(iterator_at_(idx, false), false);
+
+                auto hash = hash_(key);
+                idx = prepare_insert_(hash);
+
+                allocator_traits<slot_allocator_type>::construct(
+                    slot_allocator_, slots_ + idx, forward<Args>(args)...
+                );
+                commit_insert_(idx, hash);
+
+                return make_pair(iterator_at_(idx, false), true);
+            }
+
+            template<class T>
+            void insert_unique_(T&& val)
+            {
+                auto hash = hash_(key_extractor_(val));
+                auto idx = prepare_insert_(hash);
+
+                allocator_traits<slot_allocator_type>::construct(
+                    slot_allocator_, slots_ + idx, forward<T>(val)
+                );
+                commit_insert_(idx, hash);
+            }
+
+            size_type prepare_insert_(size_type hash)
+            {
+                if (capacity_ == 0)
+                    resize_(flat_hash_group::width);
+
+                auto idx = find_first_non_full_(hash);
+                if (growth_left_ == 0 && ctrl_[idx] != flat_hash_ctrl::deleted)
+                {
+                    /**
+                     * If most of the used slots are tombstones,
+                     * we just clean them up, otherwise we grow.
+                     */
+                    if (size_ * 2 <= growth_limit_(capacity_))
+                        resize_(capacity_);
+                    else
+                        resize_(capacity_ * 2);
+
+                    idx = find_first_non_full_(hash);
+                }
+
+                return idx;
+            }
+
+            void commit_insert_(size_type idx, size_type hash) noexcept
+            {
+                if (ctrl_[idx] == flat_hash_ctrl::empty)
+                    --growth_left_;
+                set_ctrl_(idx, h2_(hash));
+                ++size_;
+            }
+
+            void erase_at_(size_type idx)
+            {
+                allocator_traits<slot_allocator_type>::destroy(
+                    slot_allocator_, slots_ + idx
+                );
+                --size_;
+
+                /**
+                 * If there is no window of group width full slots
+                 * around idx, no probe sequence could have continued
+                 * past it, so we can mark it empty instead of leaving
+                 * a tombstone behind.
+                 */
+                auto mask = capacity_ - 1;
+                auto before = (idx - flat_hash_group::width) & mask;
+                auto empty_after = flat_hash_group{ctrl_ + idx}.match_empty();
+                auto empty_before = flat_hash_group{ctrl_ + before}.match_empty();
+
+                if (empty_after && empty_before &&
+                    flat_hash_group::lowest(empty_after) +
+                    flat_hash_group::highest_unmatched(empty_before) < flat_hash_group::width)
+                {
+                    set_ctrl_(idx, flat_hash_ctrl::empty);
+                    ++growth_left_;
+                }
+                else
+                    set_ctrl_(idx, flat_hash_ctrl::deleted);
+            }
+
+            void resize_(size_type new_capacity)
+            {
+                auto old_ctrl = ctrl_;
+                auto old_slots = slots_;
+                auto old_capacity = capacity_;
+
+                ctrl_ = allocator_traits<ctrl_allocator_type>::allocate(
+                    ctrl_allocator_, new_capacity + flat_hash_group::width
+                );
+                slots_ = allocator_traits<slot_allocator_type>::allocate(
+                    slot_allocator_, new_capacity
+                );
+                capacity_ = new_capacity;
+                reset_ctrl_();
+
+                for (size_type i = 0; i < old_capacity; ++i)
+                {
+                    if (!flat_hash_ctrl::is_full(old_ctrl[i]))
+                        continue;
+
+                    auto hash = hash_(key_extractor_(old_slots[i]));
+                    auto idx = find_first_non_full_(hash);
+
+                    allocator_traits<slot_allocator_type>::construct(
+                        slot_allocator_, slots_ + idx, move(old_slots[i])
+                    );
+                    allocator_traits<slot_allocator_type>::destroy(
+                        slot_allocator_, old_slots + i
+                    );
+                    set_ctrl_(idx, h2_(hash));
+                    --growth_left_;
+                }
+
+                deallocate_(old_ctrl, old_slots, old_capacity);
+            }
+
+            void destroy_slots_() noexcept
+            {
+                if (is_trivially_destructible_v<value_type>)
+                    return;
+
+                for (size_type i = 0; i < capacity_; ++i)
+                {
+                    if (flat_hash_ctrl::is_full(ctrl_[i]))
+                    {
+                        allocator_traits<slot_allocator_type>::destroy(
+                            slot_allocator_, slots_ + i
+                        );
+                    }
+                }
+            }
+
+            void deallocate_(uint8_t* ctrl, value_type* slots, size_type capacity)
+            {
+                if (capacity == 0)
+                    return;
+
+                allocator_traits<ctrl_allocator_type>::deallocate(
+                    ctrl_allocator_, ctrl, capacity + flat_hash_group::width
+                );
+                allocator_traits<slot_allocator_type>::deallocate(
+                    slot_allocator_, slots, capacity
+                );
+            }
+    };
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include <__bits/adt/key_extractors.hpp>
 #include <__bits/adt/hash_table_iterators.hpp>
 #include <__bits/adt/hash_table_policies.hpp>
+#include <__bits/adt/node_allocation.hpp>
 #include <cstdlib>
 #include <iterator>
 #include <limits>
@@ -86,22 +87,33 @@ namespace std::aux
                 list_node<value_type>*, size_type
             >;
 
-            hash_table(size_type buckets, float max_load_factor = 1.f)
-                : table_{new hash_table_bucket<value_type, size_type>[buckets]()},
-                  bucket_count_{buckets}, size_{}, hasher_{}, key_eq_{},
-                  key_extractor_{}, max_load_factor_{max_load_factor}
+            hash_table(size_type buckets, float max_load_factor = 1.f,
+                       const allocator_type& alloc = allocator_type{})
+                : hash_table{buckets, hasher{}, key_equal{}, max_load_factor, alloc}
             { /* DUMMY BODY */ }
 
             hash_table(size_type buckets, const hasher& hf, const key_equal& eql,
-                       float max_load_factor = 1.f)
-                : table_{new hash_table_bucket<value_type, size_type>[buckets]()},
-                  bucket_count_{buckets}, size_{}, hasher_{hf}, key_eq_{eql},
-                  key_extractor_{}, max_load_factor_{max_load_factor}
-            { /* DUMMY BODY */ }
+                       float max_load_factor = 1.f,
+                       const allocator_type& alloc = allocator_type{})
+                : table_{}, bucket_count_{buckets}, size_{}, hasher_{hf},
+                  key_eq_{eql}, key_extractor_{}, max_load_factor_{max_load_factor},
+                  allocator_{alloc}
+            {
+                table_ = allocate_table_(bucket_count_);
+            }
 
             hash_table(const hash_table& other)
+                : hash_table{
+                    other,
+                    allocator_traits<allocator_type>::select_on_container_copy_construction(
+                        other.get_allocator()
+                    )
+                  }
+            { /* DUMMY BODY */ }
+
+            hash_table(const hash_table& other, const allocator_type& alloc)
                 : hash_table{other.bucket_count_, other.hasher_, other.key_eq_,
-                             other.max_load_factor_}
+                             other.max_load_factor_, alloc}
             {
                 for (const auto& x: other)
                     insert(x);
@@ -111,7 +123,8 @@ namespace std::aux
                 : table_{other.table_}, bucket_count_{other.bucket_count_},
                   size_{other.size_}, hasher_{move(other.hasher_)},
                   key_eq_{move(other.key_eq_)}, key_extractor_{move(other.key_extractor_)},
-                  max_load_factor_{other.max_load_factor_}
+                  max_load_factor_{other.max_load_factor_},
+                  allocator_{move(other.allocator_)}
             {
                 other.table_ = nullptr;
                 other.bucket_count_ = size_type{};
@@ -119,22 +132,63 @@ namespace std::aux
                 other.max_load_factor_ = 1.f;
             }
 
+            hash_table(hash_table&& other, const allocator_type& alloc)
+                : hash_table{other.bucket_count_, other.hasher_, other.key_eq_,
+                             other.max_load_factor_, alloc}
+            {
+                if (aux::allocators_equal(allocator_, other.allocator_))
+                    swap_contents_(other);
+                else
+                    move_elements_(other);
+            }
+
             hash_table& operator=(const hash_table& other)
             {
-                hash_table tmp{other};
-                tmp.swap(*this);
+                if (this == &other)
+                    return *this;
+
+                clear();
+
+                aux::copy_assign_allocator(allocator_, other.allocator_);
+                hasher_ = other.hasher_;
+                key_eq_ = other.key_eq_;
+                max_load_factor_ = other.max_load_factor_;
+
+                for (const auto& x: other)
+                    insert(x);
 
                 return *this;
             }
 
             hash_table& operator=(hash_table&& other)
             {
-                hash_table tmp{move(other)};
-                tmp.swap(*this);
+                if (this == &other)
+                    return *this;
+
+                clear();
+
+                hasher_ = move(other.hasher_);
+                key_eq_ = move(other.key_eq_);
+                max_load_factor_ = other.max_load_factor_;
+
+                /**
+                 * Note: The bucket array comes from the same
+                 *       allocator as the nodes, so it is only
+                 *       taken over together with them.
+                 */
+                if (aux::move_assign_allocator(allocator_, other.allocator_))
+                    swap_contents_(other);
+                else
+                    move_elements_(other);
 
                 return *this;
             }
 
+            allocator_type get_allocator() const noexcept
+            {
+                return allocator_type{allocator_};
+            }
+
             bool empty() const noexcept
             {
                 return size_ == 0;
@@ -145,9 +199,9 @@ namespace std::aux
                 return size_;
             }
 
-            size_type max_size(allocator_type& alloc)
+            size_type max_size() const noexcept
             {
-                return allocator_traits<allocator_type>::max_size(alloc);
+                return allocator_traits<node_allocator_type>::max_size(allocator_);
             }
 
             iterator begin() noexcept
@@ -221,7 +275,7 @@ namespace std::aux
                  * Note: This way we will continue on the next bucket
                  *       if this is the last element in its bucket.
                  */
-                iterator res{table_, idx, size_, node};
+                iterator res{table_, idx, bucket_count_, node};
                 ++res;
 
                 if (table_[idx].head == node)
@@ -234,7 +288,7 @@ namespace std::aux
                 --size_;
 
                 node->unlink();
-                delete node;
+                destroy_node(node);
 
                 if (empty())
                     return end();
@@ -245,7 +299,7 @@ namespace std::aux
             void clear() noexcept
             {
                 for (size_type i = 0; i < bucket_count_; ++i)
-                    table_[i].clear();
+                    table_[i].clear(allocator_);
                 size_ = size_type{};
             }
 
@@ -260,6 +314,7 @@ namespace std::aux
                 std::swap(hasher_, other.hasher_);
                 std::swap(key_eq_, other.key_eq_);
                 std::swap(max_load_factor_, other.max_load_factor_);
+                aux::swap_allocators(allocator_, other.allocator_);
             }
 
             hasher hash_function() const
@@ -284,7 +339,7 @@ namespace std::aux
                 do
                 {
                     if (key_eq_(key, key_extractor_(current->value)))
-                        return iterator{table_, idx, size_, current};
+                        return iterator{table_, idx, bucket_count_, current};
                     current = current->next;
                 }
                 while (current && current != head);
@@ -304,7 +359,7 @@ namespace std::aux
                 do
                 {
                     if (key_eq_(key, key_extractor_(current->value)))
-                        return iterator{table_, idx, size_, current};
+                        return iterator{table_, idx, bucket_count_, current};
                     current = current->next;
                 }
                 while (current != head);
@@ -408,7 +463,9 @@ namespace std::aux
                  *       be thrown and no changes to this have been
                  *       made, we're ok.
                  */
-                hash_table new_table{count, max_load_factor_};
+                hash_table new_table{
+                    count, hasher_, key_eq_, max_load_factor_, get_allocator()
+                };
 
                 for (std::size_t i = 0; i < bucket_count_; ++i)
                 {
@@ -450,7 +507,7 @@ namespace std::aux
                 new_table.size_ = size_;
                 swap(new_table);
 
-                delete[] new_table.table_;
+                deallocate_table_(new_table.table_, new_table.bucket_count_);
                 new_table.table_ = nullptr;
             }
 
@@ -496,9 +553,11 @@ namespace std::aux
 
             ~hash_table()
             {
-                // Lists are deleted in ~hash_table_bucket.
                 if (table_)
-                    delete[] table_;
+                {
+                    clear();
+                    deallocate_table_(table_, bucket_count_);
+                }
             }
 
             place_type find_insertion_spot(const key_type& key) const
@@ -557,7 +616,23 @@ namespace std::aux
                 --size_;
             }
 
+            template<class... Args>
+            node_type* create_node(Args&&... args)
+            {
+                return aux::create_node(allocator_, forward<Args>(args)...);
+            }
+
+            void destroy_node(node_type* node)
+            {
+                aux::destroy_node(allocator_, node);
+            }
+
         private:
+            using bucket_type = hash_table_bucket<value_type, size_type>;
+            using node_allocator_type = aux::node_allocator_t<allocator_type, node_type>;
+            using bucket_allocator_type = aux::node_allocator_t<allocator_type, bucket_type>;
+            using bucket_traits = allocator_traits<bucket_allocator_type>;
+
             hash_table_bucket<value_type, size_type>* table_;
             size_type bucket_count_;
             size_type size_;
@@ -565,6 +640,7 @@ namespace std::aux
             key_equal key_eq_;
             key_extract key_extractor_;
             float max_load_factor_;
+            node_allocator_type allocator_;
 
             static constexpr float bucket_count_growth_factor_{1.25};
 
@@ -573,6 +649,40 @@ namespace std::aux
                 return hasher_(key) % bucket_count_;
             }
 
+            bucket_type* allocate_table_(size_type count)
+            {
+                bucket_allocator_type alloc{allocator_};
+
+                auto table = bucket_traits::allocate(alloc, count);
+                for (size_type i = 0; i < count; ++i)
+                    bucket_traits::construct(alloc, table + i);
+
+                return table;
+            }
+
+            void deallocate_table_(bucket_type* table, size_type count)
+            {
+                bucket_allocator_type alloc{allocator_};
+
+                for (size_type i = 0; i < count; ++i)
+                    bucket_traits::destroy(alloc, table + i);
+                bucket_traits::deallocate(alloc, table, count);
+            }
+
+            void swap_contents_(hash_table& other)
+            {
+                std::swap(table_, other.table_);
+                std::swap(bucket_count_, other.bucket_count_);
+                std::swap(size_, other.size_);
+            }
+
+            void move_elements_(hash_table& other)
+            {
+                for (auto& x: other)
+                    insert(move(x));
+                other.clear();
+            }
+
             size_type first_filled_bucket_() const
             {
                 size_type res{};
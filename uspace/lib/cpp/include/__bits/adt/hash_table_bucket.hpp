@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ADT_HASH_TABLE_BUCKET
 
 #include <__bits/adt/list_node.hpp>
+#include <__bits/adt/node_allocation.hpp>
 
 namespace std::aux
 {
@@ -79,7 +80,12 @@ namespace std::aux
                 head->prepend(node);
         }
 
-        void clear()
+        /**
+         * Note: Nodes are owned by the table, which
+         *       passes its node allocator in here.
+         */
+        template<class NodeAlloc>
+        void clear(NodeAlloc& alloc)
         {
             if (!head)
                 return;
@@ -89,17 +95,12 @@ namespace std::aux
             {
                 auto tmp = current;
                 current = current->next;
-                delete tmp;
+                destroy_node(alloc, tmp);
             }
             while (current && current != head);
 
             head = nullptr;
         }
-
-        ~hash_table_bucket()
-        {
-            clear();
-        }
     };
 }
 
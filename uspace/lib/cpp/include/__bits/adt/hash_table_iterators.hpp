@@ -74,7 +74,7 @@ namespace std::aux
                 {
                     if (idx_ < max_idx_)
                     {
-                        while (!table_[++idx_].head && idx_ < max_idx_)
+                        while (++idx_ < max_idx_ && !table_[idx_].head)
                         { /* DUMMY BODY */ }
 
                         if (idx_ < max_idx_)
@@ -147,6 +147,8 @@ namespace std::aux
         public:
             using value_type      = Value;
             using size_type       = Size;
+            using reference       = ConstReference;
+            using pointer         = ConstPointer;
             using const_reference = ConstReference;
             using const_pointer   = ConstPointer;
             using difference_type = ptrdiff_t;
@@ -194,7 +196,7 @@ namespace std::aux
                 {
                     if (idx_ < max_idx_)
                     {
-                        while (!table_[++idx_].head && idx_ < max_idx_)
+                        while (++idx_ < max_idx_ && !table_[idx_].head)
                         { /* DUMMY BODY */ }
 
                         if (idx_ < max_idx_)
@@ -369,6 +371,8 @@ namespace std::aux
 
         public:
             using value_type      = Value;
+            using reference       = ConstReference;
+            using pointer         = ConstPointer;
             using const_reference = ConstReference;
             using const_pointer   = ConstPointer;
             using difference_type = ptrdiff_t;
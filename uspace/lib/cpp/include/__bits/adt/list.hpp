@@ -31,7 +31,9 @@
 #define LIBCPP_BITS_ADT_LIST
 
 #include <__bits/adt/list_node.hpp>
+#include <__bits/adt/node_allocation.hpp>
 #include <__bits/insert_iterator.hpp>
+#include <__bits/memory/polymorphic_allocator.hpp>
 #include <cassert>
 #include <cstdlib>
 #include <iterator>
@@ -388,7 +390,7 @@ namespace std
             {
                 init_(
                     aux::insert_iterator<value_type>{size_type{}, value_type{}},
-                    aux::insert_iterator<value_type>{size_, value_type{}}
+                    aux::insert_iterator<value_type>{n, value_type{}}
                 );
             }
 
@@ -411,7 +413,12 @@ namespace std
             }
 
             list(const list& other)
-                : list{other, other.allocator_}
+                : list{
+                    other,
+                    allocator_traits<allocator_type>::select_on_container_copy_construction(
+                        other.get_allocator()
+                    )
+                  }
             { /* DUMMY BODY */ }
 
             list(list&& other)
@@ -430,12 +437,18 @@ namespace std
             }
 
             list(list&& other, const allocator_type& alloc)
-                : allocator_{alloc},
-                  head_{move(other.head_)},
-                  size_{move(other.size_)}
+                : allocator_{alloc}, head_{nullptr}, size_{}
             {
-                other.head_ = nullptr;
-                other.size_ = size_type{};
+                if (aux::allocators_equal(allocator_, other.allocator_))
+                {
+                    head_ = other.head_;
+                    size_ = other.size_;
+
+                    other.head_ = nullptr;
+                    other.size_ = size_type{};
+                }
+                else
+                    init_(make_move_iterator(other.begin()), make_move_iterator(other.end()));
             }
 
             list(initializer_list<value_type> init, const allocator_type& alloc = allocator_type{})
@@ -451,9 +464,12 @@ namespace std
 
             list& operator=(const list& other)
             {
+                if (this == &other)
+                    return *this;
+
                 fini_();
 
-                allocator_ = other.allocator_;
+                aux::copy_assign_allocator(allocator_, other.allocator_);
 
                 init_(other.begin(), other.end());
 
@@ -463,14 +479,24 @@ namespace std
             list& operator=(list&& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value)
             {
+                if (this == &other)
+                    return *this;
+
                 fini_();
 
-                head_ = move(other.head_);
-                size_ = move(other.size_);
-                allocator_ = move(other.allocator_);
+                if (aux::move_assign_allocator(allocator_, other.allocator_))
+                {
+                    head_ = other.head_;
+                    size_ = other.size_;
 
-                other.head_ = nullptr;
-                other.size_ = size_type{};
+                    other.head_ = nullptr;
+                    other.size_ = size_type{};
+                }
+                else
+                {
+                    init_(make_move_iterator(other.begin()), make_move_iterator(other.end()));
+                    other.clear();
+                }
 
                 return *this;
             }
@@ -511,7 +537,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return allocator_type{allocator_};
             }
 
             iterator begin() noexcept
@@ -585,7 +611,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return allocator_traits<allocator_type>::max_size(allocator_);
+                return allocator_traits<node_allocator_type>::max_size(allocator_);
             }
 
             void resize(size_type sz)
@@ -647,7 +673,7 @@ namespace std
 
                     if (head_->next == head_)
                     {
-                        delete head_;
+                        aux::destroy_node(allocator_, head_);
                         head_ = nullptr;
                     }
                     else
@@ -657,7 +683,7 @@ namespace std
                         head_->next->prev = head_->prev;
                         head_ = head_->next;
 
-                        delete tmp;
+                        aux::destroy_node(allocator_, tmp);
                     }
                 }
             }
@@ -695,19 +721,17 @@ namespace std
                     --size_;
                     auto target = head_->prev;
 
-                    if (!target)
+                    if (target == head_)
                     {
-                        delete head_;
+                        aux::destroy_node(allocator_, head_);
                         head_ = nullptr;
                     }
                     else
                     {
-                        auto tmp = target;
                         target->prev->next = target->next;
                         target->next->prev = target->prev;
-                        target = target->next;
 
-                        delete tmp;
+                        aux::destroy_node(allocator_, target);
                     }
                 }
             }
@@ -716,7 +740,7 @@ namespace std
             iterator emplace(const_iterator position, Args&&... args)
             {
                 auto node = position.node();
-                node->prepend(new aux::list_node<value_type>{forward<Args>(args)...});
+                node->prepend(aux::create_node(allocator_, forward<Args>(args)...));
                 ++size_;
 
                 if (node == head_)
@@ -751,7 +775,7 @@ namespace std
 
                 while (first != last)
                 {
-                    node->append(new aux::list_node<value_type>{*first++});
+                    node->append(aux::create_node(allocator_, *first++));
                     node = node->next;
                     ++size_;
                 }
@@ -772,7 +796,7 @@ namespace std
                 {
                     if (size_ == 1)
                     {
-                        delete head_;
+                        aux::destroy_node(allocator_, head_);
                         head_ = nullptr;
                         size_ = 0;
 
@@ -787,7 +811,7 @@ namespace std
                 --size_;
 
                 node->unlink();
-                delete node;
+                aux::destroy_node(allocator_, node);
 
                 return iterator{next, head_, size_ == 0U};
             }
@@ -819,7 +843,7 @@ namespace std
                     first_node = first_node->next;
                     --size_;
 
-                    delete tmp;
+                    aux::destroy_node(allocator_, tmp);
                 }
 
                 return iterator{next, head_, size_ == 0U};
@@ -828,7 +852,7 @@ namespace std
             void swap(list& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value)
             {
-                std::swap(allocator_, other.allocator_);
+                aux::swap_allocators(allocator_, other.allocator_);
                 std::swap(head_, other.head_);
                 std::swap(size_, other.size_);
             }
@@ -1096,7 +1120,11 @@ namespace std
             }
 
         private:
-            allocator_type allocator_;
+            using node_allocator_type = aux::node_allocator_t<
+                allocator_type, aux::list_node<value_type>
+            >;
+
+            node_allocator_type allocator_;
             aux::list_node<value_type>* head_;
             size_type size_;
 
@@ -1104,10 +1132,7 @@ namespace std
             void init_(InputIterator first, InputIterator last)
             {
                 while (first != last)
-                {
-                    auto node = append_new_();
-                    allocator_.construct(&node->value, *first++);
-                }
+                    append_new_(*first++);
             }
 
             void fini_()
@@ -1121,7 +1146,7 @@ namespace std
                     auto tmp = head_;
                     head_ = head_->next;
 
-                    delete tmp;
+                    aux::destroy_node(allocator_, tmp);
                 }
 
                 head_ = nullptr;
@@ -1131,7 +1156,7 @@ namespace std
             template<class... Args>
             aux::list_node<value_type>* append_new_(Args&&... args)
             {
-                auto node = new aux::list_node<value_type>{forward<Args>(args)...};
+                auto node = aux::create_node(allocator_, forward<Args>(args)...);
                 auto last = get_last_();
 
                 if (!last)
@@ -1147,7 +1172,7 @@ namespace std
             template<class... Args>
             aux::list_node<value_type>* prepend_new_(Args&&... args)
             {
-                auto node = new aux::list_node<value_type>{forward<Args>(args)...};
+                auto node = aux::create_node(allocator_, forward<Args>(args)...);
 
                 if (!head_)
                     head_ = node;
@@ -1182,7 +1207,7 @@ namespace std
 
                 while (first != last)
                 {
-                    where->append(new aux::list_node<value_type>{*first++});
+                    where->append(aux::create_node(allocator_, *first++));
                     where = where->next;
                 }
             }
@@ -1209,6 +1234,12 @@ namespace std
     {
         lhs.swap(rhs);
     }
+
+    namespace pmr
+    {
+        template<class T>
+        using list = std::list<T, polymorphic_allocator<T>>;
+    }
 }
 
 #endif
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_NODE_ALLOCATION
+#define LIBCPP_BITS_ADT_NODE_ALLOCATION
+
+#include <__bits/memory/allocator_traits.hpp>
+#include <utility>
+
+namespace std::aux
+{
+    /**
+     * Node based containers allocate their nodes with
+     * their allocator rebound to the node type, so that
+     * e.g. a polymorphic allocator places the nodes
+     * in its memory resource.
+     */
+
+    template<class Alloc, class Node>
+    using node_allocator_t =
+        typename allocator_traits<Alloc>::template rebind_alloc<Node>;
+
+    template<class NodeAlloc, class... Args>
+    typename allocator_traits<NodeAlloc>::pointer
+    create_node(NodeAlloc& alloc, Args&&... args)
+    {
+        using traits = allocator_traits<NodeAlloc>;
+
+        auto node = traits::allocate(alloc, 1);
+        traits::construct(alloc, node, forward<Args>(args)...);
+
+        return node;
+    }
+
+    template<class NodeAlloc, class Node>
+    void destroy_node(NodeAlloc& alloc, Node* node)
+    {
+        using traits = allocator_traits<NodeAlloc>;
+
+        traits::destroy(alloc, node);
+        traits::deallocate(alloc, node, 1);
+    }
+
+    /**
+     * Allocators only follow the contents of a container
+     * on assignment and swap if they ask for it, the rest
+     * (e.g. polymorphic allocators) stay bound to the
+     * container they were created with.
+     */
+
+    template<class Alloc>
+    void copy_assign_allocator(Alloc& lhs, const Alloc& rhs)
+    {
+        if constexpr (allocator_traits<Alloc>::propagate_on_container_copy_assignment::value)
+            lhs = rhs;
+    }
+
+    template<class Alloc>
+    bool allocators_equal(const Alloc& lhs, const Alloc& rhs)
+    {
+        if constexpr (allocator_traits<Alloc>::is_always_equal::value)
+            return true;
+        else
+            return lhs == rhs;
+    }
+
+    /**
+     * Returns true if the target of a move assignment
+     * can take over the nodes of the source container,
+     * otherwise the elements have to be moved one by one.
+     */
+    template<class Alloc>
+    bool move_assign_allocator(Alloc& lhs, Alloc& rhs)
+    {
+        if constexpr (allocator_traits<Alloc>::propagate_on_container_move_assignment::value)
+        {
+            lhs = move(rhs);
+
+            return true;
+        }
+        else
+            return allocators_equal(lhs, rhs);
+    }
+
+    template<class Alloc>
+    void swap_allocators(Alloc& lhs, Alloc& rhs)
+    {
+        if constexpr (allocator_traits<Alloc>::propagate_on_container_swap::value)
+            std::swap(lhs, rhs);
+    }
+}
+
+#endif
@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ADT_RBTREE
 
 #include <__bits/adt/key_extractors.hpp>
+#include <__bits/adt/node_allocation.hpp>
 #include <__bits/adt/rbtree_iterators.hpp>
 #include <__bits/adt/rbtree_node.hpp>
 #include <__bits/adt/rbtree_policies.hpp>
@@ -60,13 +61,23 @@ namespace std::aux
 
             using node_type = Node;
 
-            rbtree(const key_compare& kcmp = key_compare{})
-                : root_{nullptr}, size_{}, key_compare_{},
-                  key_extractor_{}
+            rbtree(const key_compare& kcmp = key_compare{},
+                   const allocator_type& alloc = allocator_type{})
+                : root_{nullptr}, size_{}, key_compare_{kcmp},
+                  key_extractor_{}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             rbtree(const rbtree& other)
-                : rbtree{other.key_compare_}
+                : rbtree{
+                    other,
+                    allocator_traits<allocator_type>::select_on_container_copy_construction(
+                        other.get_allocator()
+                    )
+                  }
+            { /* DUMMY BODY */ }
+
+            rbtree(const rbtree& other, const allocator_type& alloc)
+                : rbtree{other.key_compare_, alloc}
             {
                 for (const auto& x: other)
                     insert(x);
@@ -75,28 +86,76 @@ namespace std::aux
             rbtree(rbtree&& other)
                 : root_{other.root_}, size_{other.size_},
                   key_compare_{move(other.key_compare_)},
-                  key_extractor_{move(other.key_extractor_)}
+                  key_extractor_{move(other.key_extractor_)},
+                  allocator_{move(other.allocator_)}
             {
                 other.root_ = nullptr;
                 other.size_ = size_type{};
             }
 
+            rbtree(rbtree&& other, const allocator_type& alloc)
+                : rbtree{other.key_compare_, alloc}
+            {
+                if (aux::allocators_equal(allocator_, other.allocator_))
+                {
+                    root_ = other.root_;
+                    size_ = other.size_;
+
+                    other.root_ = nullptr;
+                    other.size_ = size_type{};
+                }
+                else
+                    move_elements_(other);
+            }
+
             rbtree& operator=(const rbtree& other)
             {
-                auto tmp{other};
-                tmp.swap(*this);
+                if (this == &other)
+                    return *this;
+
+                clear();
+
+                aux::copy_assign_allocator(allocator_, other.allocator_);
+                key_compare_ = other.key_compare_;
+
+                for (const auto& x: other)
+                    insert(x);
 
                 return *this;
             }
 
             rbtree& operator=(rbtree&& other)
             {
-                rbtree tmp{move(other)};
-                tmp.swap(*this);
+                if (this == &other)
+                    return *this;
+
+                clear();
+
+                key_compare_ = move(other.key_compare_);
+                if (aux::move_assign_allocator(allocator_, other.allocator_))
+                {
+                    root_ = other.root_;
+                    size_ = other.size_;
+
+                    other.root_ = nullptr;
+                    other.size_ = size_type{};
+                }
+                else
+                    move_elements_(other);
 
                 return *this;
             }
 
+            ~rbtree()
+            {
+                clear();
+            }
+
+            allocator_type get_allocator() const noexcept
+            {
+                return allocator_type{allocator_};
+            }
+
             bool empty() const noexcept
             {
                 return size_ == 0U;
@@ -107,9 +166,9 @@ namespace std::aux
                 return size_;
             }
 
-            size_type max_size(allocator_type& alloc)
+            size_type max_size() const noexcept
             {
-                return allocator_traits<allocator_type>::max_size(alloc);
+                return allocator_traits<node_allocator_type>::max_size(allocator_);
             }
 
             iterator begin()
@@ -222,12 +281,47 @@ namespace std::aux
 
             void clear() noexcept
             {
-                if (root_)
+                /**
+                 * Post-order traversal that unlinks leaves
+                 * as it goes, so that it needs neither
+                 * recursion nor additional memory.
+                 */
+                auto current = root_;
+                while (current)
                 {
-                    delete root_;
-                    root_ = nullptr;
-                    size_ = size_type{};
+                    if (current->left())
+                    {
+                        current = current->left();
+                        continue;
+                    }
+                    else if (current->right())
+                    {
+                        current = current->right();
+                        continue;
+                    }
+
+                    auto parent = current->parent();
+                    if (parent)
+                    {
+                        if (parent->left() == current)
+                            parent->left(nullptr);
+                        else
+                            parent->right(nullptr);
+                    }
+
+                    // Multi nodes hold a list of equivalent nodes.
+                    while (current)
+                    {
+                        auto next = current->get_next_equivalent();
+                        destroy_node(current);
+                        current = next;
+                    }
+
+                    current = parent;
                 }
+
+                root_ = nullptr;
+                size_ = size_type{};
             }
 
             void swap(rbtree& other)
@@ -238,6 +332,7 @@ namespace std::aux
                 std::swap(size_, other.size_);
                 std::swap(key_compare_, other.key_compare_);
                 std::swap(key_extractor_, other.key_extractor_);
+                aux::swap_allocators(allocator_, other.allocator_);
             }
 
             key_compare key_comp() const
@@ -365,30 +460,31 @@ namespace std::aux
                      * and return the successor which was the next
                      * in the list.
                      */
-                    delete tmp;
+                    destroy_node(tmp);
 
                     update_root_(succ); // Incase the first in list was root.
                     return succ;
                 }
-                else if (node == root_)
-                { // Only executed if root_ is unique.
+                else if (node == root_ && !node->left() && !node->right())
+                {
                     root_ = nullptr;
-                    delete node;
+                    destroy_node(node);
 
                     return nullptr;
                 }
 
                 if (node->left() && node->right())
                 {
+                    /**
+                     * Node with two children has a successor
+                     * in its right subtree, which takes its
+                     * place in the tree.
+                     */
                     node->swap(succ);
-                    if (succ && !succ->parent())
+                    if (!succ->parent())
                         root_ = succ;
 
                     // Node now has at most one child.
-                    // Also: If succ was nullptr, the swap
-                    //       didn't do anything and we can
-                    //       safely delete node.
-                    return delete_node(node);
                 }
 
                 auto child = node->right() ? node->right() : node->left();
@@ -397,7 +493,7 @@ namespace std::aux
                     // Simply remove the node.
                     // TODO: repair here too?
                     node->unlink();
-                    delete node;
+                    destroy_node(node);
                 }
                 else
                 {
@@ -415,7 +511,7 @@ namespace std::aux
                     repair_after_erase_(node, child);
                     update_root_(child);
 
-                    delete node;
+                    destroy_node(node);
                 }
 
                 return succ;
@@ -426,11 +522,32 @@ namespace std::aux
                 Policy::insert(*this, node, parent);
             }
 
+            template<class... Args>
+            node_type* create_node(Args&&... args)
+            {
+                return aux::create_node(allocator_, forward<Args>(args)...);
+            }
+
+            void destroy_node(node_type* node)
+            {
+                aux::destroy_node(allocator_, node);
+            }
+
         private:
+            using node_allocator_type = aux::node_allocator_t<allocator_type, node_type>;
+
             node_type* root_;
             size_type size_;
             key_compare key_compare_;
             key_extract key_extractor_;
+            node_allocator_type allocator_;
+
+            void move_elements_(rbtree& other)
+            {
+                for (auto& x: other)
+                    insert(move(x));
+                other.clear();
+            }
 
             node_type* find_(const key_type& key) const
             {
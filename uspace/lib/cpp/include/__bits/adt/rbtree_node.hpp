@@ -212,14 +212,28 @@ namespace std::aux
             if (!node1 || !node2)
                 return;
 
-            auto parent1 = node1->parent();
-            auto left1 = node1->left();
-            auto right1 = node1->right();
+            /**
+             * Note: If one of the nodes is the parent of the
+             *       other, the links between them have to be
+             *       reversed instead of copied.
+             */
+            auto other = [node1, node2](Node* node) {
+                if (node == node1)
+                    return node2;
+                else if (node == node2)
+                    return node1;
+                else
+                    return node;
+            };
+
+            auto parent1 = other(node1->parent());
+            auto left1 = other(node1->left());
+            auto right1 = other(node1->right());
             auto is_right1 = is_right_child(node1);
 
-            auto parent2 = node2->parent();
-            auto left2 = node2->left();
-            auto right2 = node2->right();
+            auto parent2 = other(node2->parent());
+            auto left2 = other(node2->left());
+            auto right2 = other(node2->right());
             auto is_right2 = is_right_child(node2);
 
             assimilate(node1, parent2, left2, right2, is_right2);
@@ -400,23 +414,19 @@ namespace std::aux
                 return nullptr;
             }
 
-            rbtree_single_node* get_end()
+            rbtree_single_node* get_next_equivalent()
             {
-                return this;
+                return nullptr;
             }
 
-            const rbtree_single_node* get_end() const
+            rbtree_single_node* get_end()
             {
                 return this;
             }
 
-            ~rbtree_single_node()
+            const rbtree_single_node* get_end() const
             {
-                parent_ = nullptr;
-                if (left_)
-                    delete left_;
-                if (right_)
-                    delete right_;
+                return this;
             }
 
         private:
@@ -646,8 +656,8 @@ namespace std::aux
                     }
 
                     /**
-                     * Otherwise destructor could
-                     * destroy them.
+                     * This node is no longer part
+                     * of the tree.
                      */
                     parent_ = nullptr;
                     left_ = nullptr;
@@ -669,6 +679,11 @@ namespace std::aux
                     parent_->right_ = nullptr;
             }
 
+            rbtree_multi_node* get_next_equivalent()
+            {
+                return next_;
+            }
+
             void add(rbtree_multi_node* node)
             {
                 if (next_)
@@ -704,17 +719,6 @@ namespace std::aux
                 }
             }
 
-            ~rbtree_multi_node()
-            {
-                parent_ = nullptr;
-                if (left_)
-                    delete left_;
-                if (right_)
-                    delete right_;
-
-                // TODO: delete the list
-            }
-
         private:
             rbtree_multi_node* parent_;
             rbtree_multi_node* left_;
@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ADT_SET
 
 #include <__bits/adt/rbtree.hpp>
+#include <__bits/memory/polymorphic_allocator.hpp>
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -82,7 +83,7 @@ namespace std
 
             explicit set(const key_compare& comp,
                          const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -95,23 +96,23 @@ namespace std
             }
 
             set(const set& other)
-                : set{other, other.allocator_}
+                : tree_{other.tree_}
             { /* DUMMY BODY */ }
 
             set(set&& other)
-                : tree_{move(other.tree_)}, allocator_{move(other.allocator_)}
+                : tree_{move(other.tree_)}
             { /* DUMMY BODY */ }
 
             explicit set(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}
             { /* DUMMY BODY */ }
 
             set(const set& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}
             { /* DUMMY BODY */ }
 
             set(set&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}
             { /* DUMMY BODY */ }
 
             set(initializer_list<value_type> init,
@@ -139,7 +140,6 @@ namespace std
             set& operator=(const set& other)
             {
                 tree_ = other.tree_;
-                allocator_ = other.allocator_;
 
                 return *this;
             }
@@ -149,7 +149,6 @@ namespace std
                          is_nothrow_move_assignable<key_compare>::value)
             {
                 tree_ = move(other.tree_);
-                allocator_ = move(other.allocator_);
 
                 return *this;
             }
@@ -165,7 +164,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return tree_.get_allocator();
             }
 
             iterator begin() noexcept
@@ -240,7 +239,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return tree_.max_size(allocator_);
+                return tree_.max_size();
             }
 
             template<class... Args>
@@ -312,7 +311,6 @@ namespace std
                          noexcept(std::swap(declval<key_compare>(), declval<key_compare>())))
             {
                 tree_.swap(other.tree_);
-                std::swap(allocator_, other.allocator_);
             }
 
             void clear() noexcept
@@ -465,7 +463,6 @@ namespace std
             >;
 
             tree_type tree_;
-            allocator_type allocator_;
 
             template<class K, class C, class A>
             friend bool operator==(const set<K, C, A>&,
@@ -563,7 +560,7 @@ namespace std
 
             explicit multiset(const key_compare& comp,
                               const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -576,23 +573,23 @@ namespace std
             }
 
             multiset(const multiset& other)
-                : multiset{other, other.allocator_}
+                : tree_{other.tree_}
             { /* DUMMY BODY */ }
 
             multiset(multiset&& other)
-                : tree_{move(other.tree_)}, allocator_{move(other.allocator_)}
+                : tree_{move(other.tree_)}
             { /* DUMMY BODY */ }
 
             explicit multiset(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}
             { /* DUMMY BODY */ }
 
             multiset(const multiset& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}
             { /* DUMMY BODY */ }
 
             multiset(multiset&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}
             { /* DUMMY BODY */ }
 
             multiset(initializer_list<value_type> init,
@@ -620,7 +617,6 @@ namespace std
             multiset& operator=(const multiset& other)
             {
                 tree_ = other.tree_;
-                allocator_ = other.allocator_;
 
                 return *this;
             }
@@ -630,7 +626,6 @@ namespace std
                          is_nothrow_move_assignable<key_compare>::value)
             {
                 tree_ = move(other.tree_);
-                allocator_ = move(other.allocator_);
 
                 return *this;
             }
@@ -646,7 +641,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return tree_.get_allocator();
             }
 
             iterator begin() noexcept
@@ -721,7 +716,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return tree_.max_size(allocator_);
+                return tree_.max_size();
             }
 
             template<class... Args>
@@ -793,7 +788,6 @@ namespace std
                          noexcept(std::swap(declval<key_compare>(), declval<key_compare>())))
             {
                 tree_.swap(other.tree_);
-                std::swap(allocator_, other.allocator_);
             }
 
             void clear() noexcept
@@ -946,7 +940,6 @@ namespace std
             >;
 
             tree_type tree_;
-            allocator_type allocator_;
 
             template<class K, class C, class A>
             friend bool operator==(const multiset<K, C, A>&,
@@ -998,6 +991,15 @@ namespace std
     {
         return !(rhs < lhs);
     }
+
+    namespace pmr
+    {
+        template<class Key, class Compare = less<Key>>
+        using set = std::set<Key, Compare, polymorphic_allocator<Key>>;
+
+        template<class Key, class Compare = less<Key>>
+        using multiset = std::multiset<Key, Compare, polymorphic_allocator<Key>>;
+    }
 }
 
 #endif
@@ -29,6 +29,1234 @@
 #ifndef LIBCPP_BITS_ADT_VALARRAY
 #define LIBCPP_BITS_ADT_VALARRAY
 
-#error "<valarray> is not implemented"
+#include <__bits/adt/valarray_expr.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace std
+{
+    class slice;
+    class gslice;
+
+    template<class T>
+    class slice_array;
+
+    template<class T>
+    class gslice_array;
+
+    template<class T>
+    class mask_array;
+
+    template<class T>
+    class indirect_array;
+
+    /**
+     * 26.6.4, class slice:
+     */
+
+    class slice
+    {
+        public:
+            slice()
+                : start_{}, size_{}, stride_{}
+            { /* DUMMY BODY */ }
+
+            slice(size_t start, size_t size, size_t stride)
+                : start_{start}, size_{size}, stride_{stride}
+            { /* DUMMY BODY */ }
+
+            slice(const slice&) = default;
+            slice& operator=(const slice&) = default;
+
+            size_t start() const
+            {
+                return start_;
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            size_t stride() const
+            {
+                return stride_;
+            }
+
+        private:
+            size_t start_;
+            size_t size_;
+            size_t stride_;
+    };
+
+    /**
+     * 26.6.2, class template valarray:
+     */
+
+    template<class T>
+    class valarray
+    {
+        public:
+            using value_type = T;
+
+            /**
+             * 26.6.2.1, construct/destroy:
+             */
+
+            valarray()
+                : data_{nullptr}, size_{}
+            { /* DUMMY BODY */ }
+
+            explicit valarray(size_t n)
+                : valarray()
+            {
+                allocate_(n);
+                for (size_t i = 0; i < n; ++i)
+                    ::new(static_cast<void*>(data_ + i)) T();
+            }
+
+            valarray(const T& val, size_t n)
+                : valarray()
+            {
+                init_(aux::valarray_scalar_closure<T>{val, n});
+            }
+
+            valarray(const T* arr, size_t n)
+                : valarray()
+            {
+                init_(aux::valarray_ref_closure<T>{arr, n});
+            }
+
+            valarray(const valarray& other)
+                : valarray()
+            {
+                init_(aux::valarray_ref_closure<T>{other.data_, other.size_});
+            }
+
+            valarray(valarray&& other) noexcept
+                : data_{other.data_}, size_{other.size_}
+            {
+                other.data_ = nullptr;
+                other.size_ = 0;
+            }
+
+            valarray(const slice_array<T>& arr)
+                : valarray()
+            {
+                init_proxy_(arr);
+            }
+
+            valarray(const gslice_array<T>& arr)
+                : valarray()
+            {
+                init_proxy_(arr);
+            }
+
+            valarray(const mask_array<T>& arr)
+                : valarray()
+            {
+                init_proxy_(arr);
+            }
+
+            valarray(const indirect_array<T>& arr)
+                : valarray()
+            {
+                init_proxy_(arr);
+            }
+
+            valarray(initializer_list<T> init)
+                : valarray(init.begin(), init.size())
+            { /* DUMMY BODY */ }
+
+            /**
+             * Note: This evaluates a (possibly nested) expression
+             *       like a * b + c in a single pass.
+             */
+            template<
+                class Closure,
+                class = enable_if_t<is_same_v<typename Closure::value_type, T>>
+            >
+            valarray(const aux::valarray_expr<Closure>& expr)
+                : valarray()
+            {
+                init_(expr.closure());
+            }
+
+            ~valarray()
+            {
+                destroy_();
+            }
+
+            /**
+             * 26.6.2.3, assignment:
+             */
+
+            valarray& operator=(const valarray& rhs)
+            {
+                if (this != &rhs)
+                    assign_(aux::valarray_ref_closure<T>{rhs.data_, rhs.size_});
+
+                return *this;
+            }
+
+            valarray& operator=(valarray&& rhs) noexcept
+            {
+                swap(rhs);
+
+                return *this;
+            }
+
+            valarray& operator=(initializer_list<T> init)
+            {
+                assign_(aux::valarray_ref_closure<T>{init.begin(), init.size()});
+
+                return *this;
+            }
+
+            valarray& operator=(const T& val)
+            {
+                for (size_t i = 0; i < size_; ++i)
+                    data_[i] = val;
+
+                return *this;
+            }
+
+            valarray& operator=(const slice_array<T>& arr)
+            {
+                return *this = valarray{arr};
+            }
+
+            valarray& operator=(const gslice_array<T>& arr)
+            {
+                return *this = valarray{arr};
+            }
+
+            valarray& operator=(const mask_array<T>& arr)
+            {
+                return *this = valarray{arr};
+            }
+
+            valarray& operator=(const indirect_array<T>& arr)
+            {
+                return *this = valarray{arr};
+            }
+
+            template<
+                class Closure,
+                class = enable_if_t<is_same_v<typename Closure::value_type, T>>
+            >
+            valarray& operator=(const aux::valarray_expr<Closure>& expr)
+            {
+                assign_(expr.closure());
+
+                return *this;
+            }
+
+            /**
+             * 26.6.2.4, element access:
+             */
+
+            const T& operator[](size_t idx) const
+            {
+                return data_[idx];
+            }
+
+            T& operator[](size_t idx)
+            {
+                return data_[idx];
+            }
+
+            /**
+             * 26.6.2.5, subset operations:
+             */
+
+            valarray operator[](slice s) const
+            {
+                return valarray{slice_array<T>{data_, s}};
+            }
+
+            slice_array<T> operator[](slice s)
+            {
+                return slice_array<T>{data_, s};
+            }
+
+            valarray operator[](const gslice& gs) const;
+            gslice_array<T> operator[](const gslice& gs);
+
+            valarray operator[](const valarray<bool>& mask) const;
+            mask_array<T> operator[](const valarray<bool>& mask);
+
+            valarray operator[](const valarray<size_t>& indices) const
+            {
+                return valarray{indirect_array<T>{data_, indices}};
+            }
+
+            indirect_array<T> operator[](const valarray<size_t>& indices)
+            {
+                return indirect_array<T>{data_, indices};
+            }
+
+            /**
+             * 26.6.2.6, unary operators:
+             */
+
+            auto operator+() const
+            {
+                return aux::make_valarray_unary<aux::valarray_unary_plus>(*this);
+            }
+
+            auto operator-() const
+            {
+                return aux::make_valarray_unary<negate>(*this);
+            }
+
+            auto operator~() const
+            {
+                return aux::make_valarray_unary<bit_not>(*this);
+            }
+
+            auto operator!() const
+            {
+                return aux::make_valarray_unary<logical_not>(*this);
+            }
+
+            /**
+             * 26.6.2.7, compound assignment:
+             * Note: The right hand side can be a scalar,
+             *       a valarray or an unevaluated expression.
+             */
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator*=(const Arg& arg)
+            {
+                return compound_<multiplies>(arg);
+            }
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator/=(const Arg& arg)
+            {
+                return compound_<divides>(arg);
+            }
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator%=(const Arg& arg)
+            {
+                return compound_<modulus>(arg);
+            }
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator+=(const Arg& arg)
+            {
+                return compound_<plus>(arg);
+            }
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator-=(const Arg& arg)
+            {
+                return compound_<minus>(arg);
+            }
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator^=(const Arg& arg)
+            {
+                return compound_<bit_xor>(arg);
+            }
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator&=(const Arg& arg)
+            {
+                return compound_<bit_and>(arg);
+            }
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator|=(const Arg& arg)
+            {
+                return compound_<bit_or>(arg);
+            }
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator<<=(const Arg& arg)
+            {
+                return compound_<aux::valarray_shift_left>(arg);
+            }
+
+            template<class Arg, class = aux::enable_valarray_binary_t<valarray, Arg>>
+            valarray& operator>>=(const Arg& arg)
+            {
+                return compound_<aux::valarray_shift_right>(arg);
+            }
+
+            /**
+             * 26.6.2.8, member functions:
+             */
+
+            void swap(valarray& other) noexcept
+            {
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            T sum() const
+            {
+                return expr_().sum();
+            }
+
+            T min() const
+            {
+                return expr_().min();
+            }
+
+            T max() const
+            {
+                return expr_().max();
+            }
+
+            valarray shift(int n) const
+            {
+                valarray res(size_);
+
+                /**
+                 * Note: Elements shifted in from outside
+                 *       of the array are value initialized.
+                 */
+                auto off = static_cast<ptrdiff_t>(n);
+                auto size = static_cast<ptrdiff_t>(size_);
+                for (ptrdiff_t i = 0; i < size; ++i)
+                {
+                    if (i + off >= 0 && i + off < size)
+                        res.data_[i] = data_[i + off];
+                }
+
+                return res;
+            }
+
+            valarray cshift(int n) const
+            {
+                if (size_ == 0)
+                    return valarray{};
+
+                valarray res(size_);
+
+                auto size = static_cast<ptrdiff_t>(size_);
+                auto off = static_cast<ptrdiff_t>(n) % size;
+                if (off < 0)
+                    off += size;
+
+                for (ptrdiff_t i = 0; i < size; ++i)
+                    res.data_[i] = data_[(i + off) % size];
+
+                return res;
+            }
+
+            valarray apply(T func(T)) const
+            {
+                valarray res(size_);
+                for (size_t i = 0; i < size_; ++i)
+                    res.data_[i] = func(data_[i]);
+
+                return res;
+            }
+
+            valarray apply(T func(const T&)) const
+            {
+                valarray res(size_);
+                for (size_t i = 0; i < size_; ++i)
+                    res.data_[i] = func(data_[i]);
+
+                return res;
+            }
+
+            void resize(size_t n, T val = T())
+            {
+                destroy_();
+                init_(aux::valarray_scalar_closure<T>{val, n});
+            }
+
+        private:
+            T* data_;
+            size_t size_;
+
+            auto expr_() const
+            {
+                using closure_type = aux::valarray_ref_closure<T>;
+
+                return aux::valarray_expr<closure_type>{closure_type{data_, size_}};
+            }
+
+            void allocate_(size_t n)
+            {
+                if (n > 0)
+                    data_ = static_cast<T*>(::operator new(n * sizeof(T)));
+                size_ = n;
+            }
+
+            void destroy_()
+            {
+                for (size_t i = 0; i < size_; ++i)
+                    data_[i].~T();
+                ::operator delete(data_);
+
+                data_ = nullptr;
+                size_ = 0;
+            }
+
+            template<class Closure>
+            void init_(const Closure& closure)
+            {
+                auto n = closure.size();
+                allocate_(n);
+
+                auto data = data_;
+                for (size_t i = 0; i < n; ++i)
+                    ::new(static_cast<void*>(data + i)) T(closure[i]);
+            }
+
+            template<class Closure>
+            void assign_(const Closure& closure)
+            {
+                /**
+                 * Note: Expression elements only ever depend on
+                 *       elements with the same index, so even
+                 *       if the expression refers to this array,
+                 *       it can be evaluated in place. Only when
+                 *       the size changes we need a new buffer.
+                 */
+                if (closure.size() == size_)
+                {
+                    for (size_t i = 0; i < size_; ++i)
+                        data_[i] = closure[i];
+                }
+                else
+                {
+                    valarray tmp{};
+                    tmp.init_(closure);
+                    swap(tmp);
+                }
+            }
+
+            template<template<class> class Op, class Arg>
+            valarray& compound_(const Arg& arg)
+            {
+                auto closure = aux::make_valarray_closure<T>(arg, size_);
+
+                Op<T> op{};
+                for (size_t i = 0; i < size_; ++i)
+                    data_[i] = op(data_[i], closure[i]);
+
+                return *this;
+            }
+
+            template<class Proxy>
+            void init_proxy_(const Proxy& proxy)
+            {
+                auto n = proxy.size_();
+
+                allocate_(n);
+                for (size_t i = 0; i < n; ++i)
+                    ::new(static_cast<void*>(data_ + i)) T(proxy.element_(i));
+            }
+    };
+
+    /**
+     * 26.6.6, the gslice class:
+     */
+
+    class gslice
+    {
+        public:
+            gslice()
+                : start_{}, sizes_{}, strides_{}
+            { /* DUMMY BODY */ }
+
+            gslice(size_t start, const valarray<size_t>& sizes,
+                   const valarray<size_t>& strides)
+                : start_{start}, sizes_{sizes}, strides_{strides}
+            { /* DUMMY BODY */ }
+
+            gslice(const gslice&) = default;
+            gslice& operator=(const gslice&) = default;
+
+            size_t start() const
+            {
+                return start_;
+            }
+
+            valarray<size_t> size() const
+            {
+                return sizes_;
+            }
+
+            valarray<size_t> stride() const
+            {
+                return strides_;
+            }
+
+        private:
+            size_t start_;
+            valarray<size_t> sizes_;
+            valarray<size_t> strides_;
+
+            /**
+             * Computes the indices the slice refers to,
+             * the last dimension changes fastest.
+             */
+            valarray<size_t> indices_() const
+            {
+                auto dims = sizes_.size();
+                if (dims == 0)
+                    return valarray<size_t>{};
+
+                size_t count{1};
+                for (size_t d = 0; d < dims; ++d)
+                    count *= sizes_[d];
+
+                valarray<size_t> res(count);
+                valarray<size_t> pos(dims);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    auto idx = start_;
+                    for (size_t d = 0; d < dims; ++d)
+                        idx += pos[d] * strides_[d];
+                    res[i] = idx;
+
+                    for (size_t d = dims; d > 0; --d)
+                    {
+                        if (++pos[d - 1] < sizes_[d - 1])
+                            break;
+                        pos[d - 1] = 0;
+                    }
+                }
+
+                return res;
+            }
+
+            template<class T>
+            friend class valarray;
+    };
+
+    namespace aux
+    {
+        /**
+         * Common base of slice_array, gslice_array, mask_array
+         * and indirect_array, which all refer to a subset
+         * of elements of a valarray. The derived class provides
+         * the number of elements and a mapping of their indices.
+         */
+        template<class T, class Derived>
+        class valarray_proxy
+        {
+            public:
+                using value_type = T;
+
+                void operator*=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs *= rhs; });
+                }
+
+                void operator/=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs /= rhs; });
+                }
+
+                void operator%=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs %= rhs; });
+                }
+
+                void operator+=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs += rhs; });
+                }
+
+                void operator-=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs -= rhs; });
+                }
+
+                void operator^=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs ^= rhs; });
+                }
+
+                void operator&=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs &= rhs; });
+                }
+
+                void operator|=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs |= rhs; });
+                }
+
+                void operator<<=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs <<= rhs; });
+                }
+
+                void operator>>=(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs >>= rhs; });
+                }
+
+            protected:
+                /**
+                 * The assignment operators are declared in the derived
+                 * classes, so that the implicit assignment operators
+                 * of this class do not compete with their copy assignment.
+                 */
+                void assign_(const valarray<T>& rhs) const
+                {
+                    apply_(rhs, [](T& lhs, const T& rhs){ lhs = rhs; });
+                }
+
+                void fill_(const T& val) const
+                {
+                    auto& self = static_cast<const Derived&>(*this);
+                    for (size_t i = 0; i < self.size_(); ++i)
+                        self.element_(i) = val;
+                }
+
+                template<class Fun>
+                void apply_(const valarray<T>& rhs, Fun fun) const
+                {
+                    auto& self = static_cast<const Derived&>(*this);
+                    for (size_t i = 0; i < self.size_(); ++i)
+                        fun(self.element_(i), rhs[i]);
+                }
+
+                void copy_(const Derived& rhs) const
+                {
+                    auto& self = static_cast<const Derived&>(*this);
+                    for (size_t i = 0; i < self.size_(); ++i)
+                        self.element_(i) = rhs.element_(i);
+                }
+        };
+
+        /**
+         * Base of the proxies that store the indices
+         * of the elements they refer to explicitly.
+         */
+        template<class T, class Derived>
+        class valarray_indirect_proxy: public valarray_proxy<T, Derived>
+        {
+            protected:
+                valarray_indirect_proxy(T* data, valarray<size_t>&& indices)
+                    : data_{data}, indices_{move(indices)}
+                { /* DUMMY BODY */ }
+
+                valarray_indirect_proxy(const valarray_indirect_proxy&) = default;
+
+                size_t size_() const
+                {
+                    return indices_.size();
+                }
+
+                T& element_(size_t idx) const
+                {
+                    return data_[indices_[idx]];
+                }
+
+                T* data_;
+                valarray<size_t> indices_;
+
+                friend class valarray_proxy<T, Derived>;
+                friend class valarray<T>;
+        };
+    }
+
+    /**
+     * 26.6.5, class template slice_array:
+     */
+
+    template<class T>
+    class slice_array: public aux::valarray_proxy<T, slice_array<T>>
+    {
+        public:
+            using value_type = T;
+
+            slice_array(const slice_array&) = default;
+
+            ~slice_array() = default;
+
+            const slice_array& operator=(const slice_array& rhs) const
+            {
+                this->copy_(rhs);
+
+                return *this;
+            }
+
+            void operator=(const valarray<T>& rhs) const
+            {
+                this->assign_(rhs);
+            }
+
+            void operator=(const T& val) const
+            {
+                this->fill_(val);
+            }
+
+            slice_array() = delete;
+
+        private:
+            T* data_;
+            slice slice_;
+
+            slice_array(T* data, const slice& s)
+                : data_{data}, slice_{s}
+            { /* DUMMY BODY */ }
+
+            size_t size_() const
+            {
+                return slice_.size();
+            }
+
+            T& element_(size_t idx) const
+            {
+                return data_[slice_.start() + idx * slice_.stride()];
+            }
+
+            friend class aux::valarray_proxy<T, slice_array<T>>;
+            friend class valarray<T>;
+    };
+
+    /**
+     * 26.6.7, class template gslice_array:
+     */
+
+    template<class T>
+    class gslice_array: public aux::valarray_indirect_proxy<T, gslice_array<T>>
+    {
+        public:
+            using value_type = T;
+
+            gslice_array(const gslice_array&) = default;
+
+            ~gslice_array() = default;
+
+            const gslice_array& operator=(const gslice_array& rhs) const
+            {
+                this->copy_(rhs);
+
+                return *this;
+            }
+
+            void operator=(const valarray<T>& rhs) const
+            {
+                this->assign_(rhs);
+            }
+
+            void operator=(const T& val) const
+            {
+                this->fill_(val);
+            }
+
+            gslice_array() = delete;
+
+        private:
+            gslice_array(T* data, valarray<size_t>&& indices)
+                : aux::valarray_indirect_proxy<T, gslice_array<T>>{data, move(indices)}
+            { /* DUMMY BODY */ }
+
+            friend class aux::valarray_proxy<T, gslice_array<T>>;
+            friend class valarray<T>;
+    };
+
+    /**
+     * 26.6.8, class template mask_array:
+     */
+
+    template<class T>
+    class mask_array: public aux::valarray_indirect_proxy<T, mask_array<T>>
+    {
+        public:
+            using value_type = T;
+
+            mask_array(const mask_array&) = default;
+
+            ~mask_array() = default;
+
+            const mask_array& operator=(const mask_array& rhs) const
+            {
+                this->copy_(rhs);
+
+                return *this;
+            }
+
+            void operator=(const valarray<T>& rhs) const
+            {
+                this->assign_(rhs);
+            }
+
+            void operator=(const T& val) const
+            {
+                this->fill_(val);
+            }
+
+            mask_array() = delete;
+
+        private:
+            mask_array(T* data, valarray<size_t>&& indices)
+                : aux::valarray_indirect_proxy<T, mask_array<T>>{data, move(indices)}
+            { /* DUMMY BODY */ }
+
+            friend class aux::valarray_proxy<T, mask_array<T>>;
+            friend class valarray<T>;
+    };
+
+    /**
+     * 26.6.9, class template indirect_array:
+     */
+
+    template<class T>
+    class indirect_array: public aux::valarray_indirect_proxy<T, indirect_array<T>>
+    {
+        public:
+            using value_type = T;
+
+            indirect_array(const indirect_array&) = default;
+
+            ~indirect_array() = default;
+
+            const indirect_array& operator=(const indirect_array& rhs) const
+            {
+                this->copy_(rhs);
+
+                return *this;
+            }
+
+            void operator=(const valarray<T>& rhs) const
+            {
+                this->assign_(rhs);
+            }
+
+            void operator=(const T& val) const
+            {
+                this->fill_(val);
+            }
+
+            indirect_array() = delete;
+
+        private:
+            indirect_array(T* data, const valarray<size_t>& indices)
+                : aux::valarray_indirect_proxy<T, indirect_array<T>>{
+                    data, valarray<size_t>{indices}
+                }
+            { /* DUMMY BODY */ }
+
+            friend class aux::valarray_proxy<T, indirect_array<T>>;
+            friend class valarray<T>;
+    };
+
+    namespace aux
+    {
+        inline valarray<size_t> valarray_mask_indices(const valarray<bool>& mask)
+        {
+            size_t count{};
+            for (size_t i = 0; i < mask.size(); ++i)
+            {
+                if (mask[i])
+                    ++count;
+            }
+
+            valarray<size_t> res(count);
+            for (size_t i = 0, j = 0; i < mask.size(); ++i)
+            {
+                if (mask[i])
+                    res[j++] = i;
+            }
+
+            return res;
+        }
+    }
+
+    template<class T>
+    valarray<T> valarray<T>::operator[](const gslice& gs) const
+    {
+        return valarray{gslice_array<T>{data_, gs.indices_()}};
+    }
+
+    template<class T>
+    gslice_array<T> valarray<T>::operator[](const gslice& gs)
+    {
+        return gslice_array<T>{data_, gs.indices_()};
+    }
+
+    template<class T>
+    valarray<T> valarray<T>::operator[](const valarray<bool>& mask) const
+    {
+        return valarray{mask_array<T>{data_, aux::valarray_mask_indices(mask)}};
+    }
+
+    template<class T>
+    mask_array<T> valarray<T>::operator[](const valarray<bool>& mask)
+    {
+        return mask_array<T>{data_, aux::valarray_mask_indices(mask)};
+    }
+
+    /**
+     * 26.6.2.9, specialized algorithms:
+     */
+
+    template<class T>
+    void swap(valarray<T>& lhs, valarray<T>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    /**
+     * 26.6.3.1, valarray binary operators:
+     * Note: These accept valarrays, unevaluated expressions
+     *       and scalars (for one of the operands) and return
+     *       an unevaluated expression that converts to valarray.
+     */
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator*(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<multiplies>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator/(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<divides>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator%(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<modulus>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator+(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<plus>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator-(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<minus>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator^(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<bit_xor>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator&(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<bit_and>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator|(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<bit_or>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator<<(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<aux::valarray_shift_left>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator>>(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<aux::valarray_shift_right>(lhs, rhs);
+    }
+
+    /**
+     * 26.6.3.2, valarray logical operators:
+     */
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator&&(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<logical_and>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator||(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<logical_or>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator==(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<equal_to>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator!=(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<not_equal_to>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator<(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<less>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator>(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<greater>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator<=(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<less_equal>(lhs, rhs);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto operator>=(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<greater_equal>(lhs, rhs);
+    }
+
+    /**
+     * 26.6.3.3, transcendentals:
+     */
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto abs(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_abs>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto acos(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_acos>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto asin(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_asin>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto atan(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_atan>(arg);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto atan2(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<aux::valarray_atan2>(lhs, rhs);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto cos(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_cos>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto cosh(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_cosh>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto exp(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_exp>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto log(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_log>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto log10(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_log10>(arg);
+    }
+
+    template<class Lhs, class Rhs, class = aux::enable_valarray_binary_t<Lhs, Rhs>>
+    auto pow(const Lhs& lhs, const Rhs& rhs)
+    {
+        return aux::make_valarray_binary<aux::valarray_pow>(lhs, rhs);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto sin(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_sin>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto sinh(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_sinh>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto sqrt(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_sqrt>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto tan(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_tan>(arg);
+    }
+
+    template<class Arg, class = aux::enable_valarray_unary_t<Arg>>
+    auto tanh(const Arg& arg)
+    {
+        return aux::make_valarray_unary<aux::valarray_tanh>(arg);
+    }
+
+    /**
+     * 26.6.10, valarray range access:
+     */
+
+    template<class T>
+    T* begin(valarray<T>& arr)
+    {
+        return arr.size() > 0 ? &arr[0] : nullptr;
+    }
+
+    template<class T>
+    const T* begin(const valarray<T>& arr)
+    {
+        return arr.size() > 0 ? &arr[0] : nullptr;
+    }
+
+    template<class T>
+    T* end(valarray<T>& arr)
+    {
+        return begin(arr) + arr.size();
+    }
+
+    template<class T>
+    const T* end(const valarray<T>& arr)
+    {
+        return begin(arr) + arr.size();
+    }
+}
 
 #endif
@@ -0,0 +1,651 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_VALARRAY_EXPR
+#define LIBCPP_BITS_ADT_VALARRAY_EXPR
+
+#include <__bits/functional/arithmetic_operations.hpp>
+#include <cstddef>
+#include <math.h>
+#include <type_traits>
+#include <utility>
+
+namespace std
+{
+    template<class T>
+    class valarray;
+}
+
+namespace std::aux
+{
+    /**
+     * Operations on valarrays are not evaluated immediately,
+     * instead they build an expression tree of closures that
+     * is only evaluated when it is assigned to a valarray
+     * (or reduced by sum, min and max). This way an expression
+     * like a * b + c is computed in a single loop without any
+     * temporary arrays, and since the closures are small and
+     * fully inlined, the compiler can vectorize that loop.
+     *
+     * Each closure provides value_type, size() and operator[].
+     */
+
+    template<class T>
+    struct valarray_unary_plus
+    {
+        T operator()(const T& arg) const
+        {
+            return +arg;
+        }
+    };
+
+    template<class T>
+    struct valarray_shift_left
+    {
+        T operator()(const T& lhs, const T& rhs) const
+        {
+            return lhs << rhs;
+        }
+    };
+
+    template<class T>
+    struct valarray_shift_right
+    {
+        T operator()(const T& lhs, const T& rhs) const
+        {
+            return lhs >> rhs;
+        }
+    };
+
+    /**
+     * Note: Arithmetic types are passed to the C library
+     *       (in double precision), other types (like complex)
+     *       use their own overloads found by unqualified
+     *       lookup.
+     */
+
+    template<class T>
+    struct valarray_abs
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_floating_point_v<T>)
+                return static_cast<T>(::fabs(arg));
+            else if constexpr (is_arithmetic_v<T>)
+                return arg < T{} ? -arg : arg;
+            else
+                return abs(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_acos
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::acos(arg));
+            else
+                return acos(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_asin
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::asin(arg));
+            else
+                return asin(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_atan
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::atan(arg));
+            else
+                return atan(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_atan2
+    {
+        T operator()(const T& lhs, const T& rhs) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::atan2(lhs, rhs));
+            else
+                return atan2(lhs, rhs);
+        }
+    };
+
+    template<class T>
+    struct valarray_cos
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::cos(arg));
+            else
+                return cos(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_cosh
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::cosh(arg));
+            else
+                return cosh(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_exp
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::exp(arg));
+            else
+                return exp(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_log
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::log(arg));
+            else
+                return log(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_log10
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::log10(arg));
+            else
+                return log10(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_pow
+    {
+        T operator()(const T& lhs, const T& rhs) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::pow(lhs, rhs));
+            else
+                return pow(lhs, rhs);
+        }
+    };
+
+    template<class T>
+    struct valarray_sin
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::sin(arg));
+            else
+                return sin(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_sinh
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::sinh(arg));
+            else
+                return sinh(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_sqrt
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::sqrt(arg));
+            else
+                return sqrt(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_tan
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::tan(arg));
+            else
+                return tan(arg);
+        }
+    };
+
+    template<class T>
+    struct valarray_tanh
+    {
+        T operator()(const T& arg) const
+        {
+            if constexpr (is_arithmetic_v<T>)
+                return static_cast<T>(::tanh(arg));
+            else
+                return tanh(arg);
+        }
+    };
+
+    template<class T>
+    class valarray_ref_closure
+    {
+        public:
+            using value_type = T;
+
+            valarray_ref_closure(const T* data, size_t size)
+                : data_{data}, size_{size}
+            { /* DUMMY BODY */ }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            const T& operator[](size_t idx) const
+            {
+                return data_[idx];
+            }
+
+        private:
+            const T* data_;
+            size_t size_;
+    };
+
+    template<class T>
+    class valarray_scalar_closure
+    {
+        public:
+            using value_type = T;
+
+            valarray_scalar_closure(const T& value, size_t size)
+                : value_{value}, size_{size}
+            { /* DUMMY BODY */ }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            const T& operator[](size_t) const
+            {
+                return value_;
+            }
+
+        private:
+            T value_;
+            size_t size_;
+    };
+
+    template<class Op, class Closure>
+    class valarray_unary_closure
+    {
+        public:
+            using value_type = decay_t<
+                decltype(declval<Op>()(declval<typename Closure::value_type>()))
+            >;
+
+            valarray_unary_closure(const Closure& arg)
+                : arg_{arg}
+            { /* DUMMY BODY */ }
+
+            size_t size() const
+            {
+                return arg_.size();
+            }
+
+            value_type operator[](size_t idx) const
+            {
+                return Op{}(arg_[idx]);
+            }
+
+        private:
+            Closure arg_;
+    };
+
+    template<class Op, class Lhs, class Rhs>
+    class valarray_binary_closure
+    {
+        public:
+            using value_type = decay_t<
+                decltype(declval<Op>()(
+                    declval<typename Lhs::value_type>(),
+                    declval<typename Rhs::value_type>()
+                ))
+            >;
+
+            valarray_binary_closure(const Lhs& lhs, const Rhs& rhs)
+                : lhs_{lhs}, rhs_{rhs}
+            { /* DUMMY BODY */ }
+
+            size_t size() const
+            {
+                return lhs_.size();
+            }
+
+            value_type operator[](size_t idx) const
+            {
+                return Op{}(lhs_[idx], rhs_[idx]);
+            }
+
+        private:
+            Lhs lhs_;
+            Rhs rhs_;
+    };
+
+    template<class Closure>
+    class valarray_expr;
+
+    template<class T>
+    struct valarray_operand: false_type
+    { /* DUMMY BODY */ };
+
+    template<class T>
+    struct valarray_operand<valarray<T>>: true_type
+    {
+        using element_type = T;
+        using closure_type = valarray_ref_closure<T>;
+
+        static closure_type closure(const valarray<T>& arr)
+        {
+            return closure_type{arr.size() > 0 ? &arr[0] : nullptr, arr.size()};
+        }
+    };
+
+    template<class Closure>
+    struct valarray_operand<valarray_expr<Closure>>: true_type
+    {
+        using element_type = typename Closure::value_type;
+        using closure_type = Closure;
+
+        static const closure_type& closure(const valarray_expr<Closure>& expr)
+        {
+            return expr.closure();
+        }
+    };
+
+    template<class T>
+    inline constexpr bool is_valarray_operand_v = valarray_operand<T>::value;
+
+    template<class T>
+    using enable_valarray_unary_t = enable_if_t<is_valarray_operand_v<T>>;
+
+    /**
+     * Decides whether a binary operation can be applied
+     * to the given operands and what type the elements
+     * of the operands have. One of the operands may be
+     * a scalar convertible to the element type.
+     */
+    template<class Lhs, class Rhs, class = void>
+    struct valarray_binary_traits
+    { /* DUMMY BODY */ };
+
+    template<class Lhs, class Rhs>
+    struct valarray_binary_traits<
+        Lhs, Rhs,
+        enable_if_t<
+            is_same_v<
+                typename valarray_operand<Lhs>::element_type,
+                typename valarray_operand<Rhs>::element_type
+            >
+        >
+    >
+    {
+        using value_type = typename valarray_operand<Lhs>::element_type;
+
+        static size_t size(const Lhs& lhs, const Rhs&)
+        {
+            return lhs.size();
+        }
+    };
+
+    template<class Lhs, class Rhs>
+    struct valarray_binary_traits<
+        Lhs, Rhs,
+        enable_if_t<
+            !is_valarray_operand_v<Rhs> &&
+            is_convertible_v<const Rhs&, typename valarray_operand<Lhs>::element_type>
+        >
+    >
+    {
+        using value_type = typename valarray_operand<Lhs>::element_type;
+
+        static size_t size(const Lhs& lhs, const Rhs&)
+        {
+            return lhs.size();
+        }
+    };
+
+    template<class Lhs, class Rhs>
+    struct valarray_binary_traits<
+        Lhs, Rhs,
+        enable_if_t<
+            !is_valarray_operand_v<Lhs> &&
+            is_convertible_v<const Lhs&, typename valarray_operand<Rhs>::element_type>
+        >
+    >
+    {
+        using value_type = typename valarray_operand<Rhs>::element_type;
+
+        static size_t size(const Lhs&, const Rhs& rhs)
+        {
+            return rhs.size();
+        }
+    };
+
+    template<class Lhs, class Rhs>
+    using enable_valarray_binary_t = void_t<
+        typename valarray_binary_traits<Lhs, Rhs>::value_type
+    >;
+
+    template<class T, class Arg>
+    auto make_valarray_closure(const Arg& arg, size_t size)
+    {
+        if constexpr (is_valarray_operand_v<Arg>)
+            return valarray_operand<Arg>::closure(arg);
+        else
+            return valarray_scalar_closure<T>{T(arg), size};
+    }
+
+    template<class Closure>
+    class valarray_expr
+    {
+        public:
+            using value_type = typename Closure::value_type;
+
+            explicit valarray_expr(const Closure& closure)
+                : closure_{closure}
+            { /* DUMMY BODY */ }
+
+            size_t size() const
+            {
+                return closure_.size();
+            }
+
+            value_type operator[](size_t idx) const
+            {
+                return closure_[idx];
+            }
+
+            const Closure& closure() const
+            {
+                return closure_;
+            }
+
+            value_type sum() const
+            {
+                value_type res = closure_[0];
+                for (size_t i = 1; i < size(); ++i)
+                    res += closure_[i];
+
+                return res;
+            }
+
+            value_type min() const
+            {
+                value_type res = closure_[0];
+                for (size_t i = 1; i < size(); ++i)
+                {
+                    value_type tmp = closure_[i];
+                    if (tmp < res)
+                        res = tmp;
+                }
+
+                return res;
+            }
+
+            value_type max() const
+            {
+                value_type res = closure_[0];
+                for (size_t i = 1; i < size(); ++i)
+                {
+                    value_type tmp = closure_[i];
+                    if (res < tmp)
+                        res = tmp;
+                }
+
+                return res;
+            }
+
+            valarray<value_type> shift(int n) const
+            {
+                return valarray<value_type>{*this}.shift(n);
+            }
+
+            valarray<value_type> cshift(int n) const
+            {
+                return valarray<value_type>{*this}.cshift(n);
+            }
+
+            valarray<value_type> apply(value_type func(value_type)) const
+            {
+                return valarray<value_type>{*this}.apply(func);
+            }
+
+            valarray<value_type> apply(value_type func(const value_type&)) const
+            {
+                return valarray<value_type>{*this}.apply(func);
+            }
+
+            auto operator+() const;
+            auto operator-() const;
+            auto operator~() const;
+            auto operator!() const;
+
+        private:
+            Closure closure_;
+    };
+
+    template<template<class> class Op, class Arg>
+    auto make_valarray_unary(const Arg& arg)
+    {
+        using value_type = typename valarray_operand<Arg>::element_type;
+        using closure_type = typename valarray_operand<Arg>::closure_type;
+        using result_type = valarray_unary_closure<Op<value_type>, closure_type>;
+
+        return valarray_expr<result_type>{
+            result_type{valarray_operand<Arg>::closure(arg)}
+        };
+    }
+
+    template<template<class> class Op, class Lhs, class Rhs>
+    auto make_valarray_binary(const Lhs& lhs, const Rhs& rhs)
+    {
+        using traits = valarray_binary_traits<Lhs, Rhs>;
+        using value_type = typename traits::value_type;
+
+        auto size = traits::size(lhs, rhs);
+        auto lhs_closure = make_valarray_closure<value_type>(lhs, size);
+        auto rhs_closure = make_valarray_closure<value_type>(rhs, size);
+
+        using result_type = valarray_binary_closure<
+            Op<value_type>, decltype(lhs_closure), decltype(rhs_closure)
+        >;
+
+        return valarray_expr<result_type>{
+            result_type{lhs_closure, rhs_closure}
+        };
+    }
+
+    template<class Closure>
+    auto valarray_expr<Closure>::operator+() const
+    {
+        return make_valarray_unary<valarray_unary_plus>(*this);
+    }
+
+    template<class Closure>
+    auto valarray_expr<Closure>::operator-() const
+    {
+        return make_valarray_unary<negate>(*this);
+    }
+
+    template<class Closure>
+    auto valarray_expr<Closure>::operator~() const
+    {
+        return make_valarray_unary<bit_not>(*this);
+    }
+
+    template<class Closure>
+    auto valarray_expr<Closure>::operator!() const
+    {
+        return make_valarray_unary<logical_not>(*this);
+    }
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include <initializer_list>
 #include <iterator>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 namespace std
@@ -82,15 +83,20 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = val;
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, val);
             }
 
-            template<class InputIterator>
+            template<
+                class InputIterator,
+                class = enable_if_t<!is_integral_v<InputIterator>>
+            >
             vector(InputIterator first, InputIterator last,
                    const Allocator& alloc = Allocator{})
+                : data_{nullptr}, size_{}, capacity_{},
+                  allocator_{alloc}
             {
-                // TODO: research constraints and provide multiple
-                //       implementations via enable_if
+                while (first != last)
+                    push_back(*first++);
             }
 
             vector(const vector& other)
@@ -100,7 +106,7 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = other.data_[i];
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, other.data_[i]);
             }
 
             vector(vector&& other) noexcept
@@ -119,7 +125,7 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = other.data_[i];
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, other.data_[i]);
             }
 
             vector(initializer_list<T> init, const Allocator& alloc = Allocator{})
@@ -130,9 +136,7 @@ namespace std
 
                 auto it = init.begin();
                 for (size_type i = 0; it != init.end(); ++i, ++it)
-                {
-                    data_[i] = *it;
-                }
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, *it);
             }
 
             ~vector()
@@ -274,16 +278,34 @@ namespace std
 
             void resize(size_type sz)
             {
-                resize_with_copy_(size_, capacity_);
+                if (sz <= size_)
+                {
+                    resize_with_copy_(sz, capacity_);
+
+                    return;
+                }
+
+                if (sz > capacity_)
+                    resize_with_copy_(size_, next_capacity_(sz));
+                for (size_type i = size_; i < sz; ++i)
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i);
+                size_ = sz;
             }
 
             void resize(size_type sz, const value_type& val)
             {
-                auto old_size = size_;
-                resize_with_copy_(sz, capacity_);
+                if (sz <= size_)
+                {
+                    resize_with_copy_(sz, capacity_);
 
-                for (size_type i = old_size - 1; i < size_; ++i)
-                    data_[i] = val;
+                    return;
+                }
+
+                if (sz > capacity_)
+                    resize_with_copy_(size_, next_capacity_(sz));
+                for (size_type i = size_; i < sz; ++i)
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, val);
+                size_ = sz;
             }
 
             size_type capacity() const noexcept
@@ -377,6 +399,7 @@ namespace std
 
                 allocator_traits<Allocator>::construct(allocator_,
                                                        begin() + size_, forward<Args>(args)...);
+                ++size_;
 
                 return back();
             }
@@ -385,14 +408,24 @@ namespace std
             {
                 if (size_ >= capacity_)
                     resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = x;
+
+                /**
+                 * Note: The slot past the end is raw storage,
+                 *       so we cannot assign to it.
+                 */
+                allocator_traits<Allocator>::construct(allocator_,
+                                                       begin() + size_, x);
+                ++size_;
             }
 
             void push_back(T&& x)
             {
                 if (size_ >= capacity_)
                     resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = forward<T>(x);
+
+                allocator_traits<Allocator>::construct(allocator_,
+                                                       begin() + size_, forward<T>(x));
+                ++size_;
             }
 
             void pop_back()
@@ -528,7 +561,12 @@ namespace std
 
                     auto to_copy = min(size, size_);
                     for (size_type i = 0; i < to_copy; ++i)
-                        new_data[i] = move(data_[i]);
+                    {
+                        allocator_traits<Allocator>::construct(
+                            allocator_, new_data + i, move(data_[i])
+                        );
+                        allocator_traits<Allocator>::destroy(allocator_, data_ + i);
+                    }
 
                     std::swap(data_, new_data);
 
@@ -609,17 +647,10 @@ namespace std
     template<class T, class Alloc>
     bool operator<(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
     {
-        auto min_size = min(lhs.size(), rhs.size());
-        for (decltype(lhs.size()) i = 0; i < min_size; ++i)
-        {
-            if (lhs[i] >= rhs[i])
-                return false;
-        }
-
-        if (lhs.size() == rhs.size())
-            return true;
-        else
-            return lhs.size() < rhs.size();
+        return lexicographical_compare(
+            lhs.begin(), lhs.end(),
+            rhs.begin(), rhs.end()
+        );
     }
 
     template<class T, class Alloc>
@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ALGORITHM
 
 #include <iterator>
+#include <new>
 #include <utility>
 
 namespace std
@@ -408,9 +409,10 @@ namespace std
     BidirectionalIterator2 move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
                                          BidirectionalIterator2 result)
     {
-        // Note: We're copying [first, last) so we need to skip the initial value of last.
-        while (last-- != first)
-            *result-- = move(*last);
+        while (last != first)
+            *--result = move(*--last);
+
+        return result;
     }
 
     /**
@@ -653,7 +655,40 @@ namespace std
      * 25.3.11, rotate:
      */
 
-    // TODO: implement
+    template<class ForwardIterator>
+    ForwardIterator rotate(ForwardIterator first, ForwardIterator middle,
+                           ForwardIterator last)
+    {
+        if (first == middle)
+            return last;
+        if (middle == last)
+            return first;
+
+        auto res = first;
+        advance(res, distance(middle, last));
+
+        auto next = middle;
+        while (first != next)
+        {
+            swap(*first++, *next++);
+
+            if (next == last)
+                next = middle;
+            else if (first == middle)
+                middle = next;
+        }
+
+        return res;
+    }
+
+    template<class ForwardIterator, class OutputIterator>
+    OutputIterator rotate_copy(ForwardIterator first, ForwardIterator middle,
+                               ForwardIterator last, OutputIterator result)
+    {
+        result = copy(middle, last, result);
+
+        return copy(first, middle, result);
+    }
 
     /**
      * 25.3.12, shuffle:
@@ -687,6 +722,164 @@ namespace std
     void sort_heap(RandomAccessIterator, RandomAccessIterator,
                    Compare);
 
+    template<class RandomAccessIterator, class Compare>
+    void partial_sort(RandomAccessIterator, RandomAccessIterator,
+                      RandomAccessIterator, Compare);
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator lower_bound(ForwardIterator, ForwardIterator,
+                                const T&, Compare);
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator upper_bound(ForwardIterator, ForwardIterator,
+                                const T&, Compare);
+
+    namespace aux
+    {
+        template<class RandomAccessIterator, class Size, class Compare>
+        void correct_children(RandomAccessIterator, Size, Size, Compare);
+
+        /**
+         * Ranges shorter than this are left to insertion
+         * sort, which is faster on short ranges than
+         * further partitioning or merging.
+         */
+        static constexpr ptrdiff_t sort_insertion_threshold{16};
+
+        template<class RandomAccessIterator, class Compare>
+        void insertion_sort(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare comp)
+        {
+            if (first == last)
+                return;
+
+            for (auto it = first + 1; it != last; ++it)
+            {
+                auto tmp = move(*it);
+
+                if (comp(tmp, *first))
+                {
+                    move_backward(first, it, it + 1);
+                    *first = move(tmp);
+                }
+                else
+                {
+                    /**
+                     * The first element is not greater than tmp,
+                     * so it stops this loop without a bounds check.
+                     */
+                    auto hole = it;
+                    while (comp(tmp, *(hole - 1)))
+                    {
+                        *hole = move(*(hole - 1));
+                        --hole;
+                    }
+                    *hole = move(tmp);
+                }
+            }
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void move_median_to_first(RandomAccessIterator result,
+                                  RandomAccessIterator a, RandomAccessIterator b,
+                                  RandomAccessIterator c, Compare comp)
+        {
+            if (comp(*a, *b))
+            {
+                if (comp(*b, *c))
+                    iter_swap(result, b);
+                else if (comp(*a, *c))
+                    iter_swap(result, c);
+                else
+                    iter_swap(result, a);
+            }
+            else if (comp(*a, *c))
+                iter_swap(result, a);
+            else if (comp(*b, *c))
+                iter_swap(result, c);
+            else
+                iter_swap(result, b);
+        }
+
+        /**
+         * Partitions [first + 1, last) around the median of three
+         * elements, which is moved to *first. Returns a cut such
+         * that no element before it is greater than the pivot
+         * and no element after it is smaller than the pivot.
+         * Note: The pivot is not greater than the last element
+         *       and not smaller than the first one, so the inner
+         *       loops need no bounds checks.
+         */
+        template<class RandomAccessIterator, class Compare>
+        RandomAccessIterator partition_pivot(RandomAccessIterator first,
+                                             RandomAccessIterator last,
+                                             Compare comp)
+        {
+            auto mid = first + (last - first) / 2;
+            move_median_to_first(first, first + 1, mid, last - 1, comp);
+
+            auto pivot = first;
+            ++first;
+            while (true)
+            {
+                while (comp(*first, *pivot))
+                    ++first;
+                --last;
+                while (comp(*pivot, *last))
+                    --last;
+
+                if (!(first < last))
+                    return first;
+
+                iter_swap(first, last);
+                ++first;
+            }
+        }
+
+        template<class Size>
+        Size sort_depth_limit(Size len)
+        {
+            Size res{};
+            while (len > 1)
+            {
+                len /= 2;
+                ++res;
+            }
+
+            return 2 * res;
+        }
+
+        /**
+         * Quicksort that switches to heap sort once the
+         * recursion gets too deep, which caps the worst
+         * case at O(n log n). Ranges shorter than the
+         * insertion threshold are left unsorted for the
+         * final insertion sort pass.
+         */
+        template<class RandomAccessIterator, class Size, class Compare>
+        void introsort_loop(RandomAccessIterator first, RandomAccessIterator last,
+                            Size depth_limit, Compare comp)
+        {
+            while (last - first > sort_insertion_threshold)
+            {
+                if (depth_limit == 0)
+                {
+                    make_heap(first, last, comp);
+                    sort_heap(first, last, comp);
+
+                    return;
+                }
+                --depth_limit;
+
+                auto cut = partition_pivot(first, last, comp);
+
+                // Recurse into the right part, loop on the left.
+                introsort_loop(cut, last, depth_limit, comp);
+                last = cut;
+            }
+        }
+    }
+
     template<class RandomAccessIterator>
     void sort(RandomAccessIterator first, RandomAccessIterator last)
     {
@@ -699,30 +892,262 @@ namespace std
     void sort(RandomAccessIterator first, RandomAccessIterator last,
               Compare comp)
     {
-        /**
-         * Note: This isn't the most effective approach,
-         *       but since we already have these two functions
-         *       and they satisfy asymptotic limitations
-         *       imposed by the standard, we're using them at
-         *       the moment. Might be good to change it to qsort
-         *       or merge sort later.
-         */
+        if (last - first < 2)
+            return;
 
-        make_heap(first, last, comp);
-        sort_heap(first, last, comp);
+        aux::introsort_loop(first, last, aux::sort_depth_limit(last - first), comp);
+        aux::insertion_sort(first, last, comp);
     }
 
     /**
      * 25.4.1.2, stable_sort:
      */
 
-    // TODO: implement
+    namespace aux
+    {
+        /**
+         * Uninitialized storage used by the merging algorithms,
+         * the allocation is allowed to fail, in which case
+         * the algorithms fall back to merging in place.
+         */
+        template<class T>
+        class temporary_buffer
+        {
+            public:
+                temporary_buffer(ptrdiff_t size)
+                    : data_{}, size_{}
+                {
+                    if (size <= 0)
+                        return;
+
+                    data_ = static_cast<T*>(
+                        ::operator new(size * sizeof(T), nothrow)
+                    );
+                    if (data_)
+                        size_ = size;
+                }
+
+                temporary_buffer(const temporary_buffer&) = delete;
+                temporary_buffer& operator=(const temporary_buffer&) = delete;
+
+                ~temporary_buffer()
+                {
+                    ::operator delete(data_);
+                }
+
+                T* data() const noexcept
+                {
+                    return data_;
+                }
+
+                ptrdiff_t size() const noexcept
+                {
+                    return size_;
+                }
+
+            private:
+                T* data_;
+                ptrdiff_t size_;
+        };
+
+        /**
+         * Merges [first, middle) and [middle, last), the first of
+         * which is moved to the buffer, which has to be large
+         * enough to hold it. Equal elements are taken from the
+         * first range first, so the merge is stable.
+         */
+        template<class BidirectionalIterator, class T, class Compare>
+        void merge_with_buffer(BidirectionalIterator first,
+                               BidirectionalIterator middle,
+                               BidirectionalIterator last,
+                               T* buffer, Compare comp)
+        {
+            auto buffer_end = buffer;
+            for (auto it = first; it != middle; ++it, ++buffer_end)
+                ::new(static_cast<void*>(buffer_end)) T(move(*it));
+
+            auto left = buffer;
+            auto right = middle;
+            auto out = first;
+            while (left != buffer_end && right != last)
+            {
+                if (comp(*right, *left))
+                    *out++ = move(*right++);
+                else
+                    *out++ = move(*left++);
+            }
+
+            while (left != buffer_end)
+                *out++ = move(*left++);
+
+            for (auto it = buffer; it != buffer_end; ++it)
+                it->~T();
+        }
+
+        /**
+         * Merges two adjacent sorted ranges of lengths len1
+         * and len2 by splitting them in halves that are rotated
+         * to their final place. Does not allocate, but does
+         * O(n log n) swaps.
+         */
+        template<class BidirectionalIterator, class Distance, class Compare>
+        void merge_without_buffer(BidirectionalIterator first,
+                                  BidirectionalIterator middle,
+                                  BidirectionalIterator last,
+                                  Distance len1, Distance len2,
+                                  Compare comp)
+        {
+            if (len1 == 0 || len2 == 0)
+                return;
+
+            if (len1 + len2 == 2)
+            {
+                if (comp(*middle, *first))
+                    iter_swap(first, middle);
+
+                return;
+            }
+
+            auto first_cut = first;
+            auto second_cut = middle;
+            Distance len11{}, len22{};
+            if (len1 > len2)
+            {
+                len11 = len1 / 2;
+                advance(first_cut, len11);
+                second_cut = lower_bound(middle, last, *first_cut, comp);
+                len22 = distance(middle, second_cut);
+            }
+            else
+            {
+                len22 = len2 / 2;
+                advance(second_cut, len22);
+                first_cut = upper_bound(first, middle, *second_cut, comp);
+                len11 = distance(first, first_cut);
+            }
+
+            auto new_middle = rotate(first_cut, middle, second_cut);
+            merge_without_buffer(first, first_cut, new_middle,
+                                 len11, len22, comp);
+            merge_without_buffer(new_middle, second_cut, last,
+                                 len1 - len11, len2 - len22, comp);
+        }
+
+        template<class RandomAccessIterator, class T, class Compare>
+        void merge_sort_with_buffer(RandomAccessIterator first,
+                                    RandomAccessIterator last,
+                                    T* buffer, Compare comp)
+        {
+            if (last - first <= sort_insertion_threshold)
+            {
+                insertion_sort(first, last, comp);
+
+                return;
+            }
+
+            auto middle = first + (last - first) / 2;
+            merge_sort_with_buffer(first, middle, buffer, comp);
+            merge_sort_with_buffer(middle, last, buffer, comp);
+
+            // Already in order, common for partially sorted input.
+            if (!comp(*middle, *(middle - 1)))
+                return;
+
+            merge_with_buffer(first, middle, last, buffer, comp);
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void merge_sort_without_buffer(RandomAccessIterator first,
+                                       RandomAccessIterator last,
+                                       Compare comp)
+        {
+            if (last - first <= sort_insertion_threshold)
+            {
+                insertion_sort(first, last, comp);
+
+                return;
+            }
+
+            auto middle = first + (last - first) / 2;
+            merge_sort_without_buffer(first, middle, comp);
+            merge_sort_without_buffer(middle, last, comp);
+            merge_without_buffer(first, middle, last,
+                                 middle - first, last - middle, comp);
+        }
+    }
+
+    template<class RandomAccessIterator>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        stable_sort(first, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last,
+                     Compare comp)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        auto len = last - first;
+        if (len <= aux::sort_insertion_threshold)
+        {
+            aux::insertion_sort(first, last, comp);
+
+            return;
+        }
+
+        /**
+         * Every merge moves its left half to the buffer, which
+         * is never longer than half of the range (rounded up).
+         */
+        aux::temporary_buffer<value_type> buffer{(len + 1) / 2};
+        if (buffer.data())
+            aux::merge_sort_with_buffer(first, last, buffer.data(), comp);
+        else
+            aux::merge_sort_without_buffer(first, last, comp);
+    }
 
     /**
      * 25.4.1.3, partial_sort:
      */
 
-    // TODO: implement
+    template<class RandomAccessIterator>
+    void partial_sort(RandomAccessIterator first, RandomAccessIterator middle,
+                      RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        partial_sort(first, middle, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void partial_sort(RandomAccessIterator first, RandomAccessIterator middle,
+                      RandomAccessIterator last, Compare comp)
+    {
+        if (first == middle)
+            return;
+
+        /**
+         * Keep the smallest elements seen so far in
+         * a max heap, whose top is replaced whenever
+         * a smaller element comes by.
+         */
+        make_heap(first, middle, comp);
+
+        auto count = middle - first;
+        for (auto it = middle; it != last; ++it)
+        {
+            if (comp(*it, *first))
+            {
+                iter_swap(it, first);
+                aux::correct_children(first, decltype(count){}, count, comp);
+            }
+        }
+
+        sort_heap(first, middle, comp);
+    }
 
     /**
      * 25.4.1.4, partial_sort_copy:
@@ -734,6 +1159,32 @@ namespace std
      * 25.4.1.5, is_sorted:
      */
 
+    template<class ForwardIterator, class Comp>
+    ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last,
+                                    Comp comp)
+    {
+        if (first == last)
+            return last;
+
+        auto next = first;
+        while (++next != last)
+        {
+            if (comp(*next, *first))
+                return next;
+            first = next;
+        }
+
+        return last;
+    }
+
+    template<class ForwardIterator>
+    ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last)
+    {
+        using value_type = typename iterator_traits<ForwardIterator>::value_type;
+
+        return is_sorted_until(first, last, less<value_type>{});
+    }
+
     template<class ForwardIterator>
     bool is_sorted(ForwardIterator first, ForwardIterator last)
     {
@@ -747,42 +1198,51 @@ namespace std
         return is_sorted_until(first, last, comp) == last;
     }
 
-    template<class ForwardIterator>
-    ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last)
-    {
-        if (distance(first, last) < 2)
-            return last;
+    /**
+     * 25.4.2, nth_element:
+     */
 
-        while (first != last)
-        {
-            if (*first > *(++first))
-                return first;
-        }
+    template<class RandomAccessIterator>
+    void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                     RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
 
-        return last;
+        nth_element(first, nth, last, less<value_type>{});
     }
 
-    template<class ForwardIterator, class Comp>
-    ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last,
-                                    Comp comp)
+    template<class RandomAccessIterator, class Compare>
+    void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                     RandomAccessIterator last, Compare comp)
     {
-        if (distance(first, last) < 2)
-            return last;
+        if (first == last || nth == last)
+            return;
 
-        while (first != last)
+        /**
+         * Quickselect, which only continues into the
+         * part that contains nth and falls back to
+         * partial sort when partitioning goes badly.
+         */
+        auto depth_limit = aux::sort_depth_limit(last - first);
+        while (last - first > 3)
         {
-            if (!comp(*first, *(++first)))
-                return first;
-        }
+            if (depth_limit == 0)
+            {
+                partial_sort(first, nth + 1, last, comp);
 
-        return last;
-    }
+                return;
+            }
+            --depth_limit;
 
-    /**
-     * 25.4.2, nth_element:
-     */
+            auto cut = aux::partition_pivot(first, last, comp);
+            if (cut <= nth)
+                first = cut;
+            else
+                last = cut;
+        }
 
-    // TODO: implement
+        aux::insertion_sort(first, last, comp);
+    }
 
     /**
      * 25.4.3, binary search:
@@ -792,13 +1252,69 @@ namespace std
      * 25.4.3.1, lower_bound
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T>
+    ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value)
+    {
+        return lower_bound(first, last, value, less<T>{});
+    }
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value, Compare comp)
+    {
+        auto len = distance(first, last);
+        while (len > 0)
+        {
+            auto half = len / 2;
+            auto middle = first;
+            advance(middle, half);
+
+            if (comp(*middle, value))
+            {
+                first = ++middle;
+                len -= half + 1;
+            }
+            else
+                len = half;
+        }
+
+        return first;
+    }
 
     /**
      * 25.4.3.2, upper_bound
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T>
+    ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value)
+    {
+        return upper_bound(first, last, value, less<T>{});
+    }
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value, Compare comp)
+    {
+        auto len = distance(first, last);
+        while (len > 0)
+        {
+            auto half = len / 2;
+            auto middle = first;
+            advance(middle, half);
+
+            if (!comp(value, *middle))
+            {
+                first = ++middle;
+                len -= half + 1;
+            }
+            else
+                len = half;
+        }
+
+        return first;
+    }
 
     /**
      * 25.4.3.3, equal_range:
@@ -816,7 +1332,61 @@ namespace std
      * 25.4.4, merge:
      */
 
-    // TODO: implement
+    template<class InputIterator1, class InputIterator2, class OutputIterator>
+    OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+                         InputIterator2 first2, InputIterator2 last2,
+                         OutputIterator result)
+    {
+        using value_type = typename iterator_traits<InputIterator1>::value_type;
+
+        return merge(first1, last1, first2, last2, result, less<value_type>{});
+    }
+
+    template<class InputIterator1, class InputIterator2,
+             class OutputIterator, class Compare>
+    OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+                         InputIterator2 first2, InputIterator2 last2,
+                         OutputIterator result, Compare comp)
+    {
+        while (first1 != last1 && first2 != last2)
+        {
+            if (comp(*first2, *first1))
+                *result++ = *first2++;
+            else
+                *result++ = *first1++;
+        }
+
+        result = copy(first1, last1, result);
+
+        return copy(first2, last2, result);
+    }
+
+    template<class BidirectionalIterator>
+    void inplace_merge(BidirectionalIterator first, BidirectionalIterator middle,
+                       BidirectionalIterator last)
+    {
+        using value_type = typename iterator_traits<BidirectionalIterator>::value_type;
+
+        inplace_merge(first, middle, last, less<value_type>{});
+    }
+
+    template<class BidirectionalIterator, class Compare>
+    void inplace_merge(BidirectionalIterator first, BidirectionalIterator middle,
+                       BidirectionalIterator last, Compare comp)
+    {
+        using value_type = typename iterator_traits<BidirectionalIterator>::value_type;
+
+        auto len1 = distance(first, middle);
+        auto len2 = distance(middle, last);
+        if (len1 == 0 || len2 == 0)
+            return;
+
+        aux::temporary_buffer<value_type> buffer{len1};
+        if (buffer.data())
+            aux::merge_with_buffer(first, middle, last, buffer.data(), comp);
+        else
+            aux::merge_without_buffer(first, middle, last, len1, len2, comp);
+    }
 
     /**
      * 25.4.5, set operations on sorted structures:
@@ -876,6 +1446,11 @@ namespace std
             return 2 * idx + 2;
         }
 
+        /**
+         * Moves the element at idx down the heap of
+         * count elements until neither of its children
+         * is greater than it.
+         */
         template<class RandomAccessIterator, class Size, class Compare>
         void correct_children(RandomAccessIterator first,
                               Size idx, Size count, Compare comp)
@@ -883,32 +1458,22 @@ namespace std
             using aux::heap_left_child;
             using aux::heap_right_child;
 
-            auto left = heap_left_child(idx);
-            auto right = heap_right_child(idx);
-
-            bool left_incorrect{comp(first[idx], first[left])};
-            bool right_incorrect{comp(first[idx], first[right])};
-            while ((left < count && left_incorrect) ||
-                   (right < count && right_incorrect))
+            while (true)
             {
-                if (right >= count || (left_incorrect && comp(first[right], first[left])))
-                {
-                    swap(first[idx], first[left]);
-
-                    idx = left;
-                }
-                else if (right < count && right_incorrect)
-                {
-                    swap(first[idx], first[right]);
+                auto left = heap_left_child(idx);
+                auto right = heap_right_child(idx);
 
-                    idx = right;
-                } // Else should not happen because of the while condition.
+                auto largest = idx;
+                if (left < count && comp(first[largest], first[left]))
+                    largest = left;
+                if (right < count && comp(first[largest], first[right]))
+                    largest = right;
 
-                left = heap_left_child(idx);
-                right = heap_right_child(idx);
+                if (largest == idx)
+                    return;
 
-                left_incorrect = comp(first[idx], first[left]);
-                right_incorrect = comp(first[idx], first[right]);
+                swap(first[idx], first[largest]);
+                idx = largest;
             }
         }
     }
@@ -971,7 +1536,7 @@ namespace std
             return;
 
         swap(first[0], first[count - 1]);
-        aux::correct_children(first, decltype(count){}, count - 2, comp);
+        aux::correct_children(first, decltype(count){}, count - 1, comp);
     }
 
     /**
@@ -996,7 +1561,8 @@ namespace std
         if (count <= 1)
             return;
 
-        for (auto i = count; i > 0; --i)
+        // Leaves have no children to correct.
+        for (auto i = count / 2; i > 0; --i)
         {
             auto idx = i - 1;
 
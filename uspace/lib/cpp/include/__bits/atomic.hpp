@@ -29,6 +29,980 @@
 #ifndef LIBCPP_BITS_ATOMIC
 #define LIBCPP_BITS_ATOMIC
 
-#error "<atomic> is not implemented"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * 29.3, order and consistency:
+ */
+
+#define ATOMIC_BOOL_LOCK_FREE     __GCC_ATOMIC_BOOL_LOCK_FREE
+#define ATOMIC_CHAR_LOCK_FREE     __GCC_ATOMIC_CHAR_LOCK_FREE
+#define ATOMIC_CHAR16_T_LOCK_FREE __GCC_ATOMIC_CHAR16_T_LOCK_FREE
+#define ATOMIC_CHAR32_T_LOCK_FREE __GCC_ATOMIC_CHAR32_T_LOCK_FREE
+#define ATOMIC_WCHAR_T_LOCK_FREE  __GCC_ATOMIC_WCHAR_T_LOCK_FREE
+#define ATOMIC_SHORT_LOCK_FREE    __GCC_ATOMIC_SHORT_LOCK_FREE
+#define ATOMIC_INT_LOCK_FREE      __GCC_ATOMIC_INT_LOCK_FREE
+#define ATOMIC_LONG_LOCK_FREE     __GCC_ATOMIC_LONG_LOCK_FREE
+#define ATOMIC_LLONG_LOCK_FREE    __GCC_ATOMIC_LLONG_LOCK_FREE
+#define ATOMIC_POINTER_LOCK_FREE  __GCC_ATOMIC_POINTER_LOCK_FREE
+
+#define ATOMIC_VAR_INIT(value) {value}
+#define ATOMIC_FLAG_INIT {false}
+
+namespace std
+{
+    /**
+     * Note: The values match those of the __ATOMIC_* macros,
+     *       so that the orders can be passed to the compiler
+     *       builtins as they are.
+     */
+    enum memory_order
+    {
+        memory_order_relaxed = __ATOMIC_RELAXED,
+        memory_order_consume = __ATOMIC_CONSUME,
+        memory_order_acquire = __ATOMIC_ACQUIRE,
+        memory_order_release = __ATOMIC_RELEASE,
+        memory_order_acq_rel = __ATOMIC_ACQ_REL,
+        memory_order_seq_cst = __ATOMIC_SEQ_CST
+    };
+
+    template<class T>
+    T kill_dependency(T y) noexcept
+    {
+        return y;
+    }
+
+    /**
+     * 29.8, fences:
+     */
+
+    inline void atomic_thread_fence(memory_order order) noexcept
+    {
+        __atomic_thread_fence(order);
+    }
+
+    inline void atomic_signal_fence(memory_order order) noexcept
+    {
+        __atomic_signal_fence(order);
+    }
+
+    namespace aux
+    {
+        /**
+         * The failure order of a compare exchange cannot
+         * contain a release, these are the strongest orders
+         * allowed for a given success order.
+         */
+        constexpr memory_order atomic_failure_order(memory_order order) noexcept
+        {
+            if (order == memory_order_acq_rel)
+                return memory_order_acquire;
+            else if (order == memory_order_release)
+                return memory_order_relaxed;
+            else
+                return order;
+        }
+
+        /**
+         * Waiting on an atomic blocks on one of a fixed number
+         * of condition variables selected by the address of the
+         * atomic. The predicate is evaluated with the condition
+         * variable's mutex held and the waiting stops once it
+         * returns false.
+         * Note: The notify functions have to wake all waiters
+         *       of the selected condition variable, because it
+         *       can be shared by multiple atomics.
+         */
+        using atomic_wait_pred_t = bool (*)(const volatile void*, const void*, memory_order);
+
+        void atomic_wait(const volatile void*, atomic_wait_pred_t,
+                         const void*, memory_order) noexcept;
+        void atomic_notify(const volatile void*) noexcept;
+
+        template<class T>
+        bool atomic_unchanged(const volatile void* addr, const void* old,
+                              memory_order order)
+        {
+            alignas(T) unsigned char buf[sizeof(T)];
+            __atomic_load(static_cast<const volatile T*>(addr),
+                          reinterpret_cast<T*>(buf), order);
+
+            return __builtin_memcmp(buf, old, sizeof(T)) == 0;
+        }
+
+        /**
+         * Types whose size is a power of two get aligned to
+         * their size, so that the hardware can access them
+         * atomically.
+         */
+        template<class T>
+        inline constexpr size_t atomic_alignment =
+            (sizeof(T) & (sizeof(T) - 1)) == 0 && sizeof(T) <= 16 &&
+            sizeof(T) > alignof(T) ? sizeof(T) : alignof(T);
+
+        /**
+         * Note: All operations are implemented as volatile
+         *       qualified, which does not change the generated
+         *       code. The non-volatile overloads required by
+         *       the standard forward to them, they are needed
+         *       so that assigning a value to a non-volatile
+         *       atomic is not ambiguous with the deleted copy
+         *       assignment.
+         */
+        template<class T>
+        class atomic_base
+        {
+            public:
+                using value_type = T;
+
+                static constexpr bool is_always_lock_free =
+                    __atomic_always_lock_free(sizeof(T), 0);
+
+                atomic_base() noexcept = default;
+
+                constexpr atomic_base(T desired) noexcept
+                    : value_{desired}
+                { /* DUMMY BODY */ }
+
+                atomic_base(const atomic_base&) = delete;
+                atomic_base& operator=(const atomic_base&) = delete;
+
+                bool is_lock_free() const volatile noexcept
+                {
+                    return __atomic_is_lock_free(sizeof(T), &value_);
+                }
+
+                bool is_lock_free() const noexcept
+                {
+                    return static_cast<const volatile atomic_base*>(this)->is_lock_free();
+                }
+
+                void store(T desired, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    __atomic_store(&value_, &desired, order);
+                }
+
+                void store(T desired, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    static_cast<volatile atomic_base*>(this)->store(desired, order);
+                }
+
+                T load(memory_order order = memory_order_seq_cst) const volatile noexcept
+                {
+                    alignas(T) unsigned char buf[sizeof(T)];
+                    auto res = reinterpret_cast<T*>(buf);
+                    __atomic_load(&value_, res, order);
+
+                    return *res;
+                }
+
+                T load(memory_order order = memory_order_seq_cst) const noexcept
+                {
+                    return static_cast<const volatile atomic_base*>(this)->load(order);
+                }
+
+                operator T() const volatile noexcept
+                {
+                    return load();
+                }
+
+                operator T() const noexcept
+                {
+                    return load();
+                }
+
+                T operator=(T desired) volatile noexcept
+                {
+                    store(desired);
+
+                    return desired;
+                }
+
+                T operator=(T desired) noexcept
+                {
+                    return static_cast<volatile atomic_base*>(this)->operator=(desired);
+                }
+
+                T exchange(T desired, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    alignas(T) unsigned char buf[sizeof(T)];
+                    auto res = reinterpret_cast<T*>(buf);
+                    __atomic_exchange(&value_, &desired, res, order);
+
+                    return *res;
+                }
+
+                T exchange(T desired, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return static_cast<volatile atomic_base*>(this)->exchange(
+                        desired, order);
+                }
+
+                bool compare_exchange_weak(T& expected, T desired, memory_order success,
+                                           memory_order failure) volatile noexcept
+                {
+                    return __atomic_compare_exchange(&value_, &expected, &desired,
+                                                     true, success, failure);
+                }
+
+                bool compare_exchange_weak(T& expected, T desired, memory_order success,
+                                           memory_order failure) noexcept
+                {
+                    return static_cast<volatile atomic_base*>(this)->compare_exchange_weak(
+                        expected, desired, success, failure);
+                }
+
+                bool compare_exchange_weak(T& expected, T desired,
+                                           memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return compare_exchange_weak(expected, desired, order,
+                                                 atomic_failure_order(order));
+                }
+
+                bool compare_exchange_weak(T& expected, T desired,
+                                           memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return static_cast<volatile atomic_base*>(this)->compare_exchange_weak(
+                        expected, desired, order);
+                }
+
+                bool compare_exchange_strong(T& expected, T desired, memory_order success,
+                                             memory_order failure) volatile noexcept
+                {
+                    return __atomic_compare_exchange(&value_, &expected, &desired,
+                                                     false, success, failure);
+                }
+
+                bool compare_exchange_strong(T& expected, T desired, memory_order success,
+                                             memory_order failure) noexcept
+                {
+                    return static_cast<volatile atomic_base*>(this)->compare_exchange_strong(
+                        expected, desired, success, failure);
+                }
+
+                bool compare_exchange_strong(T& expected, T desired,
+                                             memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return compare_exchange_strong(expected, desired, order,
+                                                   atomic_failure_order(order));
+                }
+
+                bool compare_exchange_strong(T& expected, T desired,
+                                             memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return static_cast<volatile atomic_base*>(this)->compare_exchange_strong(
+                        expected, desired, order);
+                }
+
+                /**
+                 * Note: Waiting and notifying comes from C++20,
+                 *       but as it is the only way of blocking
+                 *       on an atomic, we provide it anyway.
+                 */
+
+                void wait(T old, memory_order order = memory_order_seq_cst) const volatile noexcept
+                {
+                    if (!atomic_unchanged<T>(&value_, &old, order))
+                        return;
+
+                    aux::atomic_wait(&value_, atomic_unchanged<T>, &old, order);
+                }
+
+                void wait(T old, memory_order order = memory_order_seq_cst) const noexcept
+                {
+                    static_cast<const volatile atomic_base*>(this)->wait(old, order);
+                }
+
+                void notify_one() volatile noexcept
+                {
+                    aux::atomic_notify(&value_);
+                }
+
+                void notify_one() noexcept
+                {
+                    static_cast<volatile atomic_base*>(this)->notify_one();
+                }
+
+                void notify_all() volatile noexcept
+                {
+                    aux::atomic_notify(&value_);
+                }
+
+                void notify_all() noexcept
+                {
+                    static_cast<volatile atomic_base*>(this)->notify_all();
+                }
+
+            protected:
+                alignas(atomic_alignment<T>) T value_;
+        };
+
+        template<class T>
+        class atomic_integral_base: public atomic_base<T>
+        {
+            public:
+                using difference_type = T;
+
+                atomic_integral_base() noexcept = default;
+
+                constexpr atomic_integral_base(T desired) noexcept
+                    : atomic_base<T>{desired}
+                { /* DUMMY BODY */ }
+
+                using atomic_base<T>::operator=;
+
+                T fetch_add(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_add(&this->value_, arg, order);
+                }
+
+                T fetch_add(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->fetch_add(
+                        arg, order);
+                }
+
+                T fetch_sub(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_sub(&this->value_, arg, order);
+                }
+
+                T fetch_sub(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->fetch_sub(
+                        arg, order);
+                }
+
+                T fetch_and(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_and(&this->value_, arg, order);
+                }
+
+                T fetch_and(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->fetch_and(
+                        arg, order);
+                }
+
+                T fetch_or(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_or(&this->value_, arg, order);
+                }
+
+                T fetch_or(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->fetch_or(
+                        arg, order);
+                }
+
+                T fetch_xor(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_xor(&this->value_, arg, order);
+                }
+
+                T fetch_xor(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->fetch_xor(
+                        arg, order);
+                }
+
+                T operator++(int) volatile noexcept
+                {
+                    return fetch_add(1);
+                }
+
+                T operator++(int) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->operator++(
+                        0);
+                }
+
+                T operator--(int) volatile noexcept
+                {
+                    return fetch_sub(1);
+                }
+
+                T operator--(int) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->operator--(
+                        0);
+                }
+
+                T operator++() volatile noexcept
+                {
+                    return __atomic_add_fetch(&this->value_, 1, memory_order_seq_cst);
+                }
+
+                T operator++() noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->operator++(
+                        );
+                }
+
+                T operator--() volatile noexcept
+                {
+                    return __atomic_sub_fetch(&this->value_, 1, memory_order_seq_cst);
+                }
+
+                T operator--() noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->operator--(
+                        );
+                }
+
+                T operator+=(T arg) volatile noexcept
+                {
+                    return __atomic_add_fetch(&this->value_, arg, memory_order_seq_cst);
+                }
+
+                T operator+=(T arg) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->operator+=(
+                        arg);
+                }
+
+                T operator-=(T arg) volatile noexcept
+                {
+                    return __atomic_sub_fetch(&this->value_, arg, memory_order_seq_cst);
+                }
+
+                T operator-=(T arg) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->operator-=(
+                        arg);
+                }
+
+                T operator&=(T arg) volatile noexcept
+                {
+                    return __atomic_and_fetch(&this->value_, arg, memory_order_seq_cst);
+                }
+
+                T operator&=(T arg) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->operator&=(
+                        arg);
+                }
+
+                T operator|=(T arg) volatile noexcept
+                {
+                    return __atomic_or_fetch(&this->value_, arg, memory_order_seq_cst);
+                }
+
+                T operator|=(T arg) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->operator|=(
+                        arg);
+                }
+
+                T operator^=(T arg) volatile noexcept
+                {
+                    return __atomic_xor_fetch(&this->value_, arg, memory_order_seq_cst);
+                }
+
+                T operator^=(T arg) noexcept
+                {
+                    return static_cast<volatile atomic_integral_base*>(this)->operator^=(
+                        arg);
+                }
+        };
+
+        template<class T>
+        using atomic_base_for = conditional_t<
+            is_integral_v<T> && !is_same_v<T, bool>,
+            atomic_integral_base<T>, atomic_base<T>
+        >;
+    }
+
+    /**
+     * 29.5, atomic types:
+     */
+
+    template<class T>
+    struct atomic: aux::atomic_base_for<T>
+    {
+        static_assert(is_trivially_copyable_v<T>, "atomic<T> requires trivially copyable T");
+
+        atomic() noexcept = default;
+
+        constexpr atomic(T desired) noexcept
+            : aux::atomic_base_for<T>{desired}
+        { /* DUMMY BODY */ }
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+        atomic& operator=(const atomic&) volatile = delete;
+
+        using aux::atomic_base_for<T>::operator=;
+    };
+
+    template<class T>
+    struct atomic<T*>: aux::atomic_base<T*>
+    {
+        using difference_type = ptrdiff_t;
+
+        atomic() noexcept = default;
+
+        constexpr atomic(T* desired) noexcept
+            : aux::atomic_base<T*>{desired}
+        { /* DUMMY BODY */ }
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+        atomic& operator=(const atomic&) volatile = delete;
+
+        using aux::atomic_base<T*>::operator=;
+
+        /**
+         * Note: The builtins do not scale the argument
+         *       by the size of the pointed to type.
+         */
+
+        T* fetch_add(ptrdiff_t arg, memory_order order = memory_order_seq_cst) volatile noexcept
+        {
+            return __atomic_fetch_add(&this->value_, arg * sizeof(T), order);
+        }
+
+        T* fetch_add(ptrdiff_t arg, memory_order order = memory_order_seq_cst) noexcept
+        {
+            return static_cast<volatile atomic*>(this)->fetch_add(arg, order);
+        }
+
+        T* fetch_sub(ptrdiff_t arg, memory_order order = memory_order_seq_cst) volatile noexcept
+        {
+            return __atomic_fetch_sub(&this->value_, arg * sizeof(T), order);
+        }
+
+        T* fetch_sub(ptrdiff_t arg, memory_order order = memory_order_seq_cst) noexcept
+        {
+            return static_cast<volatile atomic*>(this)->fetch_sub(arg, order);
+        }
+
+        T* operator++(int) volatile noexcept
+        {
+            return fetch_add(1);
+        }
+
+        T* operator++(int) noexcept
+        {
+            return static_cast<volatile atomic*>(this)->operator++(0);
+        }
+
+        T* operator--(int) volatile noexcept
+        {
+            return fetch_sub(1);
+        }
+
+        T* operator--(int) noexcept
+        {
+            return static_cast<volatile atomic*>(this)->operator--(0);
+        }
+
+        T* operator++() volatile noexcept
+        {
+            return fetch_add(1) + 1;
+        }
+
+        T* operator++() noexcept
+        {
+            return static_cast<volatile atomic*>(this)->operator++();
+        }
+
+        T* operator--() volatile noexcept
+        {
+            return fetch_sub(1) - 1;
+        }
+
+        T* operator--() noexcept
+        {
+            return static_cast<volatile atomic*>(this)->operator--();
+        }
+
+        T* operator+=(ptrdiff_t arg) volatile noexcept
+        {
+            return fetch_add(arg) + arg;
+        }
+
+        T* operator+=(ptrdiff_t arg) noexcept
+        {
+            return static_cast<volatile atomic*>(this)->operator+=(arg);
+        }
+
+        T* operator-=(ptrdiff_t arg) volatile noexcept
+        {
+            return fetch_sub(arg) - arg;
+        }
+
+        T* operator-=(ptrdiff_t arg) noexcept
+        {
+            return static_cast<volatile atomic*>(this)->operator-=(arg);
+        }
+    };
+
+    using atomic_bool           = atomic<bool>;
+    using atomic_char           = atomic<char>;
+    using atomic_schar          = atomic<signed char>;
+    using atomic_uchar          = atomic<unsigned char>;
+    using atomic_short          = atomic<short>;
+    using atomic_ushort         = atomic<unsigned short>;
+    using atomic_int            = atomic<int>;
+    using atomic_uint           = atomic<unsigned int>;
+    using atomic_long           = atomic<long>;
+    using atomic_ulong          = atomic<unsigned long>;
+    using atomic_llong          = atomic<long long>;
+    using atomic_ullong         = atomic<unsigned long long>;
+    using atomic_char16_t       = atomic<char16_t>;
+    using atomic_char32_t       = atomic<char32_t>;
+    using atomic_wchar_t        = atomic<wchar_t>;
+
+    using atomic_int8_t         = atomic<int8_t>;
+    using atomic_uint8_t        = atomic<uint8_t>;
+    using atomic_int16_t        = atomic<int16_t>;
+    using atomic_uint16_t       = atomic<uint16_t>;
+    using atomic_int32_t        = atomic<int32_t>;
+    using atomic_uint32_t       = atomic<uint32_t>;
+    using atomic_int64_t        = atomic<int64_t>;
+    using atomic_uint64_t       = atomic<uint64_t>;
+
+    using atomic_int_least8_t   = atomic<int_least8_t>;
+    using atomic_uint_least8_t  = atomic<uint_least8_t>;
+    using atomic_int_least16_t  = atomic<int_least16_t>;
+    using atomic_uint_least16_t = atomic<uint_least16_t>;
+    using atomic_int_least32_t  = atomic<int_least32_t>;
+    using atomic_uint_least32_t = atomic<uint_least32_t>;
+    using atomic_int_least64_t  = atomic<int_least64_t>;
+    using atomic_uint_least64_t = atomic<uint_least64_t>;
+
+    using atomic_int_fast8_t    = atomic<int_fast8_t>;
+    using atomic_uint_fast8_t   = atomic<uint_fast8_t>;
+    using atomic_int_fast16_t   = atomic<int_fast16_t>;
+    using atomic_uint_fast16_t  = atomic<uint_fast16_t>;
+    using atomic_int_fast32_t   = atomic<int_fast32_t>;
+    using atomic_uint_fast32_t  = atomic<uint_fast32_t>;
+    using atomic_int_fast64_t   = atomic<int_fast64_t>;
+    using atomic_uint_fast64_t  = atomic<uint_fast64_t>;
+
+    using atomic_intptr_t       = atomic<intptr_t>;
+    using atomic_uintptr_t      = atomic<uintptr_t>;
+    using atomic_size_t         = atomic<size_t>;
+    using atomic_ptrdiff_t      = atomic<ptrdiff_t>;
+    using atomic_intmax_t       = atomic<intmax_t>;
+    using atomic_uintmax_t      = atomic<uintmax_t>;
+
+    /**
+     * 29.6, operations on atomic types:
+     */
+
+    template<class T>
+    bool atomic_is_lock_free(const volatile atomic<T>* obj) noexcept
+    {
+        return obj->is_lock_free();
+    }
+
+    template<class T>
+    void atomic_init(volatile atomic<T>* obj, typename atomic<T>::value_type desired) noexcept
+    {
+        obj->store(desired, memory_order_relaxed);
+    }
+
+    template<class T>
+    void atomic_store(volatile atomic<T>* obj, typename atomic<T>::value_type desired) noexcept
+    {
+        obj->store(desired);
+    }
+
+    template<class T>
+    void atomic_store_explicit(volatile atomic<T>* obj, typename atomic<T>::value_type desired,
+                               memory_order order) noexcept
+    {
+        obj->store(desired, order);
+    }
+
+    template<class T>
+    T atomic_load(const volatile atomic<T>* obj) noexcept
+    {
+        return obj->load();
+    }
+
+    template<class T>
+    T atomic_load_explicit(const volatile atomic<T>* obj, memory_order order) noexcept
+    {
+        return obj->load(order);
+    }
+
+    template<class T>
+    T atomic_exchange(volatile atomic<T>* obj, typename atomic<T>::value_type desired) noexcept
+    {
+        return obj->exchange(desired);
+    }
+
+    template<class T>
+    T atomic_exchange_explicit(volatile atomic<T>* obj, typename atomic<T>::value_type desired,
+                               memory_order order) noexcept
+    {
+        return obj->exchange(desired, order);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_weak(volatile atomic<T>* obj,
+                                      typename atomic<T>::value_type* expected,
+                                      typename atomic<T>::value_type desired) noexcept
+    {
+        return obj->compare_exchange_weak(*expected, desired);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_strong(volatile atomic<T>* obj,
+                                        typename atomic<T>::value_type* expected,
+                                        typename atomic<T>::value_type desired) noexcept
+    {
+        return obj->compare_exchange_strong(*expected, desired);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_weak_explicit(volatile atomic<T>* obj,
+                                               typename atomic<T>::value_type* expected,
+                                               typename atomic<T>::value_type desired,
+                                               memory_order success, memory_order failure) noexcept
+    {
+        return obj->compare_exchange_weak(*expected, desired, success, failure);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_strong_explicit(volatile atomic<T>* obj,
+                                                 typename atomic<T>::value_type* expected,
+                                                 typename atomic<T>::value_type desired,
+                                                 memory_order success, memory_order failure) noexcept
+    {
+        return obj->compare_exchange_strong(*expected, desired, success, failure);
+    }
+
+    template<class T>
+    T atomic_fetch_add(volatile atomic<T>* obj, typename atomic<T>::difference_type arg) noexcept
+    {
+        return obj->fetch_add(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_add_explicit(volatile atomic<T>* obj, typename atomic<T>::difference_type arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_add(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_sub(volatile atomic<T>* obj, typename atomic<T>::difference_type arg) noexcept
+    {
+        return obj->fetch_sub(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_sub_explicit(volatile atomic<T>* obj, typename atomic<T>::difference_type arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_sub(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_and(volatile atomic<T>* obj, typename atomic<T>::value_type arg) noexcept
+    {
+        return obj->fetch_and(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_and_explicit(volatile atomic<T>* obj, typename atomic<T>::value_type arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_and(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_or(volatile atomic<T>* obj, typename atomic<T>::value_type arg) noexcept
+    {
+        return obj->fetch_or(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_or_explicit(volatile atomic<T>* obj, typename atomic<T>::value_type arg,
+                               memory_order order) noexcept
+    {
+        return obj->fetch_or(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_xor(volatile atomic<T>* obj, typename atomic<T>::value_type arg) noexcept
+    {
+        return obj->fetch_xor(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_xor_explicit(volatile atomic<T>* obj, typename atomic<T>::value_type arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_xor(arg, order);
+    }
+
+    template<class T>
+    void atomic_wait(const volatile atomic<T>* obj, typename atomic<T>::value_type old) noexcept
+    {
+        obj->wait(old);
+    }
+
+    template<class T>
+    void atomic_wait_explicit(const volatile atomic<T>* obj, typename atomic<T>::value_type old,
+                              memory_order order) noexcept
+    {
+        obj->wait(old, order);
+    }
+
+    template<class T>
+    void atomic_notify_one(volatile atomic<T>* obj) noexcept
+    {
+        obj->notify_one();
+    }
+
+    template<class T>
+    void atomic_notify_all(volatile atomic<T>* obj) noexcept
+    {
+        obj->notify_all();
+    }
+
+    /**
+     * 29.7, flag type and operations:
+     */
+
+    struct atomic_flag
+    {
+        atomic_flag() noexcept = default;
+
+        /**
+         * Note: Allows ATOMIC_FLAG_INIT, which is
+         *       not required to be a constant
+         *       of this type.
+         */
+        constexpr atomic_flag(bool value) noexcept
+            : flag_{value}
+        { /* DUMMY BODY */ }
+
+        atomic_flag(const atomic_flag&) = delete;
+        atomic_flag& operator=(const atomic_flag&) = delete;
+        atomic_flag& operator=(const atomic_flag&) volatile = delete;
+
+        bool test(memory_order order = memory_order_seq_cst) const volatile noexcept
+        {
+            return __atomic_load_n(&flag_, order);
+        }
+
+        bool test(memory_order order = memory_order_seq_cst) const noexcept
+        {
+            return static_cast<const volatile atomic_flag*>(this)->test(order);
+        }
+
+        bool test_and_set(memory_order order = memory_order_seq_cst) volatile noexcept
+        {
+            return __atomic_test_and_set(&flag_, order);
+        }
+
+        bool test_and_set(memory_order order = memory_order_seq_cst) noexcept
+        {
+            return static_cast<volatile atomic_flag*>(this)->test_and_set(order);
+        }
+
+        void clear(memory_order order = memory_order_seq_cst) volatile noexcept
+        {
+            __atomic_clear(&flag_, order);
+        }
+
+        void clear(memory_order order = memory_order_seq_cst) noexcept
+        {
+            static_cast<volatile atomic_flag*>(this)->clear(order);
+        }
+
+        void wait(bool old, memory_order order = memory_order_seq_cst) const volatile noexcept
+        {
+            if (test(order) != old)
+                return;
+
+            aux::atomic_wait(&flag_, aux::atomic_unchanged<bool>, &old, order);
+        }
+
+        void wait(bool old, memory_order order = memory_order_seq_cst) const noexcept
+        {
+            static_cast<const volatile atomic_flag*>(this)->wait(old, order);
+        }
+
+        void notify_one() volatile noexcept
+        {
+            aux::atomic_notify(&flag_);
+        }
+
+        void notify_one() noexcept
+        {
+            static_cast<volatile atomic_flag*>(this)->notify_one();
+        }
+
+        void notify_all() volatile noexcept
+        {
+            aux::atomic_notify(&flag_);
+        }
+
+        void notify_all() noexcept
+        {
+            static_cast<volatile atomic_flag*>(this)->notify_all();
+        }
+
+        private:
+            bool flag_;
+    };
+
+    inline bool atomic_flag_test(const volatile atomic_flag* obj) noexcept
+    {
+        return obj->test();
+    }
+
+    inline bool atomic_flag_test_explicit(const volatile atomic_flag* obj,
+                                          memory_order order) noexcept
+    {
+        return obj->test(order);
+    }
+
+    inline bool atomic_flag_test_and_set(volatile atomic_flag* obj) noexcept
+    {
+        return obj->test_and_set();
+    }
+
+    inline bool atomic_flag_test_and_set_explicit(volatile atomic_flag* obj,
+                                                  memory_order order) noexcept
+    {
+        return obj->test_and_set(order);
+    }
+
+    inline void atomic_flag_clear(volatile atomic_flag* obj) noexcept
+    {
+        obj->clear();
+    }
+
+    inline void atomic_flag_clear_explicit(volatile atomic_flag* obj,
+                                           memory_order order) noexcept
+    {
+        obj->clear(order);
+    }
+
+    inline void atomic_flag_wait(const volatile atomic_flag* obj, bool old) noexcept
+    {
+        obj->wait(old);
+    }
+
+    inline void atomic_flag_notify_one(volatile atomic_flag* obj) noexcept
+    {
+        obj->notify_one();
+    }
+
+    inline void atomic_flag_notify_all(volatile atomic_flag* obj) noexcept
+    {
+        obj->notify_all();
+    }
+}
 
 #endif
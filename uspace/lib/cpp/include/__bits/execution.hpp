@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_EXECUTION
+#define LIBCPP_BITS_EXECUTION
+
+#include <__bits/algorithm.hpp>
+#include <__bits/functional/arithmetic_operations.hpp>
+#include <__bits/thread/thread.hpp>
+#include <cstdlib>
+#include <type_traits>
+
+namespace std
+{
+    /**
+     * 20.19, execution policies:
+     */
+
+    namespace execution
+    {
+        class sequenced_policy
+        { /* DUMMY BODY */ };
+
+        class parallel_policy
+        { /* DUMMY BODY */ };
+
+        class parallel_unsequenced_policy
+        { /* DUMMY BODY */ };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+        inline constexpr parallel_unsequenced_policy par_unseq{};
+    }
+
+    template<class T>
+    struct is_execution_policy: false_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::sequenced_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::parallel_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::parallel_unsequenced_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<class T>
+    inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+
+    namespace aux
+    {
+        template<class ExecutionPolicy>
+        using enable_if_execution_policy_t = enable_if_t<
+            is_execution_policy_v<decay_t<ExecutionPolicy>>
+        >;
+
+        template<class ExecutionPolicy>
+        inline constexpr bool is_parallel_policy_v =
+            !is_same_v<decay_t<ExecutionPolicy>, execution::sequenced_policy>;
+
+        /**
+         * Parallel sorting does not pay off for short
+         * ranges, because of the cost of creating
+         * the threads and the final merges.
+         */
+        static constexpr ptrdiff_t parallel_sort_threshold{1 << 14};
+
+        /**
+         * Number of chunks the range is split into, each
+         * of them is sorted by a separate thread.
+         */
+        static constexpr size_t parallel_sort_chunks{4};
+
+        /**
+         * Splits the range into chunks that are sorted
+         * in separate threads and then merged pairwise,
+         * again in parallel.
+         * Note: Every thread is a kernel thread, so the
+         *       threads that sorted the chunks also perform
+         *       the merges instead of starting new ones.
+         */
+        template<class RandomAccessIterator, class Sort, class Compare>
+        void parallel_sort(RandomAccessIterator first, RandomAccessIterator last,
+                           Sort sort_chunk, Compare comp)
+        {
+            auto len = last - first;
+            if (len < parallel_sort_threshold)
+            {
+                sort_chunk(first, last, comp);
+
+                return;
+            }
+
+            RandomAccessIterator bounds[parallel_sort_chunks + 1];
+            for (size_t i = 0; i <= parallel_sort_chunks; ++i)
+                bounds[i] = first + len * i / parallel_sort_chunks;
+
+            thread workers[parallel_sort_chunks];
+
+            /**
+             * Worker i (the caller being worker 0) sorts chunk i
+             * and then merges its run with the neighbouring one,
+             * doubling the width of sorted runs in every round.
+             * Before a merge, it joins the worker that produced
+             * the neighbouring run, which is therefore done with
+             * it and exits. The merges of one round work on
+             * disjoint ranges.
+             */
+            auto work = [&](size_t i){
+                sort_chunk(bounds[i], bounds[i + 1], comp);
+
+                for (size_t width = 1; width < parallel_sort_chunks; width *= 2)
+                {
+                    if (i % (2 * width) != 0 || i + width >= parallel_sort_chunks)
+                        break;
+
+                    auto hi = bounds[i + 2 * width < parallel_sort_chunks ?
+                                     i + 2 * width : parallel_sort_chunks];
+
+                    workers[i + width].join();
+                    inplace_merge(bounds[i], bounds[i + width], hi, comp);
+                }
+            };
+
+            /**
+             * Workers only join workers with higher indices,
+             * so these have to be created first.
+             */
+            for (size_t i = parallel_sort_chunks - 1; i > 0; --i)
+                workers[i] = thread{[&work, i](){ work(i); }};
+            work(0);
+        }
+    }
+
+    /**
+     * 25.4.1.1, sort:
+     */
+
+    template<class ExecutionPolicy, class RandomAccessIterator,
+             class = aux::enable_if_execution_policy_t<ExecutionPolicy>>
+    void sort(ExecutionPolicy&& policy, RandomAccessIterator first,
+              RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        sort(forward<ExecutionPolicy>(policy), first, last, less<value_type>{});
+    }
+
+    template<class ExecutionPolicy, class RandomAccessIterator, class Compare,
+             class = aux::enable_if_execution_policy_t<ExecutionPolicy>>
+    void sort(ExecutionPolicy&&, RandomAccessIterator first,
+              RandomAccessIterator last, Compare comp)
+    {
+        auto sort_chunk = [](auto first, auto last, auto comp){
+            sort(first, last, comp);
+        };
+
+        if constexpr (aux::is_parallel_policy_v<ExecutionPolicy>)
+            aux::parallel_sort(first, last, sort_chunk, comp);
+        else
+            sort_chunk(first, last, comp);
+    }
+
+    /**
+     * 25.4.1.2, stable_sort:
+     */
+
+    template<class ExecutionPolicy, class RandomAccessIterator,
+             class = aux::enable_if_execution_policy_t<ExecutionPolicy>>
+    void stable_sort(ExecutionPolicy&& policy, RandomAccessIterator first,
+                     RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        stable_sort(forward<ExecutionPolicy>(policy), first, last, less<value_type>{});
+    }
+
+    template<class ExecutionPolicy, class RandomAccessIterator, class Compare,
+             class = aux::enable_if_execution_policy_t<ExecutionPolicy>>
+    void stable_sort(ExecutionPolicy&&, RandomAccessIterator first,
+                     RandomAccessIterator last, Compare comp)
+    {
+        /**
+         * Merging neighbouring chunks keeps equal elements
+         * in their original order, so this stays stable
+         * as long as the chunks are sorted stably.
+         */
+        auto sort_chunk = [](auto first, auto last, auto comp){
+            stable_sort(first, last, comp);
+        };
+
+        if constexpr (aux::is_parallel_policy_v<ExecutionPolicy>)
+            aux::parallel_sort(first, last, sort_chunk, comp);
+        else
+            sort_chunk(first, last, comp);
+    }
+}
+
+#endif
@@ -501,7 +501,7 @@ namespace std
     template<class T = void>
     struct bit_not
     {
-        constexpr bool operator()(const T& x) const
+        constexpr T operator()(const T& x) const
         {
             return ~x;
         }
@@ -53,29 +53,176 @@ namespace std
             uint64_t converted;
         };
 
+        /**
+         * Note: std::hash is used for indexing in
+         *       unordered containers, not for cryptography,
+         *       but returning the value itself makes sequential
+         *       or power of two keys land in few buckets (and
+         *       with a power of two table size in a single one).
+         *       Because of that, the value is run through
+         *       the murmur3 finalizer, which is a bijection
+         *       on 64 bit values, so distinct values only
+         *       collide if size_t is narrower than that.
+         */
         template<class T>
         T hash_(uint64_t x) noexcept
         {
-            /**
-             * Note: std::hash is used for indexing in
-             *       unordered containers, not for cryptography.
-             *       Because of this, we decided to simply convert
-             *       the value to uin64_t, which will help us
-             *       with testing (since in order to create
-             *       a collision in a multiset or multimap
-             *       we simply need 2 values that congruent
-             *       by the size of the table.
-             */
+            x ^= x >> 33;
+            x *= 0xFF51AFD7ED558CCDULL;
+            x ^= x >> 33;
+            x *= 0xC4CEB9FE1A85EC53ULL;
+            x ^= x >> 33;
+
             return static_cast<T>(x);
         }
 
+        /**
+         * Full 64x64 -> 128 bit multiplication, the low
+         * half ends up in a, the high half in b.
+         */
+        inline void hash_mum_(uint64_t& a, uint64_t& b) noexcept
+        {
+#ifdef __SIZEOF_INT128__
+            __uint128_t res = a;
+            res *= b;
+            a = static_cast<uint64_t>(res);
+            b = static_cast<uint64_t>(res >> 64);
+#else
+            uint64_t ha = a >> 32, hb = b >> 32;
+            uint64_t la = static_cast<uint32_t>(a);
+            uint64_t lb = static_cast<uint32_t>(b);
+
+            uint64_t hh = ha * hb;
+            uint64_t hl = ha * lb;
+            uint64_t lh = la * hb;
+            uint64_t ll = la * lb;
+
+            uint64_t mid = hl + (ll >> 32) + static_cast<uint32_t>(lh);
+            a = (mid << 32) | static_cast<uint32_t>(ll);
+            b = hh + (mid >> 32) + (lh >> 32);
+#endif
+        }
+
+        inline uint64_t hash_mix_(uint64_t a, uint64_t b) noexcept
+        {
+            hash_mum_(a, b);
+
+            return a ^ b;
+        }
+
+        inline uint64_t hash_read8_(const unsigned char* p) noexcept
+        {
+            uint64_t res;
+            __builtin_memcpy(&res, p, sizeof(res));
+
+            return res;
+        }
+
+        inline uint64_t hash_read4_(const unsigned char* p) noexcept
+        {
+            uint32_t res;
+            __builtin_memcpy(&res, p, sizeof(res));
+
+            return res;
+        }
+
+        /**
+         * Hashes a sequence of bytes, used by the string
+         * hashes. This is the wyhash algorithm (public domain,
+         * by Wang Yi), which reads the input a word at a time
+         * and consumes 48 bytes per iteration for longer inputs.
+         * Note: The input is read in native byte order, so
+         *       the results differ between little and big
+         *       endian machines, which is fine as hashes are
+         *       not supposed to be stored anywhere.
+         */
+        inline size_t hash_bytes(const void* data, size_t len) noexcept
+        {
+            constexpr uint64_t secret[] = {
+                0x2D358DCCAA6C78A5ULL, 0x8BB84B93962EACC9ULL,
+                0x4B33A62ED433D4A3ULL, 0x4D5A2DA51DE1AA47ULL
+            };
+
+            auto p = static_cast<const unsigned char*>(data);
+            uint64_t seed = hash_mix_(secret[0], secret[1]);
+            uint64_t a{}, b{};
+
+            if (len <= 16)
+            {
+                if (len >= 4)
+                {
+                    /**
+                     * Two possibly overlapping 4 byte reads
+                     * from each end cover anything from 4 to 16
+                     * bytes without branching on the length.
+                     */
+                    size_t off = (len >> 3) << 2;
+                    a = (hash_read4_(p) << 32) | hash_read4_(p + off);
+                    b = (hash_read4_(p + len - 4) << 32) |
+                        hash_read4_(p + len - 4 - off);
+                }
+                else if (len > 0)
+                {
+                    a = (static_cast<uint64_t>(p[0]) << 16) |
+                        (static_cast<uint64_t>(p[len >> 1]) << 8) |
+                        p[len - 1];
+                }
+            }
+            else
+            {
+                size_t i = len;
+                if (i > 48)
+                {
+                    uint64_t seed1 = seed, seed2 = seed;
+                    do
+                    {
+                        seed = hash_mix_(hash_read8_(p) ^ secret[1],
+                                         hash_read8_(p + 8) ^ seed);
+                        seed1 = hash_mix_(hash_read8_(p + 16) ^ secret[2],
+                                          hash_read8_(p + 24) ^ seed1);
+                        seed2 = hash_mix_(hash_read8_(p + 32) ^ secret[3],
+                                          hash_read8_(p + 40) ^ seed2);
+                        p += 48;
+                        i -= 48;
+                    } while (i > 48);
+
+                    seed ^= seed1 ^ seed2;
+                }
+
+                while (i > 16)
+                {
+                    seed = hash_mix_(hash_read8_(p) ^ secret[1],
+                                     hash_read8_(p + 8) ^ seed);
+                    p += 16;
+                    i -= 16;
+                }
+
+                a = hash_read8_(p + i - 16);
+                b = hash_read8_(p + i - 8);
+            }
+
+            a ^= secret[1];
+            b ^= seed;
+            hash_mum_(a, b);
+
+            return static_cast<size_t>(
+                hash_mix_(a ^ secret[0] ^ len, b ^ secret[1])
+            );
+        }
+
         template<class T>
         size_t hash(T x) noexcept
         {
             static_assert(is_arithmetic<T>::value || is_pointer<T>::value,
                           "invalid type passed to aux::hash");
 
+            /**
+             * Note: Types smaller than uint64_t would leave
+             *       the upper bytes uninitialized, which would
+             *       make equal values hash differently.
+             */
             converter<T> conv;
+            conv.converted = 0;
             conv.value = x;
 
             return hash_<size_t>(conv.converted);
@@ -75,6 +75,7 @@ namespace std
                 : mode_{move(other.mode_)}, str_{move(other.str_)}
             {
                 basic_streambuf<char_type, traits_type>::swap(other);
+                rebase_();
             }
 
             /**
@@ -86,6 +87,8 @@ namespace std
             basic_stringbuf& operator=(basic_stringbuf&& other)
             {
                 swap(other);
+
+                return *this;
             }
 
             void swap(basic_stringbuf& rhs)
@@ -94,6 +97,8 @@ namespace std
                 std::swap(str_, rhs.str_);
 
                 basic_streambuf<char_type, traits_type>::swap(rhs);
+                rebase_();
+                rhs.rebase_();
             }
 
             /**
@@ -250,6 +255,32 @@ namespace std
                 }
             }
 
+            /**
+             * Short strings live inside of the string object,
+             * so moving them to a different string buffer
+             * leaves the get and put pointers pointing to
+             * the old object, move them to the new buffer.
+             */
+            void rebase_()
+            {
+                auto old_begin = this->input_begin_ ?
+                    this->input_begin_ : this->output_begin_;
+                if (!old_begin || old_begin == str_.begin())
+                    return;
+
+                auto rebase = [&](char_type*& ptr){
+                    if (ptr)
+                        ptr = str_.begin() + (ptr - old_begin);
+                };
+
+                rebase(this->input_begin_);
+                rebase(this->input_next_);
+                rebase(this->input_end_);
+                rebase(this->output_begin_);
+                rebase(this->output_next_);
+                rebase(this->output_end_);
+            }
+
             bool ensure_free_space_(size_t n = 1)
             {
                 str_.ensure_free_space_(n);
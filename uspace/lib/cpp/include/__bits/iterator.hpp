@@ -115,8 +115,26 @@ namespace std
     template<class InputIterator, class Distance>
     void advance(InputIterator& it, Distance n)
     {
-        for (Distance i = Distance{}; i < n; ++i)
-            ++it;
+        using cat_t = typename iterator_traits<InputIterator>::iterator_category;
+
+        if constexpr (is_same_v<cat_t, random_access_iterator_tag>)
+            it += n;
+        else if constexpr (is_same_v<cat_t, bidirectional_iterator_tag>)
+        {
+            for (; n > 0; --n)
+                ++it;
+            for (; n < 0; ++n)
+                --it;
+        }
+        else
+        {
+            /**
+             * Note: Negative distance is only allowed
+             *       for bidirectional iterators.
+             */
+            for (; n > 0; --n)
+                ++it;
+        }
     }
 
     template<class InputIterator>
@@ -498,12 +498,12 @@ namespace std
 
             static constexpr unsigned char max()
             {
-                return SCHAR_MAX;
+                return UCHAR_MAX;
             }
 
             static constexpr unsigned char min()
             {
-                return SCHAR_MIN;
+                return 0;
             }
 
             static constexpr unsigned char lowest()
@@ -45,23 +45,25 @@ namespace std
 
     namespace aux
     {
-        template<class T, class = void>
-        struct has_allocator_type: false_type
+        /**
+         * Note: The allocator_type member has to be checked
+         *       before it is named, otherwise types without
+         *       it would make the trait ill-formed.
+         */
+        template<class T, class Alloc, class = void>
+        struct uses_allocator_impl: false_type
         { /* DUMMY BODY */ };
 
-        template<class T>
-        struct has_allocator_type<T, void_t<typename T::allocator_type>>
-            : true_type
+        template<class T, class Alloc>
+        struct uses_allocator_impl<T, Alloc, void_t<typename T::allocator_type>>
+            : aux::value_is<
+            bool, is_convertible_v<Alloc, typename T::allocator_type>
+        >
         { /* DUMMY BODY */ };
     }
 
     template<class T, class Alloc>
-    struct uses_allocator
-        : aux::value_is<
-        bool, aux::has_allocator_type<T>::value && is_convertible_v<
-            Alloc, typename T::allocator_type
-        >
-    >
+    struct uses_allocator: aux::uses_allocator_impl<T, Alloc>
     { /* DUMMY BODY */ };
 
     /**
@@ -87,7 +89,7 @@ namespace std
         using is_always_equal                        = typename aux::alloc_get_always_equal<Alloc>::type;
 
         template<class T>
-        using rebind_alloc = typename aux::alloc_get_rebind_alloc<Alloc, T>;
+        using rebind_alloc = typename aux::alloc_get_rebind_alloc<Alloc, T>::type;
 
         template<class T>
         using rebind_traits = allocator_traits<rebind_alloc<T>>;
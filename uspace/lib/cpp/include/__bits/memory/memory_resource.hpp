@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_MEMORY_MEMORY_RESOURCE
+#define LIBCPP_BITS_MEMORY_MEMORY_RESOURCE
+
+#include <__bits/memory/polymorphic_allocator.hpp>
+#include <cstddef>
+#include <mutex>
+
+namespace std::aux
+{
+    struct pool_block
+    {
+        pool_block* next;
+    };
+
+    /**
+     * Note: The chunk descriptor is placed after the last
+     *       block of the chunk, so that blocks start at
+     *       the (maximally aligned) beginning of the memory
+     *       obtained from the upstream resource.
+     */
+    struct pool_chunk
+    {
+        pool_chunk* next;
+        size_t size;
+    };
+
+    /**
+     * Requests larger than the largest pool block are
+     * forwarded to the upstream resource, but they are
+     * still tracked so that release() can free them.
+     */
+    struct oversized_block
+    {
+        oversized_block* next;
+        oversized_block* prev;
+        size_t size;
+        size_t alignment;
+    };
+
+    /**
+     * Set of blocks of a single size. New chunks grow
+     * geometrically up to the maximal block count and
+     * their blocks are handed out from the chunk before
+     * any freed blocks are reused, so that a chunk does
+     * not have to be threaded into the free list at once.
+     */
+    class block_pool
+    {
+        public:
+            block_pool(size_t block_size)
+                : block_size_{block_size}, next_blocks_{initial_blocks_},
+                  free_{}, chunks_{}, bump_{}, bump_end_{}
+            { /* DUMMY BODY */ }
+
+            void* allocate(pmr::memory_resource*, size_t);
+            void deallocate(void*) noexcept;
+            void release(pmr::memory_resource*) noexcept;
+
+            size_t block_size() const noexcept
+            {
+                return block_size_;
+            }
+
+        private:
+            size_t block_size_;
+            size_t next_blocks_;
+            pool_block* free_;
+            pool_chunk* chunks_;
+            char* bump_;
+            char* bump_end_;
+
+            static constexpr size_t initial_blocks_{8};
+            static constexpr size_t max_chunk_size_{1U << 20};
+    };
+}
+
+namespace std::pmr
+{
+    /**
+     * 23.12.5.2, pool_options data members:
+     */
+
+    struct pool_options
+    {
+        size_t max_blocks_per_chunk = 0;
+        size_t largest_required_pool_block = 0;
+    };
+
+    /**
+     * 23.12.5, pool resource classes:
+     */
+
+    class unsynchronized_pool_resource: public memory_resource
+    {
+        public:
+            unsynchronized_pool_resource(const pool_options&, memory_resource*);
+
+            unsynchronized_pool_resource()
+                : unsynchronized_pool_resource{pool_options{}, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            explicit unsynchronized_pool_resource(memory_resource* upstream)
+                : unsynchronized_pool_resource{pool_options{}, upstream}
+            { /* DUMMY BODY */ }
+
+            explicit unsynchronized_pool_resource(const pool_options& opts)
+                : unsynchronized_pool_resource{opts, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+            unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+            virtual ~unsynchronized_pool_resource();
+
+            void release();
+
+            memory_resource* upstream_resource() const
+            {
+                return upstream_;
+            }
+
+            pool_options options() const
+            {
+                return options_;
+            }
+
+        protected:
+            void* do_allocate(size_t, size_t) override;
+            void do_deallocate(void*, size_t, size_t) override;
+            bool do_is_equal(const memory_resource&) const noexcept override;
+
+        private:
+            memory_resource* upstream_;
+            pool_options options_;
+            aux::block_pool* pools_;
+            size_t pool_count_;
+            aux::oversized_block* oversized_;
+
+            aux::block_pool* find_pool_(size_t, size_t) noexcept;
+    };
+
+    class synchronized_pool_resource: public memory_resource
+    {
+        public:
+            synchronized_pool_resource(const pool_options& opts, memory_resource* upstream)
+                : mtx_{}, resource_{opts, upstream}
+            { /* DUMMY BODY */ }
+
+            synchronized_pool_resource()
+                : synchronized_pool_resource{pool_options{}, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            explicit synchronized_pool_resource(memory_resource* upstream)
+                : synchronized_pool_resource{pool_options{}, upstream}
+            { /* DUMMY BODY */ }
+
+            explicit synchronized_pool_resource(const pool_options& opts)
+                : synchronized_pool_resource{opts, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+            synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+            virtual ~synchronized_pool_resource() = default;
+
+            void release();
+
+            memory_resource* upstream_resource() const
+            {
+                return resource_.upstream_resource();
+            }
+
+            pool_options options() const
+            {
+                return resource_.options();
+            }
+
+        protected:
+            void* do_allocate(size_t, size_t) override;
+            void do_deallocate(void*, size_t, size_t) override;
+            bool do_is_equal(const memory_resource&) const noexcept override;
+
+        private:
+            mutex mtx_;
+            unsynchronized_pool_resource resource_;
+    };
+
+    /**
+     * 23.12.6, class monotonic_buffer_resource:
+     */
+
+    class monotonic_buffer_resource: public memory_resource
+    {
+        public:
+            explicit monotonic_buffer_resource(memory_resource* upstream)
+                : monotonic_buffer_resource{nullptr, 0, upstream}
+            { /* DUMMY BODY */ }
+
+            monotonic_buffer_resource(size_t initial_size, memory_resource* upstream)
+                : monotonic_buffer_resource{nullptr, 0, upstream}
+            {
+                if (initial_size > 0)
+                    next_size_ = initial_next_size_ = initial_size;
+            }
+
+            monotonic_buffer_resource(void* buffer, size_t buffer_size,
+                                      memory_resource* upstream)
+                : upstream_{upstream}, buffer_{buffer}, buffer_size_{buffer_size},
+                  current_{static_cast<char*>(buffer)}, remaining_{buffer_size},
+                  next_size_{default_size_}, initial_next_size_{default_size_},
+                  chunks_{}
+            {
+                /**
+                 * The first chunk from upstream follows
+                 * the initial buffer geometrically.
+                 */
+                if (buffer_size > 0)
+                    next_size_ = initial_next_size_ = buffer_size * growth_factor_;
+            }
+
+            monotonic_buffer_resource()
+                : monotonic_buffer_resource{get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            explicit monotonic_buffer_resource(size_t initial_size)
+                : monotonic_buffer_resource{initial_size, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            monotonic_buffer_resource(void* buffer, size_t buffer_size)
+                : monotonic_buffer_resource{buffer, buffer_size, get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+            monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+            virtual ~monotonic_buffer_resource();
+
+            void release();
+
+            memory_resource* upstream_resource() const
+            {
+                return upstream_;
+            }
+
+        protected:
+            void* do_allocate(size_t, size_t) override;
+            void do_deallocate(void*, size_t, size_t) override;
+            bool do_is_equal(const memory_resource&) const noexcept override;
+
+        private:
+            memory_resource* upstream_;
+            void* buffer_;
+            size_t buffer_size_;
+
+            char* current_;
+            size_t remaining_;
+            size_t next_size_;
+            size_t initial_next_size_;
+            aux::pool_chunk* chunks_;
+
+            static constexpr size_t default_size_{1024};
+            static constexpr size_t growth_factor_{2};
+    };
+}
+
+#endif
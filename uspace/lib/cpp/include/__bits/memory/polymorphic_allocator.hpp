@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_MEMORY_POLYMORPHIC_ALLOCATOR
+#define LIBCPP_BITS_MEMORY_POLYMORPHIC_ALLOCATOR
+
+#include <__bits/memory/allocator_arg.hpp>
+#include <__bits/memory/allocator_traits.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace std::pmr
+{
+    /**
+     * 23.12.2, class memory_resource:
+     */
+
+    class memory_resource
+    {
+        public:
+            virtual ~memory_resource() = default;
+
+            void* allocate(size_t bytes, size_t alignment = max_align_)
+            {
+                return do_allocate(bytes, alignment);
+            }
+
+            void deallocate(void* ptr, size_t bytes, size_t alignment = max_align_)
+            {
+                do_deallocate(ptr, bytes, alignment);
+            }
+
+            bool is_equal(const memory_resource& other) const noexcept
+            {
+                return do_is_equal(other);
+            }
+
+        private:
+            static constexpr size_t max_align_{alignof(max_align_t)};
+
+            virtual void* do_allocate(size_t, size_t) = 0;
+            virtual void do_deallocate(void*, size_t, size_t) = 0;
+            virtual bool do_is_equal(const memory_resource&) const noexcept = 0;
+    };
+
+    inline bool operator==(const memory_resource& lhs, const memory_resource& rhs) noexcept
+    {
+        return &lhs == &rhs || lhs.is_equal(rhs);
+    }
+
+    inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * 23.12.4, access to program-wide memory_resource objects:
+     */
+
+    memory_resource* new_delete_resource() noexcept;
+    memory_resource* null_memory_resource() noexcept;
+    memory_resource* set_default_resource(memory_resource*) noexcept;
+    memory_resource* get_default_resource() noexcept;
+
+    /**
+     * 23.12.3, class template polymorphic_allocator:
+     */
+
+    template<class Tp>
+    class polymorphic_allocator
+    {
+        public:
+            using value_type = Tp;
+
+            /**
+             * 23.12.3.1, constructors:
+             */
+
+            polymorphic_allocator() noexcept
+                : resource_{get_default_resource()}
+            { /* DUMMY BODY */ }
+
+            polymorphic_allocator(memory_resource* resource)
+                : resource_{resource}
+            { /* DUMMY BODY */ }
+
+            polymorphic_allocator(const polymorphic_allocator&) = default;
+
+            template<class U>
+            polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+                : resource_{other.resource()}
+            { /* DUMMY BODY */ }
+
+            /**
+             * Note: The resource is bound for the lifetime
+             *       of the allocator, containers do not
+             *       propagate it on assignment or swap.
+             */
+            polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+            /**
+             * 23.12.3.2, member functions:
+             */
+
+            Tp* allocate(size_t n)
+            {
+                return static_cast<Tp*>(
+                    resource_->allocate(n * sizeof(Tp), alignof(Tp))
+                );
+            }
+
+            void deallocate(Tp* ptr, size_t n)
+            {
+                resource_->deallocate(ptr, n * sizeof(Tp), alignof(Tp));
+            }
+
+            /**
+             * Note: Uses-allocator construction, the resource
+             *       is passed to elements that can use it
+             *       either as a leading (after allocator_arg)
+             *       or as a trailing constructor argument.
+             */
+            template<class T, class... Args>
+            void construct(T* ptr, Args&&... args)
+            {
+                if constexpr (!uses_allocator<T, polymorphic_allocator>::value)
+                    ::new(static_cast<void*>(ptr)) T(forward<Args>(args)...);
+                else if constexpr (is_constructible_v<
+                    T, allocator_arg_t, const polymorphic_allocator&, Args...
+                >)
+                {
+                    ::new(static_cast<void*>(ptr)) T(
+                        allocator_arg, *this, forward<Args>(args)...
+                    );
+                }
+                else
+                    ::new(static_cast<void*>(ptr)) T(forward<Args>(args)..., *this);
+            }
+
+            template<class T>
+            void destroy(T* ptr)
+            {
+                ptr->~T();
+            }
+
+            polymorphic_allocator select_on_container_copy_construction() const
+            {
+                return polymorphic_allocator{};
+            }
+
+            memory_resource* resource() const
+            {
+                return resource_;
+            }
+
+        private:
+            memory_resource* resource_;
+    };
+
+    /**
+     * 23.12.3.3, equality:
+     */
+
+    template<class T1, class T2>
+    bool operator==(const polymorphic_allocator<T1>& lhs,
+                    const polymorphic_allocator<T2>& rhs) noexcept
+    {
+        return *lhs.resource() == *rhs.resource();
+    }
+
+    template<class T1, class T2>
+    bool operator!=(const polymorphic_allocator<T1>& lhs,
+                    const polymorphic_allocator<T2>& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
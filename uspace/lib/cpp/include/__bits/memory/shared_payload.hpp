@@ -104,17 +104,14 @@ namespace std::aux
 
             void destroy() override
             {
-                if (this->refs() == 0)
+                if (data_)
                 {
-                    if (data_)
-                    {
-                        deleter_(data_);
-                        data_ = nullptr;
-                    }
-
-                    if (this->weak_refs() == 0)
-                        delete this;
+                    deleter_(data_);
+                    data_ = nullptr;
                 }
+
+                if (this->decrement_weak())
+                    delete this;
             }
 
             T* get() const noexcept override
@@ -132,9 +129,8 @@ namespace std::aux
                 refcount_t rfs = this->refs();
                 while (rfs != 0L)
                 {
-                    if (__atomic_compare_exchange_n(&this->refcount_, &rfs, rfs + 1,
-                                                    true, __ATOMIC_RELAXED,
-                                                    __ATOMIC_RELAXED))
+                    if (this->refcount_.compare_exchange_weak(rfs, rfs + 1,
+                                                              memory_order_relaxed))
                     {
                         return this;
                     }
@@ -190,8 +190,21 @@ namespace std::aux
         : aux::type_is<typename T::is_always_equal>
     { /* DUMMY BODY */ };
 
+    template<class Alloc, class T>
+    struct alloc_get_rebind_alloc_args
+    { /* DUMMY BODY */ };
+
+    template<template <class, class...> class Alloc, class U, class... Args, class T>
+    struct alloc_get_rebind_alloc_args<Alloc<U, Args...>, T>
+        : aux::type_is<Alloc<T, Args...>>
+    { /* DUMMY BODY */ };
+
+    /**
+     * Note: The rebind member takes precedence, the template
+     *       arguments are replaced only if it is missing.
+     */
     template<class Alloc, class T, class = void>
-    struct alloc_get_rebind_alloc
+    struct alloc_get_rebind_alloc: alloc_get_rebind_alloc_args<Alloc, T>
     { /* DUMMY BODY */ };
 
     template<class Alloc, class T>
@@ -199,11 +212,6 @@ namespace std::aux
         : aux::type_is<typename Alloc::template rebind<T>::other>
     { /* DUMMY BODY */ };
 
-    template<template <class, class...> class Alloc, class U, class... Args, class T>
-    struct alloc_get_rebind_alloc<Alloc<U, Args...>, T>
-        : aux::type_is<Alloc<T, Args...>>
-    { /* DUMMY BODY */ };
-
     /**
      * These metafunctions are used to check whether an expression
      * is well-formed for the static functions of allocator_traits:
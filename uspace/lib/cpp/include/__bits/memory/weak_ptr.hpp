@@ -191,7 +191,11 @@ namespace std
 
             shared_ptr<T> lock() const noexcept
             {
-                return shared_ptr{aux::payload_tag, payload_->lock()};
+                auto payload = payload_ ? payload_->lock() : nullptr;
+                if (!payload)
+                    return shared_ptr<T>{};
+
+                return shared_ptr<T>{aux::payload_tag, payload};
             }
 
             template<class U>
@@ -211,8 +215,12 @@ namespace std
 
             void remove_payload_()
             {
+                /**
+                 * The last weak reference is only dropped after
+                 * the object is destroyed, see refcount_obj.
+                 */
                 if (payload_ && payload_->decrement_weak())
-                    payload_->destroy();
+                    delete payload_;
                 payload_ = nullptr;
             }
 
@@ -56,11 +56,20 @@ new_handler get_new_handler() noexcept;
 }
 
 void* operator new(std::size_t);
-void* operator new(std::size_t, void*);
 void* operator new(std::size_t, const std::nothrow_t&) noexcept;
 void* operator new[](std::size_t);
 void* operator new[](std::size_t, const std::nothrow_t&) noexcept;
 
+/**
+ * The placement form is inline, so that constructing
+ * elements in a loop does not cost a call per element
+ * and such loops can be vectorized.
+ */
+inline void* operator new(std::size_t, void* ptr) noexcept
+{
+	return ptr;
+}
+
 void operator delete(void*) noexcept;
 void operator delete(void*, std::size_t) noexcept;
 void operator delete[](void*) noexcept;
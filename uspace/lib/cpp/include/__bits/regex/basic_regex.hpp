@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_BASIC_REGEX
+#define LIBCPP_BITS_REGEX_BASIC_REGEX
+
+#include <__bits/regex/regex_compiler.hpp>
+#include <__bits/regex/regex_constants.hpp>
+#include <__bits/regex/regex_engine.hpp>
+#include <__bits/regex/regex_traits.hpp>
+#include <initializer_list>
+#include <iterator>
+#include <locale>
+#include <memory>
+#include <string>
+
+namespace std
+{
+    namespace aux
+    {
+        struct regex_access;
+    }
+
+    /**
+     * 28.8, class template basic_regex:
+     */
+
+    template<class Char, class Traits = regex_traits<Char>>
+    class basic_regex
+    {
+        public:
+            using value_type  = Char;
+            using traits_type = Traits;
+            using string_type = typename Traits::string_type;
+            using flag_type   = regex_constants::syntax_option_type;
+            using locale_type = typename Traits::locale_type;
+
+            /**
+             * 28.8.1, constants:
+             */
+
+            static constexpr flag_type icase      = regex_constants::icase;
+            static constexpr flag_type nosubs     = regex_constants::nosubs;
+            static constexpr flag_type optimize   = regex_constants::optimize;
+            static constexpr flag_type collate    = regex_constants::collate;
+            static constexpr flag_type ECMAScript = regex_constants::ECMAScript;
+            static constexpr flag_type basic      = regex_constants::basic;
+            static constexpr flag_type extended   = regex_constants::extended;
+            static constexpr flag_type awk        = regex_constants::awk;
+            static constexpr flag_type grep       = regex_constants::grep;
+            static constexpr flag_type egrep      = regex_constants::egrep;
+            static constexpr flag_type multiline  = regex_constants::multiline;
+
+            /**
+             * 28.8.2, construct/copy/destroy:
+             */
+
+            basic_regex()
+                : flags_{ECMAScript}, traits_{}, marks_{}, automaton_{}
+            { /* DUMMY BODY */ }
+
+            explicit basic_regex(const value_type* ptr, flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(ptr, f);
+            }
+
+            basic_regex(const value_type* ptr, size_t len, flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(ptr, len, f);
+            }
+
+            basic_regex(const basic_regex&) = default;
+
+            basic_regex(basic_regex&& other) noexcept
+                : basic_regex{}
+            {
+                swap(other);
+            }
+
+            template<class ST, class SA>
+            explicit basic_regex(const basic_string<value_type, ST, SA>& str,
+                                 flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(str, f);
+            }
+
+            template<class ForwardIterator>
+            basic_regex(ForwardIterator first, ForwardIterator last,
+                        flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(first, last, f);
+            }
+
+            basic_regex(initializer_list<value_type> init, flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(init, f);
+            }
+
+            ~basic_regex() = default;
+
+            basic_regex& operator=(const basic_regex& other)
+            {
+                return assign(other);
+            }
+
+            basic_regex& operator=(basic_regex&& other) noexcept
+            {
+                return assign(move(other));
+            }
+
+            basic_regex& operator=(const value_type* ptr)
+            {
+                return assign(ptr);
+            }
+
+            basic_regex& operator=(initializer_list<value_type> init)
+            {
+                return assign(init);
+            }
+
+            template<class ST, class SA>
+            basic_regex& operator=(const basic_string<value_type, ST, SA>& str)
+            {
+                return assign(str);
+            }
+
+            /**
+             * 28.8.3, assign:
+             */
+
+            basic_regex& assign(const basic_regex& other)
+            {
+                basic_regex tmp{other};
+                swap(tmp);
+
+                return *this;
+            }
+
+            basic_regex& assign(basic_regex&& other) noexcept
+            {
+                basic_regex tmp{};
+                tmp.swap(other);
+                swap(tmp);
+
+                return *this;
+            }
+
+            basic_regex& assign(const value_type* ptr, flag_type f = ECMAScript)
+            {
+                return assign(ptr, Traits::length(ptr), f);
+            }
+
+            basic_regex& assign(const value_type* ptr, size_t len, flag_type f = ECMAScript)
+            {
+                compile_(ptr, ptr + len, f);
+
+                return *this;
+            }
+
+            template<class ST, class SA>
+            basic_regex& assign(const basic_string<value_type, ST, SA>& str,
+                                flag_type f = ECMAScript)
+            {
+                return assign(str.data(), str.size(), f);
+            }
+
+            template<class InputIterator>
+            basic_regex& assign(InputIterator first, InputIterator last,
+                                flag_type f = ECMAScript)
+            {
+                string_type str{first, last};
+
+                return assign(str.data(), str.size(), f);
+            }
+
+            basic_regex& assign(initializer_list<value_type> init,
+                                flag_type f = ECMAScript)
+            {
+                return assign(init.begin(), init.size(), f);
+            }
+
+            /**
+             * 28.8.4, const operations:
+             */
+
+            unsigned int mark_count() const
+            {
+                return marks_;
+            }
+
+            flag_type flags() const
+            {
+                return flags_;
+            }
+
+            /**
+             * 28.8.5, locale:
+             */
+
+            locale_type imbue(locale_type loc)
+            {
+                /**
+                 * Note: The standard requires imbue to reset
+                 *       the regex to an empty one.
+                 */
+                automaton_.reset();
+                marks_ = 0;
+
+                return traits_.imbue(loc);
+            }
+
+            locale_type getloc() const
+            {
+                return traits_.getloc();
+            }
+
+            /**
+             * 28.8.6, swap:
+             */
+
+            void swap(basic_regex& other)
+            {
+                std::swap(flags_, other.flags_);
+                std::swap(traits_, other.traits_);
+                std::swap(marks_, other.marks_);
+                std::swap(automaton_, other.automaton_);
+            }
+
+        private:
+            using automaton_type = aux::regex_automaton<Char, Traits>;
+
+            flag_type flags_;
+            traits_type traits_;
+            unsigned int marks_;
+
+            /**
+             * The compiled program is immutable and shared by
+             * copies of the regex, which makes them cheap.
+             */
+            shared_ptr<automaton_type> automaton_;
+
+            void compile_(const value_type* first, const value_type* last, flag_type f)
+            {
+                aux::regex_compiler<Char, Traits> compiler{first, last, f, traits_};
+                auto prog = compiler.compile();
+
+                flags_ = f;
+                if (compiler.failed())
+                {
+                    marks_ = 0;
+                    automaton_.reset();
+
+                    return;
+                }
+
+                marks_ = static_cast<unsigned int>(compiler.mark_count());
+                automaton_ = make_shared<automaton_type>(move(prog));
+            }
+
+            friend struct aux::regex_access;
+    };
+
+    using regex  = basic_regex<char>;
+    using wregex = basic_regex<wchar_t>;
+
+    /**
+     * 28.8.7, basic_regex swap:
+     */
+
+    template<class Char, class Traits>
+    void swap(basic_regex<Char, Traits>& lhs, basic_regex<Char, Traits>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    namespace aux
+    {
+        /**
+         * Runs the automaton of a regex, a default constructed
+         * regex matches nothing.
+         */
+        struct regex_access
+        {
+            template<class BidirIt, class Allocator, class Char, class Traits>
+            static bool exec(BidirIt first, BidirIt last,
+                             match_results<BidirIt, Allocator>* m,
+                             const basic_regex<Char, Traits>& e,
+                             regex_constants::match_flag_type flags, bool full)
+            {
+                if (!e.automaton_)
+                {
+                    if (m)
+                        regex_results_access::assign_failed(*m, first, last);
+
+                    return false;
+                }
+
+                return e.automaton_->exec(first, last, m, flags, full);
+            }
+        };
+    }
+}
+
+#endif
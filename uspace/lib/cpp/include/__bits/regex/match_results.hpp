@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_MATCH_RESULTS
+#define LIBCPP_BITS_REGEX_MATCH_RESULTS
+
+#include <__bits/regex/regex_constants.hpp>
+#include <__bits/regex/sub_match.hpp>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace std
+{
+    namespace aux
+    {
+        struct regex_results_access;
+    }
+
+    /**
+     * 28.10, class template match_results:
+     */
+
+    template<
+        class BidirectionalIterator,
+        class Allocator = allocator<sub_match<BidirectionalIterator>>
+    >
+    class match_results
+    {
+        public:
+            using value_type      = sub_match<BidirectionalIterator>;
+            using const_reference = const value_type&;
+            using reference       = value_type&;
+            using const_iterator  = typename vector<value_type, Allocator>::const_iterator;
+            using iterator        = const_iterator;
+            using difference_type = typename iterator_traits<BidirectionalIterator>::difference_type;
+            using size_type       = typename allocator_traits<Allocator>::size_type;
+            using allocator_type  = Allocator;
+            using char_type       = typename iterator_traits<BidirectionalIterator>::value_type;
+            using string_type     = basic_string<char_type>;
+
+            /**
+             * 28.10.1, construct/copy/destroy:
+             */
+
+            explicit match_results(const Allocator& alloc = Allocator{})
+                : subs_{alloc}, prefix_{}, suffix_{}, unmatched_{},
+                  base_{}, ready_{false}
+            { /* DUMMY BODY */ }
+
+            match_results(const match_results&) = default;
+            match_results(match_results&&) noexcept = default;
+
+            match_results& operator=(const match_results&) = default;
+            match_results& operator=(match_results&&) = default;
+
+            ~match_results() = default;
+
+            /**
+             * 28.10.2, state:
+             */
+
+            bool ready() const
+            {
+                return ready_;
+            }
+
+            /**
+             * 28.10.3, size:
+             */
+
+            size_type size() const
+            {
+                return subs_.size();
+            }
+
+            size_type max_size() const
+            {
+                return subs_.max_size();
+            }
+
+            bool empty() const
+            {
+                return size() == 0;
+            }
+
+            /**
+             * 28.10.4, element access:
+             */
+
+            difference_type length(size_type sub = 0) const
+            {
+                return (*this)[sub].length();
+            }
+
+            difference_type position(size_type sub = 0) const
+            {
+                return distance(base_, (*this)[sub].first);
+            }
+
+            string_type str(size_type sub = 0) const
+            {
+                return (*this)[sub].str();
+            }
+
+            const_reference operator[](size_type n) const
+            {
+                if (n < size())
+                    return subs_[n];
+                else
+                    return unmatched_;
+            }
+
+            const_reference prefix() const
+            {
+                return prefix_;
+            }
+
+            const_reference suffix() const
+            {
+                return suffix_;
+            }
+
+            const_iterator begin() const
+            {
+                return subs_.begin();
+            }
+
+            const_iterator end() const
+            {
+                return subs_.end();
+            }
+
+            const_iterator cbegin() const
+            {
+                return subs_.cbegin();
+            }
+
+            const_iterator cend() const
+            {
+                return subs_.cend();
+            }
+
+            /**
+             * 28.10.5, format:
+             */
+
+            template<class OutputIterator>
+            OutputIterator format(
+                OutputIterator out, const char_type* fmt_first,
+                const char_type* fmt_last,
+                regex_constants::match_flag_type flags = regex_constants::format_default
+            ) const
+            {
+                if (flags & regex_constants::format_sed)
+                    return format_sed_(out, fmt_first, fmt_last);
+                else
+                    return format_ecma_(out, fmt_first, fmt_last);
+            }
+
+            template<class OutputIterator, class ST, class SA>
+            OutputIterator format(
+                OutputIterator out, const basic_string<char_type, ST, SA>& fmt,
+                regex_constants::match_flag_type flags = regex_constants::format_default
+            ) const
+            {
+                return format(out, fmt.data(), fmt.data() + fmt.size(), flags);
+            }
+
+            template<class ST, class SA>
+            basic_string<char_type, ST, SA> format(
+                const basic_string<char_type, ST, SA>& fmt,
+                regex_constants::match_flag_type flags = regex_constants::format_default
+            ) const
+            {
+                basic_string<char_type, ST, SA> res{};
+                format(back_inserter(res), fmt, flags);
+
+                return res;
+            }
+
+            string_type format(
+                const char_type* fmt,
+                regex_constants::match_flag_type flags = regex_constants::format_default
+            ) const
+            {
+                string_type res{};
+                format(
+                    back_inserter(res), fmt,
+                    fmt + char_traits<char_type>::length(fmt), flags
+                );
+
+                return res;
+            }
+
+            /**
+             * 28.10.6, allocator:
+             */
+
+            allocator_type get_allocator() const
+            {
+                return subs_.get_allocator();
+            }
+
+            /**
+             * 28.10.7, swap:
+             */
+
+            void swap(match_results& other)
+            {
+                std::swap(subs_, other.subs_);
+                std::swap(prefix_, other.prefix_);
+                std::swap(suffix_, other.suffix_);
+                std::swap(unmatched_, other.unmatched_);
+                std::swap(base_, other.base_);
+                std::swap(ready_, other.ready_);
+            }
+
+        private:
+            vector<value_type, Allocator> subs_;
+            value_type prefix_;
+            value_type suffix_;
+            value_type unmatched_;
+            BidirectionalIterator base_;
+            bool ready_;
+
+            template<class OutputIterator>
+            static OutputIterator copy_(OutputIterator out, const value_type& sub)
+            {
+                if (sub.matched)
+                    out = std::copy(sub.first, sub.second, out);
+
+                return out;
+            }
+
+            template<class OutputIterator>
+            OutputIterator format_ecma_(OutputIterator out, const char_type* first,
+                                        const char_type* last) const
+            {
+                while (first != last)
+                {
+                    if (*first != '$' || first + 1 == last)
+                    {
+                        *out++ = *first++;
+                        continue;
+                    }
+
+                    auto c = *(first + 1);
+                    if (c == '$')
+                        *out++ = c;
+                    else if (c == '&')
+                        out = copy_(out, (*this)[0]);
+                    else if (c == '`')
+                        out = copy_(out, prefix_);
+                    else if (c == '\'')
+                        out = copy_(out, suffix_);
+                    else if (c >= '0' && c <= '9')
+                    {
+                        size_type idx = static_cast<size_type>(c - '0');
+
+                        /**
+                         * Two digit references are only used
+                         * when such a group exists.
+                         */
+                        if (first + 2 != last && *(first + 2) >= '0' && *(first + 2) <= '9')
+                        {
+                            auto idx2 = idx * 10 + static_cast<size_type>(*(first + 2) - '0');
+                            if (idx2 < size())
+                            {
+                                idx = idx2;
+                                ++first;
+                            }
+                        }
+
+                        out = copy_(out, (*this)[idx]);
+                    }
+                    else
+                    {
+                        *out++ = *first++;
+                        continue;
+                    }
+
+                    first += 2;
+                }
+
+                return out;
+            }
+
+            template<class OutputIterator>
+            OutputIterator format_sed_(OutputIterator out, const char_type* first,
+                                       const char_type* last) const
+            {
+                while (first != last)
+                {
+                    if (*first == '&')
+                    {
+                        out = copy_(out, (*this)[0]);
+                        ++first;
+                    }
+                    else if (*first == '\\' && first + 1 != last)
+                    {
+                        auto c = *(first + 1);
+                        if (c >= '0' && c <= '9')
+                            out = copy_(out, (*this)[static_cast<size_type>(c - '0')]);
+                        else
+                            *out++ = c;
+                        first += 2;
+                    }
+                    else
+                        *out++ = *first++;
+                }
+
+                return out;
+            }
+
+            friend struct aux::regex_results_access;
+    };
+
+    using cmatch  = match_results<const char*>;
+    using wcmatch = match_results<const wchar_t*>;
+    using smatch  = match_results<string::const_iterator>;
+    using wsmatch = match_results<wstring::const_iterator>;
+
+    template<class BidirIt, class Allocator>
+    bool operator==(const match_results<BidirIt, Allocator>& lhs,
+                    const match_results<BidirIt, Allocator>& rhs)
+    {
+        if (!lhs.ready() && !rhs.ready())
+            return true;
+        if (lhs.ready() != rhs.ready() || lhs.empty() != rhs.empty())
+            return false;
+        if (lhs.empty())
+            return true;
+
+        return lhs.prefix() == rhs.prefix() && lhs.size() == rhs.size() &&
+               equal(lhs.begin(), lhs.end(), rhs.begin()) &&
+               lhs.suffix() == rhs.suffix();
+    }
+
+    template<class BidirIt, class Allocator>
+    bool operator!=(const match_results<BidirIt, Allocator>& lhs,
+                    const match_results<BidirIt, Allocator>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt, class Allocator>
+    void swap(match_results<BidirIt, Allocator>& lhs,
+              match_results<BidirIt, Allocator>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    namespace aux
+    {
+        /**
+         * Fills match results from the capture slots of the
+         * matching engines, a slot holds an iterator and
+         * a flag telling whether it has been set.
+         */
+        struct regex_results_access
+        {
+            template<class BidirIt, class Allocator, class Slots>
+            static void assign(match_results<BidirIt, Allocator>& m,
+                               BidirIt base, BidirIt first, BidirIt last,
+                               const Slots& slots, size_t groups)
+            {
+                m.subs_.resize(groups);
+                for (size_t i = 0; i < groups; ++i)
+                {
+                    auto& sub = m.subs_[i];
+                    const auto& open = slots[2 * i];
+                    const auto& close = slots[2 * i + 1];
+
+                    sub.matched = open.set && close.set;
+                    sub.first = sub.matched ? open.pos : last;
+                    sub.second = sub.matched ? close.pos : last;
+                }
+
+                m.prefix_.first = first;
+                m.prefix_.second = m.subs_[0].first;
+                m.prefix_.matched = m.prefix_.first != m.prefix_.second;
+
+                m.suffix_.first = m.subs_[0].second;
+                m.suffix_.second = last;
+                m.suffix_.matched = m.suffix_.first != m.suffix_.second;
+
+                m.unmatched_.first = last;
+                m.unmatched_.second = last;
+                m.unmatched_.matched = false;
+
+                m.base_ = base;
+                m.ready_ = true;
+            }
+
+            template<class BidirIt, class Allocator>
+            static void assign_failed(match_results<BidirIt, Allocator>& m,
+                                      BidirIt first, BidirIt last)
+            {
+                m.subs_.clear();
+                m.unmatched_.first = last;
+                m.unmatched_.second = last;
+                m.unmatched_.matched = false;
+                m.prefix_ = m.unmatched_;
+                m.suffix_ = m.unmatched_;
+                m.base_ = first;
+                m.ready_ = true;
+            }
+
+            template<class BidirIt, class Allocator>
+            static void rebase(match_results<BidirIt, Allocator>& m,
+                               BidirIt base, BidirIt prefix_first)
+            {
+                m.base_ = base;
+                m.prefix_.first = prefix_first;
+                m.prefix_.matched = m.prefix_.first != m.prefix_.second;
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_ALGORITHMS
+#define LIBCPP_BITS_REGEX_ALGORITHMS
+
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/match_results.hpp>
+#include <__bits/regex/regex_constants.hpp>
+#include <iterator>
+#include <string>
+
+namespace std
+{
+    /**
+     * 28.11.2, regex_match:
+     */
+
+    template<class BidirectionalIterator, class Allocator, class Char, class Traits>
+    bool regex_match(BidirectionalIterator first, BidirectionalIterator last,
+                     match_results<BidirectionalIterator, Allocator>& m,
+                     const basic_regex<Char, Traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_access::exec(first, last, &m, e, flags, true);
+    }
+
+    template<class BidirectionalIterator, class Char, class Traits>
+    bool regex_match(BidirectionalIterator first, BidirectionalIterator last,
+                     const basic_regex<Char, Traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        match_results<BidirectionalIterator>* m{nullptr};
+
+        return aux::regex_access::exec(first, last, m, e, flags, true);
+    }
+
+    template<class Char, class Allocator, class Traits>
+    bool regex_match(const Char* str, match_results<const Char*, Allocator>& m,
+                     const basic_regex<Char, Traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str, str + Traits::length(str), m, e, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class Char, class Traits>
+    bool regex_match(const basic_string<Char, ST, SA>& str,
+                     match_results<typename basic_string<Char, ST, SA>::const_iterator,
+                                   Allocator>& m,
+                     const basic_regex<Char, Traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str.begin(), str.end(), m, e, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class Char, class Traits>
+    bool regex_match(const basic_string<Char, ST, SA>&&,
+                     match_results<typename basic_string<Char, ST, SA>::const_iterator,
+                                   Allocator>&,
+                     const basic_regex<Char, Traits>&,
+                     regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+    template<class Char, class Traits>
+    bool regex_match(const Char* str, const basic_regex<Char, Traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str, str + Traits::length(str), e, flags);
+    }
+
+    template<class ST, class SA, class Char, class Traits>
+    bool regex_match(const basic_string<Char, ST, SA>& str,
+                     const basic_regex<Char, Traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str.begin(), str.end(), e, flags);
+    }
+
+    /**
+     * 28.11.3, regex_search:
+     */
+
+    template<class BidirectionalIterator, class Allocator, class Char, class Traits>
+    bool regex_search(BidirectionalIterator first, BidirectionalIterator last,
+                      match_results<BidirectionalIterator, Allocator>& m,
+                      const basic_regex<Char, Traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_access::exec(first, last, &m, e, flags, false);
+    }
+
+    template<class BidirectionalIterator, class Char, class Traits>
+    bool regex_search(BidirectionalIterator first, BidirectionalIterator last,
+                      const basic_regex<Char, Traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        match_results<BidirectionalIterator>* m{nullptr};
+
+        return aux::regex_access::exec(first, last, m, e, flags, false);
+    }
+
+    template<class Char, class Allocator, class Traits>
+    bool regex_search(const Char* str, match_results<const Char*, Allocator>& m,
+                      const basic_regex<Char, Traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str, str + Traits::length(str), m, e, flags);
+    }
+
+    template<class Char, class Traits>
+    bool regex_search(const Char* str, const basic_regex<Char, Traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str, str + Traits::length(str), e, flags);
+    }
+
+    template<class ST, class SA, class Char, class Traits>
+    bool regex_search(const basic_string<Char, ST, SA>& str,
+                      const basic_regex<Char, Traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str.begin(), str.end(), e, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class Char, class Traits>
+    bool regex_search(const basic_string<Char, ST, SA>& str,
+                      match_results<typename basic_string<Char, ST, SA>::const_iterator,
+                                    Allocator>& m,
+                      const basic_regex<Char, Traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str.begin(), str.end(), m, e, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class Char, class Traits>
+    bool regex_search(const basic_string<Char, ST, SA>&&,
+                      match_results<typename basic_string<Char, ST, SA>::const_iterator,
+                                    Allocator>&,
+                      const basic_regex<Char, Traits>&,
+                      regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+    namespace aux
+    {
+        /**
+         * Finds the next match after the previous one the way
+         * regex_iterator does, an empty match is retried as
+         * a non empty one at the same position first.
+         */
+        template<class BidirIt, class Char, class Traits>
+        bool regex_search_next(BidirIt last, BidirIt base,
+                               match_results<BidirIt>& m,
+                               const basic_regex<Char, Traits>& e,
+                               regex_constants::match_flag_type flags)
+        {
+            auto prev_end = m[0].second;
+            auto start = prev_end;
+            if (start != base)
+                flags |= regex_constants::match_prev_avail;
+
+            if (m[0].first == m[0].second)
+            {
+                if (start == last)
+                    return false;
+
+                if (regex_search(start, last, m, e, flags |
+                                 regex_constants::match_not_null |
+                                 regex_constants::match_continuous))
+                {
+                    regex_results_access::rebase(m, base, prev_end);
+
+                    return true;
+                }
+                ++start;
+                flags |= regex_constants::match_prev_avail;
+            }
+
+            if (!regex_search(start, last, m, e, flags))
+                return false;
+            regex_results_access::rebase(m, base, prev_end);
+
+            return true;
+        }
+    }
+
+    /**
+     * 28.11.4, regex_replace:
+     */
+
+    template<class OutputIterator, class BidirectionalIterator,
+             class Traits, class Char, class ST, class SA>
+    OutputIterator regex_replace(OutputIterator out,
+                                 BidirectionalIterator first, BidirectionalIterator last,
+                                 const basic_regex<Char, Traits>& e,
+                                 const basic_string<Char, ST, SA>& fmt,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_replace(out, first, last, e, fmt.c_str(), flags);
+    }
+
+    template<class OutputIterator, class BidirectionalIterator,
+             class Traits, class Char>
+    OutputIterator regex_replace(OutputIterator out,
+                                 BidirectionalIterator first, BidirectionalIterator last,
+                                 const basic_regex<Char, Traits>& e, const Char* fmt,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        auto fmt_last = fmt + char_traits<Char>::length(fmt);
+        bool copy_rest = !(flags & regex_constants::format_no_copy);
+        auto search_flags = flags & ~(regex_constants::format_first_only |
+                                      regex_constants::format_no_copy |
+                                      regex_constants::format_sed);
+
+        match_results<BidirectionalIterator> m{};
+        if (!regex_search(first, last, m, e, search_flags))
+        {
+            if (copy_rest)
+                out = copy(first, last, out);
+
+            return out;
+        }
+
+        BidirectionalIterator rest{};
+        while (true)
+        {
+            if (copy_rest)
+                out = copy(m.prefix().first, m.prefix().second, out);
+            out = m.format(out, fmt, fmt_last, flags);
+            rest = m[0].second;
+
+            if ((flags & regex_constants::format_first_only) ||
+                !aux::regex_search_next(last, first, m, e, search_flags))
+                break;
+        }
+
+        if (copy_rest)
+            out = copy(rest, last, out);
+
+        return out;
+    }
+
+    template<class Traits, class Char, class ST, class SA, class FST, class FSA>
+    basic_string<Char, ST, SA> regex_replace(const basic_string<Char, ST, SA>& str,
+                                             const basic_regex<Char, Traits>& e,
+                                             const basic_string<Char, FST, FSA>& fmt,
+                                             regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<Char, ST, SA> res{};
+        regex_replace(back_inserter(res), str.begin(), str.end(), e, fmt.c_str(), flags);
+
+        return res;
+    }
+
+    template<class Traits, class Char, class ST, class SA>
+    basic_string<Char, ST, SA> regex_replace(const basic_string<Char, ST, SA>& str,
+                                             const basic_regex<Char, Traits>& e,
+                                             const Char* fmt,
+                                             regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<Char, ST, SA> res{};
+        regex_replace(back_inserter(res), str.begin(), str.end(), e, fmt, flags);
+
+        return res;
+    }
+
+    template<class Traits, class Char, class ST, class SA>
+    basic_string<Char> regex_replace(const Char* str,
+                                     const basic_regex<Char, Traits>& e,
+                                     const basic_string<Char, ST, SA>& fmt,
+                                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<Char> res{};
+        regex_replace(back_inserter(res), str, str + char_traits<Char>::length(str),
+                      e, fmt.c_str(), flags);
+
+        return res;
+    }
+
+    template<class Traits, class Char>
+    basic_string<Char> regex_replace(const Char* str,
+                                     const basic_regex<Char, Traits>& e,
+                                     const Char* fmt,
+                                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<Char> res{};
+        regex_replace(back_inserter(res), str, str + char_traits<Char>::length(str),
+                      e, fmt, flags);
+
+        return res;
+    }
+}
+
+#endif
@@ -0,0 +1,1157 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_COMPILER
+#define LIBCPP_BITS_REGEX_COMPILER
+
+#include <__bits/regex/regex_constants.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace std::aux
+{
+    /**
+     * Patterns are compiled into a program for a Thompson/Pike
+     * style virtual machine. Every consuming instruction either
+     * matches a single character or fails, while the rest of them
+     * are epsilon moves. The same program is run by the lazily
+     * built DFA, the Pike VM and the backtracking matcher, see
+     * regex_engine.hpp.
+     */
+    enum class regex_op: uint8_t
+    {
+        character,       // matches c
+        any,             // matches anything but a line terminator
+        char_class,      // matches classes[x]
+        split,           // continues at x, then at y
+        jump,            // continues at x
+        save,            // stores the position into slot x
+        mark,            // stores the position into loop slot x
+        check,           // fails if the position equals loop slot x
+        assert_bol,
+        assert_eol,
+        assert_word,
+        assert_not_word,
+        backref,         // matches the text of group x again
+        lookahead,       // runs x...lookahead_end, continues at y
+        lookahead_not,
+        lookahead_end,
+        match
+    };
+
+    template<class Char>
+    struct regex_instruction
+    {
+        regex_op op;
+        Char c;
+        size_t x;
+        size_t y;
+    };
+
+    template<class Char, class Traits>
+    class regex_char_class
+    {
+        public:
+            using char_class_type = typename Traits::char_class_type;
+
+            regex_char_class()
+                : negated_{false}, singles_{}, ranges_{}, classes_{},
+                  negated_classes_{}, bits_{}
+            { /* DUMMY BODY */ }
+
+            void negate()
+            {
+                negated_ = true;
+            }
+
+            void add(Char c)
+            {
+                singles_.push_back(c);
+            }
+
+            void add_range(Char first, Char last)
+            {
+                ranges_.emplace_back(first, last);
+            }
+
+            void add_class(char_class_type cls, bool negated)
+            {
+                if (negated)
+                    negated_classes_.push_back(cls);
+                else
+                    classes_ |= cls;
+            }
+
+            /**
+             * Precomputes the result for all characters
+             * representable by a single byte, which are
+             * then matched by a single bit test.
+             */
+            void finalize(const Traits& traits, bool icase)
+            {
+                bool raw[table_size_]{};
+                bool folded[table_size_]{};
+                for (size_t i = 0; i < table_size_; ++i)
+                {
+                    raw[i] = contains_(static_cast<Char>(i), traits);
+                    if (icase)
+                        folded[index_(traits.translate_nocase(static_cast<Char>(i)))] |= raw[i];
+                }
+
+                for (size_t i = 0; i < table_size_; ++i)
+                {
+                    bool res = raw[i];
+                    if (icase)
+                        res = folded[index_(traits.translate_nocase(static_cast<Char>(i)))];
+
+                    if (res != negated_)
+                        bits_[i / 64] |= (uint64_t{1} << (i % 64));
+                }
+            }
+
+            bool matches(Char c, const Traits& traits) const
+            {
+                auto idx = index_(c);
+                if (idx < table_size_)
+                    return (bits_[idx / 64] >> (idx % 64)) & 1;
+                else
+                    return contains_(c, traits) != negated_;
+            }
+
+        private:
+            static constexpr size_t table_size_{
+                std::numeric_limits<make_unsigned_t<Char>>::max() < 255
+                ? static_cast<size_t>(std::numeric_limits<make_unsigned_t<Char>>::max()) + 1
+                : 256
+            };
+
+            bool negated_;
+            vector<Char> singles_;
+            vector<pair<Char, Char>> ranges_;
+            char_class_type classes_;
+            vector<char_class_type> negated_classes_;
+            uint64_t bits_[4];
+
+            static size_t index_(Char c)
+            {
+                return static_cast<size_t>(static_cast<make_unsigned_t<Char>>(c));
+            }
+
+            bool contains_(Char c, const Traits& traits) const
+            {
+                for (auto single: singles_)
+                {
+                    if (single == c)
+                        return true;
+                }
+
+                for (const auto& range: ranges_)
+                {
+                    if (range.first <= c && c <= range.second)
+                        return true;
+                }
+
+                if (classes_ && traits.isctype(c, classes_))
+                    return true;
+
+                for (auto cls: negated_classes_)
+                {
+                    if (!traits.isctype(c, cls))
+                        return true;
+                }
+
+                return false;
+            }
+    };
+
+    template<class Char, class Traits>
+    struct regex_program
+    {
+        vector<regex_instruction<Char>> code{};
+        vector<regex_char_class<Char, Traits>> classes{};
+
+        /**
+         * Group 0 is the whole match, the slots hold
+         * two positions for every group followed by
+         * one for each loop that can iterate without
+         * consuming anything.
+         */
+        size_t groups{1};
+        size_t slots{2};
+
+        /**
+         * Backreferences and lookaheads cannot be
+         * matched by the automata, so these programs
+         * always run on the backtracking matcher.
+         */
+        bool backtrack{false};
+
+        /**
+         * Programs without assertions do not need to
+         * know the characters around a position.
+         */
+        bool context{false};
+
+        /**
+         * If every match starts with the same character,
+         * unanchored searches skip to its occurrences.
+         */
+        bool has_first{false};
+        Char first{};
+
+        bool icase{false};
+        bool multiline{false};
+        Traits traits{};
+
+        Char translate(Char c) const
+        {
+            if (icase)
+                return traits.translate_nocase(c);
+            else
+                return traits.translate(c);
+        }
+
+        bool is_word(Char c) const
+        {
+            static const auto word = traits.lookup_classname("w", "w" + 1);
+
+            return traits.isctype(c, word);
+        }
+
+        static bool is_line_terminator(Char c)
+        {
+            return c == static_cast<Char>('\n') || c == static_cast<Char>('\r');
+        }
+    };
+
+    template<class Char, class Traits>
+    class regex_compiler
+    {
+        public:
+            using program_type    = regex_program<Char, Traits>;
+            using string_type     = basic_string<Char>;
+            using char_class_type = typename Traits::char_class_type;
+
+            regex_compiler(const Char* first, const Char* last,
+                           regex_constants::syntax_option_type flags,
+                           const Traits& traits)
+                : first_{first}, curr_{first}, last_{last},
+                  flags_{flags}, nodes_{}, prog_{}, max_backref_{},
+                  failed_{false}
+            {
+                prog_.traits = traits;
+                prog_.icase = (flags & regex_constants::icase) != 0;
+                prog_.multiline = (flags & regex_constants::multiline) != 0;
+                basic_ = (flags & (regex_constants::basic | regex_constants::grep)) != 0;
+            }
+
+            program_type compile()
+            {
+                auto root = parse_disjunction_();
+                if (curr_ != last_)
+                    error_(regex_constants::error_paren);
+                if (max_backref_ >= prog_.groups)
+                    error_(regex_constants::error_backref);
+                prog_.slots = 2 * prog_.groups;
+
+                if (!failed_)
+                {
+                    emit_(regex_op::save, 0);
+                    emit_node_(root);
+                    emit_(regex_op::save, 1);
+                    emit_(regex_op::match);
+                }
+
+                if (failed_)
+                    return program_type{};
+                find_first_();
+
+                return move(prog_);
+            }
+
+            size_t mark_count() const
+            {
+                return prog_.groups - 1;
+            }
+
+            bool failed() const
+            {
+                return failed_;
+            }
+
+        private:
+            enum class node_kind
+            {
+                empty, character, any, char_class, concat, alternation,
+                group, repeat, assertion, backref, lookahead
+            };
+
+            struct node
+            {
+                node_kind kind;
+                Char c{};
+                size_t value{};      // class, group, backref or assertion op
+                size_t min{};
+                size_t max{};
+                bool greedy{true};
+                bool negated{false};
+                vector<size_t> children{};
+            };
+
+            static constexpr size_t infinity_{std::numeric_limits<size_t>::max()};
+            static constexpr size_t max_code_size_{100000};
+
+            const Char* first_;
+            const Char* curr_;
+            const Char* last_;
+            regex_constants::syntax_option_type flags_;
+            bool basic_;
+            vector<node> nodes_;
+            program_type prog_;
+            size_t max_backref_;
+            bool failed_;
+
+            /**
+             * Note: Without exception support throw does not
+             *       leave the parser, so the rest of the pattern
+             *       is skipped and the regex will match nothing.
+             */
+            void error_(regex_constants::error_type code)
+            {
+                failed_ = true;
+                curr_ = last_;
+                throw regex_error{code};
+            }
+
+            size_t error_node_(regex_constants::error_type code)
+            {
+                error_(code);
+
+                return add_node_(node{node_kind::empty});
+            }
+
+            /**
+             * Parsing, builds a tree of nodes:
+             */
+
+            bool at_(char c) const
+            {
+                return curr_ != last_ && *curr_ == static_cast<Char>(c);
+            }
+
+            bool at_escaped_(char c) const
+            {
+                return curr_ != last_ && curr_ + 1 != last_ &&
+                       *curr_ == static_cast<Char>('\\') &&
+                       *(curr_ + 1) == static_cast<Char>(c);
+            }
+
+            /**
+             * Note: The basic grammars use escaped parentheses
+             *       and braces for groups and bounds, while their
+             *       plain forms stand for themselves.
+             */
+            bool at_special_(char c) const
+            {
+                if (basic_)
+                    return at_escaped_(c);
+                else
+                    return at_(c);
+            }
+
+            void skip_special_()
+            {
+                curr_ += basic_ ? 2 : 1;
+            }
+
+            size_t add_node_(node&& n)
+            {
+                nodes_.push_back(move(n));
+
+                return nodes_.size() - 1;
+            }
+
+            size_t parse_disjunction_()
+            {
+                vector<size_t> alternatives{};
+                alternatives.push_back(parse_alternative_());
+
+                while (at_alternation_())
+                {
+                    if (basic_ && !(flags_ & regex_constants::grep))
+                        skip_special_();
+                    else
+                        ++curr_;
+                    alternatives.push_back(parse_alternative_());
+                }
+
+                if (alternatives.size() == 1)
+                    return alternatives[0];
+
+                node n{node_kind::alternation};
+                n.children = move(alternatives);
+
+                return add_node_(move(n));
+            }
+
+            bool at_alternation_() const
+            {
+                if ((flags_ & (regex_constants::grep | regex_constants::egrep)) && at_('\n'))
+                    return true;
+                if (basic_)
+                    return !(flags_ & regex_constants::grep) && at_escaped_('|');
+                else
+                    return at_('|');
+            }
+
+            size_t parse_alternative_()
+            {
+                node n{node_kind::concat};
+                while (curr_ != last_ && !at_alternation_() && !at_special_(')'))
+                    n.children.push_back(parse_term_());
+
+                if (n.children.size() == 1)
+                    return n.children[0];
+
+                return add_node_(move(n));
+            }
+
+            size_t parse_term_()
+            {
+                if (at_('^') || at_('$'))
+                {
+                    node n{node_kind::assertion};
+                    n.value = static_cast<size_t>(
+                        at_('^') ? regex_op::assert_bol : regex_op::assert_eol
+                    );
+                    ++curr_;
+                    prog_.context = true;
+
+                    return add_node_(move(n));
+                }
+
+                if (!basic_ && (at_escaped_('b') || at_escaped_('B')))
+                {
+                    node n{node_kind::assertion};
+                    n.value = static_cast<size_t>(
+                        at_escaped_('b') ? regex_op::assert_word : regex_op::assert_not_word
+                    );
+                    curr_ += 2;
+                    prog_.context = true;
+
+                    return add_node_(move(n));
+                }
+
+                auto atom = parse_atom_();
+
+                return parse_quantifier_(atom);
+            }
+
+            size_t parse_atom_()
+            {
+                if (at_special_('('))
+                {
+                    skip_special_();
+
+                    node n{node_kind::group};
+                    if (!basic_ && at_('?'))
+                    {
+                        ++curr_;
+                        if (at_(':'))
+                            n.kind = node_kind::concat;
+                        else if (at_('=') || at_('!'))
+                        {
+                            n.kind = node_kind::lookahead;
+                            n.negated = at_('!');
+                            prog_.backtrack = true;
+                        }
+                        else
+                            return error_node_(regex_constants::error_paren);
+                        ++curr_;
+                    }
+                    else if (!(flags_ & regex_constants::nosubs))
+                        n.value = prog_.groups++;
+                    else
+                        n.kind = node_kind::concat;
+
+                    n.children.push_back(parse_disjunction_());
+                    if (!at_special_(')'))
+                        return error_node_(regex_constants::error_paren);
+                    skip_special_();
+
+                    return add_node_(move(n));
+                }
+
+                if (at_special_(')'))
+                    return error_node_(regex_constants::error_paren);
+                if (at_('*') || (!basic_ && (at_('+') || at_('?'))) || at_special_('{'))
+                    return error_node_(regex_constants::error_badrepeat);
+
+                if (at_('.'))
+                {
+                    ++curr_;
+
+                    return add_node_(node{node_kind::any});
+                }
+
+                if (at_('['))
+                {
+                    ++curr_;
+
+                    return parse_bracket_();
+                }
+
+                if (at_('\\'))
+                {
+                    ++curr_;
+                    if (curr_ == last_)
+                        return error_node_(regex_constants::error_escape);
+
+                    return parse_atom_escape_();
+                }
+
+                node n{node_kind::character};
+                n.c = *curr_++;
+
+                return add_node_(move(n));
+            }
+
+            size_t parse_atom_escape_()
+            {
+                auto c = *curr_;
+                if (is_digit_(c) && c != static_cast<Char>('0'))
+                {
+                    size_t group{};
+                    while (curr_ != last_ && is_digit_(*curr_))
+                        group = group * 10 + static_cast<size_t>(*curr_++ - static_cast<Char>('0'));
+
+                    if (group > max_backref_)
+                        max_backref_ = group;
+                    prog_.backtrack = true;
+
+                    node n{node_kind::backref};
+                    n.value = group;
+
+                    return add_node_(move(n));
+                }
+
+                char_class_type cls{};
+                bool negated{};
+                if (!basic_ && parse_class_escape_(cls, negated))
+                {
+                    regex_char_class<Char, Traits> char_class{};
+                    char_class.add_class(cls, negated);
+
+                    return add_class_node_(move(char_class));
+                }
+
+                node n{node_kind::character};
+                n.c = parse_character_escape_();
+
+                return add_node_(move(n));
+            }
+
+            bool parse_class_escape_(char_class_type& cls, bool& negated)
+            {
+                static constexpr const char* names = "dDsSwW";
+
+                for (const char* name = names; *name != '\0'; ++name)
+                {
+                    if (*curr_ != static_cast<Char>(*name))
+                        continue;
+
+                    Char lower = static_cast<Char>(*name | 0x20);
+                    cls = prog_.traits.lookup_classname(&lower, &lower + 1);
+                    negated = *curr_ != lower;
+                    ++curr_;
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            Char parse_character_escape_()
+            {
+                auto c = *curr_++;
+                switch (static_cast<char>(c))
+                {
+                    case 'f':
+                        return static_cast<Char>('\f');
+                    case 'n':
+                        return static_cast<Char>('\n');
+                    case 'r':
+                        return static_cast<Char>('\r');
+                    case 't':
+                        return static_cast<Char>('\t');
+                    case 'v':
+                        return static_cast<Char>('\v');
+                    case '0':
+                        if (curr_ != last_ && is_digit_(*curr_))
+                            error_(regex_constants::error_escape);
+                        return Char{};
+                    case 'c':
+                        if (curr_ == last_ || !prog_.traits.isctype(*curr_,
+                                prog_.traits.lookup_classname("alpha", "alpha" + 5)))
+                        {
+                            error_(regex_constants::error_escape);
+
+                            return Char{};
+                        }
+                        return static_cast<Char>(*curr_++ % 32);
+                    case 'x':
+                        return parse_hex_(2);
+                    case 'u':
+                        return parse_hex_(4);
+                    default:
+                        break;
+                }
+
+                /**
+                 * Note: ECMAScript only allows identity escapes
+                 *       of characters that cannot start a name.
+                 */
+                if (!basic_ && static_cast<char>(c) == c &&
+                    prog_.traits.isctype(c, prog_.traits.lookup_classname("w", "w" + 1)))
+                    error_(regex_constants::error_escape);
+
+                return c;
+            }
+
+            Char parse_hex_(size_t digits)
+            {
+                unsigned long res{};
+                for (size_t i = 0; i < digits; ++i)
+                {
+                    int val = curr_ != last_ ? prog_.traits.value(*curr_++, 16) : -1;
+                    if (val < 0)
+                    {
+                        error_(regex_constants::error_escape);
+
+                        return Char{};
+                    }
+                    res = res * 16 + static_cast<unsigned long>(val);
+                }
+
+                return static_cast<Char>(res);
+            }
+
+            size_t parse_bracket_()
+            {
+                regex_char_class<Char, Traits> cls{};
+                if (at_('^'))
+                {
+                    cls.negate();
+                    ++curr_;
+                }
+
+                /**
+                 * Note: In the POSIX grammars a closing bracket
+                 *       right after the opening one is literal.
+                 */
+                bool first = basic_ || (flags_ & (regex_constants::extended | regex_constants::egrep
+                                                  | regex_constants::awk));
+                while (true)
+                {
+                    if (curr_ == last_)
+                        return error_node_(regex_constants::error_brack);
+                    if (at_(']') && !first)
+                        break;
+                    first = false;
+
+                    Char lo{};
+                    if (!parse_class_atom_(cls, lo))
+                        continue;
+
+                    if (at_('-') && curr_ + 1 != last_ &&
+                        *(curr_ + 1) != static_cast<Char>(']'))
+                    {
+                        ++curr_;
+
+                        Char hi{};
+                        if (!parse_class_atom_(cls, hi) || hi < lo)
+                            return error_node_(regex_constants::error_range);
+
+                        cls.add_range(lo, hi);
+                    }
+                    else
+                        cls.add(lo);
+                }
+                ++curr_;
+
+                return add_class_node_(move(cls));
+            }
+
+            /**
+             * Returns false if the parsed atom was a whole
+             * class, which cannot be an end of a range.
+             */
+            bool parse_class_atom_(regex_char_class<Char, Traits>& cls, Char& c)
+            {
+                if (at_('[') && curr_ + 1 != last_)
+                {
+                    auto kind = *(curr_ + 1);
+                    if (kind == static_cast<Char>(':') || kind == static_cast<Char>('.') ||
+                        kind == static_cast<Char>('='))
+                    {
+                        curr_ += 2;
+                        auto name = curr_;
+                        while (curr_ != last_ && !(*curr_ == kind && curr_ + 1 != last_ &&
+                               *(curr_ + 1) == static_cast<Char>(']')))
+                            ++curr_;
+                        if (curr_ == last_)
+                        {
+                            error_(regex_constants::error_brack);
+
+                            return false;
+                        }
+                        auto name_end = curr_;
+                        curr_ += 2;
+
+                        if (kind == static_cast<Char>(':'))
+                        {
+                            auto res = prog_.traits.lookup_classname(
+                                name, name_end, prog_.icase
+                            );
+                            if (!res)
+                                error_(regex_constants::error_ctype);
+                            cls.add_class(res, false);
+
+                            return false;
+                        }
+
+                        auto elem = prog_.traits.lookup_collatename(name, name_end);
+                        if (elem.size() != 1)
+                        {
+                            error_(regex_constants::error_collate);
+
+                            return false;
+                        }
+                        c = elem[0];
+
+                        return true;
+                    }
+                }
+
+                if (at_('\\') && !basic_)
+                {
+                    ++curr_;
+                    if (curr_ == last_)
+                    {
+                        error_(regex_constants::error_escape);
+
+                        return false;
+                    }
+
+                    char_class_type res{};
+                    bool negated{};
+                    if (parse_class_escape_(res, negated))
+                    {
+                        cls.add_class(res, negated);
+
+                        return false;
+                    }
+
+                    if (at_('b'))
+                    {
+                        ++curr_;
+                        c = static_cast<Char>('\b');
+                    }
+                    else if (at_('-'))
+                    {
+                        ++curr_;
+                        c = static_cast<Char>('-');
+                    }
+                    else
+                        c = parse_character_escape_();
+
+                    return true;
+                }
+
+                c = *curr_++;
+
+                return true;
+            }
+
+            size_t add_class_node_(regex_char_class<Char, Traits>&& cls)
+            {
+                cls.finalize(prog_.traits, prog_.icase);
+                prog_.classes.push_back(move(cls));
+
+                node n{node_kind::char_class};
+                n.value = prog_.classes.size() - 1;
+
+                return add_node_(move(n));
+            }
+
+            size_t parse_quantifier_(size_t atom)
+            {
+                bool ecma = (flags_ & regex_constants::ECMAScript) || !(flags_ & ~(
+                    regex_constants::icase | regex_constants::nosubs |
+                    regex_constants::optimize | regex_constants::collate |
+                    regex_constants::multiline));
+
+                while (curr_ != last_)
+                {
+                    size_t min{}, max{};
+                    if (at_('*'))
+                    {
+                        ++curr_;
+                        min = 0;
+                        max = infinity_;
+                    }
+                    else if (!basic_ && at_('+'))
+                    {
+                        ++curr_;
+                        min = 1;
+                        max = infinity_;
+                    }
+                    else if (!basic_ && at_('?'))
+                    {
+                        ++curr_;
+                        min = 0;
+                        max = 1;
+                    }
+                    else if (at_special_('{'))
+                    {
+                        skip_special_();
+                        parse_bounds_(min, max);
+                    }
+                    else
+                        break;
+
+                    bool greedy{true};
+                    if (ecma && at_('?'))
+                    {
+                        ++curr_;
+                        greedy = false;
+                    }
+
+                    auto kind = nodes_[atom].kind;
+                    if (kind == node_kind::assertion)
+                        error_(regex_constants::error_badrepeat);
+
+                    node n{node_kind::repeat};
+                    n.min = min;
+                    n.max = max;
+                    n.greedy = greedy;
+                    n.children.push_back(atom);
+                    atom = add_node_(move(n));
+
+                    /**
+                     * Note: ECMAScript does not allow a quantifier
+                     *       to follow another one, the next one will
+                     *       be reported as nothing to repeat.
+                     */
+                    if (ecma)
+                        break;
+                }
+
+                return atom;
+            }
+
+            void parse_bounds_(size_t& min, size_t& max)
+            {
+                if (curr_ == last_ || !is_digit_(*curr_))
+                    return error_(regex_constants::error_badbrace);
+                min = parse_number_();
+                max = min;
+
+                if (at_(','))
+                {
+                    ++curr_;
+                    if (curr_ != last_ && is_digit_(*curr_))
+                        max = parse_number_();
+                    else
+                        max = infinity_;
+                }
+
+                if (!at_special_('}'))
+                {
+                    if (curr_ == last_)
+                        return error_(regex_constants::error_brace);
+                    else
+                        return error_(regex_constants::error_badbrace);
+                }
+                skip_special_();
+
+                if (max < min)
+                    error_(regex_constants::error_badbrace);
+            }
+
+            size_t parse_number_()
+            {
+                size_t res{};
+                while (curr_ != last_ && is_digit_(*curr_))
+                {
+                    res = res * 10 + static_cast<size_t>(*curr_++ - static_cast<Char>('0'));
+                    if (res > max_code_size_)
+                        error_(regex_constants::error_badbrace);
+                }
+
+                return res;
+            }
+
+            static bool is_digit_(Char c)
+            {
+                return c >= static_cast<Char>('0') && c <= static_cast<Char>('9');
+            }
+
+            /**
+             * Code generation:
+             */
+
+            size_t emit_(regex_op op, size_t x = 0, size_t y = 0, Char c = Char{})
+            {
+                if (prog_.code.size() >= max_code_size_ && !failed_)
+                    error_(regex_constants::error_complexity);
+
+                prog_.code.push_back(regex_instruction<Char>{op, c, x, y});
+
+                return prog_.code.size() - 1;
+            }
+
+            size_t here_() const
+            {
+                return prog_.code.size();
+            }
+
+            bool nullable_(size_t idx) const
+            {
+                const auto& n = nodes_[idx];
+                switch (n.kind)
+                {
+                    case node_kind::character:
+                    case node_kind::any:
+                    case node_kind::char_class:
+                        return false;
+                    case node_kind::concat:
+                        for (auto child: n.children)
+                        {
+                            if (!nullable_(child))
+                                return false;
+                        }
+                        return true;
+                    case node_kind::alternation:
+                        for (auto child: n.children)
+                        {
+                            if (nullable_(child))
+                                return true;
+                        }
+                        return false;
+                    case node_kind::group:
+                        return nullable_(n.children[0]);
+                    case node_kind::repeat:
+                        return n.min == 0 || nullable_(n.children[0]);
+                    default:
+                        return true;
+                }
+            }
+
+            void emit_node_(size_t idx)
+            {
+                /**
+                 * Note: The node vector can grow during emission
+                 *       of nested nodes, so we do not keep references.
+                 */
+                if (failed_)
+                    return;
+
+                auto kind = nodes_[idx].kind;
+                switch (kind)
+                {
+                    case node_kind::empty:
+                        break;
+                    case node_kind::character:
+                        emit_(regex_op::character, 0, 0, prog_.translate(nodes_[idx].c));
+                        break;
+                    case node_kind::any:
+                        emit_(regex_op::any);
+                        break;
+                    case node_kind::char_class:
+                        emit_(regex_op::char_class, nodes_[idx].value);
+                        break;
+                    case node_kind::concat:
+                        for (size_t i = 0; i < nodes_[idx].children.size(); ++i)
+                            emit_node_(nodes_[idx].children[i]);
+                        break;
+                    case node_kind::alternation:
+                        emit_alternation_(idx);
+                        break;
+                    case node_kind::group:
+                        emit_(regex_op::save, 2 * nodes_[idx].value);
+                        emit_node_(nodes_[idx].children[0]);
+                        emit_(regex_op::save, 2 * nodes_[idx].value + 1);
+                        break;
+                    case node_kind::repeat:
+                        emit_repeat_(idx);
+                        break;
+                    case node_kind::assertion:
+                        emit_(static_cast<regex_op>(nodes_[idx].value));
+                        break;
+                    case node_kind::backref:
+                        emit_(regex_op::backref, nodes_[idx].value);
+                        break;
+                    case node_kind::lookahead:
+                    {
+                        auto op = nodes_[idx].negated ? regex_op::lookahead_not
+                                                      : regex_op::lookahead;
+                        auto look = emit_(op);
+                        prog_.code[look].x = here_();
+                        emit_node_(nodes_[idx].children[0]);
+                        emit_(regex_op::lookahead_end);
+                        prog_.code[look].y = here_();
+                        break;
+                    }
+                }
+            }
+
+            void emit_alternation_(size_t idx)
+            {
+                vector<size_t> jumps{};
+                auto count = nodes_[idx].children.size();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (i + 1 < count)
+                    {
+                        auto split = emit_(regex_op::split);
+                        prog_.code[split].x = here_();
+                        emit_node_(nodes_[idx].children[i]);
+                        jumps.push_back(emit_(regex_op::jump));
+                        prog_.code[split].y = here_();
+                    }
+                    else
+                        emit_node_(nodes_[idx].children[i]);
+                }
+
+                for (auto jump: jumps)
+                    prog_.code[jump].x = here_();
+            }
+
+            /**
+             * Branches the other way for lazy quantifiers,
+             * the Pike VM and the backtracker both try x
+             * before y.
+             */
+            size_t emit_split_(bool greedy)
+            {
+                auto split = emit_(regex_op::split);
+                if (greedy)
+                    prog_.code[split].x = split + 1;
+                else
+                    prog_.code[split].y = split + 1;
+
+                return split;
+            }
+
+            void patch_split_exit_(size_t split, bool greedy)
+            {
+                if (greedy)
+                    prog_.code[split].y = here_();
+                else
+                    prog_.code[split].x = here_();
+            }
+
+            void emit_repeat_(size_t idx)
+            {
+                auto child = nodes_[idx].children[0];
+                auto min = nodes_[idx].min;
+                auto max = nodes_[idx].max;
+                auto greedy = nodes_[idx].greedy;
+
+                for (size_t i = 0; i < min; ++i)
+                    emit_node_(child);
+
+                if (max == infinity_)
+                {
+                    /**
+                     * Iterations that consume nothing would loop
+                     * forever in the backtracker, so nullable loop
+                     * bodies record where they started and fail
+                     * if they did not move.
+                     */
+                    bool guard = nullable_(child);
+                    size_t slot = prog_.slots;
+                    if (guard)
+                        ++prog_.slots;
+
+                    auto split = emit_split_(greedy);
+                    if (guard)
+                        emit_(regex_op::mark, slot);
+                    emit_node_(child);
+                    if (guard)
+                        emit_(regex_op::check, slot);
+                    emit_(regex_op::jump, split);
+                    patch_split_exit_(split, greedy);
+
+                    return;
+                }
+
+                vector<size_t> splits{};
+                for (size_t i = min; i < max; ++i)
+                {
+                    splits.push_back(emit_split_(greedy));
+                    emit_node_(child);
+                }
+
+                for (auto split: splits)
+                    patch_split_exit_(split, greedy);
+            }
+
+            /**
+             * Finds the character every match has to start
+             * with, if there is one.
+             */
+            void find_first_()
+            {
+                size_t pc{};
+                while (pc < prog_.code.size())
+                {
+                    const auto& instr = prog_.code[pc];
+                    if (instr.op == regex_op::save || instr.op == regex_op::mark)
+                        ++pc;
+                    else if (instr.op == regex_op::jump)
+                        pc = instr.x;
+                    else
+                        break;
+                }
+
+                if (pc < prog_.code.size() && prog_.code[pc].op == regex_op::character &&
+                    !prog_.icase)
+                {
+                    prog_.has_first = true;
+                    prog_.first = prog_.code[pc].c;
+                }
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,998 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_ENGINE
+#define LIBCPP_BITS_REGEX_ENGINE
+
+#include <__bits/regex/match_results.hpp>
+#include <__bits/regex/regex_compiler.hpp>
+#include <__bits/regex/regex_constants.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <vector>
+
+namespace std::aux
+{
+    template<class BidirIt>
+    struct regex_slot
+    {
+        BidirIt pos{};
+        bool set{false};
+    };
+
+    /**
+     * Evaluates assertions at a position of the target
+     * sequence, shared by the Pike VM and the backtracker.
+     */
+    template<class BidirIt, class Char, class Traits>
+    class regex_context
+    {
+        public:
+            using program_type = regex_program<Char, Traits>;
+
+            regex_context(const program_type& prog, BidirIt first,
+                          BidirIt last, regex_constants::match_flag_type flags)
+                : prog_{prog}, first_{first}, last_{last}, flags_{flags}
+            { /* DUMMY BODY */ }
+
+            bool holds(regex_op op, BidirIt pos) const
+            {
+                switch (op)
+                {
+                    case regex_op::assert_bol:
+                        return at_bol_(pos);
+                    case regex_op::assert_eol:
+                        return at_eol_(pos);
+                    case regex_op::assert_word:
+                        return at_boundary_(pos);
+                    case regex_op::assert_not_word:
+                        return !at_boundary_(pos);
+                    default:
+                        return true;
+                }
+            }
+
+            bool consumes(const regex_instruction<Char>& instr, BidirIt pos) const
+            {
+                if (pos == last_)
+                    return false;
+
+                switch (instr.op)
+                {
+                    case regex_op::character:
+                        return prog_.translate(*pos) == instr.c;
+                    case regex_op::any:
+                        return !program_type::is_line_terminator(*pos);
+                    case regex_op::char_class:
+                        return prog_.classes[instr.x].matches(*pos, prog_.traits);
+                    default:
+                        return false;
+                }
+            }
+
+            const program_type& program() const
+            {
+                return prog_;
+            }
+
+            BidirIt first() const
+            {
+                return first_;
+            }
+
+            BidirIt last() const
+            {
+                return last_;
+            }
+
+            regex_constants::match_flag_type flags() const
+            {
+                return flags_;
+            }
+
+        private:
+            const program_type& prog_;
+            BidirIt first_;
+            BidirIt last_;
+            regex_constants::match_flag_type flags_;
+
+            bool prev_avail_() const
+            {
+                return (flags_ & regex_constants::match_prev_avail) != 0;
+            }
+
+            bool at_bol_(BidirIt pos) const
+            {
+                if (pos == first_ && !prev_avail_())
+                    return !(flags_ & regex_constants::match_not_bol);
+
+                return prog_.multiline &&
+                       program_type::is_line_terminator(*prev(pos));
+            }
+
+            bool at_eol_(BidirIt pos) const
+            {
+                if (pos == last_)
+                    return !(flags_ & regex_constants::match_not_eol);
+
+                return prog_.multiline && program_type::is_line_terminator(*pos);
+            }
+
+            bool at_boundary_(BidirIt pos) const
+            {
+                bool prev_word{false};
+                if (pos != first_ || prev_avail_())
+                    prev_word = prog_.is_word(*prev(pos));
+                bool next_word = pos != last_ && prog_.is_word(*pos);
+
+                if (pos == first_ && !prev_avail_() &&
+                    (flags_ & regex_constants::match_not_bow))
+                    return false;
+                if (pos == last_ && (flags_ & regex_constants::match_not_eow))
+                    return false;
+
+                return prev_word != next_word;
+            }
+    };
+
+    /**
+     * Simulates the program on all threads at once, keeping
+     * them ordered by priority, so the leftmost match preferred
+     * by the ECMAScript backtracking semantics is found in
+     * a single pass over the input.
+     */
+    template<class BidirIt, class Char, class Traits>
+    class regex_pike_vm
+    {
+        public:
+            using context_type = regex_context<BidirIt, Char, Traits>;
+            using slot_type    = regex_slot<BidirIt>;
+
+            explicit regex_pike_vm(const context_type& ctx)
+                : ctx_{ctx}, code_{ctx.program().code},
+                  slots_{ctx.program().slots}, working_(slots_),
+                  clist_{code_.size(), slots_}, nlist_{code_.size(), slots_},
+                  stack_{}
+            { /* DUMMY BODY */ }
+
+            bool run(bool anchored, bool full, vector<slot_type>& result)
+            {
+                const auto& prog = ctx_.program();
+                auto pos = ctx_.first();
+                auto last = ctx_.last();
+                bool matched{false};
+                bool not_null = (ctx_.flags() & regex_constants::match_not_null) != 0;
+
+                clist_.clear();
+                while (true)
+                {
+                    if (!matched && (!anchored || pos == ctx_.first()))
+                    {
+                        if (prog.has_first && !anchored && clist_.empty())
+                        {
+                            pos = find(pos, last, prog.first);
+                            if (pos == last)
+                                break;
+                        }
+
+                        for (auto& slot: working_)
+                            slot = slot_type{};
+                        add_(clist_, 0, pos);
+                    }
+
+                    if (clist_.empty() && (matched || anchored))
+                        break;
+
+                    nlist_.clear();
+                    BidirIt next_pos = pos;
+                    if (pos != last)
+                        ++next_pos;
+
+                    for (size_t i = 0; i < clist_.size(); ++i)
+                    {
+                        auto pc = clist_.pc(i);
+                        const auto& instr = code_[pc];
+                        if (instr.op == regex_op::match)
+                        {
+                            if (full && pos != last)
+                                continue;
+
+                            auto caps = clist_.slots(i);
+                            if (not_null && caps[0].pos == pos)
+                                continue;
+
+                            result.assign(caps, caps + slots_);
+                            matched = true;
+
+                            /**
+                             * Threads of lower priority cannot
+                             * produce the preferred match.
+                             */
+                            break;
+                        }
+
+                        if (ctx_.consumes(instr, pos))
+                        {
+                            copy(clist_.slots(i), clist_.slots(i) + slots_, working_.begin());
+                            add_(nlist_, pc + 1, next_pos);
+                        }
+                    }
+
+                    if (pos == last)
+                        break;
+
+                    swap(clist_, nlist_);
+                    pos = next_pos;
+                }
+
+                return matched;
+            }
+
+        private:
+            class thread_list
+            {
+                public:
+                    thread_list(size_t size, size_t slots)
+                        : pcs_{}, stamps_(size), stamp_{1},
+                          slots_(size * slots), width_{slots}
+                    {
+                        pcs_.reserve(size);
+                    }
+
+                    void clear()
+                    {
+                        pcs_.clear();
+                        ++stamp_;
+                    }
+
+                    bool empty() const
+                    {
+                        return pcs_.empty();
+                    }
+
+                    size_t size() const
+                    {
+                        return pcs_.size();
+                    }
+
+                    size_t pc(size_t idx) const
+                    {
+                        return pcs_[idx];
+                    }
+
+                    slot_type* slots(size_t idx)
+                    {
+                        return slots_.data() + idx * width_;
+                    }
+
+                    bool visit(size_t pc)
+                    {
+                        if (stamps_[pc] == stamp_)
+                            return false;
+                        stamps_[pc] = stamp_;
+
+                        return true;
+                    }
+
+                    void push(size_t pc, const vector<slot_type>& caps)
+                    {
+                        copy(caps.begin(), caps.end(), slots(pcs_.size()));
+                        pcs_.push_back(pc);
+                    }
+
+                private:
+                    vector<size_t> pcs_;
+                    vector<size_t> stamps_;
+                    size_t stamp_;
+                    vector<slot_type> slots_;
+                    size_t width_;
+            };
+
+            struct frame
+            {
+                size_t pc;
+                size_t slot;
+                slot_type old;
+                bool restore;
+            };
+
+            const context_type& ctx_;
+            const vector<regex_instruction<Char>>& code_;
+            size_t slots_;
+            vector<slot_type> working_;
+            thread_list clist_;
+            thread_list nlist_;
+            vector<frame> stack_;
+
+            /**
+             * Follows the epsilon moves from pc and adds the
+             * reached consuming instructions to the list, in
+             * the order of their priority. The explicit stack
+             * also undoes the slot changes made on a branch
+             * once it is done.
+             */
+            void add_(thread_list& list, size_t pc, BidirIt pos)
+            {
+                stack_.clear();
+                stack_.push_back(frame{pc, 0, slot_type{}, false});
+
+                while (!stack_.empty())
+                {
+                    auto fr = stack_.back();
+                    stack_.pop_back();
+                    if (fr.restore)
+                    {
+                        working_[fr.slot] = fr.old;
+                        continue;
+                    }
+
+                    pc = fr.pc;
+                    while (list.visit(pc))
+                    {
+                        const auto& instr = code_[pc];
+                        bool next{true};
+                        switch (instr.op)
+                        {
+                            case regex_op::jump:
+                                pc = instr.x;
+                                continue;
+                            case regex_op::split:
+                                stack_.push_back(frame{instr.y, 0, slot_type{}, false});
+                                pc = instr.x;
+                                continue;
+                            case regex_op::save:
+                            case regex_op::mark:
+                                stack_.push_back(frame{0, instr.x, working_[instr.x], true});
+                                working_[instr.x] = slot_type{pos, true};
+                                break;
+                            case regex_op::check:
+                                next = !(working_[instr.x].set && working_[instr.x].pos == pos);
+                                break;
+                            case regex_op::assert_bol:
+                            case regex_op::assert_eol:
+                            case regex_op::assert_word:
+                            case regex_op::assert_not_word:
+                                next = ctx_.holds(instr.op, pos);
+                                break;
+                            default:
+                                list.push(pc, working_);
+                                next = false;
+                                break;
+                        }
+
+                        if (!next)
+                            break;
+                        ++pc;
+                    }
+                }
+            }
+    };
+
+    /**
+     * Depth first search over the program, used only for
+     * programs with backreferences or lookaheads, which
+     * cannot be simulated by the automata.
+     */
+    template<class BidirIt, class Char, class Traits>
+    class regex_backtracker
+    {
+        public:
+            using context_type = regex_context<BidirIt, Char, Traits>;
+            using slot_type    = regex_slot<BidirIt>;
+
+            explicit regex_backtracker(const context_type& ctx)
+                : ctx_{ctx}, code_{ctx.program().code},
+                  caps_(ctx.program().slots)
+            { /* DUMMY BODY */ }
+
+            bool run(bool anchored, bool full, vector<slot_type>& result)
+            {
+                const auto& prog = ctx_.program();
+                auto pos = ctx_.first();
+                auto last = ctx_.last();
+
+                while (true)
+                {
+                    if (prog.has_first && !anchored)
+                    {
+                        pos = find(pos, last, prog.first);
+                        if (pos == last)
+                            return false;
+                    }
+
+                    for (auto& slot: caps_)
+                        slot = slot_type{};
+
+                    if (match_(0, pos, full, false))
+                    {
+                        result = caps_;
+
+                        return true;
+                    }
+
+                    if (anchored || pos == last)
+                        return false;
+                    ++pos;
+                }
+            }
+
+        private:
+            struct frame
+            {
+                size_t pc;
+                BidirIt pos;
+                size_t slot;
+                slot_type old;
+                bool restore;
+            };
+
+            const context_type& ctx_;
+            const vector<regex_instruction<Char>>& code_;
+            vector<slot_type> caps_;
+
+            bool match_(size_t start_pc, BidirIt start, bool full, bool lookahead)
+            {
+                vector<frame> stack{};
+                stack.push_back(frame{start_pc, start, 0, slot_type{}, false});
+
+                auto last = ctx_.last();
+                bool not_null = (ctx_.flags() & regex_constants::match_not_null) != 0;
+
+                while (!stack.empty())
+                {
+                    auto fr = stack.back();
+                    stack.pop_back();
+                    if (fr.restore)
+                    {
+                        caps_[fr.slot] = fr.old;
+                        continue;
+                    }
+
+                    auto pc = fr.pc;
+                    auto pos = fr.pos;
+                    bool failed{false};
+                    while (!failed)
+                    {
+                        const auto& instr = code_[pc];
+                        switch (instr.op)
+                        {
+                            case regex_op::character:
+                            case regex_op::any:
+                            case regex_op::char_class:
+                                if (ctx_.consumes(instr, pos))
+                                {
+                                    ++pos;
+                                    ++pc;
+                                }
+                                else
+                                    failed = true;
+                                break;
+                            case regex_op::jump:
+                                pc = instr.x;
+                                break;
+                            case regex_op::split:
+                                stack.push_back(frame{instr.y, pos, 0, slot_type{}, false});
+                                pc = instr.x;
+                                break;
+                            case regex_op::save:
+                            case regex_op::mark:
+                                stack.push_back(frame{0, pos, instr.x, caps_[instr.x], true});
+                                caps_[instr.x] = slot_type{pos, true};
+                                ++pc;
+                                break;
+                            case regex_op::check:
+                                if (caps_[instr.x].set && caps_[instr.x].pos == pos)
+                                    failed = true;
+                                else
+                                    ++pc;
+                                break;
+                            case regex_op::assert_bol:
+                            case regex_op::assert_eol:
+                            case regex_op::assert_word:
+                            case regex_op::assert_not_word:
+                                if (ctx_.holds(instr.op, pos))
+                                    ++pc;
+                                else
+                                    failed = true;
+                                break;
+                            case regex_op::backref:
+                                failed = !backref_(instr.x, pos);
+                                if (!failed)
+                                    ++pc;
+                                break;
+                            case regex_op::lookahead:
+                            case regex_op::lookahead_not:
+                                failed = !lookahead_(instr, pos, stack);
+                                if (!failed)
+                                    pc = instr.y;
+                                break;
+                            case regex_op::lookahead_end:
+                                if (lookahead)
+                                    return true;
+                                ++pc;
+                                break;
+                            case regex_op::match:
+                                if ((full && pos != last) || (not_null && caps_[0].pos == pos))
+                                    failed = true;
+                                else
+                                    return true;
+                                break;
+                        }
+                    }
+                }
+
+                return false;
+            }
+
+            bool backref_(size_t group, BidirIt& pos)
+            {
+                const auto& open = caps_[2 * group];
+                const auto& close = caps_[2 * group + 1];
+                if (!open.set || !close.set)
+                    return true;
+
+                const auto& prog = ctx_.program();
+                auto last = ctx_.last();
+                auto curr = pos;
+                for (auto it = open.pos; it != close.pos; ++it, ++curr)
+                {
+                    if (curr == last || prog.translate(*it) != prog.translate(*curr))
+                        return false;
+                }
+                pos = curr;
+
+                return true;
+            }
+
+            /**
+             * Note: Captures made inside a positive lookahead
+             *       are kept, so their old values are pushed
+             *       to the outer stack to be restored when
+             *       the outer search backtracks.
+             */
+            bool lookahead_(const regex_instruction<Char>& instr, BidirIt pos,
+                            vector<frame>& stack)
+            {
+                auto saved = caps_;
+                bool res = match_(instr.x, pos, false, true);
+
+                if (instr.op == regex_op::lookahead_not)
+                {
+                    caps_ = move(saved);
+
+                    return !res;
+                }
+
+                if (!res)
+                {
+                    caps_ = move(saved);
+
+                    return false;
+                }
+
+                for (size_t i = 0; i < caps_.size(); ++i)
+                {
+                    if (caps_[i].set != saved[i].set || caps_[i].pos != saved[i].pos)
+                        stack.push_back(frame{0, pos, i, saved[i], true});
+                }
+
+                return true;
+            }
+    };
+
+    /**
+     * Lazily built DFA over the sets of program counters the
+     * Pike VM would be at. States are created only when the
+     * input reaches them, so the construction never blows up
+     * and every input character costs a single table lookup
+     * once the states it visits have been built.
+     * Assertions depend on the characters around a position,
+     * so a state also remembers whether the previous character
+     * started a line or was a word character, and a transition
+     * on a character tells whether a match ended right before it.
+     * Note: This only answers whether there is a match, the
+     *       positions of the match and its groups are left
+     *       to the Pike VM.
+     */
+    template<class Char, class Traits>
+    class regex_dfa
+    {
+        public:
+            using program_type = regex_program<Char, Traits>;
+
+            regex_dfa(const program_type& prog, bool anchored)
+                : prog_{prog}, anchored_{anchored}, states_{}, table_{},
+                  index_{}, stamps_(prog.code.size()), stamp_{},
+                  stack_{}, closure_{}, flushed_{false}
+            { /* DUMMY BODY */ }
+
+            /**
+             * Besides telling whether there is a match, an
+             * unanchored run reports the last position at which
+             * no partial match was pending, the leftmost match
+             * cannot start before it.
+             */
+            template<class BidirIt>
+            bool run(BidirIt first, BidirIt last,
+                     regex_constants::match_flag_type flags, bool full,
+                     BidirIt& restart)
+            {
+                uint8_t ctx{};
+                if (prog_.context)
+                {
+                    if (flags & regex_constants::match_prev_avail)
+                        ctx = context_after_(*prev(first));
+                    else if (!(flags & regex_constants::match_not_bol))
+                        ctx = bol_;
+                }
+
+                vector<size_t> kernel{0};
+                auto start = intern_(ctx, kernel);
+                auto state = start;
+                bool skip = prog_.has_first && !anchored_ && !prog_.context;
+                restart = first;
+
+                for (auto pos = first; pos != last; ++pos)
+                {
+                    if (skip && state == start)
+                    {
+                        pos = find(pos, last, prog_.first);
+                        if (pos == last)
+                            break;
+                        restart = pos;
+                    }
+
+                    auto c = *pos;
+                    auto entry = table_[state * alphabet_ + byte_(c)];
+                    if (entry == unknown_)
+                    {
+                        entry = transition_(state, c);
+                        if (flushed_)
+                        {
+                            /**
+                             * Indices of the states kept before
+                             * the flush are no longer valid.
+                             */
+                            start = intern_(ctx, kernel);
+                            flushed_ = false;
+                        }
+                    }
+
+                    if ((entry & 1) && !full)
+                        return true;
+
+                    state = entry >> 1;
+                    const auto& next = states_[state];
+                    if (next.idle)
+                        restart = std::next(pos);
+                    else if (next.kernel.empty())
+                        return false;
+                }
+
+                bool not_eol = (flags & regex_constants::match_not_eol) != 0;
+                auto& accept = states_[state].accept_at_end[not_eol];
+                if (accept < 0)
+                    accept = closure_accepts_(state, nullptr, !not_eol);
+
+                return accept;
+            }
+
+        private:
+            struct state_type
+            {
+                uint8_t ctx;
+                bool idle;
+                vector<size_t> kernel;
+                int8_t accept_at_end[2];
+            };
+
+            static constexpr size_t alphabet_{256};
+            static constexpr uint32_t unknown_{0xFFFF'FFFF};
+            static constexpr size_t max_states_{1024};
+            static constexpr uint8_t bol_{1};
+            static constexpr uint8_t word_{2};
+
+            const program_type& prog_;
+            bool anchored_;
+            vector<state_type> states_;
+            vector<uint32_t> table_;
+            map<vector<size_t>, uint32_t> index_;
+            vector<size_t> stamps_;
+            size_t stamp_;
+            vector<size_t> stack_;
+            vector<size_t> closure_;
+            bool flushed_;
+
+            static size_t byte_(Char c)
+            {
+                return static_cast<size_t>(static_cast<make_unsigned_t<Char>>(c));
+            }
+
+            uint8_t context_after_(Char c) const
+            {
+                uint8_t res{};
+                if (prog_.multiline && program_type::is_line_terminator(c))
+                    res |= bol_;
+                if (prog_.is_word(c))
+                    res |= word_;
+
+                return res;
+            }
+
+            uint32_t intern_(uint8_t ctx, const vector<size_t>& kernel)
+            {
+                vector<size_t> key{};
+                key.reserve(kernel.size() + 1);
+                key.push_back(ctx);
+                key.insert(key.end(), kernel.begin(), kernel.end());
+
+                auto it = index_.find(key);
+                if (it != index_.end())
+                    return it->second;
+
+                auto idx = static_cast<uint32_t>(states_.size());
+                bool idle = !anchored_ && kernel.size() == 1;
+                states_.push_back(state_type{ctx, idle, kernel, {-1, -1}});
+                table_.resize(states_.size() * alphabet_, unknown_);
+                index_.emplace(move(key), idx);
+
+                return idx;
+            }
+
+            /**
+             * Collects the consuming instructions reachable from
+             * the kernel of the state, given the next character
+             * (or its absence), and tells whether the match
+             * instruction is reachable as well.
+             */
+            bool closure_accepts_(uint32_t state, const Char* next, bool eol)
+            {
+                ++stamp_;
+                closure_.clear();
+                stack_.assign(states_[state].kernel.rbegin(), states_[state].kernel.rend());
+
+                auto ctx = states_[state].ctx;
+                bool prev_word = (ctx & word_) != 0;
+                bool next_word = next && prog_.is_word(*next);
+                bool accepts{false};
+
+                while (!stack_.empty())
+                {
+                    auto pc = stack_.back();
+                    stack_.pop_back();
+
+                    while (stamps_[pc] != stamp_)
+                    {
+                        stamps_[pc] = stamp_;
+
+                        const auto& instr = prog_.code[pc];
+                        bool next_pc{true};
+                        switch (instr.op)
+                        {
+                            case regex_op::jump:
+                                pc = instr.x;
+                                continue;
+                            case regex_op::split:
+                                stack_.push_back(instr.y);
+                                pc = instr.x;
+                                continue;
+                            case regex_op::save:
+                            case regex_op::mark:
+                            case regex_op::check:
+                                break;
+                            case regex_op::assert_bol:
+                                next_pc = (ctx & bol_) != 0;
+                                break;
+                            case regex_op::assert_eol:
+                                next_pc = eol;
+                                break;
+                            case regex_op::assert_word:
+                                next_pc = prev_word != next_word;
+                                break;
+                            case regex_op::assert_not_word:
+                                next_pc = prev_word == next_word;
+                                break;
+                            case regex_op::match:
+                                accepts = true;
+                                next_pc = false;
+                                break;
+                            default:
+                                closure_.push_back(pc);
+                                next_pc = false;
+                                break;
+                        }
+
+                        if (!next_pc)
+                            break;
+                        ++pc;
+                    }
+                }
+
+                return accepts;
+            }
+
+            uint32_t transition_(uint32_t state, Char c)
+            {
+                bool eol = prog_.multiline && program_type::is_line_terminator(c);
+                bool accepts = closure_accepts_(state, &c, eol);
+
+                vector<size_t> kernel{};
+                if (!anchored_)
+                    kernel.push_back(0);
+
+                auto tc = prog_.translate(c);
+                for (auto pc: closure_)
+                {
+                    const auto& instr = prog_.code[pc];
+                    bool consumed{false};
+                    if (instr.op == regex_op::character)
+                        consumed = instr.c == tc;
+                    else if (instr.op == regex_op::any)
+                        consumed = !program_type::is_line_terminator(c);
+                    else if (instr.op == regex_op::char_class)
+                        consumed = prog_.classes[instr.x].matches(c, prog_.traits);
+
+                    if (consumed)
+                        kernel.push_back(pc + 1);
+                }
+
+                /**
+                 * The closure visits every pc once, so the kernel
+                 * has no duplicates and sorting makes it canonical.
+                 */
+                sort(kernel.begin(), kernel.end());
+
+                if (states_.size() >= max_states_)
+                {
+                    /**
+                     * Instead of growing without bounds, the cache
+                     * is rebuilt from scratch with only the current
+                     * state kept.
+                     */
+                    auto current = move(states_[state]);
+                    states_.clear();
+                    table_.clear();
+                    index_.clear();
+                    state = intern_(current.ctx, current.kernel);
+                    flushed_ = true;
+                }
+
+                uint8_t ctx = prog_.context ? context_after_(c) : 0;
+                auto next = intern_(ctx, kernel);
+                uint32_t entry = (next << 1) | (accepts ? 1 : 0);
+                table_[state * alphabet_ + byte_(c)] = entry;
+
+                return entry;
+            }
+    };
+
+    /**
+     * The compiled form of a regular expression shared by the
+     * copies of a basic_regex. Searching does not modify the
+     * program, the DFA caches are only touched by one search
+     * at a time and concurrent searches fall back to the Pike VM.
+     */
+    template<class Char, class Traits>
+    class regex_automaton
+    {
+        public:
+            using program_type = regex_program<Char, Traits>;
+
+            explicit regex_automaton(program_type&& prog)
+                : prog_{move(prog)}, busy_{}, search_dfa_{prog_, false},
+                  match_dfa_{prog_, true}
+            {
+                busy_.clear();
+            }
+
+            const program_type& program() const
+            {
+                return prog_;
+            }
+
+            template<class BidirIt, class Allocator>
+            bool exec(BidirIt first, BidirIt last,
+                      match_results<BidirIt, Allocator>* m,
+                      regex_constants::match_flag_type flags, bool full)
+            {
+                bool anchored = full || (flags & regex_constants::match_continuous);
+                bool found = false;
+                auto start = first;
+                auto start_flags = flags;
+
+                if (dfa_usable_(flags) && !busy_.test_and_set(memory_order_acquire))
+                {
+                    auto& dfa = anchored ? match_dfa_ : search_dfa_;
+                    found = dfa.run(first, last, flags, full, start);
+                    busy_.clear(memory_order_release);
+
+                    if (!found || !m)
+                        return finish_(found, m, first, last);
+
+                    if (full && prog_.groups == 1)
+                    {
+                        vector<regex_slot<BidirIt>> slots{
+                            regex_slot<BidirIt>{first, true},
+                            regex_slot<BidirIt>{last, true}
+                        };
+                        regex_results_access::assign(*m, first, first, last, slots, 1);
+
+                        return true;
+                    }
+
+                    /**
+                     * The submatches are then extracted only from
+                     * the part of the input the DFA could not rule out.
+                     */
+                    if (start != first)
+                        start_flags |= regex_constants::match_prev_avail;
+                }
+
+                regex_context<BidirIt, Char, Traits> ctx{prog_, start, last, start_flags};
+                vector<regex_slot<BidirIt>> slots{};
+                if (prog_.backtrack)
+                    found = regex_backtracker<BidirIt, Char, Traits>{ctx}.run(anchored, full, slots);
+                else
+                    found = regex_pike_vm<BidirIt, Char, Traits>{ctx}.run(anchored, full, slots);
+
+                if (found && m)
+                    regex_results_access::assign(*m, first, first, last, slots, prog_.groups);
+
+                return finish_(found, m, first, last);
+            }
+
+        private:
+            program_type prog_;
+            atomic_flag busy_;
+            regex_dfa<Char, Traits> search_dfa_;
+            regex_dfa<Char, Traits> match_dfa_;
+
+            bool dfa_usable_(regex_constants::match_flag_type flags) const
+            {
+                return sizeof(Char) == 1 && !prog_.backtrack &&
+                       !(flags & (regex_constants::match_not_null |
+                                  regex_constants::match_not_bow |
+                                  regex_constants::match_not_eow));
+            }
+
+            template<class BidirIt, class Allocator>
+            static bool finish_(bool found, match_results<BidirIt, Allocator>* m,
+                                BidirIt first, BidirIt last)
+            {
+                if (!found && m)
+                    regex_results_access::assign_failed(*m, first, last);
+
+                return found;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_ITERATOR
+#define LIBCPP_BITS_REGEX_ITERATOR
+
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/match_results.hpp>
+#include <__bits/regex/regex_algorithms.hpp>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace std
+{
+    /**
+     * 28.12.1, class template regex_iterator:
+     */
+
+    template<
+        class BidirectionalIterator,
+        class Char = typename iterator_traits<BidirectionalIterator>::value_type,
+        class Traits = regex_traits<Char>
+    >
+    class regex_iterator
+    {
+        public:
+            using regex_type        = basic_regex<Char, Traits>;
+            using value_type        = match_results<BidirectionalIterator>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = const value_type*;
+            using reference         = const value_type&;
+            using iterator_category = forward_iterator_tag;
+
+            regex_iterator()
+                : begin_{}, end_{}, regex_{nullptr},
+                  flags_{regex_constants::match_default}, match_{}
+            { /* DUMMY BODY */ }
+
+            regex_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                           const regex_type& re,
+                           regex_constants::match_flag_type flags = regex_constants::match_default)
+                : begin_{first}, end_{last}, regex_{&re}, flags_{flags}, match_{}
+            {
+                if (!regex_search(begin_, end_, match_, *regex_, flags_))
+                    regex_ = nullptr;
+            }
+
+            regex_iterator(BidirectionalIterator, BidirectionalIterator,
+                           const regex_type&&,
+                           regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_iterator(const regex_iterator&) = default;
+            regex_iterator& operator=(const regex_iterator&) = default;
+
+            bool operator==(const regex_iterator& other) const
+            {
+                if (!regex_ || !other.regex_)
+                    return regex_ == other.regex_;
+
+                return begin_ == other.begin_ && end_ == other.end_ &&
+                       regex_ == other.regex_ && flags_ == other.flags_ &&
+                       match_[0].first == other.match_[0].first &&
+                       match_[0].second == other.match_[0].second;
+            }
+
+            bool operator!=(const regex_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            const value_type& operator*() const
+            {
+                return match_;
+            }
+
+            const value_type* operator->() const
+            {
+                return &match_;
+            }
+
+            regex_iterator& operator++()
+            {
+                if (!aux::regex_search_next(end_, begin_, match_, *regex_, flags_))
+                    regex_ = nullptr;
+
+                return *this;
+            }
+
+            regex_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+        private:
+            BidirectionalIterator begin_;
+            BidirectionalIterator end_;
+            const regex_type* regex_;
+            regex_constants::match_flag_type flags_;
+            value_type match_;
+    };
+
+    using cregex_iterator  = regex_iterator<const char*>;
+    using wcregex_iterator = regex_iterator<const wchar_t*>;
+    using sregex_iterator  = regex_iterator<string::const_iterator>;
+    using wsregex_iterator = regex_iterator<wstring::const_iterator>;
+
+    /**
+     * 28.12.2, class template regex_token_iterator:
+     */
+
+    template<
+        class BidirectionalIterator,
+        class Char = typename iterator_traits<BidirectionalIterator>::value_type,
+        class Traits = regex_traits<Char>
+    >
+    class regex_token_iterator
+    {
+        public:
+            using regex_type        = basic_regex<Char, Traits>;
+            using value_type        = sub_match<BidirectionalIterator>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = const value_type*;
+            using reference         = const value_type&;
+            using iterator_category = forward_iterator_tag;
+
+            regex_token_iterator()
+                : position_{}, result_{nullptr}, suffix_{}, n_{}, subs_{}, end_{}
+            { /* DUMMY BODY */ }
+
+            regex_token_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                                 const regex_type& re, int sub = 0,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+                : position_{first, last, re, flags}, result_{nullptr},
+                  suffix_{}, n_{}, subs_{sub}, end_{}
+            {
+                init_(first, last);
+            }
+
+            regex_token_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                                 const regex_type& re, const vector<int>& subs,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+                : position_{first, last, re, flags}, result_{nullptr},
+                  suffix_{}, n_{}, subs_{subs}, end_{}
+            {
+                init_(first, last);
+            }
+
+            regex_token_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                                 const regex_type& re, initializer_list<int> subs,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+                : position_{first, last, re, flags}, result_{nullptr},
+                  suffix_{}, n_{}, subs_{subs}, end_{}
+            {
+                init_(first, last);
+            }
+
+            template<size_t N>
+            regex_token_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                                 const regex_type& re, const int (&subs)[N],
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+                : position_{first, last, re, flags}, result_{nullptr},
+                  suffix_{}, n_{}, subs_{subs, subs + N}, end_{}
+            {
+                init_(first, last);
+            }
+
+            regex_token_iterator(BidirectionalIterator, BidirectionalIterator,
+                                 const regex_type&&, int = 0,
+                                 regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_token_iterator(const regex_token_iterator& other)
+                : position_{other.position_}, result_{nullptr},
+                  suffix_{other.suffix_}, n_{other.n_}, subs_{other.subs_},
+                  end_{other.end_}
+            {
+                fix_result_(other);
+            }
+
+            regex_token_iterator& operator=(const regex_token_iterator& other)
+            {
+                position_ = other.position_;
+                suffix_ = other.suffix_;
+                n_ = other.n_;
+                subs_ = other.subs_;
+                end_ = other.end_;
+                fix_result_(other);
+
+                return *this;
+            }
+
+            bool operator==(const regex_token_iterator& other) const
+            {
+                if (!result_ || !other.result_)
+                    return result_ == other.result_;
+                if (result_ == &suffix_ || other.result_ == &other.suffix_)
+                    return result_ == &suffix_ && other.result_ == &other.suffix_ &&
+                           suffix_ == other.suffix_;
+
+                return position_ == other.position_ && n_ == other.n_ &&
+                       subs_ == other.subs_;
+            }
+
+            bool operator!=(const regex_token_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            const value_type& operator*() const
+            {
+                return *result_;
+            }
+
+            const value_type* operator->() const
+            {
+                return result_;
+            }
+
+            regex_token_iterator& operator++()
+            {
+                if (result_ == &suffix_)
+                {
+                    result_ = nullptr;
+
+                    return *this;
+                }
+
+                if (n_ + 1 < subs_.size())
+                {
+                    ++n_;
+                    result_ = current_();
+
+                    return *this;
+                }
+
+                auto prev_end = (*position_)[0].second;
+                n_ = 0;
+                ++position_;
+
+                if (position_ != position_iterator{})
+                    result_ = current_();
+                else if (has_split_() && prev_end != end_)
+                {
+                    suffix_.first = prev_end;
+                    suffix_.second = end_;
+                    suffix_.matched = true;
+                    result_ = &suffix_;
+                }
+                else
+                    result_ = nullptr;
+
+                return *this;
+            }
+
+            regex_token_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+        private:
+            using position_iterator = regex_iterator<BidirectionalIterator, Char, Traits>;
+
+            position_iterator position_;
+            const value_type* result_;
+            value_type suffix_;
+            size_t n_;
+            vector<int> subs_;
+            BidirectionalIterator end_;
+
+            void init_(BidirectionalIterator first, BidirectionalIterator last)
+            {
+                end_ = last;
+                if (position_ != position_iterator{})
+                    result_ = current_();
+                else if (has_split_() && first != last)
+                {
+                    suffix_.first = first;
+                    suffix_.second = last;
+                    suffix_.matched = true;
+                    result_ = &suffix_;
+                }
+            }
+
+            bool has_split_() const
+            {
+                return find(subs_.begin(), subs_.end(), -1) != subs_.end();
+            }
+
+            const value_type* current_() const
+            {
+                if (subs_[n_] == -1)
+                    return &(*position_).prefix();
+
+                return &(*position_)[subs_[n_]];
+            }
+
+            void fix_result_(const regex_token_iterator& other)
+            {
+                if (!other.result_)
+                    result_ = nullptr;
+                else if (other.result_ == &other.suffix_)
+                    result_ = &suffix_;
+                else
+                    result_ = current_();
+            }
+    };
+
+    using cregex_token_iterator  = regex_token_iterator<const char*>;
+    using wcregex_token_iterator = regex_token_iterator<const wchar_t*>;
+    using sregex_token_iterator  = regex_token_iterator<string::const_iterator>;
+    using wsregex_token_iterator = regex_token_iterator<wstring::const_iterator>;
+}
+
+#endif
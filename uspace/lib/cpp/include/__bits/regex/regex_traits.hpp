@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_TRAITS
+#define LIBCPP_BITS_REGEX_TRAITS
+
+#include <cctype>
+#include <cstdint>
+#include <locale>
+#include <string>
+#include <type_traits>
+
+namespace std
+{
+    namespace aux
+    {
+        /**
+         * Character classes recognized by regex_traits,
+         * the w class is alnum with the underscore.
+         */
+        namespace regex_class
+        {
+            inline constexpr uint16_t alnum  = 0b0000'0000'0001;
+            inline constexpr uint16_t alpha  = 0b0000'0000'0010;
+            inline constexpr uint16_t blank  = 0b0000'0000'0100;
+            inline constexpr uint16_t cntrl  = 0b0000'0000'1000;
+            inline constexpr uint16_t digit  = 0b0000'0001'0000;
+            inline constexpr uint16_t graph  = 0b0000'0010'0000;
+            inline constexpr uint16_t lower  = 0b0000'0100'0000;
+            inline constexpr uint16_t print  = 0b0000'1000'0000;
+            inline constexpr uint16_t punct  = 0b0001'0000'0000;
+            inline constexpr uint16_t space  = 0b0010'0000'0000;
+            inline constexpr uint16_t upper  = 0b0100'0000'0000;
+            inline constexpr uint16_t xdigit = 0b1000'0000'0000;
+            inline constexpr uint16_t word   = 0b1'0000'0000'0000;
+        }
+
+        /**
+         * Note: Our libc classifies ASCII only, so anything
+         *       outside of it belongs to no class.
+         */
+        template<class Char>
+        bool regex_isctype(Char c, uint16_t cls)
+        {
+            auto val = static_cast<make_unsigned_t<Char>>(c);
+            if (val > 127)
+                return false;
+
+            int ch = static_cast<int>(val);
+
+            return ((cls & regex_class::alnum) && std::isalnum(ch))
+                || ((cls & regex_class::alpha) && std::isalpha(ch))
+                || ((cls & regex_class::blank) && std::isblank(ch))
+                || ((cls & regex_class::cntrl) && std::iscntrl(ch))
+                || ((cls & regex_class::digit) && std::isdigit(ch))
+                || ((cls & regex_class::graph) && std::isgraph(ch))
+                || ((cls & regex_class::lower) && std::islower(ch))
+                || ((cls & regex_class::print) && std::isprint(ch))
+                || ((cls & regex_class::punct) && std::ispunct(ch))
+                || ((cls & regex_class::space) && std::isspace(ch))
+                || ((cls & regex_class::upper) && std::isupper(ch))
+                || ((cls & regex_class::xdigit) && std::isxdigit(ch))
+                || ((cls & regex_class::word) && (std::isalnum(ch) || ch == '_'));
+        }
+    }
+
+    /**
+     * 28.7, class template regex_traits:
+     */
+
+    template<class Char>
+    class regex_traits
+    {
+        public:
+            using char_type       = Char;
+            using string_type     = basic_string<char_type>;
+            using locale_type     = locale;
+            using char_class_type = uint16_t;
+
+            regex_traits()
+                : loc_{}
+            { /* DUMMY BODY */ }
+
+            static size_t length(const char_type* p)
+            {
+                return char_traits<char_type>::length(p);
+            }
+
+            char_type translate(char_type c) const
+            {
+                return c;
+            }
+
+            char_type translate_nocase(char_type c) const
+            {
+                auto val = static_cast<make_unsigned_t<char_type>>(c);
+                if (val > 127)
+                    return c;
+
+                return static_cast<char_type>(std::tolower(static_cast<int>(val)));
+            }
+
+            template<class ForwardIterator>
+            string_type transform(ForwardIterator first, ForwardIterator last) const
+            {
+                return string_type(first, last);
+            }
+
+            template<class ForwardIterator>
+            string_type transform_primary(ForwardIterator first,
+                                          ForwardIterator last) const
+            {
+                string_type res{};
+                for (; first != last; ++first)
+                    res.push_back(translate_nocase(*first));
+
+                return res;
+            }
+
+            template<class ForwardIterator>
+            string_type lookup_collatename(ForwardIterator first,
+                                           ForwardIterator last) const
+            {
+                /**
+                 * Note: We have no collating elements other
+                 *       than the single characters.
+                 */
+                if (first != last && next(first) == last)
+                    return string_type(1, *first);
+                else
+                    return string_type{};
+            }
+
+            template<class ForwardIterator>
+            char_class_type lookup_classname(ForwardIterator first,
+                                             ForwardIterator last,
+                                             bool icase = false) const
+            {
+                static constexpr struct
+                {
+                    const char* name;
+                    char_class_type cls;
+                } classes[] = {
+                    { "alnum",  aux::regex_class::alnum  },
+                    { "alpha",  aux::regex_class::alpha  },
+                    { "blank",  aux::regex_class::blank  },
+                    { "cntrl",  aux::regex_class::cntrl  },
+                    { "d",      aux::regex_class::digit  },
+                    { "digit",  aux::regex_class::digit  },
+                    { "graph",  aux::regex_class::graph  },
+                    { "lower",  aux::regex_class::lower  },
+                    { "print",  aux::regex_class::print  },
+                    { "punct",  aux::regex_class::punct  },
+                    { "s",      aux::regex_class::space  },
+                    { "space",  aux::regex_class::space  },
+                    { "upper",  aux::regex_class::upper  },
+                    { "w",      aux::regex_class::word   },
+                    { "xdigit", aux::regex_class::xdigit }
+                };
+
+                for (const auto& entry: classes)
+                {
+                    auto it = first;
+                    const char* name = entry.name;
+                    while (it != last && *name != '\0' &&
+                           translate_nocase(*it) == static_cast<char_type>(*name))
+                    {
+                        ++it;
+                        ++name;
+                    }
+
+                    if (it != last || *name != '\0')
+                        continue;
+
+                    auto cls = entry.cls;
+                    if (icase && (cls & (aux::regex_class::lower | aux::regex_class::upper)))
+                        cls |= aux::regex_class::alpha;
+
+                    return cls;
+                }
+
+                return char_class_type{};
+            }
+
+            bool isctype(char_type c, char_class_type f) const
+            {
+                return aux::regex_isctype(c, f);
+            }
+
+            int value(char_type c, int radix) const
+            {
+                int res{-1};
+                if (c >= static_cast<char_type>('0') && c <= static_cast<char_type>('9'))
+                    res = static_cast<int>(c - static_cast<char_type>('0'));
+                else if (c >= static_cast<char_type>('a') && c <= static_cast<char_type>('f'))
+                    res = static_cast<int>(c - static_cast<char_type>('a')) + 10;
+                else if (c >= static_cast<char_type>('A') && c <= static_cast<char_type>('F'))
+                    res = static_cast<int>(c - static_cast<char_type>('A')) + 10;
+
+                return res < radix ? res : -1;
+            }
+
+            locale_type imbue(locale_type loc)
+            {
+                auto old = loc_;
+                loc_ = loc;
+
+                return old;
+            }
+
+            locale_type getloc() const
+            {
+                return loc_;
+            }
+
+        private:
+            locale_type loc_;
+    };
+}
+
+#endif
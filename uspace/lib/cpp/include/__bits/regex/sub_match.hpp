@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_SUB_MATCH
+#define LIBCPP_BITS_REGEX_SUB_MATCH
+
+#include <iosfwd>
+#include <iterator>
+#include <string>
+#include <utility>
+
+namespace std
+{
+    /**
+     * 28.9, class template sub_match:
+     */
+
+    template<class BidirectionalIterator>
+    class sub_match: public pair<BidirectionalIterator, BidirectionalIterator>
+    {
+        public:
+            using value_type      = typename iterator_traits<BidirectionalIterator>::value_type;
+            using difference_type = typename iterator_traits<BidirectionalIterator>::difference_type;
+            using iterator        = BidirectionalIterator;
+            using string_type     = basic_string<value_type>;
+
+            bool matched;
+
+            constexpr sub_match()
+                : pair<BidirectionalIterator, BidirectionalIterator>{},
+                  matched{false}
+            { /* DUMMY BODY */ }
+
+            difference_type length() const
+            {
+                if (matched)
+                    return distance(this->first, this->second);
+                else
+                    return difference_type{};
+            }
+
+            operator string_type() const
+            {
+                return str();
+            }
+
+            string_type str() const
+            {
+                if (matched)
+                    return string_type(this->first, this->second);
+                else
+                    return string_type{};
+            }
+
+            int compare(const sub_match& other) const
+            {
+                return str().compare(other.str());
+            }
+
+            int compare(const string_type& str) const
+            {
+                return this->str().compare(str);
+            }
+
+            int compare(const value_type* str) const
+            {
+                return this->str().compare(str);
+            }
+    };
+
+    using csub_match  = sub_match<const char*>;
+    using wcsub_match = sub_match<const wchar_t*>;
+    using ssub_match  = sub_match<string::const_iterator>;
+    using wssub_match = sub_match<wstring::const_iterator>;
+
+    /**
+     * 28.9.2, sub_match non-member operators:
+     * Note: All comparisons go through compare, the
+     *       overloads for strings with different traits
+     *       or allocators are covered by the conversion
+     *       of the sub_match to its string_type.
+     */
+
+    template<class BidirIt>
+    bool operator==(const sub_match<BidirIt>& lhs, const sub_match<BidirIt>& rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+
+    template<class BidirIt>
+    bool operator!=(const sub_match<BidirIt>& lhs, const sub_match<BidirIt>& rhs)
+    {
+        return lhs.compare(rhs) != 0;
+    }
+
+    template<class BidirIt>
+    bool operator<(const sub_match<BidirIt>& lhs, const sub_match<BidirIt>& rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    template<class BidirIt>
+    bool operator<=(const sub_match<BidirIt>& lhs, const sub_match<BidirIt>& rhs)
+    {
+        return lhs.compare(rhs) <= 0;
+    }
+
+    template<class BidirIt>
+    bool operator>=(const sub_match<BidirIt>& lhs, const sub_match<BidirIt>& rhs)
+    {
+        return lhs.compare(rhs) >= 0;
+    }
+
+    template<class BidirIt>
+    bool operator>(const sub_match<BidirIt>& lhs, const sub_match<BidirIt>& rhs)
+    {
+        return lhs.compare(rhs) > 0;
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator==(
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& lhs,
+        const sub_match<BidirIt>& rhs
+    )
+    {
+        return rhs.compare(lhs.c_str()) == 0;
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator!=(
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& lhs,
+        const sub_match<BidirIt>& rhs
+    )
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator<(
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& lhs,
+        const sub_match<BidirIt>& rhs
+    )
+    {
+        return rhs.compare(lhs.c_str()) > 0;
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator>(
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& lhs,
+        const sub_match<BidirIt>& rhs
+    )
+    {
+        return rhs < lhs;
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator>=(
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& lhs,
+        const sub_match<BidirIt>& rhs
+    )
+    {
+        return !(lhs < rhs);
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator<=(
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& lhs,
+        const sub_match<BidirIt>& rhs
+    )
+    {
+        return !(rhs < lhs);
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator==(
+        const sub_match<BidirIt>& lhs,
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& rhs
+    )
+    {
+        return lhs.compare(rhs.c_str()) == 0;
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator!=(
+        const sub_match<BidirIt>& lhs,
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& rhs
+    )
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator<(
+        const sub_match<BidirIt>& lhs,
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& rhs
+    )
+    {
+        return lhs.compare(rhs.c_str()) < 0;
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator>(
+        const sub_match<BidirIt>& lhs,
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& rhs
+    )
+    {
+        return rhs < lhs;
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator>=(
+        const sub_match<BidirIt>& lhs,
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& rhs
+    )
+    {
+        return !(lhs < rhs);
+    }
+
+    template<class BidirIt, class Traits, class Allocator>
+    bool operator<=(
+        const sub_match<BidirIt>& lhs,
+        const basic_string<typename iterator_traits<BidirIt>::value_type, Traits, Allocator>& rhs
+    )
+    {
+        return !(rhs < lhs);
+    }
+
+    template<class BidirIt>
+    bool operator==(const typename iterator_traits<BidirIt>::value_type* lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return rhs.compare(lhs) == 0;
+    }
+
+    template<class BidirIt>
+    bool operator!=(const typename iterator_traits<BidirIt>::value_type* lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt>
+    bool operator<(const typename iterator_traits<BidirIt>::value_type* lhs,
+                   const sub_match<BidirIt>& rhs)
+    {
+        return rhs.compare(lhs) > 0;
+    }
+
+    template<class BidirIt>
+    bool operator>(const typename iterator_traits<BidirIt>::value_type* lhs,
+                   const sub_match<BidirIt>& rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template<class BidirIt>
+    bool operator>=(const typename iterator_traits<BidirIt>::value_type* lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    template<class BidirIt>
+    bool operator<=(const typename iterator_traits<BidirIt>::value_type* lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template<class BidirIt>
+    bool operator==(const sub_match<BidirIt>& lhs,
+                    const typename iterator_traits<BidirIt>::value_type* rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+
+    template<class BidirIt>
+    bool operator!=(const sub_match<BidirIt>& lhs,
+                    const typename iterator_traits<BidirIt>::value_type* rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt>
+    bool operator<(const sub_match<BidirIt>& lhs,
+                   const typename iterator_traits<BidirIt>::value_type* rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    template<class BidirIt>
+    bool operator>(const sub_match<BidirIt>& lhs,
+                   const typename iterator_traits<BidirIt>::value_type* rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template<class BidirIt>
+    bool operator>=(const sub_match<BidirIt>& lhs,
+                    const typename iterator_traits<BidirIt>::value_type* rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    template<class BidirIt>
+    bool operator<=(const sub_match<BidirIt>& lhs,
+                    const typename iterator_traits<BidirIt>::value_type* rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template<class BidirIt>
+    bool operator==(const typename iterator_traits<BidirIt>::value_type& lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return rhs.compare(typename sub_match<BidirIt>::string_type(1, lhs)) == 0;
+    }
+
+    template<class BidirIt>
+    bool operator!=(const typename iterator_traits<BidirIt>::value_type& lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt>
+    bool operator==(const sub_match<BidirIt>& lhs,
+                    const typename iterator_traits<BidirIt>::value_type& rhs)
+    {
+        return lhs.compare(typename sub_match<BidirIt>::string_type(1, rhs)) == 0;
+    }
+
+    template<class BidirIt>
+    bool operator!=(const sub_match<BidirIt>& lhs,
+                    const typename iterator_traits<BidirIt>::value_type& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class Char, class StreamTraits, class BidirIt>
+    basic_ostream<Char, StreamTraits>&
+    operator<<(basic_ostream<Char, StreamTraits>& os, const sub_match<BidirIt>& m)
+    {
+        return os << m.str();
+    }
+}
+
+#endif
@@ -29,6 +29,7 @@
 #ifndef LIBCPP_BITS_STRING
 #define LIBCPP_BITS_STRING
 
+#include <__bits/functional/hash.hpp>
 #include <__bits/string/stringfwd.hpp>
 #include <algorithm>
 #include <cassert>
@@ -91,8 +92,7 @@ namespace std
 
         static const char_type* find(const char_type* s, size_t n, const char_type& c)
         {
-            size_t i{};
-            while (i++ < n)
+            for (size_t i = 0; i < n; ++i)
             {
                 if (s[i] == c)
                     return s + i;
@@ -177,44 +177,52 @@ namespace std
 
         static int compare(const char_type* s1, const char_type* s2, size_t n)
         {
-            // TODO: implement
-            __unimplemented();
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (lt(s1[i], s2[i]))
+                    return -1;
+                else if (lt(s2[i], s1[i]))
+                    return 1;
+            }
+
             return 0;
         }
 
         static size_t length(const char_type* s)
         {
-            // TODO: implement
-            __unimplemented();
-            return 0;
+            size_t i = 0;
+            while (s[i] != 0)
+                i++;
+            return i;
         }
 
         static const char_type* find(const char_type* s, size_t n, const char_type& c)
         {
-            // TODO: implement
-            __unimplemented();
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (s[i] == c)
+                    return s + i;
+            }
+
             return nullptr;
         }
 
         static char_type* move(char_type* s1, const char_type* s2, size_t n)
         {
-            // TODO: implement
-            __unimplemented();
-            return nullptr;
+            return static_cast<char_type*>(memmove(s1, s2, n * sizeof(char_type)));
         }
 
         static char_type* copy(char_type* s1, const char_type* s2, size_t n)
         {
-            // TODO: implement
-            __unimplemented();
-            return nullptr;
+            return static_cast<char_type*>(memcpy(s1, s2, n * sizeof(char_type)));
         }
 
         static char_type* assign(char_type* s, size_t n, char_type c)
         {
-            // TODO: implement
-            __unimplemented();
-            return nullptr;
+            for (size_t i = 0; i < n; ++i)
+                s[i] = c;
+
+            return s;
         }
 
         static constexpr int_type not_eof(int_type c) noexcept
@@ -271,44 +279,52 @@ namespace std
 
         static int compare(const char_type* s1, const char_type* s2, size_t n)
         {
-            // TODO: implement
-            __unimplemented();
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (lt(s1[i], s2[i]))
+                    return -1;
+                else if (lt(s2[i], s1[i]))
+                    return 1;
+            }
+
             return 0;
         }
 
         static size_t length(const char_type* s)
         {
-            // TODO: implement
-            __unimplemented();
-            return 0;
+            size_t i = 0;
+            while (s[i] != 0)
+                i++;
+            return i;
         }
 
         static const char_type* find(const char_type* s, size_t n, const char_type& c)
         {
-            // TODO: implement
-            __unimplemented();
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (s[i] == c)
+                    return s + i;
+            }
+
             return nullptr;
         }
 
         static char_type* move(char_type* s1, const char_type* s2, size_t n)
         {
-            // TODO: implement
-            __unimplemented();
-            return nullptr;
+            return static_cast<char_type*>(memmove(s1, s2, n * sizeof(char_type)));
         }
 
         static char_type* copy(char_type* s1, const char_type* s2, size_t n)
         {
-            // TODO: implement
-            __unimplemented();
-            return nullptr;
+            return static_cast<char_type*>(memcpy(s1, s2, n * sizeof(char_type)));
         }
 
         static char_type* assign(char_type* s, size_t n, char_type c)
         {
-            // TODO: implement
-            __unimplemented();
-            return nullptr;
+            for (size_t i = 0; i < n; ++i)
+                s[i] = c;
+
+            return s;
         }
 
         static constexpr int_type not_eof(int_type c) noexcept
@@ -364,8 +380,14 @@ namespace std
 
         static int compare(const char_type* s1, const char_type* s2, size_t n)
         {
-            // TODO: This function does not exits...
-            __unimplemented();
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (lt(s1[i], s2[i]))
+                    return -1;
+                else if (lt(s2[i], s1[i]))
+                    return 1;
+            }
+
             return 0;
         }
 
@@ -379,8 +401,7 @@ namespace std
 
         static const char_type* find(const char_type* s, size_t n, const char_type& c)
         {
-            size_t i{};
-            while (i++ < n)
+            for (size_t i = 0; i < n; ++i)
             {
                 if (s[i] == c)
                     return s + i;
@@ -401,7 +422,10 @@ namespace std
 
         static char_type* assign(char_type* s, size_t n, char_type c)
         {
-            return static_cast<char_type*>(memset(s, static_cast<int>(c), n * sizeof(wchar_t)));
+            for (size_t i = 0; i < n; ++i)
+                s[i] = c;
+
+            return s;
         }
 
         static constexpr int_type not_eof(int_type c) noexcept
@@ -469,8 +493,9 @@ namespace std
                 : basic_string(allocator_type{})
             { /* DUMMY BODY */ }
 
-            explicit basic_string(const allocator_type& alloc)
-                : data_{}, size_{}, capacity_{}, allocator_{alloc}
+            explicit basic_string(const allocator_type& alloc) noexcept
+                : data_{local_}, size_{}, capacity_{local_capacity_},
+                  allocator_{alloc}
             {
                 /**
                  * Postconditions:
@@ -478,29 +503,27 @@ namespace std
                  *  size() = 0
                  *  capacity() = unspecified
                  */
-                data_ = allocator_.allocate(default_capacity_);
-                capacity_ = default_capacity_;
+                ensure_null_terminator_();
             }
 
             basic_string(const basic_string& other)
-                : data_{}, size_{other.size_}, capacity_{other.capacity_},
+                : data_{local_}, size_{}, capacity_{local_capacity_},
                   allocator_{other.allocator_}
             {
-                init_(other.data(), size_);
+                init_(other.data(), other.size());
             }
 
-            basic_string(basic_string&& other)
-                : data_{other.data_}, size_{other.size_},
-                  capacity_{other.capacity_}, allocator_{move(other.allocator_)}
+            basic_string(basic_string&& other) noexcept
+                : data_{local_}, size_{}, capacity_{local_capacity_},
+                  allocator_{move(other.allocator_)}
             {
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                steal_(other);
             }
 
             basic_string(const basic_string& other, size_type pos, size_type n = npos,
                          const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{}, capacity_{}, allocator_{alloc}
+                : data_{local_}, size_{}, capacity_{local_capacity_},
+                  allocator_{alloc}
             {
                 // TODO: if pos < other.size() throw out_of_range.
                 auto len = min(n, other.size() - pos);
@@ -508,39 +531,41 @@ namespace std
             }
 
             basic_string(const value_type* str, size_type n, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{n}, capacity_{n}, allocator_{alloc}
+                : data_{local_}, size_{}, capacity_{local_capacity_},
+                  allocator_{alloc}
             {
-                init_(str, size_);
+                init_(str, n);
             }
 
             basic_string(const value_type* str, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{}, capacity_{}, allocator_{alloc}
+                : data_{local_}, size_{}, capacity_{local_capacity_},
+                  allocator_{alloc}
             {
                 init_(str, traits_type::length(str));
             }
 
             basic_string(size_type n, value_type c, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{n}, capacity_{n + 1}, allocator_{alloc}
+                : data_{local_}, size_{}, capacity_{local_capacity_},
+                  allocator_{alloc}
             {
-                data_ = allocator_.allocate(capacity_);
-                for (size_type i = 0; i < size_; ++i)
-                    traits_type::assign(data_[i], c);
+                resize_without_copy_(n + 1);
+                traits_type::assign(data_, n, c);
+                size_ = n;
                 ensure_null_terminator_();
             }
 
             template<class InputIterator>
             basic_string(InputIterator first, InputIterator last,
                          const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{}, capacity_{}, allocator_{alloc}
+                : data_{local_}, size_{}, capacity_{local_capacity_},
+                  allocator_{alloc}
             {
                 if constexpr (is_integral<InputIterator>::value)
                 { // Required by the standard.
-                    size_ = static_cast<size_type>(first);
-                    capacity_ = size_;
-                    data_ = allocator_.allocate(capacity_);
-
-                    for (size_type i = 0; i < size_; ++i)
-                        traits_type::assign(data_[i], static_cast<value_type>(last));
+                    auto n = static_cast<size_type>(first);
+                    resize_without_copy_(n + 1);
+                    traits_type::assign(data_, n, static_cast<value_type>(last));
+                    size_ = n;
                     ensure_null_terminator_();
                 }
                 else
@@ -555,31 +580,28 @@ namespace std
             { /* DUMMY BODY */ }
 
             basic_string(const basic_string& other, const allocator_type& alloc)
-                : data_{}, size_{other.size_}, capacity_{other.capacity_}, allocator_{alloc}
+                : data_{local_}, size_{}, capacity_{local_capacity_},
+                  allocator_{alloc}
             {
-                init_(other.data(), size_);
+                init_(other.data(), other.size());
             }
 
             basic_string(basic_string&& other, const allocator_type& alloc)
-                : data_{other.data_}, size_{other.size_}, capacity_{other.capacity_}, allocator_{alloc}
+                : data_{local_}, size_{}, capacity_{local_capacity_},
+                  allocator_{alloc}
             {
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                steal_(other);
             }
 
             ~basic_string()
             {
-                allocator_.deallocate(data_, capacity_);
+                deallocate_();
             }
 
             basic_string& operator=(const basic_string& other)
             {
                 if (this != &other)
-                {
-                    basic_string tmp{other};
-                    swap(tmp);
-                }
+                    init_(other.data(), other.size());
 
                 return *this;
             }
@@ -596,14 +618,14 @@ namespace std
 
             basic_string& operator=(const value_type* other)
             {
-                *this = basic_string{other};
+                init_(other, traits_type::length(other));
 
                 return *this;
             }
 
             basic_string& operator=(value_type c)
             {
-                *this = basic_string{1, c};
+                *this = basic_string(1, c);
 
                 return *this;
             }
@@ -704,9 +726,9 @@ namespace std
                 // TODO: if new_size > max_size() throw length_error.
                 if (new_size > size_)
                 {
-                    ensure_free_space_(new_size - size_ + 1);
+                    ensure_free_space_(new_size - size_);
                     for (size_type i = size_; i < new_size; ++i)
-                        traits_type::assign(data_[i], i);
+                        traits_type::assign(data_[i], c);
                 }
 
                 size_ = new_size;
@@ -720,7 +742,8 @@ namespace std
 
             size_type capacity() const noexcept
             {
-                return capacity_;
+                // One element is reserved for the null terminator.
+                return capacity_ - 1;
             }
 
             void reserve(size_type new_capacity = 0)
@@ -728,21 +751,42 @@ namespace std
                 // TODO: if new_capacity > max_size() throw
                 //       length_error (this function shall have no
                 //       effect in such case)
-                if (new_capacity > capacity_)
-                    resize_with_copy_(size_, new_capacity);
-                else if (new_capacity < capacity_)
+                if (new_capacity > capacity())
+                    resize_with_copy_(size_, new_capacity + 1);
+                else if (new_capacity < capacity())
                     shrink_to_fit(); // Non-binding request, but why not.
             }
 
             void shrink_to_fit()
             {
-                if (size_ != capacity_)
-                    resize_with_copy_(size_, capacity_);
+                if (is_local_() || size_ + 1 == capacity_)
+                    return;
+
+                if (size_ < local_capacity_)
+                {
+                    traits_type::copy(local_, data_, size_);
+                    allocator_.deallocate(data_, capacity_);
+
+                    data_ = local_;
+                    capacity_ = local_capacity_;
+                }
+                else
+                {
+                    auto new_data = allocator_.allocate(size_ + 1);
+                    traits_type::copy(new_data, data_, size_);
+                    allocator_.deallocate(data_, capacity_);
+
+                    data_ = new_data;
+                    capacity_ = size_ + 1;
+                }
+
+                ensure_null_terminator_();
             }
 
             void clear() noexcept
             {
                 size_ = 0;
+                ensure_null_terminator_();
             }
 
             bool empty() const noexcept
@@ -841,7 +885,16 @@ namespace std
             basic_string& append(const value_type* str, size_type n)
             {
                 // TODO: if (size_ + n > max_size()) throw length_error
-                ensure_free_space_(n);
+                if (is_inside_(str))
+                {
+                    // Appending a part of itself, which can get reallocated.
+                    auto offset = static_cast<size_type>(str - data_);
+                    ensure_free_space_(n);
+                    str = data_ + offset;
+                }
+                else
+                    ensure_free_space_(n);
+
                 traits_type::copy(data_ + size(), str, n);
                 size_ += n;
                 ensure_null_terminator_();
@@ -895,7 +948,6 @@ namespace std
                 if (pos < str.size())
                 {
                     auto len = min(n, str.size() - pos);
-                    ensure_free_space_(len);
 
                     return assign(str.data() + pos, len);
                 }
@@ -907,10 +959,7 @@ namespace std
             basic_string& assign(const value_type* str, size_type n)
             {
                 // TODO: if (n > max_size()) throw length_error.
-                resize_without_copy_(n + 1);
-                traits_type::copy(begin(), str, n);
-                size_ = n;
-                ensure_null_terminator_();
+                init_(str, n);
 
                 return *this;
             }
@@ -956,6 +1005,14 @@ namespace std
             {
                 // TODO: throw out_of_range if pos > size()
                 // TODO: throw length_error if size() + n > max_size()
+                if (is_inside_(str))
+                {
+                    // Inserting a part of itself, which gets shifted.
+                    basic_string tmp{str, n};
+
+                    return insert(pos, tmp.data(), n);
+                }
+
                 ensure_free_space_(n);
 
                 copy_backward_(begin() + pos, end(), end() + n);
@@ -1031,7 +1088,7 @@ namespace std
             basic_string& erase(size_type pos = 0, size_type n = npos)
             {
                 auto len = min(n, size_ - pos);
-                copy_(begin() + pos + n, end(), begin() + pos);
+                copy_(begin() + pos + len, end(), begin() + pos);
                 size_ -= len;
                 ensure_null_terminator_();
 
@@ -1083,7 +1140,7 @@ namespace std
                 auto len = min(n1, size_ - pos);
 
                 basic_string tmp{};
-                tmp.resize_without_copy_(size_ - len + n2);
+                tmp.resize_without_copy_(size_ - len + n2 + 1);
 
                 // Prefix.
                 copy_(begin(), begin() + pos, tmp.begin());
@@ -1095,6 +1152,7 @@ namespace std
                 copy_(begin() + pos + len, end(), tmp.begin() + pos + n2);
 
                 tmp.size_ = size_ - len + n2;
+                tmp.ensure_null_terminator_();
                 swap(tmp);
                 return *this;
             }
@@ -1160,9 +1218,19 @@ namespace std
                 noexcept(allocator_traits<allocator_type>::propagate_on_container_swap::value ||
                          allocator_traits<allocator_type>::is_always_equal::value)
             {
-                std::swap(data_, other.data_);
-                std::swap(size_, other.size_);
-                std::swap(capacity_, other.capacity_);
+                if (!is_local_() && !other.is_local_())
+                {
+                    std::swap(data_, other.data_);
+                    std::swap(size_, other.size_);
+                    std::swap(capacity_, other.capacity_);
+                }
+                else
+                {
+                    // At least one inline buffer has to be copied.
+                    basic_string tmp{move(*this)};
+                    steal_(other);
+                    other.steal_(tmp);
+                }
             }
 
             /**
@@ -1476,32 +1544,82 @@ namespace std
             }
 
         private:
+            /**
+             * Short strings (including the null terminator) are
+             * stored in the local_ buffer instead of the heap,
+             * in which case data_ points to local_. This saves
+             * an allocation for most of the temporary strings.
+             */
+            static constexpr size_type local_capacity_{
+                16 / sizeof(value_type) > 1 ? 16 / sizeof(value_type) : 2
+            };
+
             value_type* data_;
             size_type size_;
             size_type capacity_;
             allocator_type allocator_;
+            value_type local_[local_capacity_];
 
             template<class C, class T, class A>
             friend class basic_stringbuf;
 
+            bool is_local_() const noexcept
+            {
+                return data_ == local_;
+            }
+
+            bool is_inside_(const value_type* str) const noexcept
+            {
+                return data_ <= str && str <= data_ + size_;
+            }
+
+            void deallocate_()
+            {
+                if (!is_local_())
+                    allocator_.deallocate(data_, capacity_);
+            }
+
             /**
-             * Arbitrary value, standard just requires
-             * data() to have some capacity.
-             * (Well, we could've done data_ = &data_ and
-             * set capacity to 0, but that would be too cryptic.)
+             * Takes over the contents of other, which is left
+             * empty. This string has to be empty and local.
              */
-            static constexpr size_type default_capacity_{4};
+            void steal_(basic_string& other) noexcept
+            {
+                if (other.is_local_())
+                    traits_type::copy(local_, other.local_, other.size_ + 1);
+                else
+                {
+                    data_ = other.data_;
+                    capacity_ = other.capacity_;
+                }
+                size_ = other.size_;
+
+                other.data_ = other.local_;
+                other.size_ = 0;
+                other.capacity_ = local_capacity_;
+                other.ensure_null_terminator_();
+            }
 
             void init_(const value_type* str, size_type size)
             {
-                if (data_)
-                    allocator_.deallocate(data_, capacity_);
+                if (size + 1 > capacity_)
+                {
+                    /**
+                     * Note: The source can be inside of our
+                     *       old buffer, so it's freed only
+                     *       after the copy.
+                     */
+                    auto new_data = allocator_.allocate(size + 1);
+                    traits_type::copy(new_data, str, size);
+                    deallocate_();
+
+                    data_ = new_data;
+                    capacity_ = size + 1;
+                }
+                else
+                    traits_type::move(data_, str, size);
 
                 size_ = size;
-                capacity_ = size + 1;
-
-                data_ = allocator_.allocate(capacity_);
-                traits_type::copy(data_, str, size);
                 ensure_null_terminator_();
             }
 
@@ -1526,30 +1644,32 @@ namespace std
 
             void resize_without_copy_(size_type capacity)
             {
-                if (data_)
-                    allocator_.deallocate(data_, capacity_);
+                if (capacity > capacity_)
+                {
+                    deallocate_();
+
+                    data_ = allocator_.allocate(capacity);
+                    capacity_ = capacity;
+                }
 
-                data_ = allocator_.allocate(capacity);
                 size_ = 0;
-                capacity_ = capacity;
                 ensure_null_terminator_();
             }
 
             void resize_with_copy_(size_type size, size_type capacity)
             {
-                if(capacity_ == 0 || capacity_ < capacity)
+                if (capacity_ < capacity)
                 {
                     auto new_data = allocator_.allocate(capacity);
 
                     auto to_copy = min(size, size_);
-                    traits_type::move(new_data, data_, to_copy);
-
-                    std::swap(data_, new_data);
+                    traits_type::copy(new_data, data_, to_copy);
 
-                    allocator_.deallocate(new_data, capacity_);
+                    deallocate_();
+                    data_ = new_data;
+                    capacity_ = capacity;
                 }
 
-                capacity_ = capacity;
                 size_ = size;
                 ensure_null_terminator_();
             }
@@ -1670,7 +1790,7 @@ namespace std
     operator+(Char lhs,
               const basic_string<Char, Traits, Allocator>& rhs)
     {
-        return basic_string<Char, Traits, Allocator>{1, lhs}.append(rhs);
+        return basic_string<Char, Traits, Allocator>(1, lhs).append(rhs);
     }
 
     template<class Char, class Traits, class Allocator>
@@ -1702,7 +1822,7 @@ namespace std
     operator+(const basic_string<Char, Traits, Allocator>& lhs,
               Char rhs)
     {
-        return lhs + basic_string<Char, Traits, Allocator>{1, rhs};
+        return lhs + basic_string<Char, Traits, Allocator>(1, rhs);
     }
 
     template<class Char, class Traits, class Allocator>
@@ -1931,20 +2051,40 @@ namespace std
     {
         size_t operator()(const string& str) const noexcept
         {
-            size_t res{};
+            return aux::hash_bytes(
+                str.data(), str.size() * sizeof(string::value_type)
+            );
+        }
 
-            /**
-             * Note: No need for fancy algorithms here,
-             *       std::hash is used for indexing, not
-             *       cryptography.
-             */
-            for (const auto& c: str)
-                res = res * 5 + (res >> 3) + static_cast<size_t>(c);
+        using argument_type = string;
+        using result_type   = size_t;
+    };
 
-            return res;
+    template<>
+    struct hash<u16string>
+    {
+        size_t operator()(const u16string& str) const noexcept
+        {
+            return aux::hash_bytes(
+                str.data(), str.size() * sizeof(u16string::value_type)
+            );
         }
 
-        using argument_type = string;
+        using argument_type = u16string;
+        using result_type   = size_t;
+    };
+
+    template<>
+    struct hash<u32string>
+    {
+        size_t operator()(const u32string& str) const noexcept
+        {
+            return aux::hash_bytes(
+                str.data(), str.size() * sizeof(u32string::value_type)
+            );
+        }
+
+        using argument_type = u32string;
         using result_type   = size_t;
     };
 
@@ -1953,17 +2093,15 @@ namespace std
     {
         size_t operator()(const wstring& str) const noexcept
         {
-            // TODO: implement
-            __unimplemented();
-            return size_t{};
+            return aux::hash_bytes(
+                str.data(), str.size() * sizeof(wstring::value_type)
+            );
         }
 
         using argument_type = wstring;
         using result_type   = size_t;
     };
 
-    // TODO: add those other 2 string types
-
     /**
      * 21.7, suffix for basic_string literals:
      */
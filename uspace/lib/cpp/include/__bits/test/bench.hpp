@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_TEST_BENCH
+#define LIBCPP_BITS_TEST_BENCH
+
+#include <__bits/test/test.hpp>
+#include <chrono>
+#include <cstdint>
+
+namespace std::test
+{
+    /**
+     * Micro benchmarks are test suites that also measure
+     * how long their individual parts take. They still
+     * check the results of the benchmarked operations,
+     * so that a fast but broken implementation does not
+     * go unnoticed. They are not part of the default
+     * test set, run them with 'cpptest -b'.
+     */
+    class bench_suite: public test_suite
+    {
+        protected:
+            template<class Fun>
+            void bench(const char* bname, Fun&& fun)
+            {
+                auto start = chrono::steady_clock::now();
+                fun();
+                auto end = chrono::steady_clock::now();
+
+                report_time(bname, (end - start).count());
+            }
+
+            /**
+             * Benchmarked code should feed its results
+             * here, so that the compiler cannot optimize
+             * it away.
+             */
+            void consume(uint64_t val)
+            {
+                sink_ += val;
+            }
+
+            void report_time(const char*, int64_t);
+
+        private:
+            volatile uint64_t sink_{};
+    };
+}
+
+#endif
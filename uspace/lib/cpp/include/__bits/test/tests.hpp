@@ -29,8 +29,12 @@
 #ifndef LIBCPP_BITS_TEST_TESTS
 #define LIBCPP_BITS_TEST_TESTS
 
+#include <__bits/test/bench.hpp>
 #include <__bits/test/test.hpp>
 #include <cstdio>
+#include <memory_resource>
+#include <string>
+#include <valarray>
 #include <vector>
 
 namespace std::test
@@ -123,6 +127,7 @@ namespace std::test
             void test_find();
             void test_substr();
             void test_compare();
+            void test_short_strings();
     };
 
     class bitset_test: public test_suite
@@ -219,6 +224,20 @@ namespace std::test
             void test_multi();
     };
 
+    class flat_hash_map_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_constructors_and_assignment();
+            void test_emplace_insert();
+            void test_erase();
+            void test_growth();
+            void test_set();
+    };
+
     class numeric_test: public test_suite
     {
         public:
@@ -293,6 +312,74 @@ namespace std::test
         private:
             void test_non_modifying();
             void test_mutating();
+            void test_sorting();
+    };
+
+    class atomic_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_integral();
+            void test_pointer();
+            void test_generic();
+            void test_flag();
+            void test_free_functions();
+    };
+
+    class mutex_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_timed_mutex();
+            void test_recursive_timed_mutex();
+            void test_shared_timed_mutex();
+            void test_condition_variable();
+    };
+
+    class regex_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_match();
+            void test_search();
+            void test_groups();
+            void test_assertions();
+            void test_backtracking();
+            void test_flags();
+            void test_replace();
+            void test_iterators();
+    };
+
+    class valarray_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_construction_and_assignment();
+            void test_operators();
+            void test_subsets();
+            void test_members();
+            void test_math();
+    };
+
+    class memory_resource_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_global_resources();
+            void test_monotonic();
+            void test_pools();
+            void test_synchronized_pool();
+            void test_containers();
     };
 
     class future_test: public test_suite
@@ -308,6 +395,151 @@ namespace std::test
             void test_packaged_task();
             void test_shared_future();
     };
+
+    class hash_table_bench: public bench_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            template<class Map>
+            void bench_ints(const char*);
+
+            template<class Map>
+            void bench_strings(const char*);
+
+            static constexpr size_t int_count_{100'000};
+            static constexpr size_t string_count_{20'000};
+            static constexpr size_t lookup_stride_{7919};
+    };
+
+    class hash_bench: public bench_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_equal_strings();
+            void test_collisions();
+            void bench_throughput();
+            void bench_table();
+
+            template<class Fun>
+            void test_spread(const char*, Fun&&);
+
+            static constexpr size_t bucket_count_{4096};
+            static constexpr size_t key_count_{200'000};
+    };
+
+    class string_bench: public bench_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void bench_key_parsing();
+            void bench_formatting();
+            void bench_concatenation();
+
+            void report_allocations(const char*, size_t);
+
+            template<class String>
+            uint64_t parse_keys_(const vector<String>&);
+
+            template<class String, class Stream>
+            uint64_t format_records_(size_t);
+
+            template<class String>
+            uint64_t concatenate_(size_t);
+
+            static constexpr size_t line_count_{20'000};
+            static constexpr size_t record_count_{20'000};
+    };
+
+    class shared_ptr_bench: public bench_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void bench_copies();
+            void bench_contended_copies();
+            void bench_weak_locks();
+
+            static constexpr size_t copy_count_{400'000};
+            static constexpr size_t thread_count_{4};
+    };
+
+    class regex_bench: public bench_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void bench_literal();
+            void bench_alternation();
+            void bench_submatches();
+
+            string make_buffer_();
+
+            static constexpr size_t buffer_size_{1'000'000};
+            static constexpr size_t rounds_{10};
+    };
+
+    class valarray_bench: public bench_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void bench_fused();
+            void bench_chained();
+            void bench_reduction();
+
+            valarray<double> make_data_(double);
+
+            static constexpr size_t element_count_{1 << 16};
+            static constexpr size_t rounds_{200};
+    };
+
+    class memory_resource_bench: public bench_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void bench_map();
+            void bench_list();
+
+            template<class Map>
+            uint64_t fill_map_(Map&);
+
+            static constexpr size_t element_count_{20'000};
+            static constexpr size_t rounds_{20};
+    };
+
+    class sort_bench: public bench_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void bench_inputs();
+            void bench_partial();
+            void bench_parallel();
+
+            vector<int> random_data_(size_t, int);
+
+            static constexpr size_t element_count_{200'000};
+    };
 }
 
 #endif
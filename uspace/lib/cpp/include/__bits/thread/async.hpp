@@ -69,20 +69,12 @@ namespace std
             /**
              * Note: The case when async | deferred is set in policy
              *       is implementation defined, feel free to change.
-             * Rationale: We chose the 'deferred' policy, because unlike
-             *            the 'async' policy it carries no possible
-             *            surprise ('async' can fail due to thread
-             *            creation error).
+             * Rationale: We chose the 'async' policy, because that
+             *            is the only one that runs the function in
+             *            parallel with the caller and it cannot fail,
+             *            as thread creation falls back to fibrils.
              */
-            if (async && deferred)
-            {
-                return future<result_t>{
-                    new aux::deferred_shared_state<
-                        result_t, F, Args...
-                    >{forward<F>(f), forward<Args>(args)...}
-                };
-            }
-            else if (async)
+            if (async)
             {
                 return future<result_t>{
                     new aux::async_shared_state<
@@ -92,10 +84,6 @@ namespace std
             }
             else if (deferred)
             {
-               /**
-                * Duplicated on purpose because of the default.
-                * Do not remove!
-                */
                 return future<result_t>{
                     new aux::deferred_shared_state<
                         result_t, F, Args...
@@ -86,7 +86,12 @@ namespace std
                     cv_, *lock.mutex()->native_handle(), aux::time_until(abs_time)
                 );
 
-                if (ret == EOK)
+                /**
+                 * Note: The deadline is tracked by the uptime clock,
+                 *       so the timeout is only reported once it has
+                 *       also passed according to Clock.
+                 */
+                if (ret == EOK || Clock::now() < abs_time)
                     return cv_status::no_timeout;
                 else
                     return cv_status::timeout;
@@ -170,7 +175,12 @@ namespace std
                     cv_, *lock.mutex()->native_handle(), aux::time_until(abs_time)
                 );
 
-                if (ret == EOK)
+                /**
+                 * Note: The deadline is tracked by the uptime clock,
+                 *       so the timeout is only reported once it has
+                 *       also passed according to Clock.
+                 */
+                if (ret == EOK || Clock::now() < abs_time)
                     return cv_status::no_timeout;
                 else
                     return cv_status::timeout;
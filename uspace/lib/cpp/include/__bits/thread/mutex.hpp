@@ -117,16 +117,13 @@ namespace std
             {
                 auto time = aux::threading::time::convert(rel_time);
 
-                return aux::threading::mutex::try_lock_for(time);
+                return aux::threading::mutex::try_lock_for(mtx_, time);
             }
 
             template<class Clock, class Duration>
             bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
             {
-                auto dur = (abs_time - Clock::now());
-                auto time = aux::threading::time::convert(dur);
-
-                return aux::threading::mutex::try_lock_for(time);
+                return try_lock_for(abs_time - Clock::now());
             }
 
             using native_handle_type = aux::mutex_t*;
@@ -162,29 +159,28 @@ namespace std
             bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
             {
                 if (owner_ == this_thread::get_id())
+                {
+                    ++lock_level_;
+
                     return true;
+                }
 
                 auto time = aux::threading::time::convert(rel_time);
-                auto ret = aux::threading::mutex::try_lock_for(time);
+                auto ret = aux::threading::mutex::try_lock_for(mtx_, time);
 
                 if (ret)
-                    ++lock_level_;
+                {
+                    owner_ = this_thread::get_id();
+                    lock_level_ = 1;
+                }
+
                 return ret;
             }
 
             template<class Clock, class Duration>
             bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
             {
-                if (owner_ == this_thread::get_id())
-                    return true;
-
-                auto dur = (abs_time - Clock::now());
-                auto time = aux::threading::time::convert(dur);
-                auto ret = aux::threading::mutex::try_lock_for(time);
-
-                if (ret)
-                    ++lock_level_;
-                return ret;
+                return try_lock_for(abs_time - Clock::now());
             }
 
             using native_handle_type = aux::mutex_t*;
@@ -57,16 +57,13 @@ namespace std
             {
                 auto time = aux::threading::time::convert(rel_time);
 
-                return aux::threading::shared_mutex::try_lock_for(time);
+                return aux::threading::shared_mutex::try_lock_for(mtx_, time);
             }
 
             template<class Clock, class Duration>
             bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
             {
-                auto dur = (abs_time - Clock::now());
-                auto time = aux::threading::time::convert(dur);
-
-                return aux::threading::shared_mutex::try_lock_for(time);
+                return try_lock_for(abs_time - Clock::now());
             }
 
             void lock_shared();
@@ -78,16 +75,13 @@ namespace std
             {
                 auto time = aux::threading::time::convert(rel_time);
 
-                return aux::threading::shared_mutex::try_lock_shared_for(time);
+                return aux::threading::shared_mutex::try_lock_shared_for(mtx_, time);
             }
 
             template<class Clock, class Duration>
             bool try_lock_shared_until(const chrono::time_point<Clock, Duration>& abs_time)
             {
-                auto dur = (abs_time - Clock::now());
-                auto time = aux::threading::time::convert(dur);
-
-                return aux::threading::shared_mutex::try_lock_shared_for(time);
+                return try_lock_shared_for(abs_time - Clock::now());
             }
 
             using native_handle_type = aux::shared_mutex_t*;
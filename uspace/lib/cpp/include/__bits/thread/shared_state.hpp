@@ -178,6 +178,15 @@ namespace std::aux
              */
             virtual future_status timed_wait_(aux::time_unit_t time) const
             {
+                /**
+                 * Note: The value might have been set between
+                 *       the check in wait_for/wait_until and
+                 *       locking the mutex, in which case the
+                 *       notification is already gone.
+                 */
+                if (value_set_)
+                    return future_status::ready;
+
                 auto res = aux::threading::condvar::wait_for(
                     const_cast<aux::condvar_t&>(condvar_),
                     const_cast<aux::mutex_t&>(mutex_), time
@@ -57,6 +57,12 @@ namespace std
                     aux::threading::condvar::init(join_cv_);
                 }
 
+                /**
+                 * Threads delete the wrapper through this base,
+                 * which has to destroy the callable with it.
+                 */
+                virtual ~joinable_wrapper() = default;
+
                 void join()
                 {
                     aux::threading::mutex::lock(join_mtx_);
@@ -70,14 +76,37 @@ namespace std
                     return finished_;
                 }
 
-                void detach()
+                /**
+                 * Called by the thread when its callable returns.
+                 * Returns true if the thread has been detached, in which
+                 * case the thread owns the wrapper and has to delete it.
+                 * Otherwise the wrapper must not be touched after this
+                 * call, as the joiner may delete it at any time.
+                 */
+                bool finish()
                 {
-                    detached_ = true;
+                    aux::threading::mutex::lock(join_mtx_);
+                    finished_ = true;
+                    bool detached = detached_;
+                    aux::threading::condvar::broadcast(join_cv_);
+                    aux::threading::mutex::unlock(join_mtx_);
+
+                    return detached;
                 }
 
-                bool detached() const
+                /**
+                 * Returns true if the thread has already finished, in
+                 * which case the caller owns the wrapper and has to
+                 * delete it.
+                 */
+                bool detach()
                 {
-                    return detached_;
+                    aux::threading::mutex::lock(join_mtx_);
+                    detached_ = true;
+                    bool finished = finished_;
+                    aux::threading::mutex::unlock(join_mtx_);
+
+                    return finished;
                 }
 
             protected:
@@ -98,12 +127,6 @@ namespace std
                 void operator()()
                 {
                     callable_();
-
-                    aux::threading::mutex::lock(join_mtx_);
-                    finished_ = true;
-                    aux::threading::mutex::unlock(join_mtx_);
-
-                    aux::threading::condvar::broadcast(join_cv_);
                 }
 
             private:
@@ -196,7 +219,7 @@ namespace std
             auto callable = static_cast<CallablePtr>(clbl);
             (*callable)();
 
-            if (callable->detached())
+            if (callable->finish())
                 delete callable;
 
             return 0;
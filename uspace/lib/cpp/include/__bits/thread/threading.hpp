@@ -30,9 +30,12 @@
 #define LIBCPP_BITS_THREAD_THREADING
 
 #include <chrono>
+#include <ctime>
 
+#include <errno.h>
 #include <fibril.h>
 #include <fibril_synch.h>
+#include <thread.h>
 
 namespace std::aux
 {
@@ -108,8 +111,12 @@ namespace std::aux
 
             static bool try_lock_for(mutex_type& mtx, time_unit timeout)
             {
-                // TODO: we need fibril_mutex_trylock_for() :/
-                return try_lock(mtx);
+                if (timeout <= 0)
+                    return try_lock(mtx);
+
+                auto expires = time::deadline(timeout);
+
+                return ::helenos::fibril_mutex_lock_until(&mtx, &expires) == EOK;
             }
         };
 
@@ -127,7 +134,17 @@ namespace std::aux
 
             static int wait_for(condvar_type& cv, mutex_type& mtx, time_unit timeout)
             {
-                return ::helenos::fibril_condvar_wait_timeout(&cv, &mtx, timeout);
+                /**
+                 * Note: A zero timeout means no timeout at all
+                 *       to fibril_condvar_wait_timeout, which is
+                 *       why the deadline is computed here.
+                 */
+                if (timeout <= 0)
+                    return ETIMEOUT;
+
+                auto expires = time::deadline(timeout);
+
+                return ::helenos::fibril_condvar_wait_until(&cv, &mtx, &expires);
             }
 
             static void signal(condvar_type& cv)
@@ -153,6 +170,20 @@ namespace std::aux
             {
                 ::helenos::fibril_usleep(time);
             }
+
+            /**
+             * Turns a relative timeout into the absolute
+             * uptime based deadline the timed fibril
+             * synchronization primitives expect.
+             */
+            static ::std::timespec deadline(time_unit timeout)
+            {
+                ::std::timespec ts{};
+                ::helenos::getuptime(&ts);
+                ::helenos::ts_add_diff(&ts, USEC2NSEC(timeout));
+
+                return ts;
+            }
         };
 
         struct shared_mutex
@@ -184,38 +215,99 @@ namespace std::aux
 
             static bool try_lock(shared_mutex_type& mtx)
             {
-                // TODO: rwlocks don't have try locking capabilities
-                lock(mtx);
-
-                return true;
+                return ::helenos::fibril_rwlock_write_trylock(&mtx);
             }
 
             static bool try_lock_shared(shared_mutex_type& mtx)
             {
-                lock(mtx);
-
-                return true;
+                return ::helenos::fibril_rwlock_read_trylock(&mtx);
             }
 
             static bool try_lock_for(shared_mutex_type& mtx, time_unit timeout)
             {
-                return try_lock(mtx);
+                if (timeout <= 0)
+                    return try_lock(mtx);
+
+                auto expires = time::deadline(timeout);
+
+                return ::helenos::fibril_rwlock_write_lock_until(&mtx, &expires) == EOK;
             }
 
             static bool try_lock_shared_for(shared_mutex_type& mtx, time_unit timeout)
             {
-                return try_lock(mtx);
+                if (timeout <= 0)
+                    return try_lock_shared(mtx);
+
+                auto expires = time::deadline(timeout);
+
+                return ::helenos::fibril_rwlock_read_lock_until(&mtx, &expires) == EOK;
             }
         };
     };
 
+    /**
+     * Threads of this policy are kernel threads, so unlike
+     * fibrils, which all share the four runner threads of
+     * a multithreaded task, every one of them adds another
+     * thread that can run on a separate processor.
+     * Note: A kernel thread runs as a heavy fibril, so the
+     *       synchronization primitives are the fibril ones,
+     *       which are built on futexes and are safe to use
+     *       across threads once the task is multithreaded.
+     */
     template<>
-    struct threading_policy<thread_tag>
+    struct threading_policy<thread_tag>: threading_policy<fibril_tag>
     {
-        // TODO:
+        struct thread
+        {
+            template<class Callable, class Payload>
+            static thread_type create(Callable clbl, Payload& pld)
+            {
+                ::helenos::fibril_enable_multithreaded();
+
+                thread_type res{};
+                auto rc = ::helenos::thread_create(
+                    clbl, (void*)&pld, "cpp thread", &res
+                );
+
+                if (rc == EOK)
+                    return res;
+
+                /**
+                 * Running the callable in a fibril is the
+                 * only sensible thing we can do when we run
+                 * out of threads, as we cannot throw.
+                 */
+                res = ::helenos::fibril_create(clbl, (void*)&pld);
+                if (res)
+                    ::helenos::fibril_add_ready(res);
+
+                return res;
+            }
+
+            static void start(thread_type)
+            {
+                /**
+                 * Note: Kernel threads run as soon as they are
+                 *       created and failed creations fall back
+                 *       to fibrils that are readied right away,
+                 *       so there is nothing to do here.
+                 */
+            }
+
+            static thread_type this_thread()
+            {
+                return ::helenos::fibril_get_id();
+            }
+
+            static void yield()
+            {
+                ::helenos::fibril_yield();
+            }
+        };
     };
 
-    using default_tag = fibril_tag;
+    using default_tag = thread_tag;
     using threading = threading_policy<default_tag>;
 
     using thread_t       = typename threading::thread_type;
@@ -29,8 +29,10 @@
 #include <__bits/test/tests.hpp>
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace std::test
 {
@@ -41,6 +43,7 @@ namespace std::test
 
         test_non_modifying();
         test_mutating();
+        test_sorting();
 
         return end();
     }
@@ -293,4 +296,95 @@ namespace std::test
         );
         test_eq("transform pt2", res6, data10.end());
     }
+
+    void algorithm_test::test_sorting()
+    {
+        /**
+         * Long enough to get past the insertion sort
+         * threshold, with plenty of duplicates.
+         */
+        std::vector<int> data1{};
+        for (int i = 0; i < 1000; ++i)
+            data1.push_back((i * 7919) % 101);
+
+        auto data2 = data1;
+        std::sort(data2.begin(), data2.end());
+        test("sort", std::is_sorted(data2.begin(), data2.end()));
+        test_eq("sort size", data2.size(), data1.size());
+
+        std::sort(data2.begin(), data2.end(), std::greater<int>{});
+        test("sort with comparator",
+             std::is_sorted(data2.begin(), data2.end(), std::greater<int>{}));
+
+        std::sort(data2.begin(), data2.end());
+        test("sort reversed input", std::is_sorted(data2.begin(), data2.end()));
+
+        auto check1 = {1, 2, 3, 4, 5};
+        std::array<int, 5> data3{5, 3, 1, 4, 2};
+        std::sort(data3.begin(), data3.end());
+        test_eq(
+            "sort short", check1.begin(), check1.end(),
+            data3.begin(), data3.end()
+        );
+
+        std::vector<std::pair<int, int>> data4{};
+        for (int i = 0; i < 1000; ++i)
+            data4.emplace_back((i * 7919) % 11, i);
+
+        std::stable_sort(
+            data4.begin(), data4.end(),
+            [](const auto& lhs, const auto& rhs){
+                return lhs.first < rhs.first;
+            }
+        );
+        bool stable{true};
+        for (size_t i = 1; i < data4.size(); ++i)
+        {
+            if (data4[i - 1].first > data4[i].first ||
+                (data4[i - 1].first == data4[i].first &&
+                 data4[i - 1].second > data4[i].second))
+                stable = false;
+        }
+        test("stable_sort", stable);
+
+        auto data5 = data1;
+        std::partial_sort(data5.begin(), data5.begin() + 20, data5.end());
+        test("partial_sort sorted",
+             std::is_sorted(data5.begin(), data5.begin() + 20));
+        test_eq("partial_sort smallest", data5[19], 1);
+        test("partial_sort rest",
+             std::all_of(data5.begin() + 20, data5.end(),
+                         [](auto x){ return x >= 1; }));
+
+        auto data6 = data1;
+        auto nth = data6.begin() + 500;
+        std::nth_element(data6.begin(), nth, data6.end());
+        test_eq("nth_element", *nth, data2[500]);
+        test("nth_element left",
+             std::all_of(data6.begin(), nth, [&](auto x){ return x <= *nth; }));
+        test("nth_element right",
+             std::all_of(nth, data6.end(), [&](auto x){ return x >= *nth; }));
+
+        std::vector<int> data7{1, 3, 5, 7, 9, 2, 4, 6, 8};
+        std::inplace_merge(data7.begin(), data7.begin() + 5, data7.end());
+        auto check2 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        test_eq(
+            "inplace_merge", check2.begin(), check2.end(),
+            data7.begin(), data7.end()
+        );
+
+        auto res1 = std::lower_bound(data7.begin(), data7.end(), 4);
+        test_eq("lower_bound", *res1, 4);
+        auto res2 = std::upper_bound(data7.begin(), data7.end(), 4);
+        test_eq("upper_bound", *res2, 5);
+
+        std::vector<int> data8{1, 2, 3, 4, 5};
+        auto res3 = std::rotate(data8.begin(), data8.begin() + 2, data8.end());
+        auto check3 = {3, 4, 5, 1, 2};
+        test_eq(
+            "rotate", check3.begin(), check3.end(),
+            data8.begin(), data8.end()
+        );
+        test_eq("rotate result", *res3, 1);
+    }
 }
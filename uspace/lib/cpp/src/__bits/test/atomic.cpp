@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <atomic>
+#include <cstdint>
+
+namespace std::test
+{
+    bool atomic_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_integral();
+        test_pointer();
+        test_generic();
+        test_flag();
+        test_free_functions();
+
+        return end();
+    }
+
+    const char* atomic_test::name()
+    {
+        return "atomic";
+    }
+
+    void atomic_test::test_integral()
+    {
+        std::atomic<int> a{5};
+        test_eq("load", a.load(), 5);
+        test_eq("conversion", static_cast<int>(a), 5);
+
+        a.store(7, std::memory_order_relaxed);
+        test_eq("store", a.load(std::memory_order_relaxed), 7);
+
+        test_eq("exchange old", a.exchange(10), 7);
+        test_eq("exchange new", a.load(), 10);
+
+        test_eq("fetch_add old", a.fetch_add(5), 10);
+        test_eq("fetch_sub old", a.fetch_sub(3), 15);
+        test_eq("after fetch ops", a.load(), 12);
+
+        test_eq("fetch_and", a.fetch_and(0b1010), 12);
+        test_eq("fetch_or", a.fetch_or(0b0001), 8);
+        test_eq("fetch_xor", a.fetch_xor(0b1111), 9);
+        test_eq("after bit ops", a.load(), 6);
+
+        test_eq("pre increment", ++a, 7);
+        test_eq("post increment", a++, 7);
+        test_eq("pre decrement", --a, 7);
+        test_eq("post decrement", a--, 7);
+        test_eq("compound add", a += 4, 10);
+        test_eq("compound sub", a -= 2, 8);
+        test_eq("compound and", a &= 12, 8);
+        test_eq("compound or", a |= 3, 11);
+        test_eq("compound xor", a ^= 1, 10);
+        test_eq("assignment", a = 20, 20);
+
+        int expected{19};
+        test("cas strong fails", !a.compare_exchange_strong(expected, 30));
+        test_eq("cas strong loads current", expected, 20);
+        test("cas strong succeeds", a.compare_exchange_strong(expected, 30));
+        test_eq("cas strong stores", a.load(), 30);
+
+        expected = 30;
+        while (!a.compare_exchange_weak(expected, 40, std::memory_order_acq_rel,
+                                        std::memory_order_acquire))
+        { /* DUMMY BODY */ }
+        test_eq("cas weak stores", a.load(), 40);
+
+        std::atomic<unsigned char> c{255};
+        ++c;
+        test_eq("unsigned wrap around", c.load(), static_cast<unsigned char>(0));
+
+        std::atomic<bool> b{false};
+        test("bool exchange", !b.exchange(true));
+        test("bool load", b.load());
+
+        test("int lock free", a.is_lock_free());
+        test("int always lock free", std::atomic<int>::is_always_lock_free);
+    }
+
+    void atomic_test::test_pointer()
+    {
+        int arr[]{0, 1, 2, 3, 4, 5, 6, 7};
+        std::atomic<int*> p{arr};
+
+        test_eq("pointer fetch_add old", p.fetch_add(2), &arr[0]);
+        test_eq("pointer fetch_add scaled", p.load(), &arr[2]);
+        test_eq("pointer fetch_sub old", p.fetch_sub(1), &arr[2]);
+        test_eq("pointer pre increment", ++p, &arr[2]);
+        test_eq("pointer post increment", p++, &arr[2]);
+        test_eq("pointer pre decrement", --p, &arr[2]);
+        test_eq("pointer compound add", p += 4, &arr[6]);
+        test_eq("pointer compound sub", p -= 5, &arr[1]);
+        test_eq("pointer deref", *p.load(), 1);
+
+        int* expected{&arr[1]};
+        test("pointer cas", p.compare_exchange_strong(expected, nullptr));
+        test_eq("pointer after cas", p.load(), static_cast<int*>(nullptr));
+    }
+
+    void atomic_test::test_generic()
+    {
+        struct point
+        {
+            int x;
+            int y;
+        };
+
+        std::atomic<point> a{point{1, 2}};
+        auto p = a.load();
+        test_eq("struct load x", p.x, 1);
+        test_eq("struct load y", p.y, 2);
+
+        auto old = a.exchange(point{3, 4});
+        test_eq("struct exchange old", old.x, 1);
+        test_eq("struct exchange new", a.load().y, 4);
+
+        point expected{3, 4};
+        test("struct cas", a.compare_exchange_strong(expected, point{5, 6}));
+        test_eq("struct after cas", a.load().x, 5);
+
+        expected = point{0, 0};
+        test("struct cas fails", !a.compare_exchange_strong(expected, point{7, 8}));
+        test_eq("struct cas loads current", expected.y, 6);
+
+        std::atomic<double> d{1.5};
+        d.store(2.5);
+        test_eq("double store", d.load(), 2.5);
+    }
+
+    void atomic_test::test_flag()
+    {
+        std::atomic_flag flag = ATOMIC_FLAG_INIT;
+        test("flag initially clear", !flag.test());
+        test("flag first test_and_set", !flag.test_and_set());
+        test("flag second test_and_set", flag.test_and_set());
+        test("flag set", flag.test(std::memory_order_acquire));
+
+        flag.clear(std::memory_order_release);
+        test("flag cleared", !flag.test());
+
+        // Does not block, the flag is not set.
+        flag.wait(true);
+        flag.notify_all();
+        test("flag wait on changed value", !flag.test());
+    }
+
+    void atomic_test::test_free_functions()
+    {
+        std::atomic<long> a{};
+        std::atomic_init(&a, 1L);
+        test_eq("atomic_init", std::atomic_load(&a), 1L);
+
+        std::atomic_store_explicit(&a, 2L, std::memory_order_release);
+        test_eq("atomic_store", std::atomic_load_explicit(&a, std::memory_order_acquire), 2L);
+        test_eq("atomic_exchange", std::atomic_exchange(&a, 3L), 2L);
+        test_eq("atomic_fetch_add", std::atomic_fetch_add(&a, 4L), 3L);
+        test_eq("atomic_fetch_sub", std::atomic_fetch_sub_explicit(&a, 2L,
+                std::memory_order_relaxed), 7L);
+        test_eq("atomic_fetch_or", std::atomic_fetch_or(&a, 8L), 5L);
+
+        long expected{13};
+        test("atomic_compare_exchange", std::atomic_compare_exchange_strong(&a, &expected, 0L));
+        test("atomic_is_lock_free", std::atomic_is_lock_free(&a));
+
+        // Does not block, the value differs.
+        std::atomic_wait(&a, 1L);
+        std::atomic_notify_one(&a);
+        test_eq("atomic_wait on changed value", a.load(), 0L);
+
+        std::atomic_flag flag = ATOMIC_FLAG_INIT;
+        test("atomic_flag_test_and_set", !std::atomic_flag_test_and_set(&flag));
+        std::atomic_flag_clear(&flag);
+        test("atomic_flag_clear", !std::atomic_flag_test(&flag));
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+}
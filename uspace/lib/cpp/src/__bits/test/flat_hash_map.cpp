@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace std::test
+{
+    bool flat_hash_map_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_constructors_and_assignment();
+        test_emplace_insert();
+        test_erase();
+        test_growth();
+        test_set();
+
+        return end();
+    }
+
+    const char* flat_hash_map_test::name()
+    {
+        return "flat_hash_map";
+    }
+
+    void flat_hash_map_test::test_constructors_and_assignment()
+    {
+        auto check1 = {1, 2, 3, 4, 5, 6, 7};
+        auto src1 = {
+            std::pair<const int, int>{3, 3},
+            std::pair<const int, int>{1, 1},
+            std::pair<const int, int>{5, 5},
+            std::pair<const int, int>{2, 2},
+            std::pair<const int, int>{7, 7},
+            std::pair<const int, int>{6, 6},
+            std::pair<const int, int>{4, 4}
+        };
+
+        std::aux::flat_hash_map<int, int> m1{src1};
+        test_contains(
+            "initializer list initialization",
+            check1.begin(), check1.end(), m1
+        );
+        test_eq("size", m1.size(), 7U);
+
+        std::aux::flat_hash_map<int, int> m2{src1.begin(), src1.end()};
+        test_contains(
+            "iterator range initialization",
+            check1.begin(), check1.end(), m2
+        );
+
+        std::aux::flat_hash_map<int, int> m3{m1};
+        test_contains(
+            "copy initialization",
+            check1.begin(), check1.end(), m3
+        );
+        test_eq("copy equality", (m1 == m3), true);
+
+        std::aux::flat_hash_map<int, int> m4{std::move(m1)};
+        test_contains(
+            "move initialization",
+            check1.begin(), check1.end(), m4
+        );
+        test_eq("move initialization - origin empty", m1.size(), 0U);
+        test_eq("empty", m1.empty(), true);
+
+        m1 = m4;
+        test_contains(
+            "copy assignment",
+            check1.begin(), check1.end(), m1
+        );
+
+        m4 = std::move(m1);
+        test_contains(
+            "move assignment",
+            check1.begin(), check1.end(), m4
+        );
+        test_eq("move assignment - origin empty", m1.size(), 0U);
+
+        m1 = src1;
+        test_contains(
+            "initializer list assignment",
+            check1.begin(), check1.end(), m1
+        );
+
+        std::size_t cnt{};
+        for (const auto& x: m1)
+        {
+            if (x.first == x.second)
+                ++cnt;
+        }
+        test_eq("iteration", cnt, 7U);
+    }
+
+    void flat_hash_map_test::test_emplace_insert()
+    {
+        std::aux::flat_hash_map<int, int> map1{};
+
+        auto res1 = map1.emplace(1, 2);
+        test_eq("first emplace succession", res1.second, true);
+        test_eq("first emplace equivalence pt1", res1.first->first, 1);
+        test_eq("first emplace equivalence pt2", res1.first->second, 2);
+
+        auto res2 = map1.emplace(1, 3);
+        test_eq("second emplace failure", res2.second, false);
+        test_eq("second emplace equivalence pt1", res2.first->first, 1);
+        test_eq("second emplace equivalence pt2", res2.first->second, 2);
+
+        std::aux::flat_hash_map<int, std::string> map2{};
+        auto res3 = map2.insert(std::pair<const int, const char*>{5, "A"});
+        test_eq("conversion insert succession", res3.second, true);
+        test_eq("conversion insert equivalence pt1", res3.first->first, 5);
+        test_eq("conversion insert equivalence pt2", res3.first->second, std::string{"A"});
+
+        auto res4 = map2.insert(std::pair<const int, std::string>{6, "B"});
+        test_eq("first insert succession", res4.second, true);
+        test_eq("first insert equivalence", res4.first->second, std::string{"B"});
+
+        auto res5 = map2.insert(std::pair<const int, std::string>{6, "C"});
+        test_eq("second insert failure", res5.second, false);
+        test_eq("second insert equivalence", res5.first->second, std::string{"B"});
+
+        auto res6 = map2.insert_or_assign(6, std::string{"D"});
+        test_eq("insert_or_*assign* result", res6.second, false);
+        test_eq("insert_or_*assign* equivalence", res6.first->second, std::string{"D"});
+
+        auto res7 = map2.insert_or_assign(7, std::string{"E"});
+        test_eq("*insert*_or_assign result", res7.second, true);
+        test_eq("*insert*_or_assign equivalence", res7.first->second, std::string{"E"});
+
+        auto res8 = map2.try_emplace(8, "F");
+        test_eq("try_emplace succession", res8.second, true);
+        test_eq("try_emplace equivalence", res8.first->second, std::string{"F"});
+
+        auto res9 = map2.try_emplace(8, "G");
+        test_eq("try_emplace failure", res9.second, false);
+        test_eq("try_emplace no change", res9.first->second, std::string{"F"});
+
+        std::aux::flat_hash_map<std::string, std::size_t> map3{};
+        map3["a"] = 1;
+        ++map3["a"];
+        ++map3["b"];
+        test_eq("operator[] pt1", map3["a"], 2U);
+        test_eq("operator[] pt2", map3["b"], 1U);
+        test_eq("operator[] pt3", map3["c"], 0U);
+        test_eq("operator[] size", map3.size(), 3U);
+        test_eq("at", map3.at("a"), 2U);
+        test_eq("count pt1", map3.count("b"), 1U);
+        test_eq("count pt2", map3.count("d"), 0U);
+    }
+
+    void flat_hash_map_test::test_erase()
+    {
+        std::aux::flat_hash_map<int, int> map{};
+        for (int i = 0; i < 100; ++i)
+            map.emplace(i, i * i);
+
+        map.erase(map.find(7));
+        test_eq("erase", map.find(7), map.end());
+        test_eq("erase size", map.size(), 99U);
+
+        auto res1 = map.erase(8);
+        test_eq("erase by key pt1", res1, 1U);
+        auto res2 = map.erase(8);
+        test_eq("erase by key pt2", res2, 0U);
+
+        bool ok{true};
+        for (int i = 0; i < 100; ++i)
+        {
+            if (i == 7 || i == 8)
+                continue;
+
+            auto it = map.find(i);
+            if (it == map.end() || it->second != i * i)
+                ok = false;
+        }
+        test_eq("erase keeps other elements", ok, true);
+
+        auto it = map.begin();
+        while (it != map.end())
+        {
+            if (it->first % 2 == 0)
+                it = map.erase(it);
+            else
+                ++it;
+        }
+        test_eq("erase while iterating size", map.size(), 49U);
+
+        ok = true;
+        for (const auto& x: map)
+        {
+            if (x.first % 2 == 0)
+                ok = false;
+        }
+        test_eq("erase while iterating", ok, true);
+
+        map.clear();
+        test_eq("clear", map.empty(), true);
+        test_eq("clear begin == end", map.begin(), map.end());
+    }
+
+    void flat_hash_map_test::test_growth()
+    {
+        std::aux::flat_hash_map<int, int> map{};
+        std::unordered_map<int, int> check{};
+
+        /**
+         * Interleave insertions and erasures so that
+         * the table has to deal with tombstones as
+         * well as with growing, the chained table
+         * serves as a reference.
+         */
+        for (int i = 0; i < 5000; ++i)
+        {
+            map.emplace(i, i);
+            check.emplace(i, i);
+            if (i % 3 == 0)
+            {
+                map.erase(i / 2);
+                check.erase(i / 2);
+            }
+        }
+        test_eq("growth size", map.size(), check.size());
+
+        bool ok{true};
+        for (int i = 0; i < 5000; ++i)
+        {
+            if (map.count(i) != check.count(i))
+                ok = false;
+        }
+        test_eq("growth with tombstones", ok, true);
+
+        std::size_t cnt{};
+        for (auto it = map.begin(); it != map.end(); ++it)
+            ++cnt;
+        test_eq("growth iteration", cnt, map.size());
+        test_eq("growth load factor", (map.load_factor() <= map.max_load_factor()), true);
+
+        std::aux::flat_hash_map<int, int> map2{};
+        map2.reserve(1000);
+        auto buckets = map2.bucket_count();
+        for (int i = 0; i < 1000; ++i)
+            map2.emplace(i, i);
+        test_eq("reserve", map2.bucket_count(), buckets);
+    }
+
+    void flat_hash_map_test::test_set()
+    {
+        auto check1 = {1, 2, 3, 4, 5, 6, 7};
+        std::aux::flat_hash_set<int> s1{3, 1, 5, 2, 7, 6, 4};
+        test_contains(
+            "set initializer list initialization",
+            check1.begin(), check1.end(), s1
+        );
+        test_eq("set size", s1.size(), 7U);
+
+        auto res1 = s1.insert(8);
+        test_eq("set insert succession", res1.second, true);
+        test_eq("set insert equivalence", *res1.first, 8);
+
+        auto res2 = s1.insert(8);
+        test_eq("set insert failure", res2.second, false);
+        test_eq("set insert size", s1.size(), 8U);
+
+        auto res3 = s1.erase(8);
+        test_eq("set erase", res3, 1U);
+        test_eq("set erase find", s1.find(8), s1.end());
+
+        std::aux::flat_hash_set<int> s2{s1};
+        test_eq("set equality", (s1 == s2), true);
+        s2.erase(1);
+        test_eq("set inequality", (s1 != s2), true);
+
+        std::aux::flat_hash_set<std::string> s3{};
+        s3.emplace("abc");
+        s3.emplace("def");
+        s3.emplace("abc");
+        test_eq("set emplace size", s3.size(), 2U);
+        test_eq("set count", s3.count("def"), 1U);
+    }
+}
@@ -275,6 +275,25 @@ namespace std::test
 
         res4.get();
         test_eq("void async", x, 42);
+
+        /**
+         * The waiter would block forever if the default
+         * policy deferred it until get was called.
+         */
+        std::promise<int> p{};
+        auto f = p.get_future();
+        auto waiter = std::async(
+            [&f](){
+                return f.get() + 1;
+            }
+        );
+        auto setter = std::async(
+            [&p](){
+                p.set_value(41);
+            }
+        );
+        test_eq("async default policy in parallel", waiter.get(), 42);
+        setter.get();
     }
 
     void future_test::test_packaged_task()
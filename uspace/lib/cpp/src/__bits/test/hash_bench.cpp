@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace std::test
+{
+    bool hash_bench::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_equal_strings();
+        test_collisions();
+        bench_throughput();
+        bench_table();
+
+        return end();
+    }
+
+    const char* hash_bench::name()
+    {
+        return "hash_bench";
+    }
+
+    void hash_bench::test_equal_strings()
+    {
+        /**
+         * Lengths around the 4, 8, 16 and 48 byte
+         * boundaries of the string hash.
+         */
+        for (size_t len: {0, 1, 3, 4, 7, 8, 15, 16, 17, 47, 48, 49, 97})
+        {
+            std::string s1(len, 'x');
+            std::string s2{s1};
+            test_eq("string hash equal", std::hash<std::string>{}(s1),
+                    std::hash<std::string>{}(s2));
+
+            std::wstring w1(len, L'x');
+            std::wstring w2{w1};
+            test_eq("wstring hash equal", std::hash<std::wstring>{}(w1),
+                    std::hash<std::wstring>{}(w2));
+
+            std::u16string u16_1(len, u'x');
+            std::u16string u16_2{u16_1};
+            test_eq("u16string hash equal", std::hash<std::u16string>{}(u16_1),
+                    std::hash<std::u16string>{}(u16_2));
+
+            std::u32string u32_1(len, U'x');
+            std::u32string u32_2{u32_1};
+            test_eq("u32string hash equal", std::hash<std::u32string>{}(u32_1),
+                    std::hash<std::u32string>{}(u32_2));
+
+            if (len > 0)
+            {
+                s2[len - 1] = 'y';
+                test_eq("string hash last char", std::hash<std::string>{}(s1) !=
+                        std::hash<std::string>{}(s2), true);
+                s2[len - 1] = 'x';
+                s2[0] = 'y';
+                test_eq("string hash first char", std::hash<std::string>{}(s1) !=
+                        std::hash<std::string>{}(s2), true);
+            }
+        }
+    }
+
+    template<class Fun>
+    void hash_bench::test_spread(const char* tname, Fun&& fun)
+    {
+        /**
+         * Hashes bucket_count_ keys into as many buckets
+         * using the low bits, like a power of two sized
+         * table does. With a uniform hash, about 1/e of
+         * the buckets stay empty and the longest chain
+         * stays in single digits.
+         */
+        std::vector<size_t> buckets(bucket_count_, 0);
+        for (size_t i = 0; i < bucket_count_; ++i)
+            ++buckets[fun(i) & (bucket_count_ - 1)];
+
+        size_t used{}, longest{};
+        for (auto b: buckets)
+        {
+            used += b > 0;
+            if (b > longest)
+                longest = b;
+        }
+
+        if (report_)
+        {
+            std::printf("[%s][%s] used buckets: %zu/%zu, longest chain: %zu\n",
+                        name(), tname, used, bucket_count_, longest);
+        }
+
+        test_eq(tname, used > bucket_count_ / 2, true);
+        test_eq(tname, longest < 16, true);
+    }
+
+    void hash_bench::test_collisions()
+    {
+        test_spread("sequential ints", [](size_t i){
+            return std::hash<std::uint64_t>{}(i);
+        });
+        test_spread("strided ints", [](size_t i){
+            return std::hash<std::uint64_t>{}(i << 16);
+        });
+        test_spread("high bit ints", [](size_t i){
+            return std::hash<std::uint64_t>{}(std::uint64_t{i} << 48);
+        });
+        test_spread("pointers", [](size_t i){
+            return std::hash<int*>{}(reinterpret_cast<int*>(0x10000 + i * 64));
+        });
+        test_spread("similar strings", [](size_t i){
+            std::string key{"/srv/fs/node/"};
+            key += std::to_string(i);
+
+            return std::hash<std::string>{}(key);
+        });
+        test_spread("similar wstrings", [](size_t i){
+            std::wstring key(20, L'.');
+            key[i % 20] = static_cast<wchar_t>(L'a' + i / 20);
+
+            return std::hash<std::wstring>{}(key);
+        });
+    }
+
+    void hash_bench::bench_throughput()
+    {
+        std::uint64_t res{};
+        bench("int hash", [&](){
+            for (std::uint64_t i = 0; i < key_count_; ++i)
+                res += std::hash<std::uint64_t>{}(i);
+        });
+
+        for (size_t len: {8, 32, 256, 4096})
+        {
+            std::string str(len, 'a');
+            size_t rounds = key_count_ * 8 / len;
+
+            std::string bname{"string hash "};
+            bname += std::to_string(len);
+            bname += "B";
+            bench(bname.c_str(), [&](){
+                for (size_t i = 0; i < rounds; ++i)
+                {
+                    str[0] = static_cast<char>(i);
+                    res += std::hash<std::string>{}(str);
+                }
+            });
+        }
+
+        consume(res);
+    }
+
+    void hash_bench::bench_table()
+    {
+        /**
+         * Keys that are multiples of a power of two
+         * all used to end up in a handful of buckets.
+         */
+        std::unordered_map<std::uint64_t, std::uint64_t> map{};
+        bench("unordered_map strided insert", [&](){
+            for (std::uint64_t i = 0; i < key_count_; ++i)
+                map.emplace(i << 12, i);
+        });
+
+        std::uint64_t hits{};
+        bench("unordered_map strided find", [&](){
+            for (std::uint64_t i = 0; i < key_count_; ++i)
+                hits += map.count(i << 12);
+        });
+        test_eq("unordered_map strided find", hits, key_count_);
+
+        consume(hits);
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace std::test
+{
+    bool hash_table_bench::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        bench_ints<std::unordered_map<std::uint64_t, std::uint64_t>>("unordered_map");
+        bench_ints<std::aux::flat_hash_map<std::uint64_t, std::uint64_t>>("flat_hash_map");
+        bench_strings<std::unordered_map<std::string, std::uint64_t>>("unordered_map");
+        bench_strings<std::aux::flat_hash_map<std::string, std::uint64_t>>("flat_hash_map");
+
+        return end();
+    }
+
+    const char* hash_table_bench::name()
+    {
+        return "hash_table_bench";
+    }
+
+    template<class Map>
+    void hash_table_bench::bench_ints(const char* map_name)
+    {
+        std::string prefix{map_name};
+        std::vector<std::uint64_t> keys{};
+        keys.reserve(int_count_);
+
+        /**
+         * Scatter the keys a bit, sequential keys
+         * are an unrealistically friendly workload.
+         */
+        for (std::uint64_t i = 0; i < int_count_; ++i)
+            keys.push_back(i * 2654435761ULL % (int_count_ * 16));
+
+        /**
+         * Look the keys up in a different order than they
+         * were inserted in, otherwise node based tables get
+         * an unrealistic boost from allocation locality.
+         */
+        std::vector<std::uint64_t> lookups{};
+        lookups.reserve(int_count_);
+        for (std::uint64_t i = 0; i < int_count_; ++i)
+            lookups.push_back(keys[i * lookup_stride_ % int_count_]);
+
+        Map map{};
+        bench((prefix + " int insert").c_str(), [&](){
+            for (auto k: keys)
+                map[k] = k;
+        });
+
+        std::uint64_t hits{};
+        bench((prefix + " int find hit").c_str(), [&](){
+            for (auto k: lookups)
+            {
+                auto it = map.find(k);
+                if (it != map.end())
+                    hits += it->second == k;
+            }
+        });
+        test_eq((prefix + " int find hit").c_str(), hits, keys.size());
+
+        std::uint64_t misses{};
+        bench((prefix + " int find miss").c_str(), [&](){
+            for (auto k: lookups)
+                misses += map.count(k + int_count_ * 16) == 0;
+        });
+        test_eq((prefix + " int find miss").c_str(), misses, keys.size());
+
+        bench((prefix + " int erase").c_str(), [&](){
+            for (auto k: keys)
+                map.erase(k);
+        });
+        test_eq((prefix + " int erase").c_str(), map.empty(), true);
+
+        consume(hits + misses);
+    }
+
+    template<class Map>
+    void hash_table_bench::bench_strings(const char* map_name)
+    {
+        std::string prefix{map_name};
+        std::vector<std::string> keys{};
+        keys.reserve(string_count_);
+
+        for (std::uint64_t i = 0; i < string_count_; ++i)
+        {
+            std::string key{"/srv/fs/node/"};
+            key += std::to_string(i);
+            keys.push_back(key);
+        }
+
+        Map map{};
+        bench((prefix + " string insert").c_str(), [&](){
+            for (std::uint64_t i = 0; i < keys.size(); ++i)
+                map.emplace(keys[i], i);
+        });
+
+        std::uint64_t hits{};
+        bench((prefix + " string find hit").c_str(), [&](){
+            for (std::uint64_t i = 0; i < keys.size(); ++i)
+                hits += map.count(keys[i * lookup_stride_ % keys.size()]);
+        });
+        test_eq((prefix + " string find hit").c_str(), hits, keys.size());
+
+        consume(hits);
+    }
+}
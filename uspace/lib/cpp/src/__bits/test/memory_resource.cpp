@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        /**
+         * Upstream resource that keeps track of the memory
+         * it handed out, so that we can check that pools
+         * return everything they got.
+         */
+        class counting_resource: public pmr::memory_resource
+        {
+            public:
+                size_t allocations{};
+                size_t deallocations{};
+                size_t bytes{};
+
+            protected:
+                void* do_allocate(size_t n, size_t alignment) override
+                {
+                    ++allocations;
+                    bytes += n;
+
+                    return pmr::new_delete_resource()->allocate(n, alignment);
+                }
+
+                void do_deallocate(void* ptr, size_t n, size_t alignment) override
+                {
+                    ++deallocations;
+                    bytes -= n;
+
+                    pmr::new_delete_resource()->deallocate(ptr, n, alignment);
+                }
+
+                bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+                {
+                    return this == &other;
+                }
+        };
+
+        bool is_aligned(void* ptr, size_t alignment)
+        {
+            return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+        }
+    }
+
+    bool memory_resource_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_global_resources();
+        test_monotonic();
+        test_pools();
+        test_synchronized_pool();
+        test_containers();
+
+        return end();
+    }
+
+    const char* memory_resource_test::name()
+    {
+        return "memory_resource";
+    }
+
+    void memory_resource_test::test_global_resources()
+    {
+        auto ndr = pmr::new_delete_resource();
+        test_eq("default resource", pmr::get_default_resource(), ndr);
+        test("new_delete equality", *ndr == *pmr::new_delete_resource());
+        test("null inequality", *ndr != *pmr::null_memory_resource());
+
+        auto ptr = ndr->allocate(100, 64);
+        test("new_delete over-alignment", is_aligned(ptr, 64));
+        ndr->deallocate(ptr, 100, 64);
+
+        counting_resource upstream{};
+        auto old = pmr::set_default_resource(&upstream);
+        test_eq("set_default_resource return", old, ndr);
+        test_eq("get_default_resource", pmr::get_default_resource(),
+                static_cast<pmr::memory_resource*>(&upstream));
+
+        pmr::polymorphic_allocator<int> alloc{};
+        test_eq("default polymorphic_allocator", alloc.resource(),
+                static_cast<pmr::memory_resource*>(&upstream));
+
+        auto data = alloc.allocate(4);
+        test_eq("polymorphic_allocator allocate", upstream.bytes, 4 * sizeof(int));
+        alloc.deallocate(data, 4);
+        test_eq("polymorphic_allocator deallocate", upstream.bytes, 0U);
+
+        pmr::set_default_resource(nullptr);
+        test_eq("reset default resource", pmr::get_default_resource(), ndr);
+    }
+
+    void memory_resource_test::test_monotonic()
+    {
+        counting_resource upstream{};
+        alignas(16) char buffer[64];
+
+        {
+            pmr::monotonic_buffer_resource mr{buffer, sizeof(buffer), &upstream};
+
+            auto p1 = static_cast<char*>(mr.allocate(10, 1));
+            auto p2 = static_cast<char*>(mr.allocate(8, 8));
+            test_eq("buffer used pt1", p1, &buffer[0]);
+            test("buffer used pt2", p2 >= buffer && p2 + 8 <= buffer + sizeof(buffer));
+            test("alignment", is_aligned(p2, 8));
+            test_eq("buffer no upstream", upstream.allocations, 0U);
+
+            mr.deallocate(p1, 10, 1);
+            auto p3 = static_cast<char*>(mr.allocate(24, 8));
+            test("deallocate is no-op", p3 != p1);
+            test_eq("upstream pt1", upstream.allocations, 0U);
+
+            mr.allocate(32, 4);
+            test_eq("upstream pt2", upstream.allocations, 1U);
+
+            for (int i = 0; i < 100; ++i)
+                mr.allocate(64, 8);
+            test("geometric growth", upstream.allocations < 8U);
+
+            auto big = mr.allocate(10'000, 256);
+            test("big alignment", is_aligned(big, 256));
+
+            mr.release();
+            test_eq("release", upstream.bytes, 0U);
+
+            auto p4 = static_cast<char*>(mr.allocate(10, 1));
+            test_eq("buffer reused after release", p4, &buffer[0]);
+
+            mr.allocate(1'000, 8);
+        }
+        test_eq("destructor releases", upstream.bytes, 0U);
+        test_eq("balanced", upstream.allocations, upstream.deallocations);
+    }
+
+    void memory_resource_test::test_pools()
+    {
+        counting_resource upstream{};
+
+        {
+            pmr::unsynchronized_pool_resource mr{
+                pmr::pool_options{16, 512}, &upstream
+            };
+            test_eq("options blocks", mr.options().max_blocks_per_chunk, 16U);
+            test_eq("options largest", mr.options().largest_required_pool_block, 512U);
+
+            auto p1 = mr.allocate(24, 8);
+            auto p2 = mr.allocate(24, 8);
+            test("distinct blocks", p1 != p2);
+            test("pool alignment", is_aligned(p1, 8) && is_aligned(p2, 8));
+
+            mr.deallocate(p1, 24, 8);
+            auto p3 = mr.allocate(20, 4);
+            test_eq("block reuse", p3, p1);
+
+            auto allocations = upstream.allocations;
+            vector<void*> blocks{};
+            for (int i = 0; i < 100; ++i)
+                blocks.push_back(mr.allocate(64, 16));
+            test("chunked", upstream.allocations - allocations < 10U);
+
+            bool aligned{true};
+            for (auto block: blocks)
+                aligned = aligned && is_aligned(block, 16);
+            test("block alignment", aligned);
+
+            auto bytes = upstream.bytes;
+            auto big = mr.allocate(4'000, 8);
+            test("oversized upstream", upstream.bytes > bytes + 4'000U);
+            mr.deallocate(big, 4'000, 8);
+            test_eq("oversized deallocate", upstream.bytes, bytes);
+
+            auto aligned_big = mr.allocate(100, 128);
+            test("oversized alignment", is_aligned(aligned_big, 128));
+
+            mr.release();
+            test("release keeps pool table", upstream.bytes > 0U);
+
+            auto p4 = mr.allocate(8, 8);
+            test("allocate after release", p4 != nullptr);
+        }
+        test_eq("destructor releases", upstream.bytes, 0U);
+        test_eq("balanced", upstream.allocations, upstream.deallocations);
+    }
+
+    void memory_resource_test::test_synchronized_pool()
+    {
+        counting_resource upstream{};
+
+        {
+            pmr::synchronized_pool_resource mr{&upstream};
+            test_eq("upstream", mr.upstream_resource(),
+                    static_cast<pmr::memory_resource*>(&upstream));
+
+            constexpr size_t thread_count{4};
+            constexpr size_t block_count{1'000};
+            vector<vector<void*>> blocks(thread_count);
+
+            vector<thread> threads{};
+            for (size_t i = 0; i < thread_count; ++i)
+            {
+                threads.emplace_back([&mr, &blocks, i](){
+                    for (size_t j = 0; j < block_count; ++j)
+                    {
+                        auto ptr = static_cast<size_t*>(mr.allocate(sizeof(size_t) * 4));
+                        *ptr = i;
+                        blocks[i].push_back(ptr);
+
+                        if (j % 3 == 0)
+                        {
+                            mr.deallocate(blocks[i].back(), sizeof(size_t) * 4);
+                            blocks[i].pop_back();
+                        }
+                    }
+                });
+            }
+
+            for (auto& t: threads)
+                t.join();
+
+            bool ok{true};
+            for (size_t i = 0; i < thread_count; ++i)
+            {
+                for (auto ptr: blocks[i])
+                    ok = ok && *static_cast<size_t*>(ptr) == i;
+            }
+            test("no shared blocks", ok);
+        }
+        test_eq("destructor releases", upstream.bytes, 0U);
+    }
+
+    void memory_resource_test::test_containers()
+    {
+        counting_resource upstream{};
+        pmr::monotonic_buffer_resource mr{&upstream};
+
+        pmr::list<int> l{&mr};
+        for (int i = 0; i < 100; ++i)
+            l.push_back(i);
+        test_eq("list resource", l.get_allocator().resource(),
+                static_cast<pmr::memory_resource*>(&mr));
+        test("list nodes from resource", upstream.bytes >= 100 * sizeof(int));
+        test_eq("list contents", l.back(), 99);
+
+        auto bytes = upstream.bytes;
+        l.pop_front();
+        l.erase(l.begin());
+        test_eq("list erase", l.size(), 98U);
+        test_eq("list erase does not free", upstream.bytes, bytes);
+
+        pmr::map<int, int> m{&mr};
+        for (int i = 0; i < 100; ++i)
+            m[(i * 37) % 100] = i;
+        m.erase(m.begin());
+        test_eq("map size", m.size(), 99U);
+        test_eq("map contents", m[37], 1);
+        test("map nodes from resource", upstream.bytes > bytes);
+
+        pmr::multiset<int> ms{&mr};
+        for (int i = 0; i < 50; ++i)
+            ms.insert(i % 5);
+        test_eq("multiset count", ms.count(3), 10U);
+        ms.clear();
+        test("multiset clear", ms.empty());
+
+        pmr::unordered_map<int, int> um{&mr};
+        for (int i = 0; i < 100; ++i)
+            um.emplace(i, i * 2);
+        test_eq("unordered_map contents", um[42], 84);
+        test_eq("unordered_map resource", um.get_allocator().resource(),
+                static_cast<pmr::memory_resource*>(&mr));
+
+        /**
+         * Copies do not inherit the resource, they
+         * use the default one.
+         */
+        pmr::map<int, int> m2{m};
+        test_eq("copy resource", m2.get_allocator().resource(),
+                pmr::get_default_resource());
+        test_eq("copy contents", m2.size(), m.size());
+
+        pmr::unsynchronized_pool_resource pool{&upstream};
+        pmr::map<int, int> m3{move(m), &pool};
+        test_eq("move to other resource pt1", m3.size(), 99U);
+        test_eq("move to other resource pt2", m3[37], 1);
+        test("move to other resource pt3", m.empty());
+
+        m3 = m2;
+        test_eq("copy assignment keeps resource", m3.get_allocator().resource(),
+                static_cast<pmr::memory_resource*>(&pool));
+        test_eq("copy assignment contents", m3.size(), m2.size());
+
+        pmr::set<int> s1{&mr};
+        pmr::set<int> s2{&pool};
+        s1.insert({3, 1, 2});
+        s2 = move(s1);
+        test_eq("move assignment keeps resource", s2.get_allocator().resource(),
+                static_cast<pmr::memory_resource*>(&pool));
+        test_eq("move assignment contents", *s2.begin(), 1);
+
+        pmr::unordered_map<int, int> um2{&pool};
+        um2 = um;
+        test_eq("unordered copy assignment", um2.size(), 100U);
+        test_eq("unordered copy assignment resource", um2.get_allocator().resource(),
+                static_cast<pmr::memory_resource*>(&pool));
+    }
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory_resource>
+
+namespace std::test
+{
+    namespace
+    {
+        template<class List>
+        uint64_t fill_list(List& l, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                l.push_back(i);
+
+            uint64_t res{};
+            for (auto x: l)
+                res += x;
+
+            return res;
+        }
+    }
+
+    bool memory_resource_bench::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        bench_map();
+        bench_list();
+
+        return end();
+    }
+
+    const char* memory_resource_bench::name()
+    {
+        return "memory_resource_bench";
+    }
+
+    template<class Map>
+    uint64_t memory_resource_bench::fill_map_(Map& m)
+    {
+        for (size_t i = 0; i < element_count_; ++i)
+            m.emplace((i * 7919) % element_count_, i);
+
+        uint64_t res{};
+        for (auto& [key, value]: m)
+            res += key ^ value;
+
+        return res;
+    }
+
+    void memory_resource_bench::bench_map()
+    {
+        uint64_t res1{};
+        bench("map default allocator", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                map<size_t, size_t> m{};
+                res1 += fill_map_(m);
+            }
+        });
+
+        uint64_t res2{};
+        bench("map monotonic", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                pmr::monotonic_buffer_resource mr{};
+                pmr::map<size_t, size_t> m{&mr};
+                res2 += fill_map_(m);
+            }
+        });
+
+        uint64_t res3{};
+        pmr::unsynchronized_pool_resource pool{};
+        bench("map pool", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                pmr::map<size_t, size_t> m{&pool};
+                res3 += fill_map_(m);
+            }
+        });
+
+        uint64_t res4{};
+        pmr::synchronized_pool_resource sync_pool{};
+        bench("map synchronized pool", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                pmr::map<size_t, size_t> m{&sync_pool};
+                res4 += fill_map_(m);
+            }
+        });
+
+        test_eq("map results pt1", res1, res2);
+        test_eq("map results pt2", res1, res3);
+        test_eq("map results pt3", res1, res4);
+
+        consume(res1);
+    }
+
+    void memory_resource_bench::bench_list()
+    {
+        uint64_t res1{};
+        bench("list default allocator", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                list<size_t> l{};
+                res1 += fill_list(l, element_count_);
+            }
+        });
+
+        uint64_t res2{};
+        bench("list monotonic", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                pmr::monotonic_buffer_resource mr{};
+                pmr::list<size_t> l{&mr};
+                res2 += fill_list(l, element_count_);
+            }
+        });
+
+        uint64_t res3{};
+        pmr::unsynchronized_pool_resource pool{};
+        bench("list pool", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                pmr::list<size_t> l{&pool};
+                res3 += fill_list(l, element_count_);
+            }
+        });
+
+        test_eq("list results pt1", res1, res2);
+        test_eq("list results pt2", res1, res3);
+
+        consume(res1);
+    }
+}
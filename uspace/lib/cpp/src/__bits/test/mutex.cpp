@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+
+namespace std::test
+{
+    namespace
+    {
+        constexpr chrono::milliseconds timeout{10};
+
+        template<class Fun>
+        chrono::steady_clock::duration elapsed(Fun&& fun)
+        {
+            auto start = chrono::steady_clock::now();
+            fun();
+
+            return chrono::steady_clock::now() - start;
+        }
+    }
+
+    bool mutex_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_timed_mutex();
+        test_recursive_timed_mutex();
+        test_shared_timed_mutex();
+        test_condition_variable();
+
+        return end();
+    }
+
+    const char* mutex_test::name()
+    {
+        return "mutex";
+    }
+
+    void mutex_test::test_timed_mutex()
+    {
+        std::timed_mutex mtx{};
+
+        test("try_lock_for unlocked", mtx.try_lock_for(timeout));
+        test("try_lock locked", !mtx.try_lock());
+
+        bool res{true};
+        auto time = elapsed([&](){ res = mtx.try_lock_for(timeout); });
+        test("try_lock_for locked", !res);
+        test("try_lock_for waits", time >= timeout);
+
+        time = elapsed([&](){
+            res = mtx.try_lock_until(chrono::steady_clock::now() + timeout);
+        });
+        test("try_lock_until locked", !res);
+        test("try_lock_until waits", time >= timeout);
+
+        test("try_lock_for zero", !mtx.try_lock_for(chrono::milliseconds{0}));
+        mtx.unlock();
+
+        /**
+         * Deadlines in the past turn timed locking
+         * into plain try_lock.
+         */
+        test(
+            "try_lock_until past deadline",
+            mtx.try_lock_until(chrono::steady_clock::now() - timeout)
+        );
+        mtx.unlock();
+    }
+
+    void mutex_test::test_recursive_timed_mutex()
+    {
+        std::recursive_timed_mutex mtx{};
+
+        test("recursive try_lock_for", mtx.try_lock_for(timeout));
+        test("recursive try_lock_for again", mtx.try_lock_for(timeout));
+        test(
+            "recursive try_lock_until",
+            mtx.try_lock_until(chrono::steady_clock::now() + timeout)
+        );
+
+        /**
+         * Every successful timed lock counts as a level,
+         * so the native mutex has to stay locked until
+         * the last unlock.
+         */
+        auto& native = *mtx.native_handle();
+        mtx.unlock();
+        mtx.unlock();
+        test("recursive still locked", !aux::threading::mutex::try_lock(native));
+
+        mtx.unlock();
+        test("recursive released", aux::threading::mutex::try_lock(native));
+        aux::threading::mutex::unlock(native);
+    }
+
+    void mutex_test::test_shared_timed_mutex()
+    {
+        std::shared_timed_mutex mtx{};
+
+        mtx.lock_shared();
+        test("try_lock_shared with reader", mtx.try_lock_shared());
+        test("try_lock with reader", !mtx.try_lock());
+
+        bool res{true};
+        auto time = elapsed([&](){ res = mtx.try_lock_for(timeout); });
+        test("try_lock_for with reader", !res);
+        test("try_lock_for with reader waits", time >= timeout);
+        test(
+            "try_lock_shared_for with reader",
+            mtx.try_lock_shared_for(timeout)
+        );
+
+        mtx.unlock_shared();
+        mtx.unlock_shared();
+        mtx.unlock_shared();
+
+        test("try_lock unlocked", mtx.try_lock());
+        test("try_lock_shared with writer", !mtx.try_lock_shared());
+
+        time = elapsed([&](){
+            res = mtx.try_lock_shared_until(chrono::steady_clock::now() + timeout);
+        });
+        test("try_lock_shared_until with writer", !res);
+        test("try_lock_shared_until with writer waits", time >= timeout);
+        mtx.unlock();
+
+        {
+            std::shared_lock<std::shared_timed_mutex> lock{mtx, timeout};
+            test("shared_lock with timeout", lock.owns_lock());
+        }
+        test("shared_lock released", mtx.try_lock());
+        mtx.unlock();
+    }
+
+    void mutex_test::test_condition_variable()
+    {
+        std::mutex mtx{};
+        std::condition_variable cv{};
+        std::unique_lock<std::mutex> lock{mtx};
+
+        cv_status status{cv_status::no_timeout};
+        auto time = elapsed([&](){ status = cv.wait_for(lock, timeout); });
+        test("wait_for timeout", status == cv_status::timeout);
+        test("wait_for waits", time >= timeout);
+        test("wait_for relocks", lock.owns_lock());
+
+        status = cv.wait_until(lock, chrono::steady_clock::now() - timeout);
+        test("wait_until past deadline", status == cv_status::timeout);
+
+        test(
+            "wait_for satisfied predicate",
+            cv.wait_for(lock, timeout, [](){ return true; })
+        );
+
+        bool res{true};
+        time = elapsed([&](){
+            res = cv.wait_until(
+                lock, chrono::steady_clock::now() + timeout,
+                [](){ return false; }
+            );
+        });
+        test("wait_until unsatisfied predicate", !res);
+        test("wait_until predicate waits", time >= timeout);
+    }
+}
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <iterator>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace std::test
+{
+    bool regex_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_match();
+        test_search();
+        test_groups();
+        test_assertions();
+        test_backtracking();
+        test_flags();
+        test_replace();
+        test_iterators();
+
+        return end();
+    }
+
+    const char* regex_test::name()
+    {
+        return "regex";
+    }
+
+    void regex_test::test_match()
+    {
+        std::regex re1{"a(b|c)*d"};
+        test("match alternation loop", std::regex_match("abcbd", re1));
+        test("match empty loop", std::regex_match("ad", re1));
+        test("match requires full", !std::regex_match("abcbdx", re1));
+        test("match prefix fails", !std::regex_match("xad", re1));
+
+        std::regex re2{"[a-f0-9]{2,4}"};
+        test("match bounded low", std::regex_match("a0", re2));
+        test("match bounded high", std::regex_match("ff09", re2));
+        test("match bounded too short", !std::regex_match("a", re2));
+        test("match bounded too long", !std::regex_match("abcde", re2));
+
+        std::regex re3{"\\d+\\s\\w+\\.?"};
+        test("match classes", std::regex_match("42 items.", re3));
+        test("match classes no dot", std::regex_match("7 x_1", re3));
+        test("match classes fail", !std::regex_match("x items", re3));
+
+        std::regex re4{"[^[:digit:]]*"};
+        test("match negated class", std::regex_match("abc-def", re4));
+        test("match negated class fail", !std::regex_match("abc1", re4));
+
+        std::regex re5{".*"};
+        test("match dot empty", std::regex_match("", re5));
+        test("match dot stops at newline", !std::regex_match("a\nb", re5));
+
+        std::string str{"key=value"};
+        std::smatch m{};
+        test("match string", std::regex_match(str, m, std::regex{"(\\w+)=(\\w+)"}));
+        test_eq("match string size", m.size(), 3U);
+        test_eq("match string group 1", m.str(1), std::string{"key"});
+        test_eq("match string group 2", m.str(2), std::string{"value"});
+    }
+
+    void regex_test::test_search()
+    {
+        std::regex re1{"b+"};
+        std::cmatch m{};
+        const char* str = "aaabbbccc";
+
+        test("search", std::regex_search(str, m, re1));
+        test_eq("search position", m.position(0), 3);
+        test_eq("search length", m.length(0), 3);
+        test_eq("search prefix", m.prefix().str(), std::string{"aaa"});
+        test_eq("search suffix", m.suffix().str(), std::string{"ccc"});
+
+        test("search fails", !std::regex_search("aaaccc", re1));
+        test("search empty matches", std::regex_search("", std::regex{"x*"}));
+
+        /**
+         * The leftmost match wins even if a longer one
+         * starts later in the input.
+         */
+        std::regex re2{"ab|bcdef"};
+        test("search leftmost", std::regex_search("abcdef", m, re2));
+        test_eq("search leftmost str", m.str(), std::string{"ab"});
+
+        std::regex re3{"a+?"};
+        test("search lazy", std::regex_search("aaa", m, re3));
+        test_eq("search lazy length", m.length(0), 1);
+
+        std::regex re4{"fo+"};
+        std::string text(10'000, 'x');
+        text += "foo";
+        std::smatch sm{};
+        test("search long input", std::regex_search(text, sm, re4));
+        test_eq("search long input position", sm.position(0), 10'000);
+        test("search long input fails", !std::regex_search(text.substr(0, 10'001), re4));
+
+        /**
+         * Needs more DFA states than the cache holds,
+         * so the cache gets flushed during the search.
+         */
+        std::string ab{};
+        unsigned int seed{12345};
+        for (size_t i = 0; i < 20'000; ++i)
+        {
+            seed = seed * 1103515245U + 12345U;
+            ab += (seed >> 16) & 1 ? 'a' : 'b';
+        }
+        std::regex re5{"a[ab]{10}c"};
+        test("search many states fails", !std::regex_search(ab, re5));
+        ab += "aababababab";
+        ab += "c";
+        test("search many states", std::regex_search(ab, sm, re5));
+        test_eq("search many states position", sm.position(0),
+                static_cast<long>(ab.size() - 12));
+    }
+
+    void regex_test::test_groups()
+    {
+        std::regex re1{"(a|ab)(c|bcd)(d*)"};
+        std::cmatch m{};
+        test("groups", std::regex_match("abcd", m, re1));
+        test_eq("groups 1", m.str(1), std::string{"a"});
+        test_eq("groups 2", m.str(2), std::string{"bcd"});
+        test_eq("groups 3", m.str(3), std::string{""});
+        test("groups 3 matched", m[3].matched);
+
+        std::regex re2{"(a)|(b)"};
+        test("groups unmatched", std::regex_search("b", m, re2));
+        test("groups unmatched 1", !m[1].matched);
+        test("groups unmatched 2", m[2].matched);
+
+        std::regex re3{"(?:(\\w)\\s)+"};
+        test("groups last iteration", std::regex_match("a b c ", m, re3));
+        test_eq("groups last iteration value", m.str(1), std::string{"c"});
+        test_eq("groups mark count", re3.mark_count(), 1U);
+
+        std::regex re4{"(x)?y"};
+        test("groups optional", std::regex_match("y", m, re4));
+        test("groups optional unmatched", !m[1].matched);
+    }
+
+    void regex_test::test_assertions()
+    {
+        std::regex re1{"^ab$"};
+        test("bol eol", std::regex_match("ab", re1));
+        test("bol eol search", !std::regex_search("xab", re1));
+        test("not bol", !std::regex_search("ab", re1, std::regex_constants::match_not_bol));
+        test("not eol", !std::regex_search("ab", re1, std::regex_constants::match_not_eol));
+
+        std::regex re2{"^b", std::regex::ECMAScript | std::regex::multiline};
+        test("multiline bol", std::regex_search("a\nb", re2));
+        test("no multiline bol", !std::regex_search("a\nb", std::regex{"^b"}));
+
+        std::regex re3{"\\bcat\\b"};
+        std::cmatch m{};
+        test("word boundary", std::regex_search("concat cat", m, re3));
+        test_eq("word boundary position", m.position(0), 7);
+        test("word boundary fails", !std::regex_search("concatenate", re3));
+
+        std::regex re4{"\\Bat"};
+        test("not word boundary", std::regex_search("cat", re4));
+        test("not word boundary fails", !std::regex_search("at", re4));
+    }
+
+    void regex_test::test_backtracking()
+    {
+        std::regex re1{"(\\w+) \\1"};
+        std::cmatch m{};
+        test("backref", std::regex_search("say hello hello", m, re1));
+        test_eq("backref group", m.str(1), std::string{"hello"});
+        test("backref fails", !std::regex_search("hello world", re1));
+
+        std::regex re2{"\\w+(?=!)"};
+        test("lookahead", std::regex_search("hi there!", m, re2));
+        test_eq("lookahead str", m.str(), std::string{"there"});
+
+        std::regex re3{"a(?!b)\\w"};
+        test("negative lookahead", std::regex_search("abac", m, re3));
+        test_eq("negative lookahead str", m.str(), std::string{"ac"});
+
+        std::regex re4{"(?=(\\w+))\\1:"};
+        test("lookahead capture", std::regex_search("ab abc:", m, re4));
+        test_eq("lookahead capture str", m.str(1), std::string{"abc"});
+
+        std::regex re5{"(a*)*b"};
+        test("nullable loop", std::regex_match("aaab", re5));
+        test("nullable loop fails", !std::regex_match("aaac", re5));
+    }
+
+    void regex_test::test_flags()
+    {
+        std::regex re1{"[a-c]+X", std::regex::icase};
+        test("icase", std::regex_match("AbCx", re1));
+        test("icase fail", !std::regex_match("abdx", re1));
+
+        std::regex re2{"a\\(b*\\)c", std::regex::basic};
+        std::cmatch m{};
+        test("basic", std::regex_match("abbc", m, re2));
+        test_eq("basic group", m.str(1), std::string{"bb"});
+        test("basic literal plus", std::regex_match("a+", std::regex{"a+", std::regex::basic}));
+
+        std::regex re3{"(ab)+|c", std::regex::extended};
+        test("extended", std::regex_match("abab", re3));
+
+        std::regex re4{"a|b", std::regex::ECMAScript};
+        test("match_not_null", !std::regex_search("", re4, std::regex_constants::match_not_null));
+        test("match_continuous",
+             !std::regex_search("xa", re4, std::regex_constants::match_continuous));
+
+        std::regex re5{"x*"};
+        test("not null empty", !std::regex_search("abc", re5, std::regex_constants::match_not_null));
+
+        std::regex re6{};
+        test("default regex", !std::regex_search("abc", re6));
+
+        std::regex re8{"(ab"};
+        test("invalid matches nothing", !std::regex_search("ab", re8));
+        test_eq("invalid mark count", re8.mark_count(), 0U);
+
+        std::regex re7{re1};
+        test("copy", std::regex_match("cAx", re7));
+        re7 = "[0-9]+";
+        test("assign", std::regex_match("123", re7));
+        test("copy unchanged", std::regex_match("aX", re1));
+    }
+
+    void regex_test::test_replace()
+    {
+        std::regex re1{"(\\w+)@(\\w+)"};
+        std::string str{"mail alice@host and bob@box"};
+
+        test_eq("replace groups",
+                std::regex_replace(str, re1, "$2:$1"),
+                std::string{"mail host:alice and box:bob"});
+        test_eq("replace first only",
+                std::regex_replace(str, re1, "<$&>", std::regex_constants::format_first_only),
+                std::string{"mail <alice@host> and bob@box"});
+        test_eq("replace no copy",
+                std::regex_replace(str, re1, "[$1]", std::regex_constants::format_no_copy),
+                std::string{"[alice][bob]"});
+        test_eq("replace sed",
+                std::regex_replace(str, re1, "\\2=&", std::regex_constants::format_sed),
+                std::string{"mail host=alice@host and box=bob@box"});
+        test_eq("replace dollar",
+                std::regex_replace(std::string{"a1"}, std::regex{"\\d"}, "$$"),
+                std::string{"a$"});
+
+        test_eq("replace empty matches",
+                std::regex_replace(std::string{"abc"}, std::regex{"x*"}, "-"),
+                std::string{"-a-b-c-"});
+
+        std::string out{};
+        std::regex_replace(back_inserter(out), str.begin(), str.end(),
+                           std::regex{"\\s"}, std::string{"_"});
+        test_eq("replace iterator", out, std::string{"mail_alice@host_and_bob@box"});
+    }
+
+    void regex_test::test_iterators()
+    {
+        std::string str{"a1 b22 c333"};
+        std::regex re1{"([a-z])(\\d+)"};
+
+        std::vector<std::string> words{};
+        std::vector<long> positions{};
+        for (std::sregex_iterator it{str.begin(), str.end(), re1}, end{}; it != end; ++it)
+        {
+            words.push_back(it->str(2));
+            positions.push_back(it->position(0));
+        }
+        std::vector<std::string> expected_words{"1", "22", "333"};
+        std::vector<long> expected_positions{0, 3, 7};
+        test_eq("iterator matches", words.begin(), words.end(),
+                expected_words.begin(), expected_words.end());
+        test_eq("iterator positions", positions.begin(), positions.end(),
+                expected_positions.begin(), expected_positions.end());
+
+        std::regex re2{"x*"};
+        std::string str2{"ab"};
+        size_t count{};
+        for (std::sregex_iterator it{str2.begin(), str2.end(), re2}, end{}; it != end; ++it)
+            ++count;
+        test_eq("iterator empty matches", count, 3U);
+
+        std::string csv{"one,two,,three"};
+        std::regex sep{","};
+        std::vector<std::string> fields{
+            std::sregex_token_iterator{csv.begin(), csv.end(), sep, -1},
+            std::sregex_token_iterator{}
+        };
+        std::vector<std::string> expected_fields{"one", "two", "", "three"};
+        test_eq("token iterator split", fields.begin(), fields.end(),
+                expected_fields.begin(), expected_fields.end());
+
+        std::vector<std::string> groups{
+            std::sregex_token_iterator{str.begin(), str.end(), re1, {1, 2}},
+            std::sregex_token_iterator{}
+        };
+        std::vector<std::string> expected_groups{"a", "1", "b", "22", "c", "333"};
+        test_eq("token iterator groups", groups.begin(), groups.end(),
+                expected_groups.begin(), expected_groups.end());
+    }
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <regex>
+#include <string>
+
+namespace std::test
+{
+    bool regex_bench::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        bench_literal();
+        bench_alternation();
+        bench_submatches();
+
+        return end();
+    }
+
+    const char* regex_bench::name()
+    {
+        return "regex_bench";
+    }
+
+    string regex_bench::make_buffer_()
+    {
+        /**
+         * Log like text with the needles only near
+         * the end, so that the whole buffer is scanned.
+         */
+        string res{};
+        res.reserve(buffer_size_ + 64);
+
+        size_t i{};
+        while (res.size() < buffer_size_)
+        {
+            res += "entry ";
+            res += to_string(i++);
+            res += " status ok\n";
+        }
+        res += "entry fault 0x1f status error\n";
+
+        return res;
+    }
+
+    void regex_bench::bench_literal()
+    {
+        auto buffer = make_buffer_();
+        std::regex re{"status error"};
+
+        size_t pos1{};
+        bench("literal find", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+                pos1 += buffer.find("status error");
+        });
+
+        size_t pos2{};
+        bench("literal regex_search", [&](){
+            std::smatch m{};
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                std::regex_search(buffer, m, re);
+                pos2 += m.position(0);
+            }
+        });
+        test_eq("literal positions", pos1, pos2);
+
+        consume(pos1 + pos2);
+    }
+
+    void regex_bench::bench_alternation()
+    {
+        auto buffer = make_buffer_();
+        std::regex re{"status (error|fail|panic)"};
+
+        size_t pos1{};
+        bench("alternation find", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                auto pos = string::npos;
+                for (auto needle: {"status error", "status fail", "status panic"})
+                {
+                    auto found = buffer.find(needle);
+                    if (found < pos)
+                        pos = found;
+                }
+                pos1 += pos;
+            }
+        });
+
+        size_t pos2{};
+        bench("alternation regex_search", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                std::smatch m{};
+                std::regex_search(buffer, m, re);
+                pos2 += m.position(0);
+            }
+        });
+        test_eq("alternation positions", pos1, pos2);
+
+        bool found{};
+        bench("alternation regex_search no results", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+                found = std::regex_search(buffer, re);
+        });
+        test("alternation found", found);
+
+        consume(pos1 + pos2);
+    }
+
+    void regex_bench::bench_submatches()
+    {
+        auto buffer = make_buffer_();
+        std::regex re{"fault (0x[0-9a-f]+)"};
+
+        string val1{};
+        bench("submatch find", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                auto pos = buffer.find("fault 0x");
+                auto end = buffer.find_first_not_of("0123456789abcdef", pos + 8);
+                val1 = buffer.substr(pos + 6, end - pos - 6);
+            }
+        });
+
+        string val2{};
+        bench("submatch regex_search", [&](){
+            std::smatch m{};
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                std::regex_search(buffer, m, re);
+                val2 = m.str(1);
+            }
+        });
+        test_eq("submatch values", val1, val2);
+
+        consume(val1.size() + val2.size());
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <memory>
+#include <thread>
+
+namespace std::test
+{
+    bool shared_ptr_bench::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        bench_copies();
+        bench_contended_copies();
+        bench_weak_locks();
+
+        return end();
+    }
+
+    const char* shared_ptr_bench::name()
+    {
+        return "shared_ptr_bench";
+    }
+
+    void shared_ptr_bench::bench_copies()
+    {
+        auto ptr = std::make_shared<int>(42);
+
+        bench("copy and destroy", [&](){
+            for (size_t i = 0; i < copy_count_; ++i)
+            {
+                auto copy = ptr;
+                consume(static_cast<uint64_t>(*copy));
+            }
+        });
+        test_eq("copy and destroy use_count", ptr.use_count(), 1L);
+    }
+
+    void shared_ptr_bench::bench_contended_copies()
+    {
+        /**
+         * All threads copy the same pointer, so they
+         * contend on a single reference count.
+         */
+        auto ptr = std::make_shared<int>(42);
+
+        bench("contended copy and destroy", [&](){
+            std::thread threads[thread_count_];
+            for (auto& thr: threads)
+            {
+                thr = std::thread{[ptr](){
+                    for (size_t i = 0; i < copy_count_ / thread_count_; ++i)
+                    {
+                        auto copy = ptr;
+                        (void)copy;
+                    }
+                }};
+            }
+
+            for (auto& thr: threads)
+                thr.join();
+        });
+        test_eq("contended copy and destroy use_count", ptr.use_count(), 1L);
+    }
+
+    void shared_ptr_bench::bench_weak_locks()
+    {
+        auto ptr = std::make_shared<int>(42);
+        std::weak_ptr<int> weak{ptr};
+
+        bench("weak_ptr lock", [&](){
+            for (size_t i = 0; i < copy_count_; ++i)
+            {
+                auto locked = weak.lock();
+                consume(static_cast<uint64_t>(*locked));
+            }
+        });
+        test_eq("weak_ptr lock use_count", ptr.use_count(), 1L);
+
+        ptr.reset();
+        test("weak_ptr expired", weak.expired());
+        test("weak_ptr lock after expiry", !weak.lock());
+    }
+}
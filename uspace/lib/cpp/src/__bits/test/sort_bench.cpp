@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace std::test
+{
+    bool sort_bench::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        bench_inputs();
+        bench_partial();
+        bench_parallel();
+
+        return end();
+    }
+
+    const char* sort_bench::name()
+    {
+        return "sort_bench";
+    }
+
+    vector<int> sort_bench::random_data_(size_t count, int modulo)
+    {
+        std::vector<int> res{};
+        res.reserve(count);
+
+        std::uint32_t state{12345};
+        for (size_t i = 0; i < count; ++i)
+        {
+            state = state * 1103515245 + 12345;
+            res.push_back(static_cast<int>((state >> 8) % modulo));
+        }
+
+        return res;
+    }
+
+    void sort_bench::bench_inputs()
+    {
+        std::vector<std::pair<const char*, std::vector<int>>> inputs{};
+        inputs.emplace_back("random", random_data_(element_count_, 1 << 30));
+        inputs.emplace_back("few unique", random_data_(element_count_, 16));
+
+        auto sorted = random_data_(element_count_, 1 << 30);
+        std::sort(sorted.begin(), sorted.end());
+        auto reversed = sorted;
+        std::reverse(reversed.begin(), reversed.end());
+        inputs.emplace_back("sorted", move(sorted));
+        inputs.emplace_back("reversed", move(reversed));
+
+        for (auto& [iname, data]: inputs)
+        {
+            std::string prefix{iname};
+
+            /**
+             * Heap sort is what sort used to do,
+             * kept here for comparison.
+             */
+            auto data1 = data;
+            bench((prefix + " heap sort").c_str(), [&](){
+                std::make_heap(data1.begin(), data1.end());
+                std::sort_heap(data1.begin(), data1.end());
+            });
+            test((prefix + " heap sort").c_str(),
+                 std::is_sorted(data1.begin(), data1.end()));
+
+            auto data2 = data;
+            bench((prefix + " sort").c_str(), [&](){
+                std::sort(data2.begin(), data2.end());
+            });
+            test_eq((prefix + " sort").c_str(), data1.begin(), data1.end(),
+                    data2.begin(), data2.end());
+
+            auto data3 = data;
+            bench((prefix + " stable_sort").c_str(), [&](){
+                std::stable_sort(data3.begin(), data3.end());
+            });
+            test_eq((prefix + " stable_sort").c_str(), data1.begin(), data1.end(),
+                    data3.begin(), data3.end());
+        }
+    }
+
+    void sort_bench::bench_partial()
+    {
+        auto data = random_data_(element_count_, 1 << 30);
+        auto sorted = data;
+        std::sort(sorted.begin(), sorted.end());
+
+        auto data1 = data;
+        bench("partial_sort top 100", [&](){
+            std::partial_sort(data1.begin(), data1.begin() + 100, data1.end());
+        });
+        test_eq("partial_sort top 100", sorted.begin(), sorted.begin() + 100,
+                data1.begin(), data1.begin() + 100);
+
+        auto data2 = data;
+        auto nth = data2.begin() + data2.size() / 2;
+        bench("nth_element median", [&](){
+            std::nth_element(data2.begin(), nth, data2.end());
+        });
+        test_eq("nth_element median", *nth, sorted[sorted.size() / 2]);
+    }
+
+    void sort_bench::bench_parallel()
+    {
+        auto data = random_data_(element_count_, 1 << 30);
+
+        auto data1 = data;
+        bench("sort seq", [&](){
+            std::sort(std::execution::seq, data1.begin(), data1.end());
+        });
+        test("sort seq", std::is_sorted(data1.begin(), data1.end()));
+
+        auto data2 = data;
+        bench("sort par", [&](){
+            std::sort(std::execution::par, data2.begin(), data2.end());
+        });
+        test_eq("sort par", data1.begin(), data1.end(),
+                data2.begin(), data2.end());
+
+        std::vector<std::pair<int, int>> data3{};
+        for (size_t i = 0; i < data.size(); ++i)
+            data3.emplace_back(data[i] % 1000, static_cast<int>(i));
+        bench("stable_sort par", [&](){
+            std::stable_sort(
+                std::execution::par, data3.begin(), data3.end(),
+                [](const auto& lhs, const auto& rhs){
+                    return lhs.first < rhs.first;
+                }
+            );
+        });
+        test("stable_sort par", std::is_sorted(data3.begin(), data3.end()));
+    }
+}
@@ -47,6 +47,7 @@ namespace std::test
         test_find();
         test_substr();
         test_compare();
+        test_short_strings();
 
         return end();
     }
@@ -703,4 +704,91 @@ namespace std::test
             res, 0
         );
     }
+
+    void string_test::test_short_strings()
+    {
+        std::string short1{"short"};
+        std::string long1{"this one does not fit in the string"};
+
+        std::string moved1{std::move(short1)};
+        test_eq(
+            "move short string",
+            moved1, std::string{"short"}
+        );
+        test_eq(
+            "moved from short string is empty",
+            short1.empty(), true
+        );
+
+        std::string moved2{std::move(long1)};
+        test_eq(
+            "move long string",
+            moved2, std::string{"this one does not fit in the string"}
+        );
+        test_eq(
+            "moved from long string is empty",
+            long1.empty(), true
+        );
+
+        moved1.swap(moved2);
+        test_eq(
+            "swap short and long 1",
+            moved1, std::string{"this one does not fit in the string"}
+        );
+        test_eq(
+            "swap short and long 2",
+            moved2, std::string{"short"}
+        );
+
+        std::string str1{"abc"};
+        for (int i = 0; i < 4; ++i)
+            str1.append(str1);
+        test_eq(
+            "self append over the inline buffer",
+            str1, std::string{"abcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabc"}
+        );
+
+        str1.resize(5);
+        str1.shrink_to_fit();
+        test_eq(
+            "shrink to the inline buffer",
+            str1, std::string{"abcab"}
+        );
+        test_eq(
+            "shrunk capacity",
+            (str1.capacity() >= str1.size()), true
+        );
+
+        str1.insert(1, str1);
+        test_eq(
+            "self insert",
+            str1, std::string{"aabcabbcab"}
+        );
+
+        std::string str2{};
+        str2.reserve(40);
+        test_eq(
+            "reserve capacity",
+            (str2.capacity() >= 40), true
+        );
+
+        str2 = "xy";
+        str2 = str2 + 'z';
+        test_eq(
+            "concatenation with a char",
+            str2, std::string{"xyz"}
+        );
+
+        str2 = 'c';
+        test_eq(
+            "char assignment",
+            str2, std::string{"c"}
+        );
+
+        str2.clear();
+        test_eq(
+            "clear terminates the string",
+            str2.c_str()[0], '\0'
+        );
+    }
 }
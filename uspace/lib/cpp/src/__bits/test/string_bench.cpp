@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/mock.hpp>
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        using counted_string = basic_string<
+            char, char_traits<char>, counting_allocator<char>
+        >;
+
+        using counted_ostringstream = basic_ostringstream<
+            char, char_traits<char>, counting_allocator<char>
+        >;
+    }
+
+    bool string_bench::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        bench_key_parsing();
+        bench_formatting();
+        bench_concatenation();
+
+        return end();
+    }
+
+    const char* string_bench::name()
+    {
+        return "string_bench";
+    }
+
+    void string_bench::report_allocations(const char* bname, size_t ops)
+    {
+        if (report_)
+        {
+            std::printf("[%s][%s] %zu allocations in %zu operations\n",
+                        name(), bname, allocation_counter::allocations, ops);
+        }
+    }
+
+    template<class String>
+    uint64_t string_bench::parse_keys_(const vector<String>& lines)
+    {
+        uint64_t res{};
+        for (const auto& line: lines)
+        {
+            auto eq = line.find('=');
+            auto key = line.substr(0, eq);
+            auto value = line.substr(eq + 1);
+
+            res += key.size() + value.size();
+        }
+
+        return res;
+    }
+
+    void string_bench::bench_key_parsing()
+    {
+        /**
+         * Configuration like key=value lines, where
+         * both the keys and the values are short.
+         */
+        std::vector<counted_string> counted_lines{};
+        std::vector<std::string> lines{};
+        for (size_t i = 0; i < line_count_; ++i)
+        {
+            std::string line{"opt"};
+            line += std::to_string(i % 1000);
+            line += "=";
+            line += std::to_string(i);
+
+            lines.push_back(line);
+            counted_lines.push_back(counted_string{line.c_str()});
+        }
+
+        allocation_counter::clear();
+        auto res = parse_keys_(counted_lines);
+        report_allocations("key parsing", line_count_);
+        test_eq("key parsing does not allocate",
+                allocation_counter::allocations, 0ul);
+
+        uint64_t res2{};
+        bench("key parsing", [&](){
+            res2 = parse_keys_(lines);
+        });
+        test_eq("key parsing result", res, res2);
+
+        consume(res2);
+    }
+
+    template<class String, class Stream>
+    uint64_t string_bench::format_records_(size_t count)
+    {
+        uint64_t res{};
+        for (size_t i = 0; i < count; ++i)
+        {
+            Stream ss{};
+            ss << "node " << i;
+
+            String str = ss.str();
+            res += str.size();
+        }
+
+        return res;
+    }
+
+    void string_bench::bench_formatting()
+    {
+        allocation_counter::clear();
+        auto res = format_records_<counted_string, counted_ostringstream>(
+            record_count_
+        );
+        report_allocations("formatting", record_count_);
+        test_eq("short formatting does not allocate",
+                allocation_counter::allocations, 0ul);
+
+        uint64_t res2{};
+        bench("formatting", [&](){
+            res2 = format_records_<std::string, std::ostringstream>(
+                record_count_
+            );
+        });
+        test_eq("formatting result", res, res2);
+
+        consume(res2);
+    }
+
+    template<class String>
+    uint64_t string_bench::concatenate_(size_t count)
+    {
+        uint64_t res{};
+        for (size_t i = 0; i < count; ++i)
+        {
+            String dir{"/srv"};
+            String name{"node"};
+
+            /**
+             * Short temporaries on the way to a path
+             * that has to be allocated.
+             */
+            auto path = dir + "/" + name + "/" + name + "/data";
+            res += path.size();
+        }
+
+        return res;
+    }
+
+    void string_bench::bench_concatenation()
+    {
+        allocation_counter::clear();
+        auto res = concatenate_<counted_string>(record_count_);
+        report_allocations("concatenation", record_count_);
+        test_eq("concatenation allocates only long strings",
+                (allocation_counter::allocations <= record_count_ * 2), true);
+
+        uint64_t res2{};
+        bench("concatenation", [&](){
+            res2 = concatenate_<std::string>(record_count_);
+        });
+        test_eq("concatenation result", res, res2);
+
+        consume(res2);
+    }
+}
@@ -28,6 +28,7 @@
 
 #include <__bits/test/tests.hpp>
 #include <initializer_list>
+#include <iterator>
 #include <unordered_set>
 #include <string>
 #include <utility>
@@ -136,9 +137,11 @@ namespace std::test
         test_eq("second insert failure", res7.second, false);
         test_eq("second insert equivalence", *res7.first, std::string{"B"});
 
-        auto res10 = set1.erase(set1.find(2));
+        auto to_erase = set1.find(2);
+        auto next = std::next(to_erase);
+        auto res10 = set1.erase(to_erase);
         test_eq("erase", set1.find(2), set1.end());
-        test_eq("highest erased", res10, set1.end());
+        test_eq("erase returns successor", res10, next);
 
         set2.insert(std::string{"G"});
         set2.insert(std::string{"H"});
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <initializer_list>
+#include <valarray>
+
+namespace std::test
+{
+    bool valarray_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_construction_and_assignment();
+        test_operators();
+        test_subsets();
+        test_members();
+        test_math();
+
+        return end();
+    }
+
+    const char* valarray_test::name()
+    {
+        return "valarray";
+    }
+
+    void valarray_test::test_construction_and_assignment()
+    {
+        std::valarray<int> arr1{};
+        test_eq("default constructor", arr1.size(), 0U);
+
+        std::valarray<int> arr2(5);
+        auto check1 = {0, 0, 0, 0, 0};
+        test_eq("size constructor", check1.begin(), check1.end(),
+                std::begin(arr2), std::end(arr2));
+
+        std::valarray<int> arr3(7, 3);
+        auto check2 = {7, 7, 7};
+        test_eq("value constructor", check2.begin(), check2.end(),
+                std::begin(arr3), std::end(arr3));
+
+        int data[] = {1, 2, 3, 4};
+        std::valarray<int> arr4(data, 4);
+        auto check3 = {1, 2, 3, 4};
+        test_eq("pointer constructor", check3.begin(), check3.end(),
+                std::begin(arr4), std::end(arr4));
+
+        std::valarray<int> arr5{arr4};
+        test_eq("copy constructor", check3.begin(), check3.end(),
+                std::begin(arr5), std::end(arr5));
+
+        std::valarray<int> arr6{std::move(arr5)};
+        test_eq("move constructor", check3.begin(), check3.end(),
+                std::begin(arr6), std::end(arr6));
+        test_eq("move constructor source", arr5.size(), 0U);
+
+        arr2 = arr4;
+        test_eq("copy assignment", check3.begin(), check3.end(),
+                std::begin(arr2), std::end(arr2));
+
+        arr2 = 9;
+        auto check4 = {9, 9, 9, 9};
+        test_eq("scalar assignment", check4.begin(), check4.end(),
+                std::begin(arr2), std::end(arr2));
+
+        arr2 = {5, 6};
+        auto check5 = {5, 6};
+        test_eq("initializer_list assignment", check5.begin(), check5.end(),
+                std::begin(arr2), std::end(arr2));
+
+        std::valarray<int> arr7 = arr4 * arr4 + 1;
+        auto check6 = {2, 5, 10, 17};
+        test_eq("expression constructor", check6.begin(), check6.end(),
+                std::begin(arr7), std::end(arr7));
+
+        arr1 = arr4 - arr6;
+        auto check7 = {0, 0, 0, 0};
+        test_eq("expression assignment with resize",
+                check7.begin(), check7.end(),
+                std::begin(arr1), std::end(arr1));
+
+        arr7 = arr7 - arr4 * 2;
+        auto check8 = {0, 1, 4, 9};
+        test_eq("aliased expression assignment",
+                check8.begin(), check8.end(),
+                std::begin(arr7), std::end(arr7));
+    }
+
+    void valarray_test::test_operators()
+    {
+        std::valarray<int> arr1{1, 2, 3, 4};
+        std::valarray<int> arr2{4, 3, 2, 1};
+
+        std::valarray<int> res1 = arr1 + arr2 * 2 - 1;
+        auto check1 = {8, 7, 6, 5};
+        test_eq("fused expression", check1.begin(), check1.end(),
+                std::begin(res1), std::end(res1));
+
+        std::valarray<int> res2 = 10 / arr1 + arr2 % 3;
+        auto check2 = {11, 5, 5, 3};
+        test_eq("scalar operands", check2.begin(), check2.end(),
+                std::begin(res2), std::end(res2));
+
+        std::valarray<int> res3 = -arr1 + ~arr2;
+        auto check3 = {-6, -6, -6, -6};
+        test_eq("unary operators", check3.begin(), check3.end(),
+                std::begin(res3), std::end(res3));
+
+        std::valarray<int> res4 = (arr1 << 2) | (arr2 & 1);
+        auto check4 = {4, 9, 12, 17};
+        test_eq("bitwise operators", check4.begin(), check4.end(),
+                std::begin(res4), std::end(res4));
+
+        std::valarray<bool> res5 = arr1 < arr2;
+        auto check5 = {true, true, false, false};
+        test_eq("comparison", check5.begin(), check5.end(),
+                std::begin(res5), std::end(res5));
+
+        std::valarray<bool> res6 = (arr1 == 2) || !(arr2 != 1);
+        auto check6 = {false, true, false, true};
+        test_eq("logical operators", check6.begin(), check6.end(),
+                std::begin(res6), std::end(res6));
+
+        res1 = arr1;
+        res1 += arr2;
+        res1 *= 2;
+        res1 -= arr1 * arr2;
+        auto check7 = {6, 4, 4, 6};
+        test_eq("compound assignment", check7.begin(), check7.end(),
+                std::begin(res1), std::end(res1));
+
+        res1 >>= 1;
+        res1 ^= arr1;
+        auto check8 = {2, 0, 1, 7};
+        test_eq("compound bitwise", check8.begin(), check8.end(),
+                std::begin(res1), std::end(res1));
+
+        test_eq("expression sum", (arr1 * arr2).sum(), 20);
+        test_eq("expression min", (arr1 - arr2).min(), -3);
+        test_eq("expression max", (arr1 - arr2).max(), 3);
+    }
+
+    void valarray_test::test_subsets()
+    {
+        std::valarray<int> arr1{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+        std::valarray<int> res1 = arr1[std::slice(1, 4, 3)];
+        auto check1 = {1, 4, 7, 10};
+        test_eq("slice read", check1.begin(), check1.end(),
+                std::begin(res1), std::end(res1));
+
+        auto arr2 = arr1;
+        arr2[std::slice(0, 3, 4)] = 0;
+        arr2[std::slice(1, 3, 4)] += std::valarray<int>{10, 20, 30};
+        auto check2 = {0, 11, 2, 3, 0, 25, 6, 7, 0, 39, 10, 11};
+        test_eq("slice write", check2.begin(), check2.end(),
+                std::begin(arr2), std::end(arr2));
+
+        std::valarray<size_t> sizes{2, 3};
+        std::valarray<size_t> strides{6, 2};
+        std::valarray<int> res2 = arr1[std::gslice(1, sizes, strides)];
+        auto check3 = {1, 3, 5, 7, 9, 11};
+        test_eq("gslice read", check3.begin(), check3.end(),
+                std::begin(res2), std::end(res2));
+
+        arr2 = arr1;
+        arr2[std::gslice(0, sizes, strides)] *= std::valarray<int>(-1, 6);
+        auto check4 = {0, 1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11};
+        test_eq("gslice write", check4.begin(), check4.end(),
+                std::begin(arr2), std::end(arr2));
+
+        std::valarray<int> res3 = arr2[arr2 < 0];
+        auto check5 = {-2, -4, -6, -8, -10};
+        test_eq("mask read", check5.begin(), check5.end(),
+                std::begin(res3), std::end(res3));
+
+        arr2[arr2 < 0] = 0;
+        test_eq("mask write", arr2.min(), 0);
+
+        std::valarray<size_t> indices{11, 0, 5};
+        std::valarray<int> res4 = arr1[indices];
+        auto check6 = {11, 0, 5};
+        test_eq("indirect read", check6.begin(), check6.end(),
+                std::begin(res4), std::end(res4));
+
+        arr2 = arr1;
+        arr2[indices] = std::valarray<int>{1, 2, 3};
+        auto check7 = {2, 1, 2, 3, 4, 3, 6, 7, 8, 9, 10, 1};
+        test_eq("indirect write", check7.begin(), check7.end(),
+                std::begin(arr2), std::end(arr2));
+
+        arr2[std::slice(0, 4, 1)] = arr1[std::slice(8, 4, 1)];
+        auto check8 = {8, 9, 10, 11};
+        test_eq("slice to slice", check8.begin(), check8.end(),
+                std::begin(arr2), std::begin(arr2) + 4);
+    }
+
+    void valarray_test::test_members()
+    {
+        std::valarray<int> arr1{3, 1, 4, 1, 5};
+
+        test_eq("sum", arr1.sum(), 14);
+        test_eq("min", arr1.min(), 1);
+        test_eq("max", arr1.max(), 5);
+
+        auto res1 = arr1.shift(2);
+        auto check1 = {4, 1, 5, 0, 0};
+        test_eq("shift left", check1.begin(), check1.end(),
+                std::begin(res1), std::end(res1));
+
+        auto res2 = arr1.shift(-1);
+        auto check2 = {0, 3, 1, 4, 1};
+        test_eq("shift right", check2.begin(), check2.end(),
+                std::begin(res2), std::end(res2));
+
+        auto res3 = arr1.cshift(7);
+        auto check3 = {4, 1, 5, 3, 1};
+        test_eq("cshift left", check3.begin(), check3.end(),
+                std::begin(res3), std::end(res3));
+
+        auto res4 = arr1.cshift(-1);
+        auto check4 = {5, 3, 1, 4, 1};
+        test_eq("cshift right", check4.begin(), check4.end(),
+                std::begin(res4), std::end(res4));
+
+        auto res5 = arr1.apply([](int x){ return x * x; });
+        auto check5 = {9, 1, 16, 1, 25};
+        test_eq("apply", check5.begin(), check5.end(),
+                std::begin(res5), std::end(res5));
+
+        arr1.resize(3, 2);
+        auto check6 = {2, 2, 2};
+        test_eq("resize", check6.begin(), check6.end(),
+                std::begin(arr1), std::end(arr1));
+
+        std::valarray<int> arr2{1};
+        arr1.swap(arr2);
+        test_eq("swap pt1", arr1.size(), 1U);
+        test_eq("swap pt2", arr2.size(), 3U);
+
+        int sum{};
+        for (auto x: arr2)
+            sum += x;
+        test_eq("range for", sum, 6);
+    }
+
+    void valarray_test::test_math()
+    {
+        std::valarray<double> arr1{1.0, 4.0, 9.0, 16.0};
+        std::valarray<double> arr2{-1.5, 2.0, -0.5, 0.0};
+
+        std::valarray<double> res1 = std::sqrt(arr1) + std::abs(arr2);
+        auto check1 = {2.5, 4.0, 3.5, 4.0};
+        test_eq("sqrt and abs", check1.begin(), check1.end(),
+                std::begin(res1), std::end(res1));
+
+        std::valarray<double> res2 = std::pow(arr1, 0.5) - std::pow(2.0, arr2 * 2.0);
+        auto check2 = {0.875, -14.0, 2.5, 3.0};
+        test_eq("pow", check2.begin(), check2.end(),
+                std::begin(res2), std::end(res2));
+
+        std::valarray<int> arr3{-3, 2, -1};
+        std::valarray<int> res3 = std::abs(arr3) * 2;
+        auto check3 = {6, 4, 2};
+        test_eq("integral abs", check3.begin(), check3.end(),
+                std::begin(res3), std::end(res3));
+    }
+}
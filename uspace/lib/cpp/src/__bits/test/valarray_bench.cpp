@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <valarray>
+
+namespace std::test
+{
+    bool valarray_bench::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        bench_fused();
+        bench_chained();
+        bench_reduction();
+
+        return end();
+    }
+
+    const char* valarray_bench::name()
+    {
+        return "valarray_bench";
+    }
+
+    valarray<double> valarray_bench::make_data_(double seed)
+    {
+        valarray<double> res(element_count_);
+        for (size_t i = 0; i < element_count_; ++i)
+            res[i] = seed + static_cast<double>(i % 97) * 0.25;
+
+        return res;
+    }
+
+    void valarray_bench::bench_fused()
+    {
+        auto a = make_data_(1.0);
+        auto b = make_data_(2.0);
+        auto c = make_data_(3.0);
+
+        /**
+         * The naive variant evaluates every operation
+         * into a temporary array, which is what we would
+         * do without expression templates.
+         */
+        valarray<double> res1{};
+        bench("a * b + c naive", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                valarray<double> tmp{a * b};
+                res1 = valarray<double>{tmp + c};
+            }
+        });
+
+        valarray<double> res2{};
+        bench("a * b + c fused", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+                res2 = a * b + c;
+        });
+
+        test("a * b + c results", (res1 == res2).min());
+
+        consume(static_cast<uint64_t>(res2.sum()));
+    }
+
+    void valarray_bench::bench_chained()
+    {
+        auto a = make_data_(1.0);
+        auto b = make_data_(2.0);
+        auto c = make_data_(3.0);
+        auto d = make_data_(4.0);
+
+        valarray<double> res1{};
+        bench("chained naive", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                valarray<double> tmp1{a * b};
+                valarray<double> tmp2{c * d};
+                valarray<double> tmp3{tmp1 + tmp2};
+                valarray<double> tmp4{a * 0.5};
+                res1 = valarray<double>{tmp3 - tmp4};
+            }
+        });
+
+        valarray<double> res2{};
+        bench("chained fused", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+                res2 = a * b + c * d - a * 0.5;
+        });
+
+        valarray<double> res3 = a;
+        bench("chained compound", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                res3 = a;
+                res3 *= b;
+                res3 += c * d - a * 0.5;
+            }
+        });
+
+        test("chained results pt1", (res1 == res2).min());
+        test("chained results pt2", (res2 == res3).min());
+
+        consume(static_cast<uint64_t>(res2.sum()));
+    }
+
+    void valarray_bench::bench_reduction()
+    {
+        auto a = make_data_(1.0);
+        auto b = make_data_(2.0);
+
+        double res1{};
+        bench("dot product naive", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+            {
+                valarray<double> tmp{a * b};
+                res1 = tmp.sum();
+            }
+        });
+
+        double res2{};
+        bench("dot product fused", [&](){
+            for (size_t i = 0; i < rounds_; ++i)
+                res2 = (a * b).sum();
+        });
+
+        test_eq("dot product results", res1, res2);
+
+        consume(static_cast<uint64_t>(res1 + res2));
+    }
+}
@@ -29,6 +29,7 @@
 #include <__bits/test/tests.hpp>
 #include <algorithm>
 #include <initializer_list>
+#include <list>
 #include <utility>
 #include <vector>
 
@@ -130,6 +131,39 @@ namespace std::test
         );
 
         test_eq("move assignment origin empty", vec9.size(), 0U);
+
+        std::list<int> lst{check1};
+        std::vector<int> vec12(lst.begin(), lst.end());
+        test_eq(
+            "range constructor",
+            vec12.begin(), vec12.end(),
+            check1.begin(), check1.end()
+        );
+
+        std::vector<int> vec11{1, 2};
+        vec11.resize(5, 7);
+        auto check4 = {1, 2, 7, 7, 7};
+        test_eq(
+            "resize with value",
+            vec11.begin(), vec11.end(),
+            check4.begin(), check4.end()
+        );
+
+        vec11.resize(1);
+        vec11.resize(3);
+        auto check5 = {1, 0, 0};
+        test_eq(
+            "resize shrink and grow",
+            vec11.begin(), vec11.end(),
+            check5.begin(), check5.end()
+        );
+
+        std::vector<int> vec13{1, 3};
+        std::vector<int> vec14{2, 1};
+        test("less than", vec13 < vec14);
+        test("less than reversed", !(vec14 < vec13));
+        test("less than equal", !(vec13 < vec13));
+        test("less than prefix", std::vector<int>{1} < vec13);
     }
 
     void vector_test::test_insert()
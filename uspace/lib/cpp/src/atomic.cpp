@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/thread/threading.hpp>
+#include <atomic>
+
+namespace std::aux
+{
+    struct atomic_wait_bucket
+    {
+        atomic_wait_bucket()
+            : mtx{}, cv{}, waiters{}
+        {
+            threading::mutex::init(mtx);
+            threading::condvar::init(cv);
+        }
+
+        mutex_t mtx;
+        condvar_t cv;
+
+        /**
+         * Allows notify to skip locking the mutex
+         * when nobody waits, which is the common case.
+         */
+        atomic<size_t> waiters;
+    };
+
+    static constexpr size_t atomic_wait_bucket_count{16};
+
+    static atomic_wait_bucket atomic_wait_buckets[atomic_wait_bucket_count];
+
+    static atomic_wait_bucket& atomic_wait_bucket_for(const volatile void* addr)
+    {
+        auto key = reinterpret_cast<uintptr_t>(addr) / sizeof(void*);
+
+        return atomic_wait_buckets[key % atomic_wait_bucket_count];
+    }
+
+    void atomic_wait(const volatile void* addr, atomic_wait_pred_t unchanged,
+                     const void* old, memory_order order) noexcept
+    {
+        auto& bucket = atomic_wait_bucket_for(addr);
+
+        /**
+         * The increment and the fence in notify make sure
+         * that either the notifier sees us waiting or we
+         * see the new value.
+         */
+        bucket.waiters.fetch_add(1, memory_order_seq_cst);
+
+        threading::mutex::lock(bucket.mtx);
+        while (unchanged(addr, old, order))
+            threading::condvar::wait(bucket.cv, bucket.mtx);
+        threading::mutex::unlock(bucket.mtx);
+
+        bucket.waiters.fetch_sub(1, memory_order_relaxed);
+    }
+
+    void atomic_notify(const volatile void* addr) noexcept
+    {
+        auto& bucket = atomic_wait_bucket_for(addr);
+
+        atomic_thread_fence(memory_order_seq_cst);
+        if (bucket.waiters.load(memory_order_relaxed) == 0)
+            return;
+
+        /**
+         * Locking the mutex makes sure that a waiter that
+         * saw the old value is already blocked, so it does
+         * not miss the wake up.
+         */
+        threading::mutex::lock(bucket.mtx);
+        threading::condvar::broadcast(bucket.cv);
+        threading::mutex::unlock(bucket.mtx);
+    }
+}
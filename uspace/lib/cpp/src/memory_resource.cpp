@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+namespace std::aux
+{
+    namespace
+    {
+        size_t align_up(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    void* block_pool::allocate(pmr::memory_resource* upstream, size_t max_blocks)
+    {
+        if (free_)
+        {
+            auto block = free_;
+            free_ = block->next;
+
+            return block;
+        }
+
+        if (bump_ == bump_end_)
+        {
+            auto blocks = min(next_blocks_, max_blocks);
+            auto blocks_size = blocks * block_size_;
+            auto size = blocks_size + sizeof(pool_chunk);
+
+            auto mem = static_cast<char*>(
+                upstream->allocate(size, alignof(max_align_t))
+            );
+            if (!mem)
+                return nullptr;
+
+            auto chunk = reinterpret_cast<pool_chunk*>(mem + blocks_size);
+            chunk->next = chunks_;
+            chunk->size = size;
+            chunks_ = chunk;
+
+            bump_ = mem;
+            bump_end_ = mem + blocks_size;
+
+            if (blocks < max_blocks && blocks_size * 2 <= max_chunk_size_)
+                next_blocks_ = blocks * 2;
+        }
+
+        auto res = bump_;
+        bump_ += block_size_;
+
+        return res;
+    }
+
+    void block_pool::deallocate(void* ptr) noexcept
+    {
+        auto block = static_cast<pool_block*>(ptr);
+        block->next = free_;
+        free_ = block;
+    }
+
+    void block_pool::release(pmr::memory_resource* upstream) noexcept
+    {
+        while (chunks_)
+        {
+            auto chunk = chunks_;
+            chunks_ = chunk->next;
+
+            auto size = chunk->size;
+            auto mem = reinterpret_cast<char*>(chunk) - (size - sizeof(pool_chunk));
+            upstream->deallocate(mem, size, alignof(max_align_t));
+        }
+
+        next_blocks_ = initial_blocks_;
+        free_ = nullptr;
+        bump_ = nullptr;
+        bump_end_ = nullptr;
+    }
+}
+
+namespace std::pmr
+{
+    namespace
+    {
+        class new_delete_memory_resource: public memory_resource
+        {
+            protected:
+                /**
+                 * Note: Our operator new only guarantees the
+                 *       alignment of max_align_t, stricter
+                 *       alignments go to memalign.
+                 */
+                void* do_allocate(size_t bytes, size_t alignment) override
+                {
+                    if (alignment <= alignof(max_align_t))
+                        return ::operator new(bytes);
+                    else
+                        return ::helenos::memalign(alignment, bytes);
+                }
+
+                void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+                {
+                    if (alignment <= alignof(max_align_t))
+                        ::operator delete(ptr, bytes);
+                    else
+                        std::free(ptr);
+                }
+
+                bool do_is_equal(const memory_resource& other) const noexcept override
+                {
+                    return this == &other;
+                }
+        };
+
+        class null_memory_resource_impl: public memory_resource
+        {
+            protected:
+                void* do_allocate(size_t, size_t) override
+                {
+                    throw bad_alloc{};
+
+                    return nullptr;
+                }
+
+                void do_deallocate(void*, size_t, size_t) override
+                { /* DUMMY BODY */ }
+
+                bool do_is_equal(const memory_resource& other) const noexcept override
+                {
+                    return this == &other;
+                }
+        };
+
+        new_delete_memory_resource new_delete_resource_{};
+        null_memory_resource_impl null_memory_resource_{};
+
+        atomic<memory_resource*> default_resource_{&new_delete_resource_};
+    }
+
+    memory_resource* new_delete_resource() noexcept
+    {
+        return &new_delete_resource_;
+    }
+
+    memory_resource* null_memory_resource() noexcept
+    {
+        return &null_memory_resource_;
+    }
+
+    memory_resource* set_default_resource(memory_resource* resource) noexcept
+    {
+        if (!resource)
+            resource = new_delete_resource();
+
+        return default_resource_.exchange(resource);
+    }
+
+    memory_resource* get_default_resource() noexcept
+    {
+        return default_resource_.load();
+    }
+
+    namespace
+    {
+        constexpr size_t min_block_shift{3};
+        constexpr size_t min_block_size{1U << min_block_shift};
+
+        constexpr size_t default_max_blocks_per_chunk{1024};
+        constexpr size_t max_max_blocks_per_chunk{1U << 16};
+        constexpr size_t default_largest_pool_block{4096};
+        constexpr size_t max_largest_pool_block{1U << 16};
+
+        size_t block_shift(size_t size)
+        {
+            if (size <= min_block_size)
+                return min_block_shift;
+
+            return numeric_limits<unsigned long long>::digits
+                - __builtin_clzll(static_cast<unsigned long long>(size - 1));
+        }
+
+        pool_options normalize_options(pool_options opts)
+        {
+            if (opts.max_blocks_per_chunk == 0)
+                opts.max_blocks_per_chunk = default_max_blocks_per_chunk;
+            else if (opts.max_blocks_per_chunk > max_max_blocks_per_chunk)
+                opts.max_blocks_per_chunk = max_max_blocks_per_chunk;
+
+            if (opts.largest_required_pool_block == 0)
+                opts.largest_required_pool_block = default_largest_pool_block;
+            else if (opts.largest_required_pool_block > max_largest_pool_block)
+                opts.largest_required_pool_block = max_largest_pool_block;
+
+            opts.largest_required_pool_block =
+                size_t{1} << block_shift(opts.largest_required_pool_block);
+
+            return opts;
+        }
+
+        size_t oversized_header_size(size_t alignment)
+        {
+            return aux::align_up(
+                sizeof(aux::oversized_block),
+                max(alignment, alignof(aux::oversized_block))
+            );
+        }
+    }
+
+    unsynchronized_pool_resource::unsynchronized_pool_resource(
+        const pool_options& opts, memory_resource* upstream
+    )
+        : upstream_{upstream}, options_{normalize_options(opts)},
+          pools_{}, pool_count_{}, oversized_{}
+    {
+        pool_count_ = block_shift(options_.largest_required_pool_block)
+            - min_block_shift + 1;
+
+        pools_ = static_cast<aux::block_pool*>(upstream_->allocate(
+            pool_count_ * sizeof(aux::block_pool), alignof(aux::block_pool)
+        ));
+
+        if (!pools_)
+        {
+            pool_count_ = 0;
+            return;
+        }
+
+        for (size_t i = 0; i < pool_count_; ++i)
+            ::new(static_cast<void*>(pools_ + i)) aux::block_pool{min_block_size << i};
+    }
+
+    unsynchronized_pool_resource::~unsynchronized_pool_resource()
+    {
+        release();
+
+        if (pools_)
+        {
+            for (size_t i = 0; i < pool_count_; ++i)
+                pools_[i].~block_pool();
+
+            upstream_->deallocate(
+                pools_, pool_count_ * sizeof(aux::block_pool),
+                alignof(aux::block_pool)
+            );
+        }
+    }
+
+    void unsynchronized_pool_resource::release()
+    {
+        for (size_t i = 0; i < pool_count_; ++i)
+            pools_[i].release(upstream_);
+
+        while (oversized_)
+        {
+            auto block = oversized_;
+            oversized_ = block->next;
+
+            auto header_size = oversized_header_size(block->alignment);
+            auto mem = reinterpret_cast<char*>(block + 1) - header_size;
+            upstream_->deallocate(mem, block->size, block->alignment);
+        }
+    }
+
+    void* unsynchronized_pool_resource::do_allocate(size_t bytes, size_t alignment)
+    {
+        if (auto pool = find_pool_(bytes, alignment); pool)
+            return pool->allocate(upstream_, options_.max_blocks_per_chunk);
+
+        /**
+         * The header is placed right in front of the
+         * returned memory, so that deallocation can
+         * find it without a lookup.
+         */
+        auto header_size = oversized_header_size(alignment);
+        auto size = header_size + bytes;
+        alignment = max(alignment, alignof(aux::oversized_block));
+
+        auto mem = static_cast<char*>(upstream_->allocate(size, alignment));
+        if (!mem)
+            return nullptr;
+
+        auto res = mem + header_size;
+        auto block = reinterpret_cast<aux::oversized_block*>(res) - 1;
+        block->size = size;
+        block->alignment = alignment;
+        block->prev = nullptr;
+        block->next = oversized_;
+        if (oversized_)
+            oversized_->prev = block;
+        oversized_ = block;
+
+        return res;
+    }
+
+    void unsynchronized_pool_resource::do_deallocate(void* ptr, size_t bytes,
+                                                     size_t alignment)
+    {
+        if (!ptr)
+            return;
+
+        if (auto pool = find_pool_(bytes, alignment); pool)
+        {
+            pool->deallocate(ptr);
+            return;
+        }
+
+        auto block = static_cast<aux::oversized_block*>(ptr) - 1;
+        if (block->prev)
+            block->prev->next = block->next;
+        else
+            oversized_ = block->next;
+        if (block->next)
+            block->next->prev = block->prev;
+
+        auto mem = static_cast<char*>(ptr) - oversized_header_size(block->alignment);
+        upstream_->deallocate(mem, block->size, block->alignment);
+    }
+
+    bool unsynchronized_pool_resource::do_is_equal(
+        const memory_resource& other
+    ) const noexcept
+    {
+        return this == &other;
+    }
+
+    aux::block_pool* unsynchronized_pool_resource::find_pool_(
+        size_t bytes, size_t alignment
+    ) noexcept
+    {
+        if (alignment > alignof(max_align_t))
+            return nullptr;
+
+        auto size = max(bytes, alignment);
+        if (size > options_.largest_required_pool_block || pool_count_ == 0)
+            return nullptr;
+
+        return pools_ + (block_shift(size) - min_block_shift);
+    }
+
+    void synchronized_pool_resource::release()
+    {
+        lock_guard<mutex> lock{mtx_};
+
+        resource_.release();
+    }
+
+    void* synchronized_pool_resource::do_allocate(size_t bytes, size_t alignment)
+    {
+        lock_guard<mutex> lock{mtx_};
+
+        return resource_.allocate(bytes, alignment);
+    }
+
+    void synchronized_pool_resource::do_deallocate(void* ptr, size_t bytes,
+                                                   size_t alignment)
+    {
+        lock_guard<mutex> lock{mtx_};
+
+        resource_.deallocate(ptr, bytes, alignment);
+    }
+
+    bool synchronized_pool_resource::do_is_equal(
+        const memory_resource& other
+    ) const noexcept
+    {
+        return this == &other;
+    }
+
+    monotonic_buffer_resource::~monotonic_buffer_resource()
+    {
+        release();
+    }
+
+    void monotonic_buffer_resource::release()
+    {
+        while (chunks_)
+        {
+            auto chunk = chunks_;
+            chunks_ = chunk->next;
+
+            auto size = chunk->size;
+            auto mem = reinterpret_cast<char*>(chunk + 1) - size;
+            upstream_->deallocate(mem, size, alignof(max_align_t));
+        }
+
+        current_ = static_cast<char*>(buffer_);
+        remaining_ = buffer_size_;
+        next_size_ = initial_next_size_;
+    }
+
+    void* monotonic_buffer_resource::do_allocate(size_t bytes, size_t alignment)
+    {
+        auto addr = reinterpret_cast<uintptr_t>(current_);
+        auto padding = aux::align_up(addr, alignment) - addr;
+
+        if (!current_ || padding + bytes > remaining_)
+        {
+            /**
+             * Note: The rest of the current chunk is abandoned,
+             *       the chunk descriptor goes to its end so that
+             *       the whole chunk can be used for allocations.
+             */
+            auto size = max(next_size_, bytes + alignment);
+            auto total = aux::align_up(size, alignof(aux::pool_chunk))
+                + sizeof(aux::pool_chunk);
+
+            auto mem = static_cast<char*>(
+                upstream_->allocate(total, alignof(max_align_t))
+            );
+            if (!mem)
+                return nullptr;
+
+            auto chunk = reinterpret_cast<aux::pool_chunk*>(mem + total) - 1;
+            chunk->next = chunks_;
+            chunk->size = total;
+            chunks_ = chunk;
+
+            current_ = mem;
+            remaining_ = total - sizeof(aux::pool_chunk);
+            next_size_ = size * growth_factor_;
+
+            addr = reinterpret_cast<uintptr_t>(current_);
+            padding = aux::align_up(addr, alignment) - addr;
+        }
+
+        auto res = current_ + padding;
+        current_ = res + bytes;
+        remaining_ -= padding + bytes;
+
+        return res;
+    }
+
+    void monotonic_buffer_resource::do_deallocate(void*, size_t, size_t)
+    { /* DUMMY BODY */ }
+
+    bool monotonic_buffer_resource::do_is_equal(
+        const memory_resource& other
+    ) const noexcept
+    {
+        return this == &other;
+    }
+}
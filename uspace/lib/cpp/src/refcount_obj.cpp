@@ -30,49 +30,46 @@
 
 namespace std::aux
 {
-    void refcount_obj::increment()
+    /**
+     * Note: Taking a new reference requires already holding
+     *       one, so it does not have to synchronize with
+     *       anything and can be relaxed. Dropping a reference
+     *       has to release the changes made to the object and,
+     *       if it was the last one, acquire the changes made
+     *       by the other owners before the object gets destroyed.
+     */
+
+    void refcount_obj::increment() noexcept
     {
-        __atomic_add_fetch(&refcount_, 1, __ATOMIC_ACQ_REL);
+        refcount_.fetch_add(1, memory_order_relaxed);
     }
 
-    void refcount_obj::increment_weak()
+    void refcount_obj::increment_weak() noexcept
     {
-        __atomic_add_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL);
+        weak_refcount_.fetch_add(1, memory_order_relaxed);
     }
 
-    bool refcount_obj::decrement()
+    bool refcount_obj::decrement() noexcept
     {
-        if (__atomic_sub_fetch(&refcount_, 1, __ATOMIC_ACQ_REL) == 0)
-        {
-            /**
-             * First call to destroy() will delete the held object,
-             * so it doesn't matter what the weak_refcount_ is,
-             * but we added one and we need to remove it now.
-             */
-            decrement_weak();
-
-            return true;
-        }
-        else
-            return false;
+        return refcount_.fetch_sub(1, memory_order_acq_rel) == 1;
     }
 
-    bool refcount_obj::decrement_weak()
+    bool refcount_obj::decrement_weak() noexcept
     {
-        return __atomic_sub_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL) == 0 && refs() == 0;
+        return weak_refcount_.fetch_sub(1, memory_order_acq_rel) == 1;
     }
 
-    refcount_t refcount_obj::refs() const
+    refcount_t refcount_obj::refs() const noexcept
     {
-        return __atomic_load_n(&refcount_, __ATOMIC_RELAXED);
+        return refcount_.load(memory_order_relaxed);
     }
 
-    refcount_t refcount_obj::weak_refs() const
+    refcount_t refcount_obj::weak_refs() const noexcept
     {
-        return __atomic_load_n(&weak_refcount_, __ATOMIC_RELAXED);
+        return weak_refcount_.load(memory_order_relaxed);
     }
 
-    bool refcount_obj::expired() const
+    bool refcount_obj::expired() const noexcept
     {
         return refs() == 0;
     }
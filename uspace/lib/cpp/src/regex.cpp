@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 agent
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <regex>
+
+namespace std
+{
+    namespace
+    {
+        const char* regex_error_message(regex_constants::error_type ecode)
+        {
+            switch (ecode)
+            {
+                case regex_constants::error_collate:
+                    return "invalid collating element name";
+                case regex_constants::error_ctype:
+                    return "invalid character class name";
+                case regex_constants::error_escape:
+                    return "invalid escaped character or trailing escape";
+                case regex_constants::error_backref:
+                    return "invalid back reference";
+                case regex_constants::error_brack:
+                    return "mismatched [ and ]";
+                case regex_constants::error_paren:
+                    return "mismatched ( and )";
+                case regex_constants::error_brace:
+                    return "mismatched { and }";
+                case regex_constants::error_badbrace:
+                    return "invalid range in a {} expression";
+                case regex_constants::error_range:
+                    return "invalid character range";
+                case regex_constants::error_space:
+                    return "insufficient memory to compile the expression";
+                case regex_constants::error_badrepeat:
+                    return "repeat specifier not preceded by an expression";
+                case regex_constants::error_complexity:
+                    return "expression too complex";
+                case regex_constants::error_stack:
+                    return "insufficient memory to match the expression";
+                default:
+                    return "regex_error";
+            }
+        }
+    }
+
+    regex_error::regex_error(regex_constants::error_type ecode)
+        : runtime_error{regex_error_message(ecode)}, code_{ecode}
+    { /* DUMMY BODY */ }
+
+    regex_error::~regex_error() = default;
+
+    regex_constants::error_type regex_error::code() const
+    {
+        return code_;
+    }
+}
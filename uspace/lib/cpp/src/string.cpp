@@ -27,10 +27,18 @@
  */
 
 #include <cassert>
+#include <cstdio>
 #include <string>
 
 namespace std
 {
+    /**
+     * Integers need at most 20 digits and a sign, so they
+     * are formatted on the stack instead of using asprintf,
+     * which saves an allocation per conversion.
+     */
+    static constexpr size_t int_buffer_size_{24};
+
     int stoi(const string& str, size_t* idx, int base)
     {
         // TODO: implement using stol once we have numeric limits
@@ -107,68 +115,50 @@ namespace std
 
     string to_string(int val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%d", val);
+        char tmp[int_buffer_size_];
+        int len = ::snprintf(tmp, int_buffer_size_, "%d", val);
 
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return string(tmp, static_cast<size_t>(len));
     }
 
     string to_string(unsigned val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%u", val);
+        char tmp[int_buffer_size_];
+        int len = ::snprintf(tmp, int_buffer_size_, "%u", val);
 
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return string(tmp, static_cast<size_t>(len));
     }
 
     string to_string(long val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%ld", val);
-
-        std::string res{tmp};
-        free(tmp);
+        char tmp[int_buffer_size_];
+        int len = ::snprintf(tmp, int_buffer_size_, "%ld", val);
 
-        return res;
+        return string(tmp, static_cast<size_t>(len));
     }
 
     string to_string(unsigned long val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%lu", val);
-
-        std::string res{tmp};
-        free(tmp);
+        char tmp[int_buffer_size_];
+        int len = ::snprintf(tmp, int_buffer_size_, "%lu", val);
 
-        return res;
+        return string(tmp, static_cast<size_t>(len));
     }
 
     string to_string(long long val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%lld", val);
-
-        std::string res{tmp};
-        free(tmp);
+        char tmp[int_buffer_size_];
+        int len = ::snprintf(tmp, int_buffer_size_, "%lld", val);
 
-        return res;
+        return string(tmp, static_cast<size_t>(len));
     }
 
     string to_string(unsigned long long val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%llu", val);
+        char tmp[int_buffer_size_];
+        int len = ::snprintf(tmp, int_buffer_size_, "%llu", val);
 
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return string(tmp, static_cast<size_t>(len));
     }
 
     string to_string(float val)
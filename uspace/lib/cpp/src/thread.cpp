@@ -45,11 +45,12 @@ namespace std
         if (joinable() && false)
             std::terminate();
 
-        // TODO: check for finished too?
-        // TODO: WAIT! if it's not detached, then
-        //       we are joinable and std::terminate was called?
-        // TODO: review this entire thing
-        if (joinable_wrapper_ && !joinable_wrapper_->detached())
+        /**
+         * A thread that was neither joined nor detached is detached
+         * here, whoever of us and the thread finishes last deletes
+         * the wrapper.
+         */
+        if (joinable_wrapper_ && joinable_wrapper_->detach())
             delete joinable_wrapper_;
     }
 
@@ -65,6 +66,9 @@ namespace std
         if (joinable())
             std::terminate();
 
+        if (joinable_wrapper_ && joinable_wrapper_->detach())
+            delete joinable_wrapper_;
+
         id_ = other.id_;
         other.id_ = aux::thread_t{};
 
@@ -97,7 +101,8 @@ namespace std
 
         if (joinable_wrapper_)
         {
-            joinable_wrapper_->detach();
+            if (joinable_wrapper_->detach())
+                delete joinable_wrapper_;
             joinable_wrapper_ = nullptr;
         }
     }
@@ -570,8 +570,10 @@ locfs_read(service_id_t service_id, fs_index_t index, aoff64_t pos,
 		service_t *dev = hash_table_get_inst(lnk, service_t, link);
 		assert(dev->sess);
 
+		/* The driver limits the size of the request. */
 		ipc_call_t call;
-		if (!async_data_read_receive(&call, NULL)) {
+		if (!async_data_read_receive_max(&call, NULL,
+		    DATA_XFER_PIN_LIMIT)) {
 			fibril_mutex_unlock(&services_mutex);
 			async_answer_0(&call, EINVAL);
 			return EINVAL;
@@ -634,8 +636,10 @@ locfs_write(service_id_t service_id, fs_index_t index, aoff64_t pos,
 		service_t *dev = hash_table_get_inst(lnk, service_t, link);
 		assert(dev->sess);
 
+		/* The driver limits the size of the request. */
 		ipc_call_t call;
-		if (!async_data_write_receive(&call, NULL)) {
+		if (!async_data_write_receive_max(&call, NULL,
+		    DATA_XFER_PIN_LIMIT)) {
 			fibril_mutex_unlock(&services_mutex);
 			async_answer_0(&call, EINVAL);
 			return EINVAL;
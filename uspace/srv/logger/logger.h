@@ -38,6 +38,7 @@
 #include <adt/list.h>
 #include <adt/prodcons.h>
 #include <io/log.h>
+#include <ipc/logger.h>
 #include <async.h>
 #include <stdbool.h>
 #include <fibril_synch.h>
@@ -74,7 +75,7 @@ struct logger_log {
 	logger_dest_t *dest;
 };
 
-#define MAX_REFERENCED_LOGS_PER_CLIENT 100
+#define MAX_REFERENCED_LOGS_PER_CLIENT LOGGER_MAX_LOGS
 
 typedef struct {
 	size_t logs_count;
@@ -84,6 +85,7 @@ typedef struct {
 logger_log_t *find_log_by_name_and_lock(const char *name);
 logger_log_t *find_or_create_log_and_lock(const char *, sysarg_t);
 logger_log_t *find_log_by_id_and_lock(sysarg_t);
+log_level_t log_get_level(logger_log_t *);
 bool shall_log_message(logger_log_t *, log_level_t);
 void log_unlock(logger_log_t *);
 void write_to_log(logger_log_t *, log_level_t, const char *);
@@ -98,6 +100,7 @@ errno_t set_default_logging_level(log_level_t);
 
 void logger_connection_handler_control(ipc_call_t *);
 void logger_connection_handler_writer(ipc_call_t *);
+void refresh_log_levels(void);
 
 void parse_initial_settings(void);
 void parse_level_settings(char *);
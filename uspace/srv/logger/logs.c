@@ -184,14 +184,19 @@ static log_level_t get_actual_log_level(logger_log_t *log)
 	return log->logged_level;
 }
 
-bool shall_log_message(logger_log_t *log, log_level_t level)
+log_level_t log_get_level(logger_log_t *log)
 {
 	fibril_mutex_lock(&log_list_guard);
-	bool result = level <= get_actual_log_level(log);
+	log_level_t result = get_actual_log_level(log);
 	fibril_mutex_unlock(&log_list_guard);
 	return result;
 }
 
+bool shall_log_message(logger_log_t *log, log_level_t level)
+{
+	return level <= log_get_level(log);
+}
+
 void log_unlock(logger_log_t *log)
 {
 	assert(fibril_mutex_is_locked(&log->guard));
@@ -38,15 +38,62 @@
 #include <ipc/logger.h>
 #include <io/log.h>
 #include <io/logctl.h>
+#include <io/logger_ring.h>
 #include <io/klog.h>
+#include <as.h>
+#include <assert.h>
 #include <ns.h>
 #include <async.h>
 #include <errno.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <str.h>
 #include <str_error.h>
 #include "logger.h"
 
+/** Connected writer. */
+typedef struct {
+	link_t link;
+	/** Logs created by the client. */
+	logger_registered_logs_t logs;
+	/** Number of logs whose level is published in the ring. */
+	size_t published;
+	/** Ring buffer shared with the client, NULL if none. */
+	logger_ring_t *ring;
+} logger_client_t;
+
+/** Protects client_list and the published levels. */
+static FIBRIL_MUTEX_INITIALIZE(client_list_guard);
+static LIST_INITIALIZE(client_list);
+
+/** Publish effective levels of client logs in its ring buffer.
+ *
+ * Precondition: client_list_guard is locked.
+ */
+static void publish_log_levels(logger_client_t *client)
+{
+	assert(fibril_mutex_is_locked(&client_list_guard));
+
+	if (client->ring == NULL)
+		return;
+
+	for (size_t i = 0; i < client->published; i++) {
+		atomic_store_explicit(&client->ring->levels[i],
+		    log_get_level(client->logs.logs[i]), memory_order_relaxed);
+	}
+}
+
+/** Republish log levels of all clients after they have been changed. */
+void refresh_log_levels(void)
+{
+	fibril_mutex_lock(&client_list_guard);
+	list_foreach(client_list, link, logger_client_t, client) {
+		publish_log_levels(client);
+	}
+	fibril_mutex_unlock(&client_list_guard);
+}
+
 static logger_log_t *handle_create_log(sysarg_t parent)
 {
 	void *name;
@@ -61,6 +108,17 @@ static logger_log_t *handle_create_log(sysarg_t parent)
 	return log;
 }
 
+static void handle_message(logger_log_t *log, sysarg_t level,
+    const char *message)
+{
+	if (!shall_log_message(log, level))
+		return;
+
+	KLOG_PRINTF(level, "[%s] %s: %s",
+	    log->full_name, log_level_str(level), message);
+	write_to_log(log, level, message);
+}
+
 static errno_t handle_receive_message(sysarg_t log_id, sysarg_t level)
 {
 	logger_log_t *log = find_log_by_id_and_lock(log_id);
@@ -72,15 +130,7 @@ static errno_t handle_receive_message(sysarg_t log_id, sysarg_t level)
 	if (rc != EOK)
 		goto leave;
 
-	if (!shall_log_message(log, level)) {
-		rc = EOK;
-		goto leave;
-	}
-
-	KLOG_PRINTF(level, "[%s] %s: %s",
-	    log->full_name, log_level_str(level),
-	    (const char *) message);
-	write_to_log(log, level, message);
+	handle_message(log, level, message);
 
 	rc = EOK;
 
@@ -91,6 +141,98 @@ leave:
 	return rc;
 }
 
+static errno_t handle_set_ring(logger_client_t *client)
+{
+	if (client->ring != NULL)
+		return EEXIST;
+
+	ipc_call_t call;
+	size_t size;
+	unsigned int flags;
+	if (!async_share_out_receive(&call, &size, &flags)) {
+		async_answer_0(&call, EINVAL);
+		return EINVAL;
+	}
+
+	if ((size < LOGGER_RING_SIZE) || ((flags & AS_AREA_WRITE) == 0)) {
+		async_answer_0(&call, EINVAL);
+		return EINVAL;
+	}
+
+	void *ring;
+	errno_t rc = async_share_out_finalize(&call, &ring);
+	if ((rc != EOK) || (ring == AS_MAP_FAILED))
+		return ENOMEM;
+
+	fibril_mutex_lock(&client_list_guard);
+	client->ring = ring;
+	publish_log_levels(client);
+	fibril_mutex_unlock(&client_list_guard);
+
+	/* Ask to be notified about the first message. */
+	atomic_store(&client->ring->armed, true);
+
+	return EOK;
+}
+
+/** Write out messages from the ring buffer of the client.
+ *
+ * The ring is writable by the client, so all records are validated
+ * and a corrupted ring is discarded.
+ */
+static void handle_flush(logger_client_t *client)
+{
+	logger_ring_t *ring = client->ring;
+	if (ring == NULL)
+		return;
+
+	while (true) {
+		size_t head = atomic_load_explicit(&ring->head,
+		    memory_order_acquire);
+		size_t tail = atomic_load_explicit(&ring->tail,
+		    memory_order_relaxed);
+
+		while (tail != head) {
+			size_t size;
+			const logger_ring_rec_t *rec =
+			    logger_ring_read(ring, head, tail, &size);
+			if (rec == NULL) {
+				logger_log("writer: corrupted ring.\n");
+				tail = head;
+				break;
+			}
+
+			uint32_t level = rec->level;
+			sysarg_t log_id = rec->log;
+
+			if (level != LOGGER_RING_PAD) {
+				char *message = str_ndup(rec->message,
+				    size - sizeof(logger_ring_rec_t));
+				logger_log_t *log = find_log_by_id_and_lock(log_id);
+				if ((message != NULL) && (log != NULL))
+					handle_message(log, level, message);
+				if (log != NULL)
+					log_unlock(log);
+				free(message);
+			}
+
+			tail += size;
+		}
+
+		atomic_store_explicit(&ring->tail, tail, memory_order_release);
+
+		/*
+		 * Rearm the notification and check whether the client appended
+		 * more messages in the meantime without notifying us.
+		 */
+		atomic_store(&ring->armed, true);
+		if (atomic_load(&ring->head) == tail)
+			break;
+		if (!atomic_exchange(&ring->armed, false))
+			break;
+	}
+}
+
 void logger_connection_handler_writer(ipc_call_t *icall)
 {
 	logger_log_t *log;
@@ -101,8 +243,15 @@ void logger_connection_handler_writer(ipc_call_t *icall)
 
 	logger_log("writer: new client.\n");
 
-	logger_registered_logs_t registered_logs;
-	registered_logs_init(&registered_logs);
+	logger_client_t client;
+	link_initialize(&client.link);
+	registered_logs_init(&client.logs);
+	client.published = 0;
+	client.ring = NULL;
+
+	fibril_mutex_lock(&client_list_guard);
+	list_append(&client.link, &client_list);
+	fibril_mutex_unlock(&client_list_guard);
 
 	while (true) {
 		ipc_call_t call;
@@ -120,26 +269,50 @@ void logger_connection_handler_writer(ipc_call_t *icall)
 				async_answer_0(&call, ENOMEM);
 				break;
 			}
-			if (!register_log(&registered_logs, log)) {
+			if (!register_log(&client.logs, log)) {
 				log_unlock(log);
 				async_answer_0(&call, ELIMIT);
 				break;
 			}
 			log_unlock(log);
-			async_answer_1(&call, EOK, (sysarg_t) log);
+
+			fibril_mutex_lock(&client_list_guard);
+			client.published = client.logs.logs_count;
+			publish_log_levels(&client);
+			fibril_mutex_unlock(&client_list_guard);
+
+			async_answer_2(&call, EOK, (sysarg_t) log,
+			    client.logs.logs_count - 1);
 			break;
 		case LOGGER_WRITER_MESSAGE:
 			rc = handle_receive_message(ipc_get_arg1(&call),
 			    ipc_get_arg2(&call));
 			async_answer_0(&call, rc);
 			break;
+		case LOGGER_WRITER_SET_RING:
+			rc = handle_set_ring(&client);
+			async_answer_0(&call, rc);
+			break;
+		case LOGGER_WRITER_FLUSH:
+			handle_flush(&client);
+			async_answer_0(&call, EOK);
+			break;
 		default:
 			async_answer_0(&call, EINVAL);
 			break;
 		}
 	}
 
-	unregister_logs(&registered_logs);
+	fibril_mutex_lock(&client_list_guard);
+	list_remove(&client.link);
+	fibril_mutex_unlock(&client_list_guard);
+
+	if (client.ring != NULL) {
+		handle_flush(&client);
+		as_area_destroy(client.ring);
+	}
+
+	unregister_logs(&client.logs);
 	logger_log("writer: client terminated.\n");
 }
 
@@ -55,7 +55,7 @@
 static service_id_t svc_id;
 
 enum {
-	max_rw_buf_size = 16384,
+	max_rw_buf_size = DATA_XFER_PIN_LIMIT,
 };
 
 /** Object in read-only memory area that will be shared.
@@ -237,7 +237,8 @@ static void ipc_test_read_srv(ipc_call_t *icall)
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "ipc_test_read_srv");
 
-	if (!async_data_read_receive(&call, &size)) {
+	if (!async_data_read_receive_max(&call, &size, max_rw_buf_size)) {
+		async_answer_0(&call, EREFUSED);
 		async_answer_0(icall, EREFUSED);
 		log_msg(LOG_DEFAULT, LVL_ERROR, "data_read_receive failed");
 		return;
@@ -269,7 +270,8 @@ static void ipc_test_write_srv(ipc_call_t *icall)
 
 	log_msg(LOG_DEFAULT, LVL_DEBUG, "ipc_test_write_srv");
 
-	if (!async_data_write_receive(&call, &size)) {
+	if (!async_data_write_receive_max(&call, &size, max_rw_buf_size)) {
+		async_answer_0(&call, EREFUSED);
 		async_answer_0(icall, EREFUSED);
 		log_msg(LOG_DEFAULT, LVL_ERROR, "data_write_receive failed");
 		return;